@@ -0,0 +1,334 @@
+// Synthetic layout benchmarks for clay.
+// Each workload declares a parameterised tree every frame using a stub text measurement function, so the
+// numbers reflect the cost of clay itself rather than a font backend or renderer.
+//
+// Usage: clay_bench [frames] [scale]
+//   frames - number of timed frames per workload (default 500)
+//   scale  - multiplier applied to the size of every synthetic tree (default 1)
+//
+// Usage: clay_bench --replay capture [frames]
+//   Times the frames of a capture made with clay_capture.h instead of the synthetic workloads, looping over them.
+//   Text is measured with the sizes recorded in the capture.
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+#endif
+#define CLAY_IMPLEMENTATION
+#include "../clay.h"
+#define CLAY_CAPTURE_IMPLEMENTATION
+#include "clay_capture.h"
+#include "../examples/shared-layouts/clay-video-demo.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+static uint64_t Bench_Now(void) {
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+}
+#else
+#include <time.h>
+static uint64_t Bench_Now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+#endif
+
+#define BENCH_WARMUP_FRAMES 20
+
+static const Clay_Dimensions BENCH_LAYOUT_DIMENSIONS = { 1920, 1080 };
+static int32_t benchScale = 1;
+static int32_t benchErrorCount = 0;
+static ClayVideoDemo_Data benchVideoDemoData;
+static Clay_CaptureReplay benchReplay;
+static int32_t benchReplayFrame = 0;
+
+static Clay_String BENCH_SHORT_TEXT = CLAY_STRING_CONST("List item label");
+static Clay_String BENCH_PARAGRAPH_TEXT = CLAY_STRING_CONST("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat.\nDuis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum.");
+
+// Fixed advance stub, every character is half of the font size wide.
+static Clay_Dimensions Bench_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData) {
+    (void)userData;
+    return (Clay_Dimensions) { (float)text.length * (float)config->fontSize * 0.5f, (float)config->fontSize };
+}
+
+static void Bench_HandleError(Clay_ErrorData errorData) {
+    if (benchErrorCount++ == 0) {
+        fprintf(stderr, "clay error: %.*s\n", errorData.errorText.length, errorData.errorText.chars);
+    }
+}
+
+// Workloads -----------------------------------------
+
+static void Bench_DeclareNested(int32_t depth) {
+    CLAY_AUTO_ID({
+        .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .padding = CLAY_PADDING_ALL(1), .layoutDirection = depth & 1 ? CLAY_LEFT_TO_RIGHT : CLAY_TOP_TO_BOTTOM },
+        .backgroundColor = { 60, 60, 60, 255 }
+    }) {
+        if (depth > 0) {
+            Bench_DeclareNested(depth - 1);
+        } else {
+            CLAY_TEXT(BENCH_SHORT_TEXT, CLAY_TEXT_CONFIG({ .fontSize = 16, .textColor = { 255, 255, 255, 255 } }));
+        }
+    }
+}
+
+static Clay_RenderCommandArray Bench_DeepNesting(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
+        for (int32_t i = 0; i < 8; i++) {
+            Bench_DeclareNested(64 * benchScale);
+        }
+    }
+    return Clay_EndLayout();
+}
+
+static Clay_RenderCommandArray Bench_WideFlatList(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 2 } }) {
+        for (int32_t i = 0; i < 2000 * benchScale; i++) {
+            CLAY(CLAY_IDI("ListItem", i), {
+                .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(20) }, .childAlignment = { .y = CLAY_ALIGN_Y_CENTER } },
+                .backgroundColor = i & 1 ? (Clay_Color) { 40, 40, 40, 255 } : (Clay_Color) { 50, 50, 50, 255 }
+            }) {
+                CLAY_TEXT(BENCH_SHORT_TEXT, CLAY_TEXT_CONFIG({ .fontSize = 16, .textColor = { 255, 255, 255, 255 } }));
+            }
+        }
+    }
+    return Clay_EndLayout();
+}
+
+static Clay_RenderCommandArray Bench_WrappingText(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .childGap = 8 } }) {
+        for (int32_t column = 0; column < 4; column++) {
+            CLAY(CLAY_IDI("Column", column), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 4 } }) {
+                for (int32_t i = 0; i < 50 * benchScale; i++) {
+                    CLAY_TEXT(BENCH_PARAGRAPH_TEXT, CLAY_TEXT_CONFIG({ .fontSize = (uint16_t)(12 + (i & 3) * 2), .textColor = { 255, 255, 255, 255 } }));
+                }
+            }
+        }
+    }
+    return Clay_EndLayout();
+}
+
+static Clay_RenderCommandArray Bench_FloatingElements(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) } } }) {
+        for (int32_t i = 0; i < 1000 * benchScale; i++) {
+            CLAY(CLAY_IDI("Floating", i), {
+                .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) }, .padding = CLAY_PADDING_ALL(4) },
+                .backgroundColor = { 80, 80, 120, 255 },
+                .floating = {
+                    .attachTo = i & 1 ? CLAY_ATTACH_TO_ROOT : CLAY_ATTACH_TO_PARENT,
+                    .offset = { (float)((i * 37) % 1800), (float)((i * 53) % 1000) },
+                    .zIndex = (int16_t)(i % 8)
+                }
+            }) {
+                CLAY_TEXT(BENCH_SHORT_TEXT, CLAY_TEXT_CONFIG({ .fontSize = 16, .textColor = { 255, 255, 255, 255 } }));
+            }
+        }
+    }
+    return Clay_EndLayout();
+}
+
+// The number of scroll containers stays fixed as clay only tracks a limited number of them, the scale applies to their contents.
+static Clay_RenderCommandArray Bench_NestedScrollContainers(void) {
+    Clay_BeginLayout();
+    CLAY(CLAY_ID("Root"), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .childGap = 4 } }) {
+        for (int32_t outer = 0; outer < 8; outer++) {
+            CLAY(CLAY_IDI("OuterScroll", outer), {
+                .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 4 },
+                .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
+            }) {
+                for (int32_t inner = 0; inner < 8; inner++) {
+                    CLAY(CLAY_IDI("InnerScroll", outer * 8 + inner), {
+                        .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(200) }, .layoutDirection = CLAY_TOP_TO_BOTTOM },
+                        .backgroundColor = { 50, 50, 50, 255 },
+                        .clip = { .horizontal = true, .vertical = true, .childOffset = Clay_GetScrollOffset() }
+                    }) {
+                        for (int32_t row = 0; row < 20 * benchScale; row++) {
+                            CLAY_AUTO_ID({ .layout = { .sizing = { CLAY_SIZING_FIXED(400), CLAY_SIZING_FIXED(24) }, .padding = { 4, 4, 2, 2 } } }) {
+                                CLAY_TEXT(BENCH_SHORT_TEXT, CLAY_TEXT_CONFIG({ .fontSize = 16, .textColor = { 255, 255, 255, 255 } }));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return Clay_EndLayout();
+}
+
+static Clay_RenderCommandArray Bench_VideoDemo(void) {
+    return ClayVideoDemo_CreateLayout(&benchVideoDemoData);
+}
+
+static Clay_RenderCommandArray Bench_Replay(void) {
+    return Clay_CaptureReplay_Frame(&benchReplay, benchReplayFrame++ % benchReplay.frameCount);
+}
+
+// Reads the whole file, malloc() returns memory aligned well enough to replay it in place
+static void *Bench_ReadFile(const char *path, size_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void *data = size > 0 ? malloc((size_t)size) : NULL;
+    if (data && fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *length = data ? (size_t)size : 0;
+    return data;
+}
+
+// Harness -------------------------------------------
+
+typedef struct {
+    const char *name;
+    Clay_RenderCommandArray (*declareLayout)(void);
+    bool scrolls;
+} Bench_Workload;
+
+static int Bench_CompareUint64(const void *a, const void *b) {
+    uint64_t left = *(const uint64_t *)a;
+    uint64_t right = *(const uint64_t *)b;
+    return left < right ? -1 : left > right;
+}
+
+// Nearest rank percentile of an already sorted array.
+static uint64_t Bench_Percentile(const uint64_t *sorted, int32_t count, double percentile) {
+    int32_t rank = (int32_t)(percentile / 100.0 * (double)count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+static void Bench_Run(Bench_Workload workload, uint64_t *frameTimes, int32_t frameCount) {
+    int32_t elementCount = 0;
+    int32_t renderCommandCount = 0;
+    uint64_t totalTime = 0;
+    benchErrorCount = 0;
+    Clay_ResetMeasureTextCache();
+    for (int32_t frame = -BENCH_WARMUP_FRAMES; frame < frameCount; frame++) {
+        uint64_t start = Bench_Now();
+        if (workload.scrolls) {
+            Clay_SetPointerState((Clay_Vector2) { (float)(frame & 1023), 540 }, false);
+            Clay_UpdateScrollContainers(false, (Clay_Vector2) { 0, frame & 1 ? -4.0f : 4.0f }, 1.0f / 60.0f);
+        }
+        Clay_RenderCommandArray commands = workload.declareLayout();
+        uint64_t frameTime = Bench_Now() - start;
+        if (frame >= 0) {
+            frameTimes[frame] = frameTime;
+            totalTime += frameTime;
+        }
+        renderCommandCount = commands.length;
+    }
+    elementCount = Clay_GetFrameStats().elementCount;
+    qsort(frameTimes, (size_t)frameCount, sizeof(uint64_t), Bench_CompareUint64);
+    double meanTime = (double)totalTime / (double)frameCount;
+    printf("%-26s %9d %9d %12.2f %10.1f %10.1f%s\n",
+        workload.name,
+        elementCount,
+        renderCommandCount,
+        elementCount > 0 ? meanTime / (double)elementCount : 0.0,
+        (double)Bench_Percentile(frameTimes, frameCount, 50) / 1000.0,
+        (double)Bench_Percentile(frameTimes, frameCount, 99) / 1000.0,
+        benchErrorCount > 0 ? "  (errors)" : "");
+#ifdef CLAY_ENABLE_PROFILING
+    Clay_FrameStats stats = Clay_GetFrameStats();
+    printf("    tree %.1fus, sizing x %.1fus, wrap %.1fus, sizing y %.1fus, position %.1fus, hash probes %d/%d lookups\n",
+        (double)stats.treeBuildTime / 1000.0, (double)stats.sizingXTime / 1000.0, (double)stats.textWrapTime / 1000.0,
+        (double)stats.sizingYTime / 1000.0, (double)stats.positioningTime / 1000.0, stats.hashMapProbeCount, stats.hashMapLookupCount);
+#endif
+}
+
+#ifdef CLAY_ENABLE_PROFILING
+static uint64_t Bench_ProfilingClock(void *userData) {
+    (void)userData;
+    return Bench_Now();
+}
+#endif
+
+int main(int argc, char **argv) {
+    const char *replayPath = NULL;
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0) {
+        replayPath = argv[2];
+        argv += 2;
+        argc -= 2;
+    }
+    int32_t frameCount = argc > 1 ? atoi(argv[1]) : 500;
+    benchScale = argc > 2 && !replayPath ? atoi(argv[2]) : 1;
+    if (frameCount < 1 || benchScale < 1) {
+        fprintf(stderr, "usage: %s [frames] [scale]\n       %s --replay capture [frames]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    void *replayData = NULL;
+    if (replayPath) {
+        size_t replayLength;
+        replayData = Bench_ReadFile(replayPath, &replayLength);
+        if (!replayData || !Clay_CaptureReplay_Open(&benchReplay, replayData, replayLength) || benchReplay.frameCount == 0) {
+            fprintf(stderr, "%s is missing, empty or isn't a capture made by this version of clay\n", replayPath);
+            return 1;
+        }
+    }
+
+    Clay_SetMaxElementCount(CLAY__MAX(32768 * benchScale, benchReplay.maxElementCount));
+    Clay_SetMaxMeasureTextCacheWordCount(CLAY__MAX(65536 * benchScale, benchReplay.maxMeasureTextCacheWordCount));
+    uint64_t clayRequiredMemory = Clay_MinMemorySize();
+    Clay_Arena clayMemory = Clay_CreateArenaWithCapacityAndMemory(clayRequiredMemory, malloc(clayRequiredMemory));
+    Clay_Initialize(clayMemory, BENCH_LAYOUT_DIMENSIONS, (Clay_ErrorHandler) { Bench_HandleError });
+    Clay_SetMeasureTextFunction(Bench_MeasureText, NULL);
+#ifdef CLAY_ENABLE_PROFILING
+    Clay_SetProfilingClockFunction(Bench_ProfilingClock, NULL);
+#endif
+    benchVideoDemoData = ClayVideoDemo_Initialize();
+
+    Bench_Workload workloads[] = {
+        { "deep nesting", Bench_DeepNesting },
+        { "wide flat list", Bench_WideFlatList },
+        { "wrapping text", Bench_WrappingText },
+        { "floating elements", Bench_FloatingElements },
+        { "nested scroll containers", Bench_NestedScrollContainers, true },
+        { "video demo", Bench_VideoDemo, true },
+    };
+
+    uint64_t *frameTimes = (uint64_t *)malloc(sizeof(uint64_t) * (size_t)frameCount);
+    if (replayPath) {
+        Clay_SetMeasureTextFunction(Clay_CaptureReplay_MeasureText, &benchReplay);
+        printf("%d frames of %s, which has %d captured frames\n", frameCount, replayPath, benchReplay.frameCount);
+    } else {
+        printf("%d frames per workload, scale %d\n", frameCount, benchScale);
+    }
+    printf("%-26s %9s %9s %12s %10s %10s\n", "workload", "elements", "commands", "ns/element", "p50 (us)", "p99 (us)");
+    if (replayPath) {
+        // Element counts and render commands are those of the last frame timed
+        Bench_Run((Bench_Workload) { "replay", Bench_Replay }, frameTimes, frameCount);
+        if (benchReplay.missedMeasurementCount > 0) {
+            printf("%d strings weren't measured in the capture and were estimated\n", benchReplay.missedMeasurementCount);
+        }
+        Clay_CaptureReplay_Close(&benchReplay);
+        free(replayData);
+    } else {
+        for (size_t i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++) {
+            Bench_Run(workloads[i], frameTimes, frameCount);
+        }
+    }
+    free(frameTimes);
+    return 0;
+}
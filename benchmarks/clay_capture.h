@@ -0,0 +1,502 @@
+#ifndef CLAY_CAPTURE_INCLUDED
+#define CLAY_CAPTURE_INCLUDED (1)
+/*
+    clay_capture.h -- record the layouts an application declares, and replay them without it
+
+    Do this:
+        #define CLAY_CAPTURE_IMPLEMENTATION
+
+    before you include this file in *one* C file to create the
+    implementation. clay.h must be included first.
+
+    Optionally define CLAY_CAPTURE_REALLOC and CLAY_CAPTURE_FREE before the
+    implementation to replace realloc() and free().
+
+    FEATURE OVERVIEW:
+    =================
+    A capture records every element an application declares in each frame,
+    with its ID, Clay_ElementDeclaration and text, along with the size that
+    the text measurement function returned for every string it measured.
+    Replaying a capture feeds the same declarations back through
+    Clay_BeginLayout() and Clay_EndLayout(), and answers text measurement from
+    the recorded sizes, so the exact trees that a user had can be laid out
+    again without the application, its fonts or its renderer. The clay_bench
+    target replays captures with "clay_bench --replay capture.clay", which
+    turns real traces into benchmarks that can be compared commit to commit.
+
+    The capture file is a header followed by records, which are all aligned
+    to 8 bytes and use the byte order of the machine that made the capture.
+    Declarations and text are stored as they were declared, and replay passes
+    pointers into the file directly to clay, so a file can be memory mapped
+    and replayed without being parsed into another form. As the declarations
+    are stored as structs, a capture can only be replayed by a build of clay
+    with the same Clay_ElementDeclaration and Clay_TextElementConfig layout,
+    which is checked when it is opened.
+
+    Pointers in declarations (userData, imageData and customData) are stored
+    as they were, and are only meaningful to the process that captured them.
+    CLAY_CACHED blocks are declared in full while capturing so that their
+    contents are recorded, and the debug view isn't captured.
+
+    HOWTO:
+    ======
+        // Capturing
+        static Clay_Capture capture; // Zero initialised
+        Clay_Capture_Start(&capture);
+        ... // Declare frames as usual
+        Clay_Capture_Stop(&capture);
+        fwrite(capture.data, 1, capture.length, file);
+        Clay_Capture_Free(&capture);
+
+    Long captures can be streamed to a file instead, by writing capture.data
+    and setting capture.length to zero after any Clay_EndLayout().
+
+        // Replaying, data should be aligned to 8 bytes, which mmap() and malloc() both are
+        Clay_CaptureReplay replay;
+        if (Clay_CaptureReplay_Open(&replay, data, length)) {
+            Clay_SetMeasureTextFunction(Clay_CaptureReplay_MeasureText, &replay);
+            for (int32_t i = 0; i < replay.frameCount; i++) {
+                Clay_RenderCommandArray renderCommands = Clay_CaptureReplay_Frame(&replay, i);
+            }
+            Clay_CaptureReplay_Close(&replay);
+        }
+ */
+
+#define CLAY_CAPTURE_VERSION 1
+
+typedef struct {
+    char magic[4]; // "CLCP"
+    uint32_t version;
+    // The size of the declaration structs in the build that made the capture
+    uint32_t declarationSize;
+    uint32_t textConfigSize;
+    // The capacities of the context that was captured, which are needed to replay it without errors
+    int32_t maxElementCount;
+    int32_t maxMeasureTextCacheWordCount;
+} Clay_CaptureHeader;
+
+// Every record starts with this header, and is followed by a payload that depends on the type
+typedef struct {
+    uint32_t type; // Clay_CaptureEventType
+    uint32_t size; // The size of the record including this header, a multiple of 8
+} Clay_CaptureRecord;
+
+typedef struct {
+    // The capture. It can be written out and emptied between frames.
+    uint8_t *data;
+    size_t length;
+    // Internal storage, grown as required
+    size_t capacity;
+} Clay_Capture;
+
+// A text measurement recorded in a capture
+typedef struct {
+    const char *chars;
+    int32_t length;
+    uint16_t fontId;
+    uint16_t fontSize;
+    uint16_t letterSpacing;
+    uint16_t lineHeight;
+    uint32_t hash;
+    Clay_Dimensions dimensions;
+} Clay_CaptureMeasurement;
+
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+    // The number of complete frames in the capture
+    int32_t frameCount;
+    // The capacities that the capture was made with, see Clay_SetMaxElementCount() and Clay_SetMaxMeasureTextCacheWordCount()
+    int32_t maxElementCount;
+    int32_t maxMeasureTextCacheWordCount;
+    // The number of strings measured during replay that weren't measured in the capture, and were estimated instead
+    int32_t missedMeasurementCount;
+    // Internal storage
+    size_t *frameOffsets;
+    Clay_CaptureMeasurement *measurements;
+    int32_t measurementCount;
+    int32_t *measurementSlots;
+    int32_t measurementSlotCount;
+} Clay_CaptureReplay;
+
+// Starts appending the declarations of every frame from the next Clay_BeginLayout() of the current context to capture->data.
+// Writes the file header first if capture->data is empty.
+void Clay_Capture_Start(Clay_Capture *capture);
+// Stops capturing the current context
+void Clay_Capture_Stop(Clay_Capture *capture);
+// Frees the memory used by the capture, which can then be reused
+void Clay_Capture_Free(Clay_Capture *capture);
+
+// Checks a capture and indexes its frames and text measurements. The data is used in place and must outlive the replay.
+// Returns false if the data isn't a capture, was captured by an incompatible build, or is malformed.
+bool Clay_CaptureReplay_Open(Clay_CaptureReplay *replay, const void *data, size_t length);
+// Declares one frame of the capture in the current context, from Clay_BeginLayout() to Clay_EndLayout(), and returns its render commands.
+// The layout dimensions are set to those of the captured frame.
+Clay_RenderCommandArray Clay_CaptureReplay_Frame(Clay_CaptureReplay *replay, int32_t frameIndex);
+// A text measurement function that returns the sizes recorded in the capture, to be bound with userData pointing to the replay
+Clay_Dimensions Clay_CaptureReplay_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData);
+// Frees the memory used by the replay. The capture data is left untouched.
+void Clay_CaptureReplay_Close(Clay_CaptureReplay *replay);
+
+#endif /* CLAY_CAPTURE_INCLUDED */
+
+#ifdef CLAY_CAPTURE_IMPLEMENTATION
+#undef CLAY_CAPTURE_IMPLEMENTATION
+#ifndef CLAY_HEADER
+#error "Please include clay.h before clay_capture.h"
+#endif
+
+#include <stddef.h>
+#include <string.h>
+
+#if !defined(CLAY_CAPTURE_REALLOC) || !defined(CLAY_CAPTURE_FREE)
+#include <stdlib.h>
+#define CLAY_CAPTURE_REALLOC(pointer, size) realloc(pointer, size)
+#define CLAY_CAPTURE_FREE(pointer) free(pointer)
+#endif
+
+#define CLAY__CAPTURE_ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+// Record payloads. Text and element ID strings follow the fixed part of the payload.
+typedef struct {
+    Clay_Dimensions dimensions;
+} Clay__CaptureBeginLayout;
+
+typedef struct {
+    uint32_t id;
+    uint32_t offset;
+    uint32_t baseId;
+    int32_t stringLength;
+} Clay__CaptureOpenElement;
+
+typedef struct {
+    int32_t length;
+    uint32_t isStaticallyAllocated;
+} Clay__CaptureText;
+
+typedef struct {
+    Clay_Dimensions dimensions;
+    uint16_t fontId;
+    uint16_t fontSize;
+    uint16_t letterSpacing;
+    uint16_t lineHeight;
+    int32_t length;
+    uint32_t padding;
+} Clay__CaptureMeasureText;
+
+static const char CLAY__CAPTURE_MAGIC[4] = { 'C', 'L', 'C', 'P' };
+
+static uint32_t Clay__CaptureHashMeasurement(const char *chars, int32_t length, uint16_t fontId, uint16_t fontSize, uint16_t letterSpacing, uint16_t lineHeight) {
+    uint32_t hash = 2166136261u;
+    uint16_t style[4] = { fontId, fontSize, letterSpacing, lineHeight };
+    const uint8_t *styleBytes = (const uint8_t *)style;
+    for (size_t i = 0; i < sizeof(style); i++) {
+        hash = (hash ^ styleBytes[i]) * 16777619u;
+    }
+    for (int32_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)chars[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Capturing -------------------------------------
+
+// Reserves space for a record with a payload of payloadSize bytes followed by tailSize bytes, and returns a pointer to the payload
+static uint8_t *Clay__CaptureAppendRecord(Clay_Capture *capture, Clay_CaptureEventType type, size_t payloadSize, size_t tailSize) {
+    size_t recordSize = CLAY__CAPTURE_ALIGN(sizeof(Clay_CaptureRecord) + CLAY__CAPTURE_ALIGN(payloadSize) + tailSize);
+    if (capture->length + recordSize > capture->capacity) {
+        capture->capacity = CLAY__MAX(capture->capacity * 2, CLAY__MAX(capture->length + recordSize, (size_t)65536));
+        capture->data = (uint8_t *)CLAY_CAPTURE_REALLOC(capture->data, capture->capacity);
+    }
+    uint8_t *record = capture->data + capture->length;
+    memset(record, 0, recordSize);
+    ((Clay_CaptureRecord *)record)->type = (uint32_t)type;
+    ((Clay_CaptureRecord *)record)->size = (uint32_t)recordSize;
+    capture->length += recordSize;
+    return record + sizeof(Clay_CaptureRecord);
+}
+
+static void Clay__CaptureEvent(const Clay_CaptureEvent *event, void *userData) {
+    Clay_Capture *capture = (Clay_Capture *)userData;
+    switch (event->type) {
+        case CLAY_CAPTURE_EVENT_BEGIN_LAYOUT: {
+            Clay__CaptureBeginLayout payload = { event->dimensions };
+            memcpy(Clay__CaptureAppendRecord(capture, event->type, sizeof(payload), 0), &payload, sizeof(payload));
+            break;
+        }
+        case CLAY_CAPTURE_EVENT_OPEN_ELEMENT: {
+            Clay__CaptureOpenElement payload = { event->elementId.id, event->elementId.offset, event->elementId.baseId, event->elementId.stringId.length };
+            uint8_t *destination = Clay__CaptureAppendRecord(capture, event->type, sizeof(payload), (size_t)payload.stringLength);
+            memcpy(destination, &payload, sizeof(payload));
+            if (payload.stringLength > 0) {
+                memcpy(destination + CLAY__CAPTURE_ALIGN(sizeof(payload)), event->elementId.stringId.chars, (size_t)payload.stringLength);
+            }
+            break;
+        }
+        case CLAY_CAPTURE_EVENT_CONFIGURE_ELEMENT: {
+            memcpy(Clay__CaptureAppendRecord(capture, event->type, sizeof(Clay_ElementDeclaration), 0), event->declaration, sizeof(Clay_ElementDeclaration));
+            break;
+        }
+        case CLAY_CAPTURE_EVENT_TEXT_ELEMENT: {
+            Clay__CaptureText payload = { event->text.length, event->textIsStaticallyAllocated };
+            size_t configSize = CLAY__CAPTURE_ALIGN(sizeof(Clay_TextElementConfig));
+            uint8_t *destination = Clay__CaptureAppendRecord(capture, event->type, configSize + sizeof(payload), (size_t)payload.length);
+            memcpy(destination, event->textConfig, sizeof(Clay_TextElementConfig));
+            memcpy(destination + configSize, &payload, sizeof(payload));
+            if (payload.length > 0) {
+                memcpy(destination + configSize + CLAY__CAPTURE_ALIGN(sizeof(payload)), event->text.chars, (size_t)payload.length);
+            }
+            break;
+        }
+        case CLAY_CAPTURE_EVENT_MEASURE_TEXT: {
+            Clay_TextElementConfig *config = event->textConfig;
+            Clay__CaptureMeasureText payload = { event->dimensions, config->fontId, config->fontSize, config->letterSpacing, config->lineHeight, event->text.length, 0 };
+            uint8_t *destination = Clay__CaptureAppendRecord(capture, event->type, sizeof(payload), (size_t)payload.length);
+            memcpy(destination, &payload, sizeof(payload));
+            if (payload.length > 0) {
+                memcpy(destination + CLAY__CAPTURE_ALIGN(sizeof(payload)), event->text.chars, (size_t)payload.length);
+            }
+            break;
+        }
+        case CLAY_CAPTURE_EVENT_CLOSE_ELEMENT:
+        case CLAY_CAPTURE_EVENT_END_LAYOUT: {
+            Clay__CaptureAppendRecord(capture, event->type, 0, 0);
+            break;
+        }
+        default: break;
+    }
+}
+
+void Clay_Capture_Start(Clay_Capture *capture) {
+    if (capture->length == 0) {
+        Clay_CaptureHeader header = {
+            .version = CLAY_CAPTURE_VERSION,
+            .declarationSize = (uint32_t)sizeof(Clay_ElementDeclaration),
+            .textConfigSize = (uint32_t)sizeof(Clay_TextElementConfig),
+            .maxElementCount = Clay_GetMaxElementCount(),
+            .maxMeasureTextCacheWordCount = Clay_GetMaxMeasureTextCacheWordCount(),
+        };
+        memcpy(header.magic, CLAY__CAPTURE_MAGIC, sizeof(header.magic));
+        capture->capacity = CLAY__MAX(capture->capacity, (size_t)65536);
+        capture->data = (uint8_t *)CLAY_CAPTURE_REALLOC(capture->data, capture->capacity);
+        memcpy(capture->data, &header, sizeof(header));
+        capture->length = CLAY__CAPTURE_ALIGN(sizeof(header));
+    }
+    Clay_SetCaptureFunction(Clay__CaptureEvent, capture);
+}
+
+void Clay_Capture_Stop(Clay_Capture *capture) {
+    (void)capture;
+    Clay_SetCaptureFunction(NULL, NULL);
+}
+
+void Clay_Capture_Free(Clay_Capture *capture) {
+    CLAY_CAPTURE_FREE(capture->data);
+    *capture = (Clay_Capture) { 0 };
+}
+
+// Replaying -------------------------------------
+
+// Checks that the payload of a record holds fixedSize bytes, followed by a tail with the length stored at lengthOffset in the payload, if lengthOffset isn't -1
+static bool Clay__CaptureRecordFits(const Clay_CaptureRecord *record, size_t fixedSize, size_t lengthOffset) {
+    size_t payloadSize = record->size - sizeof(Clay_CaptureRecord);
+    if (payloadSize < fixedSize) {
+        return false;
+    }
+    if (lengthOffset == (size_t)-1) {
+        return true;
+    }
+    int32_t tailLength;
+    memcpy(&tailLength, (const uint8_t *)(record + 1) + lengthOffset, sizeof(tailLength));
+    return tailLength >= 0 && (size_t)tailLength <= payloadSize - CLAY__CAPTURE_ALIGN(fixedSize);
+}
+
+static void Clay__CaptureAddMeasurement(Clay_CaptureReplay *replay, Clay_CaptureMeasurement measurement) {
+    if ((replay->measurementCount + 1) * 2 > replay->measurementSlotCount) {
+        int32_t slotCount = CLAY__MAX(replay->measurementSlotCount * 2, 1024);
+        replay->measurementSlots = (int32_t *)CLAY_CAPTURE_REALLOC(replay->measurementSlots, (size_t)slotCount * sizeof(int32_t));
+        replay->measurements = (Clay_CaptureMeasurement *)CLAY_CAPTURE_REALLOC(replay->measurements, (size_t)(slotCount / 2) * sizeof(Clay_CaptureMeasurement));
+        replay->measurementSlotCount = slotCount;
+        for (int32_t i = 0; i < slotCount; i++) {
+            replay->measurementSlots[i] = -1;
+        }
+        for (int32_t i = 0; i < replay->measurementCount; i++) {
+            uint32_t slot = replay->measurements[i].hash & (uint32_t)(slotCount - 1);
+            while (replay->measurementSlots[slot] != -1) {
+                slot = (slot + 1) & (uint32_t)(slotCount - 1);
+            }
+            replay->measurementSlots[slot] = i;
+        }
+    }
+    uint32_t mask = (uint32_t)replay->measurementSlotCount - 1;
+    uint32_t slot = measurement.hash & mask;
+    while (replay->measurementSlots[slot] != -1) {
+        Clay_CaptureMeasurement *existing = &replay->measurements[replay->measurementSlots[slot]];
+        // The same string can be measured again after being evicted from the cache, the first measurement is kept
+        if (existing->hash == measurement.hash && existing->length == measurement.length && existing->fontId == measurement.fontId && existing->fontSize == measurement.fontSize
+            && existing->letterSpacing == measurement.letterSpacing && existing->lineHeight == measurement.lineHeight && memcmp(existing->chars, measurement.chars, (size_t)measurement.length) == 0) {
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    replay->measurements[replay->measurementCount] = measurement;
+    replay->measurementSlots[slot] = replay->measurementCount++;
+}
+
+bool Clay_CaptureReplay_Open(Clay_CaptureReplay *replay, const void *data, size_t length) {
+    *replay = (Clay_CaptureReplay) { .data = (const uint8_t *)data, .length = length };
+    Clay_CaptureHeader header;
+    if (length < sizeof(header) || ((uintptr_t)data & 7) != 0) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, CLAY__CAPTURE_MAGIC, sizeof(header.magic)) != 0 || header.version != CLAY_CAPTURE_VERSION
+        || header.declarationSize != sizeof(Clay_ElementDeclaration) || header.textConfigSize != sizeof(Clay_TextElementConfig)) {
+        return false;
+    }
+    replay->maxElementCount = header.maxElementCount;
+    replay->maxMeasureTextCacheWordCount = header.maxMeasureTextCacheWordCount;
+
+    int32_t frameCapacity = 0;
+    size_t frameStart = 0;
+    bool inFrame = false;
+    size_t offset = CLAY__CAPTURE_ALIGN(sizeof(header));
+    while (offset + sizeof(Clay_CaptureRecord) <= length) {
+        const Clay_CaptureRecord *record = (const Clay_CaptureRecord *)(replay->data + offset);
+        if (record->size < sizeof(Clay_CaptureRecord) || (record->size & 7) != 0 || record->size > length - offset) {
+            break;
+        }
+        const uint8_t *payload = (const uint8_t *)(record + 1);
+        bool valid = true;
+        switch (record->type) {
+            case CLAY_CAPTURE_EVENT_BEGIN_LAYOUT: {
+                valid = Clay__CaptureRecordFits(record, sizeof(Clay__CaptureBeginLayout), (size_t)-1);
+                frameStart = offset;
+                inFrame = true;
+                break;
+            }
+            case CLAY_CAPTURE_EVENT_OPEN_ELEMENT: valid = inFrame && Clay__CaptureRecordFits(record, sizeof(Clay__CaptureOpenElement), offsetof(Clay__CaptureOpenElement, stringLength)); break;
+            case CLAY_CAPTURE_EVENT_CONFIGURE_ELEMENT: valid = inFrame && Clay__CaptureRecordFits(record, sizeof(Clay_ElementDeclaration), (size_t)-1); break;
+            case CLAY_CAPTURE_EVENT_CLOSE_ELEMENT: valid = inFrame; break;
+            case CLAY_CAPTURE_EVENT_TEXT_ELEMENT: {
+                size_t configSize = CLAY__CAPTURE_ALIGN(sizeof(Clay_TextElementConfig));
+                valid = inFrame && Clay__CaptureRecordFits(record, configSize + sizeof(Clay__CaptureText), configSize + offsetof(Clay__CaptureText, length));
+                break;
+            }
+            case CLAY_CAPTURE_EVENT_MEASURE_TEXT: {
+                valid = Clay__CaptureRecordFits(record, sizeof(Clay__CaptureMeasureText), offsetof(Clay__CaptureMeasureText, length));
+                if (valid) {
+                    Clay__CaptureMeasureText measured;
+                    memcpy(&measured, payload, sizeof(measured));
+                    const char *chars = (const char *)payload + CLAY__CAPTURE_ALIGN(sizeof(measured));
+                    Clay__CaptureAddMeasurement(replay, (Clay_CaptureMeasurement) {
+                        .chars = chars, .length = measured.length,
+                        .fontId = measured.fontId, .fontSize = measured.fontSize, .letterSpacing = measured.letterSpacing, .lineHeight = measured.lineHeight,
+                        .hash = Clay__CaptureHashMeasurement(chars, measured.length, measured.fontId, measured.fontSize, measured.letterSpacing, measured.lineHeight),
+                        .dimensions = measured.dimensions
+                    });
+                }
+                break;
+            }
+            case CLAY_CAPTURE_EVENT_END_LAYOUT: {
+                valid = inFrame;
+                if (valid) {
+                    if (replay->frameCount == frameCapacity) {
+                        frameCapacity = CLAY__MAX(frameCapacity * 2, 64);
+                        replay->frameOffsets = (size_t *)CLAY_CAPTURE_REALLOC(replay->frameOffsets, (size_t)frameCapacity * sizeof(size_t));
+                    }
+                    replay->frameOffsets[replay->frameCount++] = frameStart;
+                }
+                inFrame = false;
+                break;
+            }
+            default: valid = false; break;
+        }
+        if (!valid) {
+            Clay_CaptureReplay_Close(replay);
+            return false;
+        }
+        offset += record->size;
+    }
+    // A capture that was cut off part way through a frame is still usable, up to the last complete frame
+    return true;
+}
+
+Clay_RenderCommandArray Clay_CaptureReplay_Frame(Clay_CaptureReplay *replay, int32_t frameIndex) {
+    size_t offset = replay->frameOffsets[frameIndex];
+    while (true) {
+        const Clay_CaptureRecord *record = (const Clay_CaptureRecord *)(replay->data + offset);
+        const uint8_t *payload = (const uint8_t *)(record + 1);
+        offset += record->size;
+        switch (record->type) {
+            case CLAY_CAPTURE_EVENT_BEGIN_LAYOUT: {
+                Clay__CaptureBeginLayout begin;
+                memcpy(&begin, payload, sizeof(begin));
+                Clay_SetLayoutDimensions(begin.dimensions);
+                Clay_BeginLayout();
+                break;
+            }
+            case CLAY_CAPTURE_EVENT_OPEN_ELEMENT: {
+                const Clay__CaptureOpenElement *open = (const Clay__CaptureOpenElement *)payload;
+                if (open->id == 0) {
+                    Clay__OpenElement();
+                } else {
+                    Clay_String stringId = { .isStaticallyAllocated = true, .length = open->stringLength, .chars = (const char *)payload + CLAY__CAPTURE_ALIGN(sizeof(*open)) };
+                    Clay__OpenElementWithId((Clay_ElementId) { .id = open->id, .offset = open->offset, .baseId = open->baseId, .stringId = stringId });
+                }
+                break;
+            }
+            case CLAY_CAPTURE_EVENT_CONFIGURE_ELEMENT: {
+                Clay__ConfigureOpenElementPtr((const Clay_ElementDeclaration *)payload);
+                break;
+            }
+            case CLAY_CAPTURE_EVENT_CLOSE_ELEMENT: {
+                Clay__CloseElement();
+                break;
+            }
+            case CLAY_CAPTURE_EVENT_TEXT_ELEMENT: {
+                size_t configSize = CLAY__CAPTURE_ALIGN(sizeof(Clay_TextElementConfig));
+                const Clay__CaptureText *text = (const Clay__CaptureText *)(payload + configSize);
+                Clay_String string = { .isStaticallyAllocated = text->isStaticallyAllocated != 0, .length = text->length, .chars = (const char *)payload + configSize + CLAY__CAPTURE_ALIGN(sizeof(*text)) };
+                // Clay only reads text configs, so the config is used directly from the capture
+                Clay__OpenTextElement(string, (Clay_TextElementConfig *)payload);
+                break;
+            }
+            case CLAY_CAPTURE_EVENT_END_LAYOUT: {
+                return Clay_EndLayout();
+            }
+            default: break;
+        }
+    }
+}
+
+Clay_Dimensions Clay_CaptureReplay_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData) {
+    Clay_CaptureReplay *replay = (Clay_CaptureReplay *)userData;
+    uint32_t hash = Clay__CaptureHashMeasurement(text.chars, text.length, config->fontId, config->fontSize, config->letterSpacing, config->lineHeight);
+    if (replay->measurementSlotCount > 0) {
+        uint32_t mask = (uint32_t)replay->measurementSlotCount - 1;
+        for (uint32_t slot = hash & mask; replay->measurementSlots[slot] != -1; slot = (slot + 1) & mask) {
+            Clay_CaptureMeasurement *measurement = &replay->measurements[replay->measurementSlots[slot]];
+            if (measurement->hash == hash && measurement->length == text.length && measurement->fontId == config->fontId && measurement->fontSize == config->fontSize
+                && measurement->letterSpacing == config->letterSpacing && measurement->lineHeight == config->lineHeight && memcmp(measurement->chars, text.chars, (size_t)text.length) == 0) {
+                return measurement->dimensions;
+            }
+        }
+    }
+    // Strings can be split differently when replayed by another version of clay, so they're estimated rather than failing
+    replay->missedMeasurementCount++;
+    return (Clay_Dimensions) { (float)text.length * (float)config->fontSize * 0.5f, (float)config->fontSize };
+}
+
+void Clay_CaptureReplay_Close(Clay_CaptureReplay *replay) {
+    CLAY_CAPTURE_FREE(replay->frameOffsets);
+    CLAY_CAPTURE_FREE(replay->measurements);
+    CLAY_CAPTURE_FREE(replay->measurementSlots);
+    replay->frameOffsets = NULL;
+    replay->measurements = NULL;
+    replay->measurementSlots = NULL;
+    replay->frameCount = 0;
+    replay->measurementCount = 0;
+    replay->measurementSlotCount = 0;
+}
+#endif /* CLAY_CAPTURE_IMPLEMENTATION */
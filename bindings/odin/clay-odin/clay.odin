@@ -111,6 +111,7 @@ TextElementConfig :: struct {
 	lineHeight:         u16,
 	wrapMode:           TextWrapMode,
 	textAlignment:      TextAlignment,
+	monospace:          bool,
 }
 
 AspectRatioElementConfig :: struct {
@@ -17,8 +17,18 @@
 // SIMD includes on supported platforms
 #if !defined(CLAY_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64))
 #include <emmintrin.h>
+#if defined(__AVX2__) || defined(CLAY_ENABLE_CPU_DISPATCH)
+#include <immintrin.h>
+#endif
+#if defined(CLAY_ENABLE_CPU_DISPATCH) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(CLAY_ENABLE_CPU_DISPATCH)
+#include <cpuid.h>
+#endif
 #elif !defined(CLAY_DISABLE_SIMD) && defined(__aarch64__)
 #include <arm_neon.h>
+#elif !defined(CLAY_DISABLE_SIMD) && defined(__wasm_simd128__)
+#include <wasm_simd128.h>
 #endif
 
 // -----------------------------------------
@@ -49,6 +59,21 @@
 #define CLAY_DLL_EXPORT
 #endif
 
+// With CLAY_THREAD_LOCAL_CONTEXT defined each thread has its own current context and element latch, so independent contexts can be laid out on separate threads.
+#ifdef CLAY_THREAD_LOCAL_CONTEXT
+    #if defined(__cplusplus)
+        #define CLAY__THREAD_LOCAL thread_local
+    #elif defined(_MSC_VER)
+        #define CLAY__THREAD_LOCAL __declspec(thread)
+    #elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+        #define CLAY__THREAD_LOCAL _Thread_local
+    #else
+        #define CLAY__THREAD_LOCAL __thread
+    #endif
+#else
+    #define CLAY__THREAD_LOCAL
+#endif
+
 // Public Macro API ------------------------
 
 #define CLAY__MAX(x, y) (((x) > (y)) ? (x) : (y))
@@ -72,13 +97,25 @@
 
 #define CLAY_SIZING_PERCENT(percentOfParent) (CLAY__INIT(Clay_SizingAxis) { .size = { .percent = (percentOfParent) }, .type = CLAY__SIZING_TYPE_PERCENT })
 
+// In C++20 (with consteval) the hashes of CLAY_ID and CLAY_IDI string literals are calculated at compile time, see Clay__HashStringLiteral()
+#if defined(__cplusplus) && defined(__cpp_consteval)
 // Note: If a compile error led you here, you might be trying to use CLAY_ID with something other than a string literal. To construct an ID with a dynamic string, use CLAY_SID instead.
-#define CLAY_ID(label) CLAY_SID(CLAY_STRING(label))
+#define CLAY_ID(label) CLAY_ID_HASHED(label, Clay__HashStringLiteral(CLAY__ENSURE_STRING_LITERAL(label), CLAY__STRING_LENGTH(CLAY__ENSURE_STRING_LITERAL(label))))
 
-#define CLAY_SID(label) Clay__HashString(label, 0)
+// Note: If a compile error led you here, you might be trying to use CLAY_IDI with something other than a string literal. To construct an ID with a dynamic string, use CLAY_SIDI instead.
+#define CLAY_IDI(label, index) Clay__HashStringBaseWithOffset(CLAY_STRING(label), Clay__HashStringLiteralBase(CLAY__ENSURE_STRING_LITERAL(label), CLAY__STRING_LENGTH(CLAY__ENSURE_STRING_LITERAL(label))), index)
+#else
+// Note: If a compile error led you here, you might be trying to use CLAY_ID with something other than a string literal. To construct an ID with a dynamic string, use CLAY_SID instead.
+#define CLAY_ID(label) CLAY_SID(CLAY_STRING(label))
 
 // Note: If a compile error led you here, you might be trying to use CLAY_IDI with something other than a string literal. To construct an ID with a dynamic string, use CLAY_SIDI instead.
 #define CLAY_IDI(label, index) CLAY_SIDI(CLAY_STRING(label), index)
+#endif
+
+// Constructs the same ID as CLAY_ID(label) from a hash calculated ahead of time, i.e. the value of CLAY_ID(label).id, without hashing the label at runtime.
+#define CLAY_ID_HASHED(label, hash) (CLAY__INIT(Clay_ElementId) { .id = (hash), .offset = 0, .baseId = (hash), .stringId = CLAY_STRING(label) })
+
+#define CLAY_SID(label) Clay__HashString(label, 0)
 
 #define CLAY_SIDI(label, index) Clay__HashStringWithOffset(label, index, 0)
 
@@ -101,7 +138,7 @@
 
 #define CLAY_STRING_CONST(string) { .isStaticallyAllocated = true, .length = CLAY__STRING_LENGTH(CLAY__ENSURE_STRING_LITERAL(string)), .chars = (string) }
 
-static uint8_t CLAY__ELEMENT_DEFINITION_LATCH;
+static CLAY__THREAD_LOCAL uint8_t CLAY__ELEMENT_DEFINITION_LATCH;
 
 // GCC marks the above CLAY__ELEMENT_DEFINITION_LATCH as an unused variable for files that include clay.h but don't declare any layout
 // This is to suppress that warning
@@ -147,6 +184,24 @@ static inline void Clay__SuppressUnusedLatchDefinitionVariableWarning(void) { (v
         CLAY__ELEMENT_DEFINITION_LATCH=1, Clay__CloseElement()                                                                                                      \
     )
 
+/* Declares a block of elements that only needs to be declared again when stateHash changes, e.g.
+
+  CLAY_CACHED(CLAY_ID("Toolbar"), toolbarStateHash) {
+      CLAY(CLAY_ID("ToolbarButton"), { ... }) { ... }
+      ...
+  }
+
+  The first time the block is declared with a given stateHash, the elements it declares are recorded. On following frames,
+  as long as the block is declared with the same id and stateHash within the same parent, the recorded elements are added
+  to the layout directly and the body of the block isn't run. See the README for what stateHash needs to cover.
+*/
+#define CLAY_CACHED(id, stateHash)                                                                      \
+    for (                                                                                               \
+        CLAY__ELEMENT_DEFINITION_LATCH = Clay__BeginCachedSubtree(id, stateHash) ? 0 : 1;              \
+        CLAY__ELEMENT_DEFINITION_LATCH < 1;                                                             \
+        CLAY__ELEMENT_DEFINITION_LATCH=1, Clay__EndCachedSubtree()                                      \
+    )
+
 // These macros exist to allow the CLAY() macro to be called both with an inline struct definition, such as
 // CLAY({ .id = something... });
 // As well as by passing a predefined declaration struct
@@ -403,10 +458,27 @@ typedef struct Clay_TextElementConfig {
     // CLAY_TEXT_ALIGN_CENTER - Horizontally aligns wrapped lines of text to the center of their bounding box.
     // CLAY_TEXT_ALIGN_RIGHT - Horizontally aligns wrapped lines of text to the right hand side of their bounding box.
     Clay_TextAlignment textAlignment;
+    // Set for fixed width fonts. Clay_MeasureText will only be called once per string, to measure a single space, and a word of n characters
+    // (UTF-8 codepoints) is treated as n * (width of a space) + (n - 1) * letterSpacing wide, and as tall as the space.
+    bool monospace;
 } Clay_TextElementConfig;
 
 CLAY__WRAPPER_STRUCT(Clay_TextElementConfig);
 
+// A single string to be measured by the function passed to Clay_SetMeasureTextBatchFunction().
+typedef struct Clay_MeasureTextBatchItem {
+    Clay_StringSlice text; // The string to measure, which will be either a single word or a single space.
+    Clay_TextElementConfig *config; // The text config of the element the string belongs to.
+    Clay_Dimensions dimensions; // Written by the batch measurement function with the measured size of the string.
+} Clay_MeasureTextBatchItem;
+
+// Wrapper struct around the strings returned by Clay_BeginTextPrefetchBatch().
+typedef struct Clay_MeasureTextBatchItemArray {
+    int32_t capacity;
+    int32_t length;
+    Clay_MeasureTextBatchItem *internalArray;
+} Clay_MeasureTextBatchItemArray;
+
 // Aspect Ratio --------------------------------
 
 // Controls various settings related to aspect ratio scaling element.
@@ -660,6 +732,35 @@ typedef struct Clay_ScrollContainerData {
     bool found;
 } Clay_ScrollContainerData;
 
+// Describes a list of items inside a clip element where only the visible items are declared each frame, see Clay_VirtualListBegin().
+typedef struct Clay_VirtualListConfig {
+    // The total number of items in the list.
+    int32_t itemCount;
+    // The size of every item along the layout direction of the clip element. Ignored if itemSizeFunction is set.
+    float itemSize;
+    // Optional, returns the size of an individual item along the layout direction. It's called for every item each frame,
+    // so a fixed itemSize is preferred for very long lists.
+    float (*itemSizeFunction)(int32_t itemIndex, void *userData);
+    // A pointer that will be transparently passed through when itemSizeFunction is called.
+    void *userData;
+    // The number of additional items to declare on either side of the visible range.
+    int32_t overscan;
+} Clay_VirtualListConfig;
+
+// The items of a virtual list that should be declared this frame, returned by Clay_VirtualListBegin().
+typedef struct Clay_VirtualListRange {
+    // The index of the first item to declare.
+    int32_t startIndex;
+    // One past the index of the last item to declare.
+    int32_t endIndex;
+    // The size of the space that stands in for the items before startIndex.
+    float leadingSize;
+    // The size of the space that stands in for the items from endIndex onwards, declared by Clay_VirtualListEnd().
+    float trailingSize;
+    // The total number of items in the list.
+    int32_t itemCount;
+} Clay_VirtualListRange;
+
 // Bounding box and other data for a specific UI element.
 typedef struct Clay_ElementData {
     // The rectangle that encloses this UI element, with the position relative to the root of the layout.
@@ -722,6 +823,111 @@ typedef struct Clay_RenderCommandArray {
     Clay_RenderCommand* internalArray;
 } Clay_RenderCommandArray;
 
+// Byte offsets of the render command fields as laid out by the compiler that built clay, returned by Clay_GetRenderCommandLayout().
+// Used by bindings that read render commands directly out of clay's memory, e.g. the web renderers read them from wasm memory through typed array views.
+typedef struct Clay_RenderCommandLayout {
+    // sizeof(Clay_RenderCommand), i.e. the stride between commands in Clay_RenderCommandArray.internalArray.
+    uint32_t commandSize;
+    // Offsets from the start of a Clay_RenderCommand.
+    uint32_t boundingBox; // Four floats: x, y, width, height
+    uint32_t userData;
+    uint32_t id;
+    uint32_t zIndex; // int16_t
+    uint32_t commandType; // uint8_t
+    uint32_t rectangleBackgroundColor; // Four floats: r, g, b, a
+    uint32_t rectangleCornerRadius; // Four floats: topLeft, topRight, bottomLeft, bottomRight
+    uint32_t textStringLength;
+    uint32_t textStringChars;
+    uint32_t textColor;
+    uint32_t textFontId; // uint16_t
+    uint32_t textFontSize; // uint16_t
+    uint32_t textLetterSpacing; // uint16_t
+    uint32_t textLineHeight; // uint16_t
+    uint32_t imageBackgroundColor;
+    uint32_t imageCornerRadius;
+    uint32_t imageData;
+    uint32_t customBackgroundColor;
+    uint32_t customCornerRadius;
+    uint32_t customData;
+    uint32_t borderColor;
+    uint32_t borderCornerRadius;
+    uint32_t borderWidth; // Five uint16_t: left, right, top, bottom, betweenChildren
+    uint32_t clipHorizontal; // bool
+    uint32_t clipVertical; // bool
+    // Offsets from the start of a Clay_TextElementConfig, for text measurement callbacks.
+    uint32_t textConfigFontId;
+    uint32_t textConfigFontSize;
+    uint32_t textConfigLetterSpacing;
+    uint32_t textConfigLineHeight;
+    // Offsets from the start of a Clay_String and a Clay_StringSlice.
+    uint32_t stringLength;
+    uint32_t stringChars;
+    uint32_t stringSliceLength;
+    uint32_t stringSliceChars;
+    // Offsets from the start of a Clay_RenderCommandArray.
+    uint32_t arrayLength;
+    uint32_t arrayInternalArray;
+} Clay_RenderCommandLayout;
+
+// Describes how a render command has changed since the previous call to Clay_EndLayoutDiff().
+typedef CLAY_PACKED_ENUM {
+    // The command didn't exist in the previous frame.
+    CLAY_RENDER_COMMAND_CHANGE_ADDED,
+    // The command existed in the previous frame, but not this frame.
+    CLAY_RENDER_COMMAND_CHANGE_REMOVED,
+    // The command exists in both frames, but its bounding box or render data has changed.
+    CLAY_RENDER_COMMAND_CHANGE_MODIFIED,
+} Clay_RenderCommandChangeType;
+
+// A single render command that has changed since the previous call to Clay_EndLayoutDiff().
+// Commands are matched between frames using their id and commandType.
+typedef struct Clay_RenderCommandChange {
+    // The bounding box that the command occupied in the previous frame. Zeroed for added commands.
+    Clay_BoundingBox previousBoundingBox;
+    // The id of the render command that changed, as found in Clay_RenderCommand.id.
+    uint32_t id;
+    // The index of the command in this frame's render command array, or -1 if the command was removed.
+    int32_t renderCommandIndex;
+    // The type of the render command that changed.
+    Clay_RenderCommandType commandType;
+    // CLAY_RENDER_COMMAND_CHANGE_ADDED - The command is new this frame, and can be found at renderCommandIndex.
+    // CLAY_RENDER_COMMAND_CHANGE_REMOVED - The command no longer exists. Only the previousBoundingBox is available.
+    // CLAY_RENDER_COMMAND_CHANGE_MODIFIED - The command can be found at renderCommandIndex, and previously occupied previousBoundingBox.
+    Clay_RenderCommandChangeType changeType;
+} Clay_RenderCommandChange;
+
+// A sized array of render command changes.
+typedef struct Clay_RenderCommandChangeArray {
+    // The underlying max capacity of the array, not necessarily all initialized.
+    int32_t capacity;
+    // The number of initialized elements in this array. Used for loops and iteration.
+    int32_t length;
+    // A pointer to the first element in the internal array.
+    Clay_RenderCommandChange* internalArray;
+} Clay_RenderCommandChangeArray;
+
+// A sized array of bounding boxes.
+typedef struct Clay_BoundingBoxArray {
+    // The underlying max capacity of the array, not necessarily all initialized.
+    int32_t capacity;
+    // The number of initialized elements in this array. Used for loops and iteration.
+    int32_t length;
+    // A pointer to the first element in the internal array.
+    Clay_BoundingBox* internalArray;
+} Clay_BoundingBoxArray;
+
+// The result of Clay_EndLayoutDiff().
+typedef struct Clay_RenderCommandDiff {
+    // The full array of render commands for this frame, identical to the return value of Clay_EndLayout().
+    Clay_RenderCommandArray renderCommands;
+    // Every render command that was added, removed or modified since the previous call to Clay_EndLayoutDiff().
+    Clay_RenderCommandChangeArray changes;
+    // A list of non overlapping rectangles, clamped to the layout dimensions, that together cover the previous and current bounding boxes of every change.
+    // Renderers that retain their output between frames only need to redraw the render commands that intersect these rectangles.
+    // There are at most 64 rectangles. Past that, each new rectangle is merged with the existing one that grows the least, so the list still covers every change.
+    Clay_BoundingBoxArray dirtyRects;
+} Clay_RenderCommandDiff;
+
 // Represents the current state of interaction with clay this frame.
 typedef CLAY_PACKED_ENUM {
     // A left mouse click, or touch occurred this frame.
@@ -746,6 +952,134 @@ typedef struct Clay_PointerData {
     Clay_PointerDataInteractionState state;
 } Clay_PointerData;
 
+// The elements found under a single point by Clay_QueryPointsOver().
+typedef struct Clay_PointQueryResult {
+    // The queried position, relative to the root of the layout.
+    Clay_Vector2 point;
+    // The IDs of all elements under the point, in the same order as Clay_GetPointerOverIds().
+    Clay_ElementIdArray elementIds;
+} Clay_PointQueryResult;
+
+// Wrapper struct around the results of Clay_QueryPointsOver(), with one entry per queried point.
+typedef struct Clay_PointQueryResultArray {
+    int32_t capacity;
+    int32_t length;
+    Clay_PointQueryResult *internalArray;
+} Clay_PointQueryResultArray;
+
+// The kinds of Clay_HoverEvent, see Clay_SetHoverEventQueueEnabled().
+typedef CLAY_PACKED_ENUM {
+    // The pointer moved over the element, i.e. it wasn't in Clay_GetPointerOverIds() before this pointer update.
+    CLAY_HOVER_EVENT_ENTER,
+    // The pointer was already over the element before this pointer update, and still is.
+    CLAY_HOVER_EVENT_HOVER,
+    // The pointer is no longer over the element.
+    CLAY_HOVER_EVENT_LEAVE,
+} Clay_HoverEventType;
+
+// A change in whether the pointer is over an element, recorded by Clay_SetPointerState() while the hover event queue is enabled.
+typedef struct Clay_HoverEvent {
+    Clay_ElementId elementId;
+    // The pointer position and state of the pointer update that recorded this event.
+    Clay_PointerData pointerData;
+    Clay_HoverEventType type;
+} Clay_HoverEvent;
+
+// Wrapper struct around the events returned by Clay_GetHoverEvents().
+typedef struct Clay_HoverEventArray {
+    int32_t capacity;
+    int32_t length;
+    Clay_HoverEvent *internalArray;
+} Clay_HoverEventArray;
+
+// Controls which entries Clay evicts from its internal text measurement cache when it runs out of space, set with Clay_SetMeasureTextCachePolicy().
+// Entries that have been used during the current frame are never evicted.
+typedef CLAY_PACKED_ENUM {
+    // (default) Only evicts entries that haven't been used for more than two frames. If there are none, measurement fails with a capacity error.
+    CLAY_MEASURE_TEXT_CACHE_POLICY_GENERATION,
+    // Evicts the least recently used entry.
+    CLAY_MEASURE_TEXT_CACHE_POLICY_LRU,
+    // Evicts an approximation of the least recently used entry, using a sweeping "clock" hand and a referenced bit that is set whenever an entry is used.
+    // Cheaper than LRU for workloads that hit the cache much more often than they miss.
+    CLAY_MEASURE_TEXT_CACHE_POLICY_CLOCK,
+} Clay_MeasureTextCachePolicy;
+
+// Usage statistics for Clay's internal text measurement cache, returned by Clay_GetMeasureTextCacheStats().
+typedef struct Clay_MeasureTextCacheStats {
+    // The number of text measurements found in the cache, since the cache was initialized or last reset.
+    uint64_t hits;
+    // The number of text measurements that weren't found in the cache and had to be measured, since the cache was initialized or last reset.
+    uint64_t misses;
+    // The number of entries removed from the cache to make room for new ones or because they were no longer used, since the cache was initialized or last reset.
+    uint64_t evictions;
+    // The number of measured strings currently stored in the cache, and the maximum that can be stored (see Clay_SetMaxElementCount()).
+    int32_t itemCount;
+    int32_t itemCapacity;
+    // The number of measured words currently stored in the cache, and the maximum that can be stored (see Clay_SetMaxMeasureTextCacheWordCount()).
+    int32_t wordCount;
+    int32_t wordCapacity;
+    // The number of free word slots in the middle of the word pool, left behind by evicted entries and waiting to be reused.
+    // A high value relative to wordCount means the pool is sized for a peak the cache no longer needs.
+    int32_t wordFreeListLength;
+} Clay_MeasureTextCacheStats;
+
+// Separate limits for the kinds of per-frame data that are usually far less numerous than elements, see Clay_SetCapacities().
+// Any field other than pointQueries left as 0 uses the max element count (see Clay_SetMaxElementCount()), which is enough for every element to use one.
+typedef struct Clay_CapacityConfig {
+    // The number of CLAY_TEXT() elements.
+    int32_t textElements;
+    // The number of elements declared with .aspectRatio, .image, .floating, .clip, .custom or .border respectively.
+    int32_t aspectRatioElements;
+    int32_t imageElements;
+    int32_t floatingElements;
+    int32_t clipElements;
+    int32_t customElements;
+    int32_t borderElements;
+    // The number of elements declared with any of .backgroundColor, .cornerRadius or .userData.
+    int32_t sharedElements;
+    // The number of lines of wrapped text, across all text elements.
+    int32_t wrappedTextLines;
+    // The number of render commands returned by Clay_EndLayout().
+    int32_t renderCommands;
+    // The number of bytes of per-frame string storage, used by Clay_InternString(), Clay_FormatInt() and friends, and the debug view.
+    // Each interned string takes its length plus up to 7 bytes.
+    int32_t dynamicStringBytes;
+    // The number of points that can be passed to one call of Clay_QueryPointsOver(). Left as 0, this is 64 rather than the max element count.
+    int32_t pointQueries;
+} Clay_CapacityConfig;
+
+// Timings and counters describing the most recent frame, returned by Clay_GetFrameStats().
+typedef struct Clay_FrameStats {
+    // The time spent in each phase of the frame, in the units of the clock function passed to Clay_SetProfilingClockFunction().
+    // Timings are only recorded when clay is compiled with CLAY_ENABLE_PROFILING defined, and are zero otherwise.
+    uint64_t treeBuildTime; // From Clay_BeginLayout() until layout calculation starts in Clay_EndLayout(), i.e. declaring all the elements.
+    uint64_t sizingXTime; // Sizing elements along the X axis.
+    uint64_t textWrapTime; // Wrapping text into lines now that widths are known.
+    uint64_t sizingYTime; // Propagating wrapped heights and sizing elements along the Y axis.
+    uint64_t aspectRatioTime; // Scaling elements with an aspect ratio.
+    uint64_t positioningTime; // Calculating final positions and generating render commands.
+    uint64_t pointerUpdateTime; // Clay_SetPointerState() calls since the previous frame.
+    uint64_t scrollUpdateTime; // Clay_UpdateScrollContainers() calls since the previous frame.
+    // The number of elements and text elements declared, lines of wrapped text and render commands generated.
+    int32_t elementCount;
+    int32_t textElementCount;
+    int32_t wrappedLineCount;
+    int32_t renderCommandCount;
+    // True if nothing that affects the size of any element changed since the previous frame, so the sizing and text wrapping phases were
+    // skipped and the previous frame's sizes were reused. Only possible while incremental layout is enabled, see Clay_SetIncrementalLayoutEnabled().
+    bool layoutSizesReused;
+    // Lookups of elements by ID, the total number of hash map slots probed by them, and the longest single probe sequence.
+    // Only recorded when clay is compiled with CLAY_ENABLE_PROFILING defined.
+    int32_t hashMapLookupCount;
+    int32_t hashMapProbeCount;
+    int32_t hashMapMaxProbeLength;
+    // Bytes of the arena passed to Clay_Initialize() that are in use, and its total capacity.
+    size_t arenaBytesUsed;
+    size_t arenaCapacity;
+    // How much of each capacity limited by Clay_SetCapacities() was used, for choosing those limits.
+    Clay_CapacityConfig capacityUsage;
+} Clay_FrameStats;
+
 typedef struct Clay_ElementDeclaration {
     // Controls various settings that affect the size and position of an element, as well as the sizes and positions of any child elements.
     Clay_LayoutConfig layout;
@@ -795,6 +1129,12 @@ typedef CLAY_PACKED_ENUM {
     CLAY_ERROR_TYPE_INTERNAL_ERROR,
     // Clay__OpenElement was called more times than Clay__CloseElement, so there were still remaining open elements when the layout ended.
     CLAY_ERROR_TYPE_UNBALANCED_OPEN_CLOSE,
+    // Every render output buffer set up with Clay_SetRenderOutputBufferCount() was still held when Clay_BeginLayout() was called, so the oldest was overwritten.
+    CLAY_ERROR_TYPE_RENDER_OUTPUT_BUFFERS_IN_USE,
+    // Clay ran out of per-frame storage for strings passed to Clay_InternString() or formatted with Clay_FormatInt() and friends.
+    CLAY_ERROR_TYPE_DYNAMIC_STRING_CAPACITY_EXCEEDED,
+    // More points were passed to Clay_QueryPointsOver() than the limit set with Clay_SetMaxPointQueryCount().
+    CLAY_ERROR_TYPE_POINT_QUERY_CAPACITY_EXCEEDED,
 } Clay_ErrorType;
 
 // Data to identify the error that clay has encountered.
@@ -808,6 +1148,9 @@ typedef struct Clay_ErrorData {
     // CLAY_ERROR_TYPE_FLOATING_CONTAINER_PARENT_NOT_FOUND - A floating element was declared using CLAY_ATTACH_TO_ELEMENT_ID and either an invalid .parentId was provided or no element with the provided .parentId was found.
     // CLAY_ERROR_TYPE_PERCENTAGE_OVER_1 - An element was declared that using CLAY_SIZING_PERCENT but the percentage value was over 1. Percentage values are expected to be in the 0-1 range.
     // CLAY_ERROR_TYPE_INTERNAL_ERROR - Clay encountered an internal error. It would be wonderful if you could report this so we can fix it!
+    // CLAY_ERROR_TYPE_RENDER_OUTPUT_BUFFERS_IN_USE - Every render output buffer was still held when Clay_BeginLayout() was called, so the oldest was overwritten. Release frames with Clay_ReleaseRenderCommands().
+    // CLAY_ERROR_TYPE_DYNAMIC_STRING_CAPACITY_EXCEEDED - Clay ran out of per-frame storage for interned and formatted strings. This limit can be increased with Clay_CapacityConfig.dynamicStringBytes, see Clay_SetCapacities().
+    // CLAY_ERROR_TYPE_POINT_QUERY_CAPACITY_EXCEEDED - More points were passed to Clay_QueryPointsOver() than it can hold results for, and only the first ones were queried. This limit can be increased with Clay_SetMaxPointQueryCount().
     Clay_ErrorType errorType;
     // A string containing human-readable error text that explains the error in more detail.
     Clay_String errorText;
@@ -823,6 +1166,35 @@ typedef struct {
     void *userData;
 } Clay_ErrorHandler;
 
+// The declaration calls reported to the function bound with Clay_SetCaptureFunction().
+typedef CLAY_PACKED_ENUM {
+    // Clay_BeginLayout() was called. .dimensions holds the layout dimensions.
+    CLAY_CAPTURE_EVENT_BEGIN_LAYOUT,
+    // An element was opened. .elementId holds its ID, which is zero for elements declared with CLAY_AUTO_ID.
+    CLAY_CAPTURE_EVENT_OPEN_ELEMENT,
+    // The open element was configured with .declaration.
+    CLAY_CAPTURE_EVENT_CONFIGURE_ELEMENT,
+    // The open element was closed.
+    CLAY_CAPTURE_EVENT_CLOSE_ELEMENT,
+    // A text element was declared with .text and .textConfig.
+    CLAY_CAPTURE_EVENT_TEXT_ELEMENT,
+    // The text measurement function returned .dimensions for .text measured with .textConfig. Can also occur during Clay_EndLayout().
+    CLAY_CAPTURE_EVENT_MEASURE_TEXT,
+    // Clay_EndLayout() was called.
+    CLAY_CAPTURE_EVENT_END_LAYOUT,
+} Clay_CaptureEventType;
+
+typedef struct Clay_CaptureEvent {
+    Clay_CaptureEventType type;
+    // True if .text of a TEXT_ELEMENT event was declared as statically allocated, e.g. with CLAY_STRING().
+    bool textIsStaticallyAllocated;
+    Clay_ElementId elementId;
+    const Clay_ElementDeclaration *declaration;
+    Clay_StringSlice text;
+    Clay_TextElementConfig *textConfig;
+    Clay_Dimensions dimensions;
+} Clay_CaptureEvent;
+
 // Function Forward Declarations ---------------------------------
 
 // Public API functions ------------------------------------------
@@ -855,6 +1227,13 @@ CLAY_DLL_EXPORT void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_
 // Returns the internally stored scroll offset for the currently open element.
 // Generally intended for use with clip elements to create scrolling containers.
 CLAY_DLL_EXPORT Clay_Vector2 Clay_GetScrollOffset(void);
+// Called inside a clip element before declaring the items of a long list, so that only the visible items need to be declared.
+// Declares a spacer in place of the items before the visible range, and returns the range of items to declare.
+// Items are assumed to be laid out along the clip element's layoutDirection, separated by its childGap.
+CLAY_DLL_EXPORT Clay_VirtualListRange Clay_VirtualListBegin(Clay_VirtualListConfig config);
+// Called after declaring the items returned by Clay_VirtualListBegin(). Declares a spacer in place of the remaining items,
+// so that the content size and scroll position of the clip element behave as though every item had been declared.
+CLAY_DLL_EXPORT void Clay_VirtualListEnd(Clay_VirtualListRange range);
 // Updates the layout dimensions in response to the window or outer container being resized.
 CLAY_DLL_EXPORT void Clay_SetLayoutDimensions(Clay_Dimensions dimensions);
 // Called before starting any layout declarations.
@@ -862,6 +1241,41 @@ CLAY_DLL_EXPORT void Clay_BeginLayout(void);
 // Called when all layout declarations are finished.
 // Computes the layout and generates and returns the array of render commands to draw.
 CLAY_DLL_EXPORT Clay_RenderCommandArray Clay_EndLayout(void);
+// Explicit context versions of Clay_BeginLayout() and Clay_EndLayout(). The context becomes the current context for the calling thread,
+// so element declarations between the two calls go to it. With CLAY_THREAD_LOCAL_CONTEXT defined, separate contexts can be laid out on separate threads at the same time.
+CLAY_DLL_EXPORT void Clay_BeginLayoutCtx(Clay_Context *context);
+CLAY_DLL_EXPORT Clay_RenderCommandArray Clay_EndLayoutCtx(Clay_Context *context);
+// Binds a clock used to time each phase of the frame when clay is compiled with CLAY_ENABLE_PROFILING defined.
+// - clockFunction returns the current time in any monotonic unit, e.g. nanoseconds. The timings in Clay_FrameStats are reported in the same unit.
+// - userData is a pointer that will be transparently passed through when the clockFunction is called.
+CLAY_DLL_EXPORT void Clay_SetProfilingClockFunction(uint64_t (*clockFunction)(void *userData), void *userData);
+// Returns timings and counters for the most recently completed frame. See Clay_FrameStats.
+CLAY_DLL_EXPORT Clay_FrameStats Clay_GetFrameStats(void);
+// Binds a function that clay will use to size independent layout trees (the main layout and each floating element) in parallel.
+// - parallelForFunction must call taskFunction(taskIndex, taskData) exactly once for every taskIndex from 0 to taskCount - 1, on any thread,
+//   and only return once all of them have completed. Passing NULL sizes every tree on the calling thread.
+// - userData is a pointer that will be transparently passed through when the parallelForFunction is called.
+CLAY_DLL_EXPORT void Clay_SetParallelForFunction(void (*parallelForFunction)(int32_t taskCount, void (*taskFunction)(int32_t taskIndex, void *taskData), void *taskData, void *userData), void *userData);
+// Binds a function that clay will use to move into a larger block of memory when a frame runs out of capacity, rather than reporting errors every frame.
+// At the start of the next Clay_BeginLayout(), the max element count, text measurement cache size and any limits set with Clay_SetCapacities() are doubled,
+// and the text measurement cache, scroll positions and element hash map are moved into the new block, so they don't need to be rebuilt.
+// - growFunction is called with the number of bytes required and must return a block of at least that size, or NULL to keep the current arena.
+//   Once clay has moved out of the previous block it calls growFunction again with previousMemory set to that block and capacity 0, so it can be freed.
+//   previousMemory is the pointer passed to Clay_Initialize(), or returned by an earlier call to growFunction.
+// - userData is a pointer that will be transparently passed through when the growFunction is called.
+// The context moves into the new block, so pointers returned by Clay_Initialize() must be refreshed with Clay_GetCurrentContext() after Clay_BeginLayout().
+CLAY_DLL_EXPORT void Clay_SetArenaGrowFunction(void *(*growFunction)(void *previousMemory, size_t capacity, void *userData), void *userData);
+// Binds a function that clay will call with every element declaration and text measurement, so that frames can be recorded and later replayed without the application.
+// Declarations are reported from the next Clay_BeginLayout(), and the debug view and CLAY_CACHED blocks are excluded, as CLAY_CACHED blocks are always declared in full while a function is bound.
+// Binding a function resets the text measurement cache, so that the measurement of every string is reported at least once. Pass NULL to stop capturing.
+// benchmarks/clay_capture.h implements a capture file writer and replay on top of this function.
+// - captureFunction is called with each event, and any pointers in the event are only valid during the call.
+// - userData is a pointer that will be transparently passed through when the captureFunction is called.
+CLAY_DLL_EXPORT void Clay_SetCaptureFunction(void (*captureFunction)(const Clay_CaptureEvent *event, void *userData), void *userData);
+// An alternative to Clay_EndLayout() for renderers that retain their output between frames.
+// Computes the layout in the same way, and additionally compares the resulting render commands with those from the previous call to Clay_EndLayoutDiff(),
+// returning the commands that were added, removed or modified along with a list of dirty rectangles that need to be redrawn.
+CLAY_DLL_EXPORT Clay_RenderCommandDiff Clay_EndLayoutDiff(void);
 // Calculates a hash ID from the given idString.
 // Generally only used for dynamic strings when CLAY_ID("stringLiteral") can't be used.
 CLAY_DLL_EXPORT Clay_ElementId Clay_GetElementId(Clay_String idString);
@@ -885,6 +1299,23 @@ CLAY_DLL_EXPORT void Clay_OnHover(void (*onHoverFunction)(Clay_ElementId element
 CLAY_DLL_EXPORT bool Clay_PointerOver(Clay_ElementId elementId);
 // Returns the array of element IDs that the pointer is currently over.
 CLAY_DLL_EXPORT Clay_ElementIdArray Clay_GetPointerOverIds(void);
+// Returns the IDs of the elements under each of the provided points using the most recently calculated layout, e.g. for multi touch input.
+// Unlike Clay_SetPointerState, this doesn't affect pointer state or call any hover callbacks. The results are valid until the next call.
+// At most Clay_SetMaxPointQueryCount() points are queried, and passing more reports CLAY_ERROR_TYPE_POINT_QUERY_CAPACITY_EXCEEDED.
+CLAY_DLL_EXPORT Clay_PointQueryResultArray Clay_QueryPointsOver(Clay_Vector2 *points, int32_t pointCount);
+// Modifies the maximum number of points that can be passed to one call of Clay_QueryPointsOver(), which is 64 by default.
+// This is the same limit as Clay_CapacityConfig.pointQueries, see Clay_SetCapacities(), and values below 1 are treated as 1.
+// This may require reallocating additional memory, and re-calling Clay_Initialize();
+CLAY_DLL_EXPORT void Clay_SetMaxPointQueryCount(int32_t maxPointQueryCount);
+// Enables and disables the hover event queue. While it's enabled, Clay_SetPointerState() doesn't call the functions passed to Clay_OnHover(),
+// and instead records an ENTER, HOVER or LEAVE event for each element the pointer is now over or was over before the update, to be read with Clay_GetHoverEvents().
+// This state is retained and does not need to be set each frame.
+CLAY_DLL_EXPORT void Clay_SetHoverEventQueueEnabled(bool enabled);
+// Returns the hover events recorded since the previous call, in the order they happened. The results are valid until the next call to Clay_SetPointerState().
+// At most 1024 events are kept between calls, so an application doesn't need to read the queue while it isn't interested in it. Once the queue is full,
+// HOVER events are dropped to make room for ENTER and LEAVE events, then pairs of consecutive ENTER and LEAVE events for the same element, so the events still add up to the elements the pointer is over.
+// Consecutive HOVER events for the same element with the same pointer state are combined into one with the latest position.
+CLAY_DLL_EXPORT Clay_HoverEventArray Clay_GetHoverEvents(void);
 // Returns data representing the state of the scrolling element with the provided ID.
 // The returned Clay_ScrollContainerData contains a `found` bool that will be true if a scroll element was found with the provided ID.
 // An imperative function that returns true if the pointer position provided by Clay_SetPointerState is within the element with the provided ID's bounding box.
@@ -894,18 +1325,44 @@ CLAY_DLL_EXPORT Clay_ScrollContainerData Clay_GetScrollContainerData(Clay_Elemen
 // - measureTextFunction is a user provided function that adheres to the interface Clay_Dimensions (Clay_StringSlice text, Clay_TextElementConfig *config, void *userData);
 // - userData is a pointer that will be transparently passed through when the measureTextFunction is called.
 CLAY_DLL_EXPORT void Clay_SetMeasureTextFunction(Clay_Dimensions (*measureTextFunction)(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData), void *userData);
+// Binds a callback function that measures many string slices in a single call, for cases where each call to the measurement function is expensive (e.g. shaping, or crossing from wasm to JS).
+// Strings that are missing from Clay's measurement cache are collected while the layout is declared, and measured together during Clay_EndLayout().
+// - measureTextBatchFunction is a user provided function that writes the measured size of each item's text into item.dimensions.
+// - userData is a pointer that will be transparently passed through when the measureTextBatchFunction is called.
+// Takes precedence over the function bound with Clay_SetMeasureTextFunction(). Pass NULL to return to measuring strings individually.
+CLAY_DLL_EXPORT void Clay_SetMeasureTextBatchFunction(void (*measureTextBatchFunction)(Clay_MeasureTextBatchItem *items, int32_t itemCount, void *userData), void *userData);
+// Queues text that is about to be displayed to be measured ahead of time, e.g. on worker threads, if it isn't already in the measurement cache.
+// The text and config are copied, so they don't need to stay valid. Returns false if the text couldn't be queued because the queue is full.
+CLAY_DLL_EXPORT bool Clay_PrefetchText(Clay_String text, Clay_TextElementConfig *config);
+// Returns the strings queued since the previous batch, to be measured on any thread by writing the size of each item's text into item.dimensions.
+// The items stay valid until Clay_EndTextPrefetchBatch(), and an empty array is returned while a batch is still being measured.
+CLAY_DLL_EXPORT Clay_MeasureTextBatchItemArray Clay_BeginTextPrefetchBatch(void);
+// Adds the measurements of the batch returned by Clay_BeginTextPrefetchBatch() to the measurement cache. Call this on the thread that lays out the UI, between frames.
+CLAY_DLL_EXPORT void Clay_EndTextPrefetchBatch(void);
+// Enables and disables measurement placeholders. When enabled, text that isn't in the measurement cache is queued with Clay_PrefetchText() rather than measured during layout,
+// and is given a size estimated from its length and font size, without any render commands, until its prefetch batch has been ended.
+// This state is retained and does not need to be set each frame.
+CLAY_DLL_EXPORT void Clay_SetMeasureTextPlaceholdersEnabled(bool enabled);
 // Experimental - Used in cases where Clay needs to integrate with a system that manages its own scrolling containers externally.
 // Please reach out if you plan to use this function, as it may be subject to change.
 CLAY_DLL_EXPORT void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)(uint32_t elementId, void *userData), void *userData);
 // A bounds-checked "get" function for the Clay_RenderCommandArray returned from Clay_EndLayout().
 CLAY_DLL_EXPORT Clay_RenderCommand * Clay_RenderCommandArray_Get(Clay_RenderCommandArray* array, int32_t index);
+// Returns the byte offsets of the fields of Clay_RenderCommand and related structs, for reading render commands from memory without C struct definitions.
+CLAY_DLL_EXPORT Clay_RenderCommandLayout Clay_GetRenderCommandLayout(void);
 // Enables and disables Clay's internal debug tools.
 // This state is retained and does not need to be set each frame.
 CLAY_DLL_EXPORT void Clay_SetDebugModeEnabled(bool enabled);
 // Returns true if Clay's internal debug tools are currently enabled.
 CLAY_DLL_EXPORT bool Clay_IsDebugModeEnabled(void);
-// Enables and disables visibility culling. By default, Clay will not generate render commands for elements whose bounding box is entirely outside the screen.
+// Enables and disables visibility culling. By default, Clay will not generate render commands for elements whose bounding box is entirely outside the screen
+// or outside the clip containers enclosing them.
 CLAY_DLL_EXPORT void Clay_SetCullingEnabled(bool enabled);
+// Enables and disables incremental layout. When enabled, Clay hashes each element's layout declaration and children as the tree is built,
+// and subtrees whose hash and available size match the previous frame reuse their cached sizes rather than being resized.
+// If nothing that affects sizing changed at all (e.g. only scroll offsets or colors), sizing and text wrapping are skipped entirely.
+// This state is retained and does not need to be set each frame.
+CLAY_DLL_EXPORT void Clay_SetIncrementalLayoutEnabled(bool enabled);
 // Returns the maximum number of UI elements supported by Clay's current configuration.
 CLAY_DLL_EXPORT int32_t Clay_GetMaxElementCount(void);
 // Modifies the maximum number of UI elements supported by Clay's current configuration.
@@ -916,8 +1373,38 @@ CLAY_DLL_EXPORT int32_t Clay_GetMaxMeasureTextCacheWordCount(void);
 // Modifies the maximum number of measured "words" (whitespace seperated runs of characters) that Clay can store in its internal text measurement cache.
 // This may require reallocating additional memory, and re-calling Clay_Initialize();
 CLAY_DLL_EXPORT void Clay_SetMaxMeasureTextCacheWordCount(int32_t maxMeasureTextCacheWordCount);
+// Returns the per-array capacities set by Clay_SetCapacities(), with fields that were left as 0 still 0.
+CLAY_DLL_EXPORT Clay_CapacityConfig Clay_GetCapacities(void);
+// Limits the storage for each kind of element config and other per-frame data separately, rather than reserving enough for every element.
+// Clay_GetFrameStats().capacityUsage reports how much of each was used by the previous frame. Include the debug view's usage if it's enabled.
+// This may require reallocating additional memory, and re-calling Clay_Initialize();
+CLAY_DLL_EXPORT void Clay_SetCapacities(Clay_CapacityConfig capacities);
+// Keeps the render commands and dynamic strings of up to bufferCount frames valid at the same time, so that a renderer on another thread can draw one frame while the next is laid out.
+// With more than one buffer, the render commands returned by Clay_EndLayout() stay valid until they're passed to Clay_ReleaseRenderCommands(), rather than until the next Clay_BeginLayout(). The default is 1.
+// This requires reallocating additional memory and re-calling Clay_Initialize(), and the current context keeps its buffers until then.
+CLAY_DLL_EXPORT void Clay_SetRenderOutputBufferCount(int32_t bufferCount);
+// Returns true if there is a render output buffer that isn't held by the renderer, i.e. the next Clay_BeginLayout() won't overwrite a frame that hasn't been released.
+CLAY_DLL_EXPORT bool Clay_RenderOutputBufferAvailable(void);
+// Returns the buffer holding renderCommands to clay, so that it can be reused by a later layout. Has no effect with a single render output buffer.
+// Call this on the thread that lays out the UI, e.g. once the renderer thread has handed the finished frame back.
+CLAY_DLL_EXPORT void Clay_ReleaseRenderCommands(Clay_RenderCommandArray renderCommands);
 // Resets Clay's internal text measurement cache. Useful if font mappings have changed or fonts have been reloaded.
 CLAY_DLL_EXPORT void Clay_ResetMeasureTextCache(void);
+// Sets the policy used to evict entries from Clay's internal text measurement cache when it is full. See Clay_MeasureTextCachePolicy.
+CLAY_DLL_EXPORT void Clay_SetMeasureTextCachePolicy(Clay_MeasureTextCachePolicy policy);
+// Returns hit, miss and eviction counts and the current occupancy of Clay's internal text measurement cache, e.g. for choosing a value for Clay_SetMaxMeasureTextCacheWordCount().
+CLAY_DLL_EXPORT Clay_MeasureTextCacheStats Clay_GetMeasureTextCacheStats(void);
+// Copies the string into the current frame's dynamic string storage, which is sized with Clay_CapacityConfig.dynamicStringBytes, and returns the copy.
+// Strings with identical contents are stored once per frame, and text elements using the returned string reuse its hash as their measurement cache key rather than rehashing it.
+// The returned string has the same lifetime as the frame's render commands. Call this between Clay_BeginLayout() and Clay_EndLayout().
+CLAY_DLL_EXPORT Clay_String Clay_InternString(Clay_String string);
+// Formats an integer in decimal into the current frame's dynamic string storage, with the same lifetime and interning as Clay_InternString().
+CLAY_DLL_EXPORT Clay_String Clay_FormatInt(int64_t value);
+// Formats a float with exactly fractionDigits (0-9) digits after the decimal point, rounded to nearest, e.g. Clay_FormatFloat(3.14159f, 2) gives "3.14".
+// Every finite value is written out in full, e.g. Clay_FormatFloat(1e10f, 9) gives "10000000000.000000000". Infinities are written as "inf" or "-inf", and NaN as "nan".
+CLAY_DLL_EXPORT Clay_String Clay_FormatFloat(float value, int32_t fractionDigits);
+// Formats a fixed point value with fractionDigits (0-18) decimal digits of fraction, e.g. Clay_FormatFixed(-1205, 2) gives "-12.05".
+CLAY_DLL_EXPORT Clay_String Clay_FormatFixed(int64_t value, int32_t fractionDigits);
 
 // Internal API functions required by macros ----------------------
 
@@ -928,9 +1415,12 @@ CLAY_DLL_EXPORT void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration
 CLAY_DLL_EXPORT void Clay__CloseElement(void);
 CLAY_DLL_EXPORT Clay_ElementId Clay__HashString(Clay_String key, uint32_t seed);
 CLAY_DLL_EXPORT Clay_ElementId Clay__HashStringWithOffset(Clay_String key, uint32_t offset, uint32_t seed);
+CLAY_DLL_EXPORT Clay_ElementId Clay__HashStringBaseWithOffset(Clay_String key, uint32_t base, uint32_t offset);
 CLAY_DLL_EXPORT void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig);
 CLAY_DLL_EXPORT Clay_TextElementConfig *Clay__StoreTextElementConfig(Clay_TextElementConfig config);
 CLAY_DLL_EXPORT uint32_t Clay__GetParentElementId(void);
+CLAY_DLL_EXPORT bool Clay__BeginCachedSubtree(Clay_ElementId id, uint32_t stateHash);
+CLAY_DLL_EXPORT void Clay__EndCachedSubtree(void);
 
 extern Clay_Color Clay__debugViewHighlightColor;
 extern uint32_t Clay__debugViewWidth;
@@ -939,6 +1429,28 @@ extern uint32_t Clay__debugViewWidth;
 }
 #endif
 
+#if defined(__cplusplus) && defined(__cpp_consteval)
+// Compile time equivalent of the string hashing loop in Clay__HashString() and Clay__HashStringWithOffset(), before the final avalanche
+consteval uint32_t Clay__HashStringLiteralBase(const char *chars, int32_t length) {
+    uint32_t hash = 0;
+    for (int32_t i = 0; i < length; i++) {
+        hash += chars[i];
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    return hash;
+}
+
+// Compile time equivalent of Clay__HashString(CLAY_STRING(chars), 0).id
+consteval uint32_t Clay__HashStringLiteral(const char *chars, int32_t length) {
+    uint32_t hash = Clay__HashStringLiteralBase(chars, length);
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return hash + 1; // Reserve the hash result of zero as "null id"
+}
+#endif
+
 #endif // CLAY_HEADER
 
 // -----------------------------------------
@@ -1024,9 +1536,20 @@ typedef struct                                      \
                                                     \
 CLAY__ARRAY_DEFINE_FUNCTIONS(typeName, arrayName)   \
 
-Clay_Context *Clay__currentContext;
+CLAY__THREAD_LOCAL Clay_Context *Clay__currentContext;
 int32_t Clay__defaultMaxElementCount = 8192;
 int32_t Clay__defaultMaxMeasureTextWordCacheCount = 16384;
+Clay_CapacityConfig Clay__defaultCapacities = CLAY__DEFAULT_STRUCT;
+int32_t Clay__defaultRenderOutputBufferCount = 1;
+int32_t Clay__measureTextBatchCapacity = 1024; // The maximum number of strings passed to a single call of the batch measurement function
+int32_t Clay__textPrefetchCapacity = 256; // The maximum number of texts queued by Clay_PrefetchText() and not yet added to the measurement cache
+int32_t Clay__textPrefetchWordsPerText = 8; // The number of words reserved for measuring, per queued text
+int32_t Clay__textPrefetchCharsPerText = 64; // The memory reserved for copies of the queued text, per queued text
+int32_t Clay__hoverEventCapacity = 1024; // The maximum number of hover events queued between calls to Clay_GetHoverEvents()
+int32_t Clay__dirtyRectCapacity = 64; // The maximum number of dirty rectangles returned by Clay_EndLayoutDiff(), past which changed areas are merged into the existing rectangles
+int32_t Clay__defaultPointQueryCount = 64; // The maximum number of points passed to one call of Clay_QueryPointsOver() while Clay_CapacityConfig.pointQueries is left as 0
+int32_t Clay__cachedSubtreeCapacity = 128; // The maximum number of CLAY_CACHED blocks retained between frames
+int32_t Clay__cachedSubtreeBytesPerElement = 32; // The memory reserved for recorded CLAY_CACHED blocks, per element of Clay_SetMaxElementCount()
 
 void Clay__ErrorHandlerFunctionDefault(Clay_ErrorData errorText) {
     (void) errorText;
@@ -1040,6 +1563,7 @@ typedef struct {
     bool maxRenderCommandsExceeded;
     bool maxTextMeasureCacheExceeded;
     bool textMeasurementFunctionNotSet;
+    bool maxDynamicStringsExceeded;
 } Clay_BooleanWarnings;
 
 typedef struct {
@@ -1072,7 +1596,12 @@ bool Clay__Array_AddCapacityCheck(int32_t length, int32_t capacity);
 CLAY__ARRAY_DEFINE(bool, Clay__boolArray)
 CLAY__ARRAY_DEFINE(int32_t, Clay__int32_tArray)
 CLAY__ARRAY_DEFINE(char, Clay__charArray)
+CLAY__ARRAY_DEFINE(float, Clay__floatArray)
+CLAY__ARRAY_DEFINE(uint8_t, Clay__uint8_tArray)
+CLAY__ARRAY_DEFINE(Clay_Dimensions, Clay__DimensionsArray)
 CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_ElementId, Clay_ElementIdArray)
+CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_PointQueryResult, Clay_PointQueryResultArray)
+CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_HoverEvent, Clay_HoverEventArray)
 CLAY__ARRAY_DEFINE(Clay_LayoutConfig, Clay__LayoutConfigArray)
 CLAY__ARRAY_DEFINE(Clay_TextElementConfig, Clay__TextElementConfigArray)
 CLAY__ARRAY_DEFINE(Clay_AspectRatioElementConfig, Clay__AspectRatioElementConfigArray)
@@ -1084,6 +1613,8 @@ CLAY__ARRAY_DEFINE(Clay_BorderElementConfig, Clay__BorderElementConfigArray)
 CLAY__ARRAY_DEFINE(Clay_String, Clay__StringArray)
 CLAY__ARRAY_DEFINE(Clay_SharedElementConfig, Clay__SharedElementConfigArray)
 CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_RenderCommand, Clay_RenderCommandArray)
+CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_RenderCommandChange, Clay_RenderCommandChangeArray)
+CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_BoundingBox, Clay_BoundingBoxArray)
 
 typedef CLAY_PACKED_ENUM {
     CLAY__ELEMENT_CONFIG_TYPE_NONE,
@@ -1136,6 +1667,8 @@ typedef struct {
     uint16_t length;
 } Clay__LayoutElementChildren;
 
+typedef struct Clay_LayoutElementHashMapItem Clay_LayoutElementHashMapItem;
+
 typedef struct {
     union {
         Clay__LayoutElementChildren children;
@@ -1146,6 +1679,8 @@ typedef struct {
     Clay_LayoutConfig *layoutConfig;
     Clay__ElementConfigArraySlice elementConfigs;
     uint32_t id;
+    uint32_t layoutHash; // Only calculated when incremental layout is enabled
+    Clay_LayoutElementHashMapItem *hashMapItem; // Null if the hash map was full when this element was declared
     uint16_t floatingChildrenCount;
 } Clay_LayoutElement;
 
@@ -1175,19 +1710,33 @@ typedef struct {
 
 CLAY__ARRAY_DEFINE(Clay__DebugElementData, Clay__DebugElementDataArray)
 
-typedef struct { // todo get this struct into a single cache line
+struct Clay_LayoutElementHashMapItem {
     Clay_BoundingBox boundingBox;
     Clay_ElementId elementId;
     Clay_LayoutElement* layoutElement;
     void (*onHoverFunction)(Clay_ElementId elementId, Clay_PointerData pointerInfo, void *userData);
     void *hoverFunctionUserData;
-    int32_t nextIndex;
+    int32_t hoverEventIndex; // This element's most recent event in hoverEvents, used to combine consecutive HOVER events
     uint32_t generation;
     Clay__DebugElementData *debugData;
-} Clay_LayoutElementHashMapItem;
+    // Incremental layout cache, written at the end of each sizing pass
+    Clay_Dimensions cachedDimensions;
+    uint32_t layoutHash;
+    uint32_t layoutCacheGeneration;
+    bool layoutCacheWidthValid;
+};
 
 CLAY__ARRAY_DEFINE(Clay_LayoutElementHashMapItem, Clay__LayoutElementHashMapItemArray)
 
+// Open addressed key table for the layout element hash map. Lookups probe these densely packed slots
+// and only touch the much larger hash map item once the id matches.
+typedef struct {
+    uint32_t id;
+    int32_t itemIndex; // -1 if the slot is empty
+} Clay__LayoutElementHashMapSlot;
+
+CLAY__ARRAY_DEFINE(Clay__LayoutElementHashMapSlot, Clay__LayoutElementHashMapSlotArray)
+
 typedef struct {
     int32_t startOffset;
     int32_t length;
@@ -1201,19 +1750,57 @@ typedef struct {
     Clay_Dimensions unwrappedDimensions;
     int32_t measuredWordsStartIndex;
     float minWidth;
+    float spaceWidth;
     bool containsNewlines;
+    // The lines from the most recent time this text was wrapped, stored in wrappedLineCache. Only valid while the container is wrappedWidth wide.
+    int32_t wrappedLinesStartIndex;
+    int32_t wrappedLineCount;
+    float wrappedWidth;
+    // The dimensions are only an estimate, as the text is still waiting to be measured by a prefetch batch, see Clay_SetMeasureTextPlaceholdersEnabled()
+    bool measurementPending;
+    // The item is waiting for a batch measurement and has no size yet, see Clay__QueueTextMeasurement()
+    bool measurementQueued;
     // Hash map data
     uint32_t id;
     int32_t nextIndex;
     uint32_t generation;
+    // Eviction data
+    int32_t lruPrevious;
+    int32_t lruNext;
+    bool referenced;
 } Clay__MeasureTextCacheItem;
 
 CLAY__ARRAY_DEFINE(Clay__MeasureTextCacheItem, Clay__MeasureTextCacheItemArray)
 
+CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_MeasureTextBatchItem, Clay_MeasureTextBatchItemArray)
+
+// A string stored in dynamicStringData by Clay_InternString(). The index of this item is written in the 4 bytes before the string's chars.
+typedef struct {
+    uint32_t hash; // The content hash used by Clay__HashStringContentsWithConfig
+    int32_t offset; // The offset of the chars in dynamicStringData
+    int32_t length;
+    int32_t nextIndex; // The next item in the same bucket of internedStringBuckets, or -1
+} Clay__InternedString;
+
+CLAY__ARRAY_DEFINE(Clay__InternedString, Clay__InternedStringArray)
+
+// A measure text cache item waiting on the results of a batch measurement
+typedef struct {
+    Clay_String text;
+    Clay_TextElementConfig *config;
+    int32_t cacheItemIndex;
+    int32_t batchItemsStartIndex;
+    uint32_t id; // The measure cache id of the text, for prefetched text which is hashed differently to its copy
+} Clay__PendingTextMeasurement;
+
+CLAY__ARRAY_DEFINE(Clay__PendingTextMeasurement, Clay__PendingTextMeasurementArray)
+
 typedef struct {
     Clay_LayoutElement *layoutElement;
     Clay_Vector2 position;
     Clay_Vector2 nextChildOffset;
+    // Intersection of the screen and the clip containers enclosing this element, used for culling
+    Clay_BoundingBox cullBox;
 } Clay__LayoutElementTreeNode;
 
 CLAY__ARRAY_DEFINE(Clay__LayoutElementTreeNode, Clay__LayoutElementTreeNodeArray)
@@ -1228,9 +1815,105 @@ typedef struct {
 
 CLAY__ARRAY_DEFINE(Clay__LayoutElementTreeRoot, Clay__LayoutElementTreeRootArray)
 
+// The area covered by an element and all of its descendants, used to skip entire subtrees during pointer hit testing
+typedef struct {
+    float left;
+    float top;
+    float right;
+    float bottom;
+} Clay__SubtreeBounds;
+
+CLAY__ARRAY_DEFINE(Clay__SubtreeBounds, Clay__SubtreeBoundsArray)
+
+// Bookkeeping for sizing a layout tree root on a worker thread, see Clay_SetParallelForFunction()
+typedef struct {
+    Clay_LayoutElement *floatingParent; // The element that a floating root is sized relative to, if any
+    int32_t wave; // Roots in the same wave don't depend on each other's sizes and can be sized simultaneously
+    int32_t scratchOffset; // The start of this root's slice of the shared scratch buffers
+    int32_t scratchCapacity; // The number of elements in this root's tree, which bounds its use of the scratch buffers
+} Clay__ParallelSizingRoot;
+
+CLAY__ARRAY_DEFINE(Clay__ParallelSizingRoot, Clay__ParallelSizingRootArray)
+
+// The ephemeral arrays that declaring a CLAY_CACHED block appends to, and which are recorded so that the block can be replayed
+enum {
+    CLAY__CACHED_ARRAY_LAYOUT_ELEMENTS,
+    CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN,
+    CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN_BUFFER,
+    CLAY__CACHED_ARRAY_TEXT_ELEMENT_DATA,
+    CLAY__CACHED_ARRAY_ASPECT_RATIO_ELEMENT_INDEXES,
+    CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_TREE_ROOTS,
+    CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_ID_STRINGS,
+    CLAY__CACHED_ARRAY_LAYOUT_CONFIGS,
+    CLAY__CACHED_ARRAY_ELEMENT_CONFIGS,
+    CLAY__CACHED_ARRAY_TEXT_ELEMENT_CONFIGS,
+    CLAY__CACHED_ARRAY_ASPECT_RATIO_ELEMENT_CONFIGS,
+    CLAY__CACHED_ARRAY_IMAGE_ELEMENT_CONFIGS,
+    CLAY__CACHED_ARRAY_FLOATING_ELEMENT_CONFIGS,
+    CLAY__CACHED_ARRAY_CLIP_ELEMENT_CONFIGS,
+    CLAY__CACHED_ARRAY_CUSTOM_ELEMENT_CONFIGS,
+    CLAY__CACHED_ARRAY_BORDER_ELEMENT_CONFIGS,
+    CLAY__CACHED_ARRAY_SHARED_ELEMENT_CONFIGS,
+    CLAY__CACHED_ARRAY_COUNT,
+};
+
+typedef struct {
+    int32_t *length;
+    int32_t capacity;
+    char *internalArray;
+    int32_t itemSize;
+} Clay__CachedArrayView;
+
+// The recorded declarations of a CLAY_CACHED block, retained between frames
+typedef struct {
+    uint32_t id;
+    uint32_t stateHash;
+    uint32_t parentId;
+    uint32_t childOffset; // The number of children the parent already had when the block was declared
+    int32_t floatingChildCount; // The number of floating elements the block added to its parent
+    int32_t dataOffset; // The start of the recorded array items in the cached subtree data
+    int32_t dataSize;
+    char *arrayBases[CLAY__CACHED_ARRAY_COUNT]; // The address of each array when recorded, used to rebase pointers between items
+    int32_t arrayStarts[CLAY__CACHED_ARRAY_COUNT];
+    int32_t arrayCounts[CLAY__CACHED_ARRAY_COUNT];
+} Clay__CachedSubtree;
+
+CLAY__ARRAY_DEFINE(Clay__CachedSubtree, Clay__CachedSubtreeArray)
+
+// The Clay_OnHover() handler of a recorded element, which is cleared when the element is registered again on replay
+typedef struct {
+    void (*onHoverFunction)(Clay_ElementId elementId, Clay_PointerData pointerInfo, void *userData);
+    void *hoverFunctionUserData;
+} Clay__CachedHoverHandler;
+
+// A CLAY_CACHED block that is currently being declared and recorded
+typedef struct {
+    Clay__CachedSubtree subtree;
+    int32_t parentFloatingChildrenCount;
+    bool textPending; // The block declared text that has no final size yet
+} Clay__OpenCachedSubtree;
+
+CLAY__ARRAY_DEFINE(Clay__OpenCachedSubtree, Clay__OpenCachedSubtreeArray)
+
+// A compact record of a render command, retained between calls to Clay_EndLayoutDiff()
+// The render command itself can't be retained, as text commands point into string memory that may not outlive the frame
+typedef struct {
+    Clay_BoundingBox boundingBox;
+    uint32_t id;
+    uint32_t contentHash;
+    int32_t nextIndex;
+    Clay_RenderCommandType commandType;
+    bool matched;
+} Clay__RenderCommandSnapshot;
+
+CLAY__ARRAY_DEFINE(Clay__RenderCommandSnapshot, Clay__RenderCommandSnapshotArray)
+
 struct Clay_Context {
     int32_t maxElementCount;
     int32_t maxMeasureTextCacheWordCount;
+    Clay_CapacityConfig capacities;
+    int32_t renderOutputBufferCount;
+    int32_t requestedRenderOutputBufferCount; // Set by Clay_SetRenderOutputBufferCount(), applied at the next Clay_Initialize()
     bool warningsEnabled;
     Clay_ErrorHandler errorHandler;
     Clay_BooleanWarnings booleanWarnings;
@@ -1243,10 +1926,42 @@ struct Clay_Context {
     bool debugModeEnabled;
     bool disableCulling;
     bool externalScrollHandlingEnabled;
+    bool incrementalLayoutEnabled;
+    bool hoverEventQueueEnabled;
+    bool hoverEventsRead; // Events returned by Clay_GetHoverEvents() are cleared by the next pointer update
     uint32_t debugSelectedElementId;
     uint32_t generation;
     uintptr_t arenaResetOffset;
+    #ifndef CLAY_WASM
+    Clay_Dimensions (*measureTextFunction)(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData);
+    Clay_Vector2 (*queryScrollOffsetFunction)(uint32_t elementId, void *userData);
+    #endif
     void *measureTextUserData;
+    void (*measureTextBatchFunction)(Clay_MeasureTextBatchItem *items, int32_t itemCount, void *userData);
+    void *measureTextBatchUserData;
+    bool textMeasurementBatchResolved; // True if text has been batch measured since the layout elements were last sized
+    bool measureTextPlaceholdersEnabled;
+    bool prefetchingText; // Set during Clay_PrefetchText() so that a cache miss queues the text for prefetching
+    Clay_MeasureTextBatchItem *prefetchedTextItems; // Set during Clay_EndTextPrefetchBatch() so that a cache miss reads the measurements of the text from these
+    Clay_MeasureTextCachePolicy measureTextCachePolicy;
+    Clay_MeasureTextCacheStats measureTextCacheStats; // Only the counters are kept up to date, occupancy is filled in by Clay_GetMeasureTextCacheStats()
+    int32_t measureTextCacheLruHead; // Least recently used
+    int32_t measureTextCacheLruTail; // Most recently used
+    int32_t measureTextCacheClockHand;
+    uint32_t measureTextCacheOldestGeneration; // No cache item was last used before this generation, found by the last sweep that had nothing to evict
+    uint64_t (*profilingClockFunction)(void *userData);
+    void *profilingClockUserData;
+    void (*parallelForFunction)(int32_t taskCount, void (*taskFunction)(int32_t taskIndex, void *taskData), void *taskData, void *userData);
+    void *parallelForUserData;
+    void *(*arenaGrowFunction)(void *previousMemory, size_t capacity, void *userData);
+    void *arenaGrowUserData;
+    void *arenaMemory; // The block passed to Clay_Initialize() or returned by the arena grow function, before it was cacheline aligned
+    void (*captureFunction)(const Clay_CaptureEvent *event, void *userData);
+    void *captureUserData;
+    bool captureActive; // True between Clay_BeginLayout() and Clay_EndLayout() while a capture function is bound
+    uint64_t profilingPhaseStart;
+    Clay_FrameStats frameStats; // The most recently completed frame
+    Clay_FrameStats currentFrameStats; // Accumulates until the end of the current frame
     void *queryScrollOffsetUserData;
     Clay_Arena internalArena;
     // Layout Elements / Render Commands
@@ -1276,18 +1991,77 @@ struct Clay_Context {
     Clay__LayoutElementTreeNodeArray layoutElementTreeNodeArray1;
     Clay__LayoutElementTreeRootArray layoutElementTreeRoots;
     Clay__LayoutElementHashMapItemArray layoutElementsHashMapInternal;
-    Clay__int32_tArray layoutElementsHashMap;
+    Clay__LayoutElementHashMapSlotArray layoutElementsHashMap; // Capacity is always a power of two
     Clay__MeasureTextCacheItemArray measureTextHashMapInternal;
     Clay__int32_tArray measureTextHashMapInternalFreeList;
+    Clay_MeasureTextBatchItemArray measureTextBatchItems;
+    Clay__PendingTextMeasurementArray pendingTextMeasurements;
+    // Text queued by Clay_PrefetchText(). The first textPrefetchesInFlight entries have been returned by Clay_BeginTextPrefetchBatch() and may be being measured on other threads.
+    Clay__PendingTextMeasurementArray textPrefetches;
+    Clay__TextElementConfigArray textPrefetchConfigs; // A copy of the config of each entry in textPrefetches
+    Clay_MeasureTextBatchItemArray textPrefetchItems;
+    Clay__charArray textPrefetchChars; // A copy of the text of each entry in textPrefetches
+    int32_t textPrefetchesInFlight;
     Clay__int32_tArray measureTextHashMap;
     Clay__MeasuredWordArray measuredWords;
     Clay__int32_tArray measuredWordsFreeList;
+    Clay__MeasuredWordArray wrappedLineCache; // Kept apart from measuredWords, so that cached lines never take space needed for measurements
+    Clay__int32_tArray wrappedLineCacheFreeList;
     Clay__int32_tArray openClipElementStack;
     Clay_ElementIdArray pointerOverIds;
+    Clay_PointQueryResultArray pointQueryResults;
+    Clay_ElementIdArray previousPointerOverIds;
+    Clay_HoverEventArray hoverEvents;
+    Clay_ElementIdArray pointQueryElementIds;
     Clay__ScrollContainerDataInternalArray scrollContainerDatas;
     Clay__boolArray treeNodeVisited;
+    Clay__SubtreeBoundsArray layoutElementSubtreeBounds;
+    Clay__ParallelSizingRootArray parallelSizingRoots;
+    Clay__int32_tArray parallelSizingOrder; // Root indexes ordered by wave
+    Clay__int32_tArray layoutElementRootIndexes; // The index of the tree root that each layout element belongs to
+    Clay__CachedSubtreeArray cachedSubtrees; // CLAY_CACHED blocks recorded or replayed during the current frame
+    Clay__CachedSubtreeArray previousCachedSubtrees; // CLAY_CACHED blocks from the previous frame, which can be replayed
+    Clay__charArray cachedSubtreeData;
+    Clay__charArray previousCachedSubtreeData;
+    Clay__OpenCachedSubtreeArray openCachedSubtrees;
+    int32_t openCachedSubtreeDepth; // Can exceed the length of openCachedSubtrees, in which case the innermost blocks aren't recorded
+    // The results of sizing the previous frame, which are reused if nothing that affects sizing has changed
+    Clay__DimensionsArray retainedLayoutDimensions; // Indexed by element index
+    Clay__WrappedTextLineArray retainedWrappedTextLines;
+    Clay__int32_tArray retainedWrappedLineCounts; // Indexed by text element index
+    uint32_t retainedLayoutDeclarationHash;
+    bool retainedLayoutSizesValid;
+#ifdef CLAY_SOA_LAYOUT
+    // Dense copies of the sizing properties of each element, indexed by element index
+    Clay__floatArray layoutAxisSizes; // Sizes along the axis currently being sized
+    Clay__floatArray layoutMinWidths;
+    Clay__floatArray layoutMinHeights;
+    Clay__floatArray layoutMaxWidths;
+    Clay__floatArray layoutMaxHeights;
+    Clay__uint8_tArray layoutWidthSizingTypes;
+    Clay__uint8_tArray layoutHeightSizingTypes;
+    Clay__uint8_tArray layoutAxisFlags;
+#endif
     Clay__charArray dynamicStringData;
+    Clay__InternedStringArray internedStrings;
+    Clay__int32_tArray internedStringBuckets; // Index of the first interned string in each bucket, or -1
     Clay__DebugElementDataArray debugElementData;
+    // Render Command Diffing
+    Clay__RenderCommandSnapshotArray renderCommandSnapshots;
+    Clay__RenderCommandSnapshotArray previousRenderCommandSnapshots;
+    Clay__int32_tArray renderCommandSnapshotHashMap;
+    Clay_RenderCommandChangeArray renderCommandChanges;
+    Clay_BoundingBoxArray dirtyRects;
+    // Render output buffers, only allocated with more than one. Each holds the render commands and dynamic strings of one frame until it's released.
+    Clay_RenderCommandArray renderOutputCommands;
+    Clay__charArray renderOutputStrings;
+    Clay__boolArray renderOutputBuffersHeld;
+    int32_t renderOutputBufferIndex;
+    // A block the arena grew out of while the renderer still held frames in it, which is freed once they've all been released
+    void *retiredArenaMemory;
+    Clay_RenderCommandArray retiredRenderOutputCommands;
+    Clay__boolArray retiredRenderOutputBuffersHeld; // Still in the retired block, so that releasing a frame twice is ignored
+    int32_t retiredRenderOutputCount;
 };
 
 Clay_Context* Clay__Context_Allocate_Arena(Clay_Arena *arena) {
@@ -1300,7 +2074,49 @@ Clay_Context* Clay__Context_Allocate_Arena(Clay_Arena *arena) {
     return (Clay_Context*)(arena->memory);
 }
 
+#ifdef CLAY_ENABLE_PROFILING
+void Clay__ProfileBegin(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->profilingClockFunction) {
+        context->profilingPhaseStart = context->profilingClockFunction(context->profilingClockUserData);
+    }
+}
+
+// Adds the time since the previous call to Clay__ProfileBegin or Clay__ProfileEnd to the phase, so consecutive phases can be chained together
+void Clay__ProfileEnd(uint64_t *phaseTime) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->profilingClockFunction) {
+        uint64_t now = context->profilingClockFunction(context->profilingClockUserData);
+        *phaseTime += now - context->profilingPhaseStart;
+        context->profilingPhaseStart = now;
+    }
+}
+
+#define CLAY__PROFILE_BEGIN() Clay__ProfileBegin()
+#define CLAY__PROFILE_END(phase) Clay__ProfileEnd(&Clay_GetCurrentContext()->currentFrameStats.phase)
+#else
+#define CLAY__PROFILE_BEGIN()
+#define CLAY__PROFILE_END(phase)
+#endif
+
+void Clay__CopyMemory(char *destination, const char *source, int32_t size) {
+    for (int32_t i = 0; i < size; i++) {
+        destination[i] = source[i];
+    }
+}
+
 Clay_String Clay__WriteStringToCharBuffer(Clay__charArray *buffer, Clay_String string) {
+    if (buffer->length + string.length > buffer->capacity) {
+        Clay_Context* context = Clay_GetCurrentContext();
+        if (!context->booleanWarnings.maxDynamicStringsExceeded) {
+            context->booleanWarnings.maxDynamicStringsExceeded = true;
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_DYNAMIC_STRING_CAPACITY_EXCEEDED,
+                .errorText = CLAY_STRING("Clay ran out of capacity while writing dynamic strings. Try using Clay_SetCapacities() with a higher dynamicStringBytes."),
+                .userData = context->errorHandler.userData });
+        }
+        return CLAY__STRING_DEFAULT;
+    }
     for (int32_t i = 0; i < string.length; i++) {
         buffer->internalArray[buffer->length + i] = string.chars[i];
     }
@@ -1311,9 +2127,6 @@ Clay_String Clay__WriteStringToCharBuffer(Clay__charArray *buffer, Clay_String s
 #ifdef CLAY_WASM
     __attribute__((import_module("clay"), import_name("measureTextFunction"))) Clay_Dimensions Clay__MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData);
     __attribute__((import_module("clay"), import_name("queryScrollOffsetFunction"))) Clay_Vector2 Clay__QueryScrollOffset(uint32_t elementId, void *userData);
-#else
-    Clay_Dimensions (*Clay__MeasureText)(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData);
-    Clay_Vector2 (*Clay__QueryScrollOffset)(uint32_t elementId, void *userData);
 #endif
 
 Clay_LayoutElement* Clay__GetOpenLayoutElement(void) {
@@ -1326,15 +2139,32 @@ uint32_t Clay__GetParentElementId(void) {
     return Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 2))->id;
 }
 
+// Reports running out of one of the capacities set by Clay_SetCapacities() in the same way as running out of elements
+bool Clay__CapacityExceeded(int32_t length, int32_t capacity) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
+        return true;
+    }
+    if (length < capacity) {
+        return false;
+    }
+    context->booleanWarnings.maxElementsExceeded = true;
+    context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+        .errorType = CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED,
+        .errorText = CLAY_STRING("Clay ran out of capacity for one kind of element config or text. Try using Clay_SetCapacities() with higher values, see Clay_GetFrameStats().capacityUsage."),
+        .userData = context->errorHandler.userData });
+    return true;
+}
+
 Clay_LayoutConfig * Clay__StoreLayoutConfig(Clay_LayoutConfig config) {  return Clay_GetCurrentContext()->booleanWarnings.maxElementsExceeded ? &CLAY_LAYOUT_DEFAULT : Clay__LayoutConfigArray_Add(&Clay_GetCurrentContext()->layoutConfigs, config); }
-Clay_TextElementConfig * Clay__StoreTextElementConfig(Clay_TextElementConfig config) {  return Clay_GetCurrentContext()->booleanWarnings.maxElementsExceeded ? &Clay_TextElementConfig_DEFAULT : Clay__TextElementConfigArray_Add(&Clay_GetCurrentContext()->textElementConfigs, config); }
-Clay_AspectRatioElementConfig * Clay__StoreAspectRatioElementConfig(Clay_AspectRatioElementConfig config) {  return Clay_GetCurrentContext()->booleanWarnings.maxElementsExceeded ? &Clay_AspectRatioElementConfig_DEFAULT : Clay__AspectRatioElementConfigArray_Add(&Clay_GetCurrentContext()->aspectRatioElementConfigs, config); }
-Clay_ImageElementConfig * Clay__StoreImageElementConfig(Clay_ImageElementConfig config) {  return Clay_GetCurrentContext()->booleanWarnings.maxElementsExceeded ? &Clay_ImageElementConfig_DEFAULT : Clay__ImageElementConfigArray_Add(&Clay_GetCurrentContext()->imageElementConfigs, config); }
-Clay_FloatingElementConfig * Clay__StoreFloatingElementConfig(Clay_FloatingElementConfig config) {  return Clay_GetCurrentContext()->booleanWarnings.maxElementsExceeded ? &Clay_FloatingElementConfig_DEFAULT : Clay__FloatingElementConfigArray_Add(&Clay_GetCurrentContext()->floatingElementConfigs, config); }
-Clay_CustomElementConfig * Clay__StoreCustomElementConfig(Clay_CustomElementConfig config) {  return Clay_GetCurrentContext()->booleanWarnings.maxElementsExceeded ? &Clay_CustomElementConfig_DEFAULT : Clay__CustomElementConfigArray_Add(&Clay_GetCurrentContext()->customElementConfigs, config); }
-Clay_ClipElementConfig * Clay__StoreClipElementConfig(Clay_ClipElementConfig config) {  return Clay_GetCurrentContext()->booleanWarnings.maxElementsExceeded ? &Clay_ClipElementConfig_DEFAULT : Clay__ClipElementConfigArray_Add(&Clay_GetCurrentContext()->clipElementConfigs, config); }
-Clay_BorderElementConfig * Clay__StoreBorderElementConfig(Clay_BorderElementConfig config) {  return Clay_GetCurrentContext()->booleanWarnings.maxElementsExceeded ? &Clay_BorderElementConfig_DEFAULT : Clay__BorderElementConfigArray_Add(&Clay_GetCurrentContext()->borderElementConfigs, config); }
-Clay_SharedElementConfig * Clay__StoreSharedElementConfig(Clay_SharedElementConfig config) {  return Clay_GetCurrentContext()->booleanWarnings.maxElementsExceeded ? &Clay_SharedElementConfig_DEFAULT : Clay__SharedElementConfigArray_Add(&Clay_GetCurrentContext()->sharedElementConfigs, config); }
+Clay_TextElementConfig * Clay__StoreTextElementConfig(Clay_TextElementConfig config) {  Clay_Context* context = Clay_GetCurrentContext(); return Clay__CapacityExceeded(context->textElementConfigs.length, context->textElementConfigs.capacity) ? &Clay_TextElementConfig_DEFAULT : Clay__TextElementConfigArray_Add(&context->textElementConfigs, config); }
+Clay_AspectRatioElementConfig * Clay__StoreAspectRatioElementConfig(Clay_AspectRatioElementConfig config) {  Clay_Context* context = Clay_GetCurrentContext(); return Clay__CapacityExceeded(context->aspectRatioElementConfigs.length, context->aspectRatioElementConfigs.capacity) ? &Clay_AspectRatioElementConfig_DEFAULT : Clay__AspectRatioElementConfigArray_Add(&context->aspectRatioElementConfigs, config); }
+Clay_ImageElementConfig * Clay__StoreImageElementConfig(Clay_ImageElementConfig config) {  Clay_Context* context = Clay_GetCurrentContext(); return Clay__CapacityExceeded(context->imageElementConfigs.length, context->imageElementConfigs.capacity) ? &Clay_ImageElementConfig_DEFAULT : Clay__ImageElementConfigArray_Add(&context->imageElementConfigs, config); }
+Clay_FloatingElementConfig * Clay__StoreFloatingElementConfig(Clay_FloatingElementConfig config) {  Clay_Context* context = Clay_GetCurrentContext(); return Clay__CapacityExceeded(context->floatingElementConfigs.length, context->floatingElementConfigs.capacity) ? &Clay_FloatingElementConfig_DEFAULT : Clay__FloatingElementConfigArray_Add(&context->floatingElementConfigs, config); }
+Clay_CustomElementConfig * Clay__StoreCustomElementConfig(Clay_CustomElementConfig config) {  Clay_Context* context = Clay_GetCurrentContext(); return Clay__CapacityExceeded(context->customElementConfigs.length, context->customElementConfigs.capacity) ? &Clay_CustomElementConfig_DEFAULT : Clay__CustomElementConfigArray_Add(&context->customElementConfigs, config); }
+Clay_ClipElementConfig * Clay__StoreClipElementConfig(Clay_ClipElementConfig config) {  Clay_Context* context = Clay_GetCurrentContext(); return Clay__CapacityExceeded(context->clipElementConfigs.length, context->clipElementConfigs.capacity) ? &Clay_ClipElementConfig_DEFAULT : Clay__ClipElementConfigArray_Add(&context->clipElementConfigs, config); }
+Clay_BorderElementConfig * Clay__StoreBorderElementConfig(Clay_BorderElementConfig config) {  Clay_Context* context = Clay_GetCurrentContext(); return Clay__CapacityExceeded(context->borderElementConfigs.length, context->borderElementConfigs.capacity) ? &Clay_BorderElementConfig_DEFAULT : Clay__BorderElementConfigArray_Add(&context->borderElementConfigs, config); }
+Clay_SharedElementConfig * Clay__StoreSharedElementConfig(Clay_SharedElementConfig config) {  Clay_Context* context = Clay_GetCurrentContext(); return Clay__CapacityExceeded(context->sharedElementConfigs.length, context->sharedElementConfigs.capacity) ? &Clay_SharedElementConfig_DEFAULT : Clay__SharedElementConfigArray_Add(&context->sharedElementConfigs, config); }
 
 Clay_ElementConfig Clay__AttachElementConfig(Clay_ElementConfigUnion config, Clay__ElementConfigType type) {
     Clay_Context* context = Clay_GetCurrentContext();
@@ -1384,7 +2214,6 @@ Clay_ElementId Clay__HashString(Clay_String key, const uint32_t seed) {
 }
 
 Clay_ElementId Clay__HashStringWithOffset(Clay_String key, const uint32_t offset, const uint32_t seed) {
-    uint32_t hash = 0;
     uint32_t base = seed;
 
     for (int32_t i = 0; i < key.length; i++) {
@@ -1392,7 +2221,12 @@ Clay_ElementId Clay__HashStringWithOffset(Clay_String key, const uint32_t offset
         base += (base << 10);
         base ^= (base >> 6);
     }
-    hash = base;
+    return Clay__HashStringBaseWithOffset(key, base, offset);
+}
+
+// Finishes the hash of an indexed ID from the hash of its string, which may have been calculated at compile time
+Clay_ElementId Clay__HashStringBaseWithOffset(Clay_String key, uint32_t base, const uint32_t offset) {
+    uint32_t hash = base;
     hash += offset;
     hash += (hash << 10);
     hash ^= (hash >> 6);
@@ -1416,13 +2250,8 @@ static inline void Clay__SIMDARXMix(__m128i* a, __m128i* b) {
     *b = _mm_xor_si128(Clay__SIMDRotateLeft(*b, 17), *a);
 }
 
-uint64_t Clay__HashData(const uint8_t* data, size_t length) {
-    // Pinched these constants from the BLAKE implementation
-    __m128i v0 = _mm_set1_epi64x(0x6a09e667f3bcc908ULL);
-    __m128i v1 = _mm_set1_epi64x(0xbb67ae8584caa73bULL);
-    __m128i v2 = _mm_set1_epi64x(0x3c6ef372fe94f82bULL);
-    __m128i v3 = _mm_set1_epi64x(0xa54ff53a5f1d36f1ULL);
-
+// Mixes the remaining data into the state 16 bytes at a time and finalizes the hash
+static inline uint64_t Clay__HashDataSSE2Finish(const uint8_t* data, size_t length, __m128i v0, __m128i v1, __m128i v2, __m128i v3) {
     uint8_t overflowBuffer[16] = { 0 };  // Temporary buffer for small inputs
 
     while (length > 0) {
@@ -1459,6 +2288,117 @@ uint64_t Clay__HashData(const uint8_t* data, size_t length) {
 
     return result[0] ^ result[1];
 }
+
+uint64_t Clay__HashDataSSE2(const uint8_t* data, size_t length) {
+    // Pinched these constants from the BLAKE implementation
+    __m128i v0 = _mm_set1_epi64x(0x6a09e667f3bcc908ULL);
+    __m128i v1 = _mm_set1_epi64x(0xbb67ae8584caa73bULL);
+    __m128i v2 = _mm_set1_epi64x(0x3c6ef372fe94f82bULL);
+    __m128i v3 = _mm_set1_epi64x(0xa54ff53a5f1d36f1ULL);
+    return Clay__HashDataSSE2Finish(data, length, v0, v1, v2, v3);
+}
+
+#if defined(__AVX2__) || defined(CLAY_ENABLE_CPU_DISPATCH)
+#if !defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+#define CLAY__TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CLAY__TARGET_AVX2
+#endif
+
+// The same mixer with v0 and v2 in one register and v1 and v3 in the other, so that both pairs are mixed by one instruction and 32 bytes are consumed at a time.
+// The upper 16 bytes of each block are mixed into v2, so hashes of strings of 64 bytes or more differ from Clay__HashDataSSE2, which only has to be consistent within a process.
+CLAY__TARGET_AVX2 uint64_t Clay__HashDataAVX2(const uint8_t* data, size_t length) {
+    // Short strings (most IDs) don't amortize the extra shuffles
+    if (length < 64) {
+        return Clay__HashDataSSE2(data, length);
+    }
+    __m256i v02 = _mm256_set_epi64x(0x3c6ef372fe94f82bLL, 0x3c6ef372fe94f82bLL, 0x6a09e667f3bcc908LL, 0x6a09e667f3bcc908LL);
+    __m256i v13 = _mm256_set_epi64x((long long)0xa54ff53a5f1d36f1ULL, (long long)0xa54ff53a5f1d36f1ULL, (long long)0xbb67ae8584caa73bULL, (long long)0xbb67ae8584caa73bULL);
+    const __m256i zero = _mm256_setzero_si256();
+    while (length >= 32) {
+        v02 = _mm256_xor_si256(v02, _mm256_loadu_si256((const __m256i*)data));
+        v02 = _mm256_add_epi64(v02, v13);
+        v13 = _mm256_xor_si256(_mm256_or_si256(_mm256_slli_epi64(v13, 17), _mm256_srli_epi64(v13, 64 - 17)), v02);
+        // v0 += v2 and v1 += v3, by adding the upper halves to the lower halves
+        v02 = _mm256_add_epi64(v02, _mm256_blend_epi32(zero, _mm256_permute4x64_epi64(v02, 0x4E), 0x0F));
+        v13 = _mm256_add_epi64(v13, _mm256_blend_epi32(zero, _mm256_permute4x64_epi64(v13, 0x4E), 0x0F));
+        data += 32;
+        length -= 32;
+    }
+    return Clay__HashDataSSE2Finish(data, length, _mm256_castsi256_si128(v02), _mm256_castsi256_si128(v13), _mm256_extracti128_si256(v02, 1), _mm256_extracti128_si256(v13, 1));
+}
+#endif
+
+#if defined(__AVX2__)
+uint64_t Clay__HashData(const uint8_t* data, size_t length) {
+    return Clay__HashDataAVX2(data, length);
+}
+#elif defined(CLAY_ENABLE_CPU_DISPATCH)
+// Selected by Clay__HashDataDetect() on the first hash. Threads that hash before it is selected each detect the same function,
+// so the pointer only needs to be read and written atomically rather than guarded.
+uint64_t Clay__HashDataDetect(const uint8_t* data, size_t length);
+uint64_t (* volatile Clay__hashDataFunction)(const uint8_t* data, size_t length) = Clay__HashDataDetect;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CLAY__ATOMIC_LOAD_RELAXED(variable) __atomic_load_n(&(variable), __ATOMIC_RELAXED)
+#define CLAY__ATOMIC_STORE_RELAXED(variable, value) __atomic_store_n(&(variable), (value), __ATOMIC_RELAXED)
+#else
+// MSVC reads and writes aligned volatile pointers atomically on the x86 targets that dispatch is used for
+#define CLAY__ATOMIC_LOAD_RELAXED(variable) (variable)
+#define CLAY__ATOMIC_STORE_RELAXED(variable, value) ((variable) = (value))
+#endif
+
+bool Clay__CPUSupportsAVX2(void) {
+    uint32_t registers[4]; // eax, ebx, ecx, edx
+#ifdef _MSC_VER
+    __cpuid((int *)registers, 0);
+    if (registers[0] < 7) {
+        return false;
+    }
+    __cpuid((int *)registers, 1);
+#else
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return false;
+    }
+    __cpuid(1, registers[0], registers[1], registers[2], registers[3]);
+#endif
+    // The CPU supports AVX and the OS saves the upper halves of the ymm registers (OSXSAVE, then XCR0 bits 1 and 2)
+    if ((registers[2] & (1u << 27)) == 0 || (registers[2] & (1u << 28)) == 0) {
+        return false;
+    }
+#if defined(_MSC_VER) && !defined(__clang__)
+    uint64_t enabledState = _xgetbv(0);
+#else
+    uint32_t enabledStateLow, enabledStateHigh;
+    __asm__ volatile ("xgetbv" : "=a"(enabledStateLow), "=d"(enabledStateHigh) : "c"(0));
+    uint64_t enabledState = ((uint64_t)enabledStateHigh << 32) | enabledStateLow;
+#endif
+    if ((enabledState & 6) != 6) {
+        return false;
+    }
+#ifdef _MSC_VER
+    __cpuidex((int *)registers, 7, 0);
+#else
+    __cpuid_count(7, 0, registers[0], registers[1], registers[2], registers[3]);
+#endif
+    return (registers[1] & (1u << 5)) != 0;
+}
+
+uint64_t Clay__HashDataDetect(const uint8_t* data, size_t length) {
+    uint64_t (*hashDataFunction)(const uint8_t* data, size_t length) = Clay__CPUSupportsAVX2() ? Clay__HashDataAVX2 : Clay__HashDataSSE2;
+    CLAY__ATOMIC_STORE_RELAXED(Clay__hashDataFunction, hashDataFunction);
+    return hashDataFunction(data, length);
+}
+
+uint64_t Clay__HashData(const uint8_t* data, size_t length) {
+    uint64_t (*hashDataFunction)(const uint8_t* data, size_t length) = CLAY__ATOMIC_LOAD_RELAXED(Clay__hashDataFunction);
+    return hashDataFunction(data, length);
+}
+#else
+uint64_t Clay__HashData(const uint8_t* data, size_t length) {
+    return Clay__HashDataSSE2(data, length);
+}
+#endif
 #elif !defined(CLAY_DISABLE_SIMD) && defined(__aarch64__)
 static inline void Clay__SIMDARXMix(uint64x2_t* a, uint64x2_t* b) {
     *a = vaddq_u64(*a, *b);
@@ -1513,6 +2453,52 @@ uint64_t Clay__HashData(const uint8_t* data, size_t length) {
 
     return result[0] ^ result[1];
 }
+#elif !defined(CLAY_DISABLE_SIMD) && defined(__wasm_simd128__)
+static inline void Clay__SIMDARXMix(v128_t* a, v128_t* b) {
+    *a = wasm_i64x2_add(*a, *b);
+    *b = wasm_v128_xor(wasm_v128_or(wasm_i64x2_shl(*b, 17), wasm_u64x2_shr(*b, 64 - 17)), *a);
+}
+
+uint64_t Clay__HashData(const uint8_t* data, size_t length) {
+    // Pinched these constants from the BLAKE implementation
+    v128_t v0 = wasm_i64x2_splat((int64_t)0x6a09e667f3bcc908ULL);
+    v128_t v1 = wasm_i64x2_splat((int64_t)0xbb67ae8584caa73bULL);
+    v128_t v2 = wasm_i64x2_splat((int64_t)0x3c6ef372fe94f82bULL);
+    v128_t v3 = wasm_i64x2_splat((int64_t)0xa54ff53a5f1d36f1ULL);
+
+    uint8_t overflowBuffer[16] = { 0 };  // Temporary buffer for small inputs
+
+    while (length > 0) {
+        v128_t msg;
+        if (length >= 16) {
+            msg = wasm_v128_load(data);
+            data += 16;
+            length -= 16;
+        }
+        else {
+            for (size_t i = 0; i < length; i++) {
+                overflowBuffer[i] = data[i];
+            }
+            msg = wasm_v128_load(overflowBuffer);
+            length = 0;
+        }
+
+        v0 = wasm_v128_xor(v0, msg);
+        Clay__SIMDARXMix(&v0, &v1);
+        Clay__SIMDARXMix(&v2, &v3);
+
+        v0 = wasm_i64x2_add(v0, v2);
+        v1 = wasm_i64x2_add(v1, v3);
+    }
+
+    Clay__SIMDARXMix(&v0, &v1);
+    Clay__SIMDARXMix(&v2, &v3);
+    v0 = wasm_i64x2_add(v0, v2);
+    v1 = wasm_i64x2_add(v1, v3);
+    v0 = wasm_i64x2_add(v0, v1);
+
+    return (uint64_t)wasm_i64x2_extract_lane(v0, 0) ^ (uint64_t)wasm_i64x2_extract_lane(v0, 1);
+}
 #else
 uint64_t Clay__HashData(const uint8_t* data, size_t length) {
     uint64_t hash = 0;
@@ -1526,8 +2512,26 @@ uint64_t Clay__HashData(const uint8_t* data, size_t length) {
 }
 #endif
 
+// Returns the interned string that text refers to, if it was returned by Clay_InternString() during the current frame
+Clay__InternedString *Clay__GetInternedString(Clay_String *text) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    uintptr_t start = (uintptr_t)context->dynamicStringData.internalArray;
+    uintptr_t chars = (uintptr_t)text->chars;
+    if (chars < start + sizeof(int32_t) || chars >= start + context->dynamicStringData.length || chars % sizeof(int32_t) != 0) {
+        return NULL;
+    }
+    int32_t index = *(const int32_t *)(chars - sizeof(int32_t));
+    if (index < 0 || index >= context->internedStrings.length) {
+        return NULL;
+    }
+    // The header may just be chars of another string, so make sure the item really describes this one
+    Clay__InternedString *item = &context->internedStrings.internalArray[index];
+    return (uintptr_t)item->offset == chars - start && item->length == text->length ? item : NULL;
+}
+
 uint32_t Clay__HashStringContentsWithConfig(Clay_String *text, Clay_TextElementConfig *config) {
     uint32_t hash = 0;
+    Clay__InternedString *internedString = NULL;
     if (text->isStaticallyAllocated) {
         hash += (uintptr_t)text->chars;
         hash += (hash << 10);
@@ -1535,6 +2539,8 @@ uint32_t Clay__HashStringContentsWithConfig(Clay_String *text, Clay_TextElementC
         hash += text->length;
         hash += (hash << 10);
         hash ^= (hash >> 6);
+    } else if ((internedString = Clay__GetInternedString(text))) {
+        hash = internedString->hash;
     } else {
         hash = Clay__HashData((const uint8_t *)text->chars, text->length) % UINT32_MAX;
     }
@@ -1551,17 +2557,175 @@ uint32_t Clay__HashStringContentsWithConfig(Clay_String *text, Clay_TextElementC
     hash += (hash << 10);
     hash ^= (hash >> 6);
 
+    if (config->monospace) {
+        hash += 1;
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+
     hash += (hash << 3);
     hash ^= (hash >> 11);
     hash += (hash << 15);
     return hash + 1; // Reserve the hash result of zero as "null id"
 }
 
-Clay__MeasuredWord *Clay__AddMeasuredWord(Clay__MeasuredWord word, Clay__MeasuredWord *previousWord) {
-    Clay_Context* context = Clay_GetCurrentContext();
-    if (context->measuredWordsFreeList.length > 0) {
-        uint32_t newItemIndex = Clay__int32_tArray_GetValue(&context->measuredWordsFreeList, (int)context->measuredWordsFreeList.length - 1);
-        context->measuredWordsFreeList.length--;
+uint32_t Clay__HashMixValue(uint32_t hash, uint32_t value) {
+    hash += value;
+    hash += (hash << 10);
+    hash ^= (hash >> 6);
+    return hash;
+}
+
+uint32_t Clay__HashMixFloat(uint32_t hash, float value) {
+    union { float f; uint32_t u; } bits = { value };
+    return Clay__HashMixValue(hash, bits.u);
+}
+
+uint32_t Clay__HashLayoutSizingAxis(uint32_t hash, Clay_SizingAxis axis) {
+    hash = Clay__HashMixValue(hash, axis.type);
+    if (axis.type == CLAY__SIZING_TYPE_PERCENT) {
+        return Clay__HashMixFloat(hash, axis.size.percent);
+    }
+    hash = Clay__HashMixFloat(hash, axis.size.minMax.min);
+    return Clay__HashMixFloat(hash, axis.size.minMax.max);
+}
+
+uint32_t Clay__HashMixFinish(uint32_t hash) {
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return hash + 1; // Reserve the hash result of zero to mean "no hash"
+}
+
+void Clay__MeasureTextCacheLruAppend(int32_t itemIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, itemIndex);
+    item->lruPrevious = context->measureTextCacheLruTail;
+    item->lruNext = 0;
+    if (context->measureTextCacheLruTail != 0) {
+        Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, context->measureTextCacheLruTail)->lruNext = itemIndex;
+    } else {
+        context->measureTextCacheLruHead = itemIndex;
+    }
+    context->measureTextCacheLruTail = itemIndex;
+}
+
+void Clay__MeasureTextCacheLruRemove(int32_t itemIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, itemIndex);
+    if (item->lruPrevious != 0) {
+        Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, item->lruPrevious)->lruNext = item->lruNext;
+    } else {
+        context->measureTextCacheLruHead = item->lruNext;
+    }
+    if (item->lruNext != 0) {
+        Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, item->lruNext)->lruPrevious = item->lruPrevious;
+    } else {
+        context->measureTextCacheLruTail = item->lruPrevious;
+    }
+}
+
+// Adds a linked list of measured words to the freelist
+void Clay__FreeMeasuredWords(int32_t nextWordIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    while (nextWordIndex != -1) {
+        Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, nextWordIndex);
+        Clay__int32_tArray_Add(&context->measuredWordsFreeList, nextWordIndex);
+        nextWordIndex = measuredWord->next;
+    }
+}
+
+// Adds a linked list of cached wrapped lines to the freelist
+void Clay__FreeWrappedLines(int32_t nextLineIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    while (nextLineIndex != -1) {
+        Clay__MeasuredWord *line = Clay__MeasuredWordArray_Get(&context->wrappedLineCache, nextLineIndex);
+        Clay__int32_tArray_Add(&context->wrappedLineCacheFreeList, nextLineIndex);
+        nextLineIndex = line->next;
+    }
+}
+
+// Returns a cache item's measured words and the item itself to their free lists. The item must already be unlinked from its hash bucket.
+void Clay__FreeMeasureTextCacheItem(int32_t itemIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasureTextCacheItem *item = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, itemIndex);
+    Clay__FreeMeasuredWords(item->measuredWordsStartIndex);
+    Clay__FreeWrappedLines(item->wrappedLinesStartIndex);
+    Clay__MeasureTextCacheLruRemove(itemIndex);
+    Clay__MeasureTextCacheItemArray_Set(&context->measureTextHashMapInternal, itemIndex, CLAY__INIT(Clay__MeasureTextCacheItem) { .measuredWordsStartIndex = -1, .wrappedLinesStartIndex = -1 });
+    Clay__int32_tArray_Add(&context->measureTextHashMapInternalFreeList, itemIndex);
+}
+
+// Chooses a cache item to evict when the cache is full, according to the cache policy.
+// Items used during the current frame are never evicted, as their measurements may still be needed to finish the layout.
+int32_t Clay__FindMeasureTextCacheVictim(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__MeasureTextCacheItemArray *items = &context->measureTextHashMapInternal;
+    if (context->measureTextCachePolicy == CLAY_MEASURE_TEXT_CACHE_POLICY_LRU) {
+        int32_t victimIndex = context->measureTextCacheLruHead;
+        return victimIndex != 0 && items->internalArray[victimIndex].generation != context->generation ? victimIndex : 0;
+    }
+    // Items only ever become younger, so until enough frames have passed since the last sweep that found nothing, there is still nothing to evict
+    uint32_t oldestAge = context->generation - context->measureTextCacheOldestGeneration;
+    if (oldestAge == 0 || (context->measureTextCachePolicy == CLAY_MEASURE_TEXT_CACHE_POLICY_GENERATION && oldestAge <= 2)) {
+        return 0;
+    }
+    uint32_t oldestGeneration = context->generation;
+    // Sweep a clock hand through the items. Two full turns is enough for CLOCK to clear every reference bit and come back around.
+    for (int32_t i = 0; i < (items->length - 1) * 2; ++i) {
+        context->measureTextCacheClockHand = context->measureTextCacheClockHand + 1 < items->length ? context->measureTextCacheClockHand + 1 : 1;
+        Clay__MeasureTextCacheItem *item = &items->internalArray[context->measureTextCacheClockHand];
+        if (item->id == 0 || item->generation == context->generation) {
+            continue;
+        }
+        if (context->generation - item->generation > context->generation - oldestGeneration) {
+            oldestGeneration = item->generation;
+        }
+        if (context->measureTextCachePolicy == CLAY_MEASURE_TEXT_CACHE_POLICY_GENERATION) {
+            if (context->generation - item->generation > 2) {
+                return context->measureTextCacheClockHand;
+            }
+        } else if (item->referenced) {
+            item->referenced = false;
+        } else {
+            return context->measureTextCacheClockHand;
+        }
+    }
+    context->measureTextCacheOldestGeneration = oldestGeneration;
+    return 0;
+}
+
+// Evicts a single cache item to make room for new measurements. Returns false if no item could be evicted.
+bool Clay__EvictMeasureTextCacheItem(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t victimIndex = Clay__FindMeasureTextCacheVictim();
+    if (victimIndex == 0) {
+        return false;
+    }
+    Clay__MeasureTextCacheItem *victim = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, victimIndex);
+    uint32_t hashBucket = victim->id % (context->maxMeasureTextCacheWordCount / 32);
+    int32_t *previousNextIndex = &context->measureTextHashMap.internalArray[hashBucket];
+    while (*previousNextIndex != victimIndex) {
+        previousNextIndex = &Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, *previousNextIndex)->nextIndex;
+    }
+    *previousNextIndex = victim->nextIndex;
+    Clay__FreeMeasureTextCacheItem(victimIndex);
+    context->measureTextCacheStats.evictions++;
+    return true;
+}
+
+// Adds a measured word after previousWord, evicting cache items to make room if the word storage is full.
+// Returns NULL without linking the word if no room could be made.
+Clay__MeasuredWord *Clay__AddMeasuredWord(Clay__MeasuredWord word, Clay__MeasuredWord *previousWord) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    while (context->measuredWordsFreeList.length == 0 && context->measuredWords.length >= context->measuredWords.capacity - 1) {
+        if (!Clay__EvictMeasureTextCacheItem()) {
+            return CLAY__NULL;
+        }
+    }
+    if (context->measuredWordsFreeList.length > 0) {
+        uint32_t newItemIndex = Clay__int32_tArray_GetValue(&context->measuredWordsFreeList, (int)context->measuredWordsFreeList.length - 1);
+        context->measuredWordsFreeList.length--;
         Clay__MeasuredWordArray_Set(&context->measuredWords, (int)newItemIndex, word);
         previousWord->next = (int32_t)newItemIndex;
         return Clay__MeasuredWordArray_Get(&context->measuredWords, (int)newItemIndex);
@@ -1571,10 +2735,329 @@ Clay__MeasuredWord *Clay__AddMeasuredWord(Clay__MeasuredWord word, Clay__Measure
     }
 }
 
+// Reports that the measured word storage is full. The words measured so far are kept on the item so that they can be freed.
+bool Clay__MeasuredWordsExhausted(Clay__MeasureTextCacheItem *measured, int32_t firstWordIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (!context->booleanWarnings.maxTextMeasureCacheExceeded) {
+        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED,
+            .errorText = CLAY_STRING("Clay has run out of space in it's internal text measurement cache. Try using Clay_SetMaxMeasureTextCacheWordCount() (default 16384, with 1 unit storing 1 measured word)."),
+            .userData = context->errorHandler.userData });
+        context->booleanWarnings.maxTextMeasureCacheExceeded = true;
+    }
+    measured->measuredWordsStartIndex = firstWordIndex;
+    return false;
+}
+
+// Reports a declaration to the capture function, if one is bound and a layout is being declared
+static inline void Clay__CaptureDeclaration(Clay_Context *context, Clay_CaptureEvent event) {
+    if (context->captureActive) {
+        context->captureFunction(&event, context->captureUserData);
+    }
+}
+
+static inline void Clay__CaptureMeasuredText(Clay_Context *context, Clay_StringSlice text, Clay_TextElementConfig *config, Clay_Dimensions dimensions) {
+    if (context->captureFunction) {
+        Clay_CaptureEvent event = { .type = CLAY_CAPTURE_EVENT_MEASURE_TEXT, .text = text, .textConfig = config, .dimensions = dimensions };
+        context->captureFunction(&event, context->captureUserData);
+    }
+}
+
+// Measures a single string, either by reading the next result of a batch measurement or by calling the measurement function directly
+static inline Clay_Dimensions Clay__MeasureTextSlice(Clay_StringSlice text, Clay_TextElementConfig *config, Clay_MeasureTextBatchItem **batchItems) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (*batchItems) {
+        // Already reported to the capture function when the batch was measured
+        return (*batchItems)++->dimensions;
+    }
+    Clay_Dimensions dimensions;
+    if (context->measureTextBatchFunction) {
+        Clay_MeasureTextBatchItem item = { .text = text, .config = config };
+        context->measureTextBatchFunction(&item, 1, context->measureTextBatchUserData);
+        dimensions = item.dimensions;
+    } else {
+        #ifdef CLAY_WASM
+        dimensions = Clay__MeasureText(text, config, context->measureTextUserData);
+        #else
+        dimensions = context->measureTextFunction(text, config, context->measureTextUserData);
+        #endif
+    }
+    Clay__CaptureMeasuredText(context, text, config, dimensions);
+    return dimensions;
+}
+
+// Returns the index of the first space or newline in chars at or after start, or length if there are none
+static inline int32_t Clay__FindTextSeparator(const char *chars, int32_t start, int32_t length) {
+#if !defined(CLAY_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64))
+    const __m128i spaces = _mm_set1_epi8(' ');
+    const __m128i newlines = _mm_set1_epi8('\n');
+    while (start + 16 <= length) {
+        __m128i v = _mm_loadu_si128((const __m128i *)&chars[start]);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, spaces), _mm_cmpeq_epi8(v, newlines)));
+        if (mask != 0) {
+            while (!(mask & 1)) {
+                mask >>= 1;
+                start++;
+            }
+            return start;
+        }
+        start += 16;
+    }
+#elif !defined(CLAY_DISABLE_SIMD) && defined(__aarch64__)
+    const uint8x16_t spaces = vdupq_n_u8(' ');
+    const uint8x16_t newlines = vdupq_n_u8('\n');
+    while (start + 16 <= length) {
+        uint8x16_t v = vld1q_u8((const uint8_t *)&chars[start]);
+        uint8x16_t matches = vorrq_u8(vceqq_u8(v, spaces), vceqq_u8(v, newlines));
+        // Narrow each byte of the comparison result to 4 bits, giving a 64 bit mask with a nibble per character
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+        if (mask != 0) {
+            while (!(mask & 0xF)) {
+                mask >>= 4;
+                start++;
+            }
+            return start;
+        }
+        start += 16;
+    }
+#endif
+    while (start < length && chars[start] != ' ' && chars[start] != '\n') {
+        start++;
+    }
+    return start;
+}
+
+// Measures a single word, computing the width from the width of a space for monospace text rather than calling the measurement function
+static inline Clay_Dimensions Clay__MeasureTextWord(Clay_StringSlice text, Clay_TextElementConfig *config, Clay_Dimensions spaceDimensions, Clay_MeasureTextBatchItem **batchItems) {
+    if (config->monospace) {
+        // Every character has the same advance, so count UTF-8 codepoints by skipping continuation bytes (0b10xxxxxx)
+        int32_t characterCount = 0;
+        for (int32_t i = 0; i < text.length; ++i) {
+            characterCount += ((uint8_t)text.chars[i] & 0xC0) != 0x80;
+        }
+        return CLAY__INIT(Clay_Dimensions) { (float)characterCount * spaceDimensions.width + (float)(characterCount - 1) * config->letterSpacing, spaceDimensions.height };
+    }
+    return Clay__MeasureTextSlice(text, config, batchItems);
+}
+
+// Splits text into words and measures them into the cache item.
+// If batchItems is not null, the measurements are read in order from the results of a batch measurement rather than measured here.
+bool Clay__MeasureTextWords(Clay__MeasureTextCacheItem *measured, Clay_String *text, Clay_TextElementConfig *config, Clay_MeasureTextBatchItem *batchItems) {
+    int32_t start = 0;
+    int32_t end = 0;
+    float lineWidth = 0;
+    float measuredWidth = 0;
+    float measuredHeight = 0;
+    Clay_Dimensions spaceDimensions = Clay__MeasureTextSlice(CLAY__INIT(Clay_StringSlice) { .length = 1, .chars = CLAY__SPACECHAR.chars, .baseChars = CLAY__SPACECHAR.chars }, config, &batchItems);
+    float spaceWidth = spaceDimensions.width;
+    Clay__MeasuredWord tempWord = { .next = -1 };
+    Clay__MeasuredWord *previousWord = &tempWord;
+    while (end < text->length) {
+        end = Clay__FindTextSeparator(text->chars, end, text->length);
+        if (end == text->length) {
+            break;
+        }
+        char current = text->chars[end];
+        int32_t length = end - start;
+        Clay_Dimensions dimensions = CLAY__DEFAULT_STRUCT;
+        if (length > 0) {
+            dimensions = Clay__MeasureTextWord(CLAY__INIT(Clay_StringSlice) {.length = length, .chars = &text->chars[start], .baseChars = text->chars}, config, spaceDimensions, &batchItems);
+        }
+        measured->minWidth = CLAY__MAX(dimensions.width, measured->minWidth);
+        measuredHeight = CLAY__MAX(measuredHeight, dimensions.height);
+        if (current == ' ') {
+            dimensions.width += spaceWidth;
+            previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length + 1, .width = dimensions.width, .next = -1 }, previousWord);
+            if (!previousWord) {
+                return Clay__MeasuredWordsExhausted(measured, tempWord.next);
+            }
+            lineWidth += dimensions.width;
+        }
+        if (current == '\n') {
+            if (length > 0) {
+                previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length, .width = dimensions.width, .next = -1 }, previousWord);
+                if (!previousWord) {
+                    return Clay__MeasuredWordsExhausted(measured, tempWord.next);
+                }
+            }
+            previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = end + 1, .length = 0, .width = 0, .next = -1 }, previousWord);
+            if (!previousWord) {
+                return Clay__MeasuredWordsExhausted(measured, tempWord.next);
+            }
+            lineWidth += dimensions.width;
+            measuredWidth = CLAY__MAX(lineWidth, measuredWidth);
+            measured->containsNewlines = true;
+            lineWidth = 0;
+        }
+        start = end + 1;
+        end++;
+    }
+    if (end - start > 0) {
+        Clay_Dimensions dimensions = Clay__MeasureTextWord(CLAY__INIT(Clay_StringSlice) { .length = end - start, .chars = &text->chars[start], .baseChars = text->chars }, config, spaceDimensions, &batchItems);
+        if (!Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = end - start, .width = dimensions.width, .next = -1 }, previousWord)) {
+            return Clay__MeasuredWordsExhausted(measured, tempWord.next);
+        }
+        lineWidth += dimensions.width;
+        measuredHeight = CLAY__MAX(measuredHeight, dimensions.height);
+        measured->minWidth = CLAY__MAX(dimensions.width, measured->minWidth);
+    }
+    measuredWidth = CLAY__MAX(lineWidth, measuredWidth) - config->letterSpacing;
+
+    measured->measuredWordsStartIndex = tempWord.next;
+    measured->unwrappedDimensions.width = measuredWidth;
+    measured->unwrappedDimensions.height = measuredHeight;
+    measured->spaceWidth = spaceWidth;
+    return true;
+
+}
+
+// Measures all of the text queued by Clay__QueueTextMeasurement in a single call to the batch measurement function
+void Clay__ResolveTextMeasurementBatch(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->pendingTextMeasurements.length == 0) {
+        return;
+    }
+    context->measureTextBatchFunction(context->measureTextBatchItems.internalArray, context->measureTextBatchItems.length, context->measureTextBatchUserData);
+    for (int32_t i = 0; i < context->measureTextBatchItems.length && context->captureFunction; ++i) {
+        Clay_MeasureTextBatchItem *item = &context->measureTextBatchItems.internalArray[i];
+        Clay__CaptureMeasuredText(context, item->text, item->config, item->dimensions);
+    }
+    for (int32_t i = 0; i < context->pendingTextMeasurements.length; ++i) {
+        Clay__PendingTextMeasurement *pending = &context->pendingTextMeasurements.internalArray[i];
+        Clay__MeasureTextCacheItem *measured = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, pending->cacheItemIndex);
+        Clay__MeasureTextWords(measured, &pending->text, pending->config, &context->measureTextBatchItems.internalArray[pending->batchItemsStartIndex]);
+        measured->measurementQueued = false;
+    }
+    context->measureTextBatchItems.length = 0;
+    context->pendingTextMeasurements.length = 0;
+    context->textMeasurementBatchResolved = true;
+}
+
+// Returns the number of strings that Clay__MeasureTextWords will measure for text
+int32_t Clay__CountTextMeasurementSlices(Clay_String *text, Clay_TextElementConfig *config) {
+    int32_t sliceCount = 1; // The width of a space is always measured first
+    int32_t start = 0;
+    // Monospace words are measured from the width of the space, so only the space needs to be queued
+    while (!config->monospace && start <= text->length) {
+        int32_t end = Clay__FindTextSeparator(text->chars, start, text->length);
+        sliceCount += end - start > 0 ? 1 : 0;
+        start = end + 1;
+    }
+    return sliceCount;
+}
+
+// Adds the strings that Clay__MeasureTextWords will measure for text to items, in the same order that it will read them
+void Clay__AddTextMeasurementSlices(Clay_MeasureTextBatchItemArray *items, Clay_String *text, Clay_TextElementConfig *config) {
+    Clay_MeasureTextBatchItemArray_Add(items, CLAY__INIT(Clay_MeasureTextBatchItem) { .text = { .length = 1, .chars = CLAY__SPACECHAR.chars, .baseChars = CLAY__SPACECHAR.chars }, .config = config });
+    int32_t start = 0;
+    while (!config->monospace && start <= text->length) {
+        int32_t end = Clay__FindTextSeparator(text->chars, start, text->length);
+        if (end - start > 0) {
+            Clay_MeasureTextBatchItemArray_Add(items, CLAY__INIT(Clay_MeasureTextBatchItem) { .text = { .length = end - start, .chars = &text->chars[start], .baseChars = text->chars }, .config = config });
+        }
+        start = end + 1;
+    }
+}
+
+// Queues the words of text to be measured by the next batch.
+// Returns false if the text has too many words to fit in a batch.
+bool Clay__QueueTextMeasurement(Clay_String *text, Clay_TextElementConfig *config, int32_t cacheItemIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t sliceCount = Clay__CountTextMeasurementSlices(text, config);
+    if (sliceCount > context->measureTextBatchItems.capacity) {
+        return false;
+    }
+    if (context->measureTextBatchItems.length + sliceCount > context->measureTextBatchItems.capacity || context->pendingTextMeasurements.length == context->pendingTextMeasurements.capacity) {
+        Clay__ResolveTextMeasurementBatch();
+    }
+    Clay__PendingTextMeasurementArray_Add(&context->pendingTextMeasurements, CLAY__INIT(Clay__PendingTextMeasurement) { .text = *text, .config = config, .cacheItemIndex = cacheItemIndex, .batchItemsStartIndex = context->measureTextBatchItems.length });
+    Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, cacheItemIndex)->measurementQueued = true;
+    Clay__AddTextMeasurementSlices(&context->measureTextBatchItems, text, config);
+    return true;
+}
+
+// Copies text and its config into the prefetch queue, along with the strings it will be measured as. Returns false if the queue is full.
+bool Clay__QueueTextPrefetch(Clay_String *text, Clay_TextElementConfig *config, uint32_t id) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->textPrefetches.length == context->textPrefetches.capacity
+        || context->textPrefetchChars.length + text->length > context->textPrefetchChars.capacity
+        || context->textPrefetchItems.length + Clay__CountTextMeasurementSlices(text, config) > context->textPrefetchItems.capacity) {
+        return false;
+    }
+    Clay_String textCopy = { .length = text->length, .chars = context->textPrefetchChars.internalArray + context->textPrefetchChars.length };
+    Clay__CopyMemory(context->textPrefetchChars.internalArray + context->textPrefetchChars.length, text->chars, text->length);
+    context->textPrefetchChars.length += text->length;
+    Clay_TextElementConfig *configCopy = Clay__TextElementConfigArray_Add(&context->textPrefetchConfigs, *config);
+    Clay__PendingTextMeasurementArray_Add(&context->textPrefetches, CLAY__INIT(Clay__PendingTextMeasurement) { .text = textCopy, .config = configCopy, .batchItemsStartIndex = context->textPrefetchItems.length, .id = id });
+    Clay__AddTextMeasurementSlices(&context->textPrefetchItems, &textCopy, configCopy);
+    return true;
+}
+
+// Moves the queued prefetches of source from firstIndex onwards to the start of the prefetch queue of destination, which may be the same context,
+// and points the moved text and strings to be measured at the moved copies.
+void Clay__MoveTextPrefetches(Clay_Context *destination, Clay_Context *source, int32_t firstIndex) {
+    int32_t count = source->textPrefetches.length - firstIndex;
+    int32_t charsStart = source->textPrefetchChars.length;
+    int32_t itemsStart = source->textPrefetchItems.length;
+    if (count > 0) {
+        charsStart = (int32_t)(source->textPrefetches.internalArray[firstIndex].text.chars - source->textPrefetchChars.internalArray);
+        itemsStart = source->textPrefetches.internalArray[firstIndex].batchItemsStartIndex;
+    }
+    int32_t charCount = source->textPrefetchChars.length - charsStart;
+    int32_t itemCount = source->textPrefetchItems.length - itemsStart;
+    // Moving towards the start of the same arrays overlaps, so copy forwards one element at a time
+    for (int32_t i = 0; i < charCount; ++i) {
+        destination->textPrefetchChars.internalArray[i] = source->textPrefetchChars.internalArray[charsStart + i];
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        Clay__PendingTextMeasurement prefetch = source->textPrefetches.internalArray[firstIndex + i];
+        destination->textPrefetchConfigs.internalArray[i] = source->textPrefetchConfigs.internalArray[firstIndex + i];
+        prefetch.text.chars = destination->textPrefetchChars.internalArray + (prefetch.text.chars - source->textPrefetchChars.internalArray - charsStart);
+        prefetch.config = &destination->textPrefetchConfigs.internalArray[i];
+        prefetch.batchItemsStartIndex -= itemsStart;
+        destination->textPrefetches.internalArray[i] = prefetch;
+    }
+    for (int32_t i = 0; i < itemCount; ++i) {
+        Clay_MeasureTextBatchItem item = source->textPrefetchItems.internalArray[itemsStart + i];
+        item.config = destination->textPrefetchConfigs.internalArray + (item.config - source->textPrefetchConfigs.internalArray - firstIndex);
+        if (item.text.baseChars != CLAY__SPACECHAR.chars) {
+            item.text.chars = destination->textPrefetchChars.internalArray + (item.text.chars - source->textPrefetchChars.internalArray - charsStart);
+            item.text.baseChars = destination->textPrefetchChars.internalArray + (item.text.baseChars - source->textPrefetchChars.internalArray - charsStart);
+        }
+        destination->textPrefetchItems.internalArray[i] = item;
+    }
+    destination->textPrefetches.length = count;
+    destination->textPrefetchConfigs.length = count;
+    destination->textPrefetchChars.length = charCount;
+    destination->textPrefetchItems.length = itemCount;
+}
+
+// Estimates the size of text that is still waiting to be measured, from roughly half an em per character
+Clay_Dimensions Clay__EstimateTextDimensions(Clay_String *text, Clay_TextElementConfig *config) {
+    return CLAY__INIT(Clay_Dimensions) { (float)text->length * ((float)config->fontSize * 0.5f + (float)config->letterSpacing), (float)config->fontSize };
+}
+
+// Replaces the estimated size of a placeholder with the measurements of its text, which are read from batchItems if they aren't null
+void Clay__MeasurePendingText(Clay__MeasureTextCacheItem *item, Clay_String *text, Clay_TextElementConfig *config, Clay_MeasureTextBatchItem *batchItems) {
+    Clay__MeasureTextCacheItem measured = { .measuredWordsStartIndex = -1 };
+    if (!Clay__MeasureTextWords(&measured, text, config, batchItems)) {
+        Clay__FreeMeasuredWords(measured.measuredWordsStartIndex);
+        return;
+    }
+    item->unwrappedDimensions = measured.unwrappedDimensions;
+    item->measuredWordsStartIndex = measured.measuredWordsStartIndex;
+    item->minWidth = measured.minWidth;
+    item->spaceWidth = measured.spaceWidth;
+    item->containsNewlines = measured.containsNewlines;
+    item->measurementPending = false;
+}
+
+Clay__MeasureTextCacheItem *Clay__MeasureTextCachedWithId(Clay_String *text, Clay_TextElementConfig *config, uint32_t id);
+
 Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_TextElementConfig *config) {
     Clay_Context* context = Clay_GetCurrentContext();
     #ifndef CLAY_WASM
-    if (!Clay__MeasureText) {
+    if (!context->measureTextFunction && !context->measureTextBatchFunction) {
         if (!context->booleanWarnings.textMeasurementFunctionNotSet) {
             context->booleanWarnings.textMeasurementFunctionNotSet = true;
             context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
@@ -1585,7 +3068,11 @@ Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_Text
         return &Clay__MeasureTextCacheItem_DEFAULT;
     }
     #endif
-    uint32_t id = Clay__HashStringContentsWithConfig(text, config);
+    return Clay__MeasureTextCachedWithId(text, config, Clay__HashStringContentsWithConfig(text, config));
+}
+
+Clay__MeasureTextCacheItem *Clay__MeasureTextCachedWithId(Clay_String *text, Clay_TextElementConfig *config, uint32_t id) {
+    Clay_Context* context = Clay_GetCurrentContext();
     uint32_t hashBucket = id % (context->maxMeasureTextCacheWordCount / 32);
     int32_t elementIndexPrevious = 0;
     int32_t elementIndex = context->measureTextHashMap.internalArray[hashBucket];
@@ -1593,36 +3080,42 @@ Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_Text
         Clay__MeasureTextCacheItem *hashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndex);
         if (hashEntry->id == id) {
             hashEntry->generation = context->generation;
+            hashEntry->referenced = true;
+            if (context->measureTextCachePolicy == CLAY_MEASURE_TEXT_CACHE_POLICY_LRU) {
+                Clay__MeasureTextCacheLruRemove(elementIndex);
+                Clay__MeasureTextCacheLruAppend(elementIndex);
+            }
+            context->measureTextCacheStats.hits++;
+            // Either its prefetch batch has been measured, or placeholders have been disabled since the text was queued and it's needed now
+            if (hashEntry->measurementPending && !context->prefetchingText && (context->prefetchedTextItems || !context->measureTextPlaceholdersEnabled)) {
+                Clay__MeasurePendingText(hashEntry, text, config, context->prefetchedTextItems);
+            }
             return hashEntry;
         }
         // This element hasn't been seen in a few frames, delete the hash map item
         if (context->generation - hashEntry->generation > 2) {
-            // Add all the measured words that were included in this measurement to the freelist
-            int32_t nextWordIndex = hashEntry->measuredWordsStartIndex;
-            while (nextWordIndex != -1) {
-                Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, nextWordIndex);
-                Clay__int32_tArray_Add(&context->measuredWordsFreeList, nextWordIndex);
-                nextWordIndex = measuredWord->next;
-            }
-
             int32_t nextIndex = hashEntry->nextIndex;
-            Clay__MeasureTextCacheItemArray_Set(&context->measureTextHashMapInternal, elementIndex, CLAY__INIT(Clay__MeasureTextCacheItem) { .measuredWordsStartIndex = -1 });
-            Clay__int32_tArray_Add(&context->measureTextHashMapInternalFreeList, elementIndex);
             if (elementIndexPrevious == 0) {
                 context->measureTextHashMap.internalArray[hashBucket] = nextIndex;
             } else {
                 Clay__MeasureTextCacheItem *previousHashEntry = Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndexPrevious);
                 previousHashEntry->nextIndex = nextIndex;
             }
+            Clay__FreeMeasureTextCacheItem(elementIndex);
+            context->measureTextCacheStats.evictions++;
             elementIndex = nextIndex;
         } else {
             elementIndexPrevious = elementIndex;
             elementIndex = hashEntry->nextIndex;
         }
     }
+    context->measureTextCacheStats.misses++;
 
+    if (context->measureTextHashMapInternalFreeList.length == 0 && context->measureTextHashMapInternal.length == context->measureTextHashMapInternal.capacity - 1) {
+        Clay__EvictMeasureTextCacheItem();
+    }
     int32_t newItemIndex = 0;
-    Clay__MeasureTextCacheItem newCacheItem = { .measuredWordsStartIndex = -1, .id = id, .generation = context->generation };
+    Clay__MeasureTextCacheItem newCacheItem = { .measuredWordsStartIndex = -1, .wrappedLinesStartIndex = -1, .id = id, .generation = context->generation, .referenced = true };
     Clay__MeasureTextCacheItem *measured = NULL;
     if (context->measureTextHashMapInternalFreeList.length > 0) {
         newItemIndex = Clay__int32_tArray_GetValue(&context->measureTextHashMapInternalFreeList, context->measureTextHashMapInternalFreeList.length - 1);
@@ -1643,72 +3136,31 @@ Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_Text
         measured = Clay__MeasureTextCacheItemArray_Add(&context->measureTextHashMapInternal, newCacheItem);
         newItemIndex = context->measureTextHashMapInternal.length - 1;
     }
-
-    int32_t start = 0;
-    int32_t end = 0;
-    float lineWidth = 0;
-    float measuredWidth = 0;
-    float measuredHeight = 0;
-    float spaceWidth = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) { .length = 1, .chars = CLAY__SPACECHAR.chars, .baseChars = CLAY__SPACECHAR.chars }, config, context->measureTextUserData).width;
-    Clay__MeasuredWord tempWord = { .next = -1 };
-    Clay__MeasuredWord *previousWord = &tempWord;
-    while (end < text->length) {
-        if (context->measuredWords.length == context->measuredWords.capacity - 1) {
-            if (!context->booleanWarnings.maxTextMeasureCacheExceeded) {
-                context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
-                    .errorType = CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED,
-                    .errorText = CLAY_STRING("Clay has run out of space in it's internal text measurement cache. Try using Clay_SetMaxMeasureTextCacheWordCount() (default 16384, with 1 unit storing 1 measured word)."),
-                    .userData = context->errorHandler.userData });
-                context->booleanWarnings.maxTextMeasureCacheExceeded = true;
-            }
+    Clay__MeasureTextCacheLruAppend(newItemIndex);
+
+    bool prefetchQueued = false;
+    if (!context->prefetchedTextItems && (context->prefetchingText || context->measureTextPlaceholdersEnabled)) {
+        // The item is filled in when the prefetch batch is ended, and until then has an estimated size
+        prefetchQueued = Clay__QueueTextPrefetch(text, config, id);
+        if (prefetchQueued) {
+            measured->measurementPending = true;
+            measured->unwrappedDimensions = Clay__EstimateTextDimensions(text, config);
+        } else if (context->prefetchingText) {
+            Clay__FreeMeasureTextCacheItem(newItemIndex);
             return &Clay__MeasureTextCacheItem_DEFAULT;
         }
-        char current = text->chars[end];
-        if (current == ' ' || current == '\n') {
-            int32_t length = end - start;
-            Clay_Dimensions dimensions = CLAY__DEFAULT_STRUCT;
-            if (length > 0) {
-                dimensions = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) {.length = length, .chars = &text->chars[start], .baseChars = text->chars}, config, context->measureTextUserData);
-            }
-            measured->minWidth = CLAY__MAX(dimensions.width, measured->minWidth);
-            measuredHeight = CLAY__MAX(measuredHeight, dimensions.height);
-            if (current == ' ') {
-                dimensions.width += spaceWidth;
-                previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length + 1, .width = dimensions.width, .next = -1 }, previousWord);
-                lineWidth += dimensions.width;
-            }
-            if (current == '\n') {
-                if (length > 0) {
-                    previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = length, .width = dimensions.width, .next = -1 }, previousWord);
-                }
-                previousWord = Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = end + 1, .length = 0, .width = 0, .next = -1 }, previousWord);
-                lineWidth += dimensions.width;
-                measuredWidth = CLAY__MAX(lineWidth, measuredWidth);
-                measured->containsNewlines = true;
-                lineWidth = 0;
-            }
-            start = end + 1;
-        }
-        end++;
     }
-    if (end - start > 0) {
-        Clay_Dimensions dimensions = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) { .length = end - start, .chars = &text->chars[start], .baseChars = text->chars }, config, context->measureTextUserData);
-        Clay__AddMeasuredWord(CLAY__INIT(Clay__MeasuredWord) { .startOffset = start, .length = end - start, .width = dimensions.width, .next = -1 }, previousWord);
-        lineWidth += dimensions.width;
-        measuredHeight = CLAY__MAX(measuredHeight, dimensions.height);
-        measured->minWidth = CLAY__MAX(dimensions.width, measured->minWidth);
+    // With a batch measurement function, the item is filled in when the batch is resolved
+    if (!prefetchQueued && (context->prefetchedTextItems || !context->measureTextBatchFunction || !Clay__QueueTextMeasurement(text, config, newItemIndex))) {
+        if (!Clay__MeasureTextWords(measured, text, config, context->prefetchedTextItems)) {
+            Clay__FreeMeasureTextCacheItem(newItemIndex);
+            return &Clay__MeasureTextCacheItem_DEFAULT;
+        }
     }
-    measuredWidth = CLAY__MAX(lineWidth, measuredWidth) - config->letterSpacing;
-
-    measured->measuredWordsStartIndex = tempWord.next;
-    measured->unwrappedDimensions.width = measuredWidth;
-    measured->unwrappedDimensions.height = measuredHeight;
 
-    if (elementIndexPrevious != 0) {
-        Clay__MeasureTextCacheItemArray_Get(&context->measureTextHashMapInternal, elementIndexPrevious)->nextIndex = newItemIndex;
-    } else {
-        context->measureTextHashMap.internalArray[hashBucket] = newItemIndex;
-    }
+    // Evicting to make room for this item may have changed the bucket, so insert at the head rather than after elementIndexPrevious
+    measured->nextIndex = context->measureTextHashMap.internalArray[hashBucket];
+    context->measureTextHashMap.internalArray[hashBucket] = newItemIndex;
     return measured;
 }
 
@@ -1716,19 +3168,25 @@ bool Clay__PointIsInsideRect(Clay_Vector2 point, Clay_BoundingBox rect) {
     return point.x >= rect.x && point.x <= rect.x + rect.width && point.y >= rect.y && point.y <= rect.y + rect.height;
 }
 
+// Ids are already hashes, but adjacent ids (e.g. from CLAY_IDI) differ only in their low bits, so mix before masking
+static inline uint32_t Clay__LayoutElementHashMapSlotIndex(uint32_t id, int32_t slotCount) {
+    id ^= id >> 16;
+    id *= 0x7feb352d;
+    id ^= id >> 15;
+    return id & (uint32_t)(slotCount - 1);
+}
+
 Clay_LayoutElementHashMapItem* Clay__AddHashMapItem(Clay_ElementId elementId, Clay_LayoutElement* layoutElement) {
     Clay_Context* context = Clay_GetCurrentContext();
     if (context->layoutElementsHashMapInternal.length == context->layoutElementsHashMapInternal.capacity - 1) {
         return NULL;
     }
-    Clay_LayoutElementHashMapItem item = { .elementId = elementId, .layoutElement = layoutElement, .nextIndex = -1, .generation = context->generation + 1 };
-    uint32_t hashBucket = elementId.id % context->layoutElementsHashMap.capacity;
-    int32_t hashItemPrevious = -1;
-    int32_t hashItemIndex = context->layoutElementsHashMap.internalArray[hashBucket];
-    while (hashItemIndex != -1) { // Just replace collision, not a big deal - leave it up to the end user
-        Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, hashItemIndex);
-        if (hashItem->elementId.id == elementId.id) { // Collision - resolve based on generation
-            item.nextIndex = hashItem->nextIndex;
+    Clay__LayoutElementHashMapSlot *slots = context->layoutElementsHashMap.internalArray;
+    int32_t slotMask = context->layoutElementsHashMap.capacity - 1;
+    int32_t slotIndex = (int32_t)Clay__LayoutElementHashMapSlotIndex(elementId.id, context->layoutElementsHashMap.capacity);
+    while (slots[slotIndex].itemIndex != -1) { // Just replace collision, not a big deal - leave it up to the end user
+        if (slots[slotIndex].id == elementId.id) { // Collision - resolve based on generation
+            Clay_LayoutElementHashMapItem *hashItem = &context->layoutElementsHashMapInternal.internalArray[slots[slotIndex].itemIndex];
             if (hashItem->generation <= context->generation) { // First collision - assume this is the "same" element
                 hashItem->elementId = elementId; // Make sure to copy this across. If the stringId reference has changed, we should update the hash item to use the new one.
                 hashItem->generation = context->generation + 1;
@@ -1736,6 +3194,7 @@ Clay_LayoutElementHashMapItem* Clay__AddHashMapItem(Clay_ElementId elementId, Cl
                 hashItem->debugData->collision = false;
                 hashItem->onHoverFunction = NULL;
                 hashItem->hoverFunctionUserData = 0;
+                layoutElement->hashMapItem = hashItem;
             } else { // Multiple collisions this frame - two elements have the same ID
                 context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
                     .errorType = CLAY_ERROR_TYPE_DUPLICATE_ID,
@@ -1747,31 +3206,36 @@ Clay_LayoutElementHashMapItem* Clay__AddHashMapItem(Clay_ElementId elementId, Cl
             }
             return hashItem;
         }
-        hashItemPrevious = hashItemIndex;
-        hashItemIndex = hashItem->nextIndex;
+        slotIndex = (slotIndex + 1) & slotMask;
     }
-    Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Add(&context->layoutElementsHashMapInternal, item);
+    Clay_LayoutElementHashMapItem *hashItem = Clay__LayoutElementHashMapItemArray_Add(&context->layoutElementsHashMapInternal, CLAY__INIT(Clay_LayoutElementHashMapItem) { .elementId = elementId, .layoutElement = layoutElement, .generation = context->generation + 1 });
     hashItem->debugData = Clay__DebugElementDataArray_Add(&context->debugElementData, CLAY__INIT(Clay__DebugElementData) CLAY__DEFAULT_STRUCT);
-    if (hashItemPrevious != -1) {
-        Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, hashItemPrevious)->nextIndex = (int32_t)context->layoutElementsHashMapInternal.length - 1;
-    } else {
-        context->layoutElementsHashMap.internalArray[hashBucket] = (int32_t)context->layoutElementsHashMapInternal.length - 1;
-    }
+    layoutElement->hashMapItem = hashItem;
+    slots[slotIndex] = CLAY__INIT(Clay__LayoutElementHashMapSlot) { .id = elementId.id, .itemIndex = (int32_t)context->layoutElementsHashMapInternal.length - 1 };
     return hashItem;
 }
 
 Clay_LayoutElementHashMapItem *Clay__GetHashMapItem(uint32_t id) {
     Clay_Context* context = Clay_GetCurrentContext();
-    uint32_t hashBucket = id % context->layoutElementsHashMap.capacity;
-    int32_t elementIndex = context->layoutElementsHashMap.internalArray[hashBucket];
-    while (elementIndex != -1) {
-        Clay_LayoutElementHashMapItem *hashEntry = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, elementIndex);
-        if (hashEntry->elementId.id == id) {
-            return hashEntry;
-        }
-        elementIndex = hashEntry->nextIndex;
+    Clay__LayoutElementHashMapSlot *slots = context->layoutElementsHashMap.internalArray;
+    int32_t slotMask = context->layoutElementsHashMap.capacity - 1;
+    int32_t slotIndex = (int32_t)Clay__LayoutElementHashMapSlotIndex(id, context->layoutElementsHashMap.capacity);
+#ifdef CLAY_ENABLE_PROFILING
+    int32_t firstSlotIndex = slotIndex;
+#endif
+    while (slots[slotIndex].itemIndex != -1 && slots[slotIndex].id != id) {
+        slotIndex = (slotIndex + 1) & slotMask;
     }
-    return &Clay_LayoutElementHashMapItem_DEFAULT;
+#ifdef CLAY_ENABLE_PROFILING
+    int32_t probeLength = ((slotIndex - firstSlotIndex) & slotMask) + 1;
+    context->currentFrameStats.hashMapLookupCount++;
+    context->currentFrameStats.hashMapProbeCount += probeLength;
+    context->currentFrameStats.hashMapMaxProbeLength = CLAY__MAX(context->currentFrameStats.hashMapMaxProbeLength, probeLength);
+#endif
+    if (slots[slotIndex].itemIndex == -1) {
+        return &Clay_LayoutElementHashMapItem_DEFAULT;
+    }
+    return &context->layoutElementsHashMapInternal.internalArray[slots[slotIndex].itemIndex];
 }
 
 Clay_ElementId Clay__GenerateIdForAnonymousElement(Clay_LayoutElement *openLayoutElement) {
@@ -1812,94 +3276,115 @@ void Clay__UpdateAspectRatioBox(Clay_LayoutElement *layoutElement) {
     }
 }
 
-void Clay__CloseElement(void) {
-    Clay_Context* context = Clay_GetCurrentContext();
-    if (context->booleanWarnings.maxElementsExceeded) {
-        return;
+// Hashes everything about an element that can influence its own size or the sizes of its descendants, used by incremental layout to detect unchanged subtrees.
+// Visual properties such as colors, corner radius and child alignment are deliberately left out so that changing them doesn't invalidate the cache.
+uint32_t Clay__HashLayoutElement(Clay_LayoutElement *layoutElement, uint32_t seed) {
+    // Elements without their own hash map item (duplicate IDs, or a full hash map) have nowhere to cache their sizes, so they and their ancestors are never cached
+    if (!layoutElement->hashMapItem) {
+        return 0;
     }
-    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
-    Clay_LayoutConfig *layoutConfig = openLayoutElement->layoutConfig;
-    if (!layoutConfig) {
-        openLayoutElement->layoutConfig = &Clay_LayoutConfig_DEFAULT;
-        layoutConfig = &Clay_LayoutConfig_DEFAULT;
+    Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
+    uint32_t hash = Clay__HashLayoutSizingAxis(seed, layoutConfig->sizing.width);
+    hash = Clay__HashLayoutSizingAxis(hash, layoutConfig->sizing.height);
+    hash = Clay__HashMixValue(hash, layoutConfig->padding.left | ((uint32_t)layoutConfig->padding.right << 16));
+    hash = Clay__HashMixValue(hash, layoutConfig->padding.top | ((uint32_t)layoutConfig->padding.bottom << 16));
+    hash = Clay__HashMixValue(hash, layoutConfig->childGap | ((uint32_t)layoutConfig->layoutDirection << 16));
+    hash = Clay__HashMixFloat(hash, layoutElement->dimensions.width);
+    hash = Clay__HashMixFloat(hash, layoutElement->dimensions.height);
+    hash = Clay__HashMixFloat(hash, layoutElement->minDimensions.width);
+    hash = Clay__HashMixFloat(hash, layoutElement->minDimensions.height);
+    bool isTextElement = false;
+    for (int32_t i = 0; i < layoutElement->elementConfigs.length; i++) {
+        Clay_ElementConfig *config = Clay__ElementConfigArraySlice_Get(&layoutElement->elementConfigs, i);
+        switch (config->type) {
+            case CLAY__ELEMENT_CONFIG_TYPE_CLIP: {
+                hash = Clay__HashMixValue(hash, config->type | (config->config.clipElementConfig->horizontal << 8) | (config->config.clipElementConfig->vertical << 9));
+                break;
+            }
+            case CLAY__ELEMENT_CONFIG_TYPE_ASPECT: {
+                hash = Clay__HashMixFloat(Clay__HashMixValue(hash, config->type), config->config.aspectRatioElementConfig->aspectRatio);
+                break;
+            }
+            case CLAY__ELEMENT_CONFIG_TYPE_TEXT: {
+                hash = Clay__HashMixValue(hash, config->type | (config->config.textElementConfig->wrapMode << 8) | ((uint32_t)config->config.textElementConfig->lineHeight << 16));
+                isTextElement = true;
+                break;
+            }
+            default: break;
+        }
     }
-    bool elementHasClipHorizontal = false;
-    bool elementHasClipVertical = false;
-    for (int32_t i = 0; i < openLayoutElement->elementConfigs.length; i++) {
-        Clay_ElementConfig *config = Clay__ElementConfigArraySlice_Get(&openLayoutElement->elementConfigs, i);
-        if (config->type == CLAY__ELEMENT_CONFIG_TYPE_CLIP) {
-            elementHasClipHorizontal = config->config.clipElementConfig->horizontal;
-            elementHasClipVertical = config->config.clipElementConfig->vertical;
-            context->openClipElementStack.length--;
-            break;
-        } else if (config->type == CLAY__ELEMENT_CONFIG_TYPE_FLOATING) {
-            context->openClipElementStack.length--;
+    if (!isTextElement) {
+        for (int32_t i = 0; i < layoutElement->childrenOrTextContent.children.length; i++) {
+            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&Clay_GetCurrentContext()->layoutElements, layoutElement->childrenOrTextContent.children.elements[i]);
+            if (child->layoutHash == 0) {
+                return 0;
+            }
+            hash = Clay__HashMixValue(hash, child->id);
+            hash = Clay__HashMixValue(hash, child->layoutHash);
         }
     }
+    return Clay__HashMixFinish(hash);
+}
 
+// Calculates the size of an element from the sizes of its children, then clamps it to the sizing configured in its layout
+void Clay__CalculateElementFitDimensions(Clay_LayoutElement *layoutElement, bool clipHorizontal, bool clipVertical) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
     float leftRightPadding = (float)(layoutConfig->padding.left + layoutConfig->padding.right);
     float topBottomPadding = (float)(layoutConfig->padding.top + layoutConfig->padding.bottom);
 
-    // Attach children to the current open element
-    openLayoutElement->childrenOrTextContent.children.elements = &context->layoutElementChildren.internalArray[context->layoutElementChildren.length];
     if (layoutConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) {
-        openLayoutElement->dimensions.width = leftRightPadding;
-        openLayoutElement->minDimensions.width = leftRightPadding;
-        for (int32_t i = 0; i < openLayoutElement->childrenOrTextContent.children.length; i++) {
-            int32_t childIndex = Clay__int32_tArray_GetValue(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->childrenOrTextContent.children.length + i);
-            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childIndex);
-            openLayoutElement->dimensions.width += child->dimensions.width;
-            openLayoutElement->dimensions.height = CLAY__MAX(openLayoutElement->dimensions.height, child->dimensions.height + topBottomPadding);
+        layoutElement->dimensions.width = leftRightPadding;
+        layoutElement->minDimensions.width = leftRightPadding;
+        for (int32_t i = 0; i < layoutElement->childrenOrTextContent.children.length; i++) {
+            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->childrenOrTextContent.children.elements[i]);
+            layoutElement->dimensions.width += child->dimensions.width;
+            layoutElement->dimensions.height = CLAY__MAX(layoutElement->dimensions.height, child->dimensions.height + topBottomPadding);
             // Minimum size of child elements doesn't matter to clip containers as they can shrink and hide their contents
-            if (!elementHasClipHorizontal) {
-                openLayoutElement->minDimensions.width += child->minDimensions.width;
+            if (!clipHorizontal) {
+                layoutElement->minDimensions.width += child->minDimensions.width;
             }
-            if (!elementHasClipVertical) {
-                openLayoutElement->minDimensions.height = CLAY__MAX(openLayoutElement->minDimensions.height, child->minDimensions.height + topBottomPadding);
+            if (!clipVertical) {
+                layoutElement->minDimensions.height = CLAY__MAX(layoutElement->minDimensions.height, child->minDimensions.height + topBottomPadding);
             }
-            Clay__int32_tArray_Add(&context->layoutElementChildren, childIndex);
         }
-        float childGap = (float)(CLAY__MAX(openLayoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
-        openLayoutElement->dimensions.width += childGap;
-        if (!elementHasClipHorizontal) {
-            openLayoutElement->minDimensions.width += childGap;
+        float childGap = (float)(CLAY__MAX(layoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+        layoutElement->dimensions.width += childGap;
+        if (!clipHorizontal) {
+            layoutElement->minDimensions.width += childGap;
         }
     }
     else if (layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM) {
-        openLayoutElement->dimensions.height = topBottomPadding;
-        openLayoutElement->minDimensions.height = topBottomPadding;
-        for (int32_t i = 0; i < openLayoutElement->childrenOrTextContent.children.length; i++) {
-            int32_t childIndex = Clay__int32_tArray_GetValue(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->childrenOrTextContent.children.length + i);
-            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childIndex);
-            openLayoutElement->dimensions.height += child->dimensions.height;
-            openLayoutElement->dimensions.width = CLAY__MAX(openLayoutElement->dimensions.width, child->dimensions.width + leftRightPadding);
+        layoutElement->dimensions.height = topBottomPadding;
+        layoutElement->minDimensions.height = topBottomPadding;
+        for (int32_t i = 0; i < layoutElement->childrenOrTextContent.children.length; i++) {
+            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, layoutElement->childrenOrTextContent.children.elements[i]);
+            layoutElement->dimensions.height += child->dimensions.height;
+            layoutElement->dimensions.width = CLAY__MAX(layoutElement->dimensions.width, child->dimensions.width + leftRightPadding);
             // Minimum size of child elements doesn't matter to clip containers as they can shrink and hide their contents
-            if (!elementHasClipVertical) {
-                openLayoutElement->minDimensions.height += child->minDimensions.height;
+            if (!clipVertical) {
+                layoutElement->minDimensions.height += child->minDimensions.height;
             }
-            if (!elementHasClipHorizontal) {
-                openLayoutElement->minDimensions.width = CLAY__MAX(openLayoutElement->minDimensions.width, child->minDimensions.width + leftRightPadding);
+            if (!clipHorizontal) {
+                layoutElement->minDimensions.width = CLAY__MAX(layoutElement->minDimensions.width, child->minDimensions.width + leftRightPadding);
             }
-            Clay__int32_tArray_Add(&context->layoutElementChildren, childIndex);
         }
-        float childGap = (float)(CLAY__MAX(openLayoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
-        openLayoutElement->dimensions.height += childGap;
-        if (!elementHasClipVertical) {
-            openLayoutElement->minDimensions.height += childGap;
+        float childGap = (float)(CLAY__MAX(layoutElement->childrenOrTextContent.children.length - 1, 0) * layoutConfig->childGap);
+        layoutElement->dimensions.height += childGap;
+        if (!clipVertical) {
+            layoutElement->minDimensions.height += childGap;
         }
     }
 
-    context->layoutElementChildrenBuffer.length -= openLayoutElement->childrenOrTextContent.children.length;
-
     // Clamp element min and max width to the values configured in the layout
     if (layoutConfig->sizing.width.type != CLAY__SIZING_TYPE_PERCENT) {
         if (layoutConfig->sizing.width.size.minMax.max <= 0) { // Set the max size if the user didn't specify, makes calculations easier
             layoutConfig->sizing.width.size.minMax.max = CLAY__MAXFLOAT;
         }
-        openLayoutElement->dimensions.width = CLAY__MIN(CLAY__MAX(openLayoutElement->dimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
-        openLayoutElement->minDimensions.width = CLAY__MIN(CLAY__MAX(openLayoutElement->minDimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
+        layoutElement->dimensions.width = CLAY__MIN(CLAY__MAX(layoutElement->dimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
+        layoutElement->minDimensions.width = CLAY__MIN(CLAY__MAX(layoutElement->minDimensions.width, layoutConfig->sizing.width.size.minMax.min), layoutConfig->sizing.width.size.minMax.max);
     } else {
-        openLayoutElement->dimensions.width = 0;
+        layoutElement->dimensions.width = 0;
     }
 
     // Clamp element min and max height to the values configured in the layout
@@ -1907,18 +3392,110 @@ void Clay__CloseElement(void) {
         if (layoutConfig->sizing.height.size.minMax.max <= 0) { // Set the max size if the user didn't specify, makes calculations easier
             layoutConfig->sizing.height.size.minMax.max = CLAY__MAXFLOAT;
         }
-        openLayoutElement->dimensions.height = CLAY__MIN(CLAY__MAX(openLayoutElement->dimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
-        openLayoutElement->minDimensions.height = CLAY__MIN(CLAY__MAX(openLayoutElement->minDimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
+        layoutElement->dimensions.height = CLAY__MIN(CLAY__MAX(layoutElement->dimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
+        layoutElement->minDimensions.height = CLAY__MIN(CLAY__MAX(layoutElement->minDimensions.height, layoutConfig->sizing.height.size.minMax.min), layoutConfig->sizing.height.size.minMax.max);
     } else {
-        openLayoutElement->dimensions.height = 0;
+        layoutElement->dimensions.height = 0;
     }
 
-    Clay__UpdateAspectRatioBox(openLayoutElement);
+    Clay__UpdateAspectRatioBox(layoutElement);
+}
+
+#ifdef CLAY_SOA_LAYOUT
+typedef CLAY_PACKED_ENUM {
+    CLAY__LAYOUT_AXIS_FLAG_RESIZABLE_X = 1,
+    CLAY__LAYOUT_AXIS_FLAG_RESIZABLE_Y = 2,
+    CLAY__LAYOUT_AXIS_FLAG_CLIPS_CHILDREN_X = 4,
+    CLAY__LAYOUT_AXIS_FLAG_CLIPS_CHILDREN_Y = 8,
+    CLAY__LAYOUT_AXIS_FLAG_HAS_CHILD_CONTAINERS = 16,
+} Clay__LayoutAxisFlag;
+
+// Must be called once the element's configs, children and min dimensions are final
+void Clay__StoreLayoutAxisData(Clay_LayoutElement *layoutElement, int32_t elementIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_SizingAxis width = layoutElement->layoutConfig->sizing.width;
+    Clay_SizingAxis height = layoutElement->layoutConfig->sizing.height;
+    bool isText = false;
+    bool wrapsWords = false;
+    bool foundClip = false;
+    uint8_t flags = 0;
+    for (int32_t i = 0; i < layoutElement->elementConfigs.length; ++i) {
+        Clay_ElementConfig *config = &layoutElement->elementConfigs.internalArray[i];
+        if (config->type == CLAY__ELEMENT_CONFIG_TYPE_TEXT && !isText) {
+            isText = true;
+            wrapsWords = config->config.textElementConfig->wrapMode == CLAY_TEXT_WRAP_WORDS;
+        } else if (config->type == CLAY__ELEMENT_CONFIG_TYPE_CLIP && !foundClip) {
+            foundClip = true;
+            flags |= config->config.clipElementConfig->horizontal ? CLAY__LAYOUT_AXIS_FLAG_CLIPS_CHILDREN_X : 0;
+            flags |= config->config.clipElementConfig->vertical ? CLAY__LAYOUT_AXIS_FLAG_CLIPS_CHILDREN_Y : 0;
+        }
+    }
+    if (!isText && layoutElement->childrenOrTextContent.children.length > 0) {
+        flags |= CLAY__LAYOUT_AXIS_FLAG_HAS_CHILD_CONTAINERS;
+    }
+    if (width.type != CLAY__SIZING_TYPE_PERCENT && width.type != CLAY__SIZING_TYPE_FIXED && (!isText || wrapsWords)) {
+        flags |= CLAY__LAYOUT_AXIS_FLAG_RESIZABLE_X;
+    }
+    if (height.type != CLAY__SIZING_TYPE_PERCENT && height.type != CLAY__SIZING_TYPE_FIXED && (!isText || wrapsWords)) {
+        flags |= CLAY__LAYOUT_AXIS_FLAG_RESIZABLE_Y;
+    }
+    context->layoutMinWidths.internalArray[elementIndex] = layoutElement->minDimensions.width;
+    context->layoutMinHeights.internalArray[elementIndex] = layoutElement->minDimensions.height;
+    // Percentage sizing shares storage with min / max, so the percentage is stored in place of the max
+    context->layoutMaxWidths.internalArray[elementIndex] = width.type == CLAY__SIZING_TYPE_PERCENT ? width.size.percent : width.size.minMax.max;
+    context->layoutMaxHeights.internalArray[elementIndex] = height.type == CLAY__SIZING_TYPE_PERCENT ? height.size.percent : height.size.minMax.max;
+    context->layoutWidthSizingTypes.internalArray[elementIndex] = (uint8_t)width.type;
+    context->layoutHeightSizingTypes.internalArray[elementIndex] = (uint8_t)height.type;
+    context->layoutAxisFlags.internalArray[elementIndex] = flags;
+}
+#endif
+
+void Clay__CloseElement(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__CaptureDeclaration(context, CLAY__INIT(Clay_CaptureEvent) { .type = CLAY_CAPTURE_EVENT_CLOSE_ELEMENT });
+    if (context->booleanWarnings.maxElementsExceeded) {
+        return;
+    }
+    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
+    Clay_LayoutConfig *layoutConfig = openLayoutElement->layoutConfig;
+    if (!layoutConfig) {
+        openLayoutElement->layoutConfig = &Clay_LayoutConfig_DEFAULT;
+        layoutConfig = &Clay_LayoutConfig_DEFAULT;
+    }
+    bool elementHasClipHorizontal = false;
+    bool elementHasClipVertical = false;
+    for (int32_t i = 0; i < openLayoutElement->elementConfigs.length; i++) {
+        Clay_ElementConfig *config = Clay__ElementConfigArraySlice_Get(&openLayoutElement->elementConfigs, i);
+        if (config->type == CLAY__ELEMENT_CONFIG_TYPE_CLIP) {
+            elementHasClipHorizontal = config->config.clipElementConfig->horizontal;
+            elementHasClipVertical = config->config.clipElementConfig->vertical;
+            context->openClipElementStack.length--;
+            break;
+        } else if (config->type == CLAY__ELEMENT_CONFIG_TYPE_FLOATING) {
+            context->openClipElementStack.length--;
+        }
+    }
+
+    // Attach children to the current open element
+    openLayoutElement->childrenOrTextContent.children.elements = &context->layoutElementChildren.internalArray[context->layoutElementChildren.length];
+    for (int32_t i = 0; i < openLayoutElement->childrenOrTextContent.children.length; i++) {
+        Clay__int32_tArray_Add(&context->layoutElementChildren, Clay__int32_tArray_GetValue(&context->layoutElementChildrenBuffer, (int)context->layoutElementChildrenBuffer.length - openLayoutElement->childrenOrTextContent.children.length + i));
+    }
+    context->layoutElementChildrenBuffer.length -= openLayoutElement->childrenOrTextContent.children.length;
+
+    Clay__CalculateElementFitDimensions(openLayoutElement, elementHasClipHorizontal, elementHasClipVertical);
+
+    if (context->incrementalLayoutEnabled) {
+        openLayoutElement->layoutHash = Clay__HashLayoutElement(openLayoutElement, 0);
+    }
 
     bool elementIsFloating = Clay__ElementHasConfig(openLayoutElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING);
 
     // Close the currently open element
     int32_t closingElementIndex = Clay__int32_tArray_RemoveSwapback(&context->openLayoutElementStack, (int)context->openLayoutElementStack.length - 1);
+#ifdef CLAY_SOA_LAYOUT
+    Clay__StoreLayoutAxisData(openLayoutElement, closingElementIndex);
+#endif
 
     // Get the currently open parent
     openLayoutElement = Clay__GetOpenLayoutElement();
@@ -2000,6 +3577,7 @@ bool Clay__MemCmp(const char *s1, const char *s2, int32_t length);
 
 void Clay__OpenElement(void) {
     Clay_Context* context = Clay_GetCurrentContext();
+    Clay__CaptureDeclaration(context, CLAY__INIT(Clay_CaptureEvent) { .type = CLAY_CAPTURE_EVENT_OPEN_ELEMENT });
     if (context->layoutElements.length == context->layoutElements.capacity - 1 || context->booleanWarnings.maxElementsExceeded) {
         context->booleanWarnings.maxElementsExceeded = true;
         return;
@@ -2017,6 +3595,7 @@ void Clay__OpenElement(void) {
 
 void Clay__OpenElementWithId(Clay_ElementId elementId) {
     Clay_Context* context = Clay_GetCurrentContext();
+    Clay__CaptureDeclaration(context, CLAY__INIT(Clay_CaptureEvent) { .type = CLAY_CAPTURE_EVENT_OPEN_ELEMENT, .elementId = elementId });
     if (context->layoutElements.length == context->layoutElements.capacity - 1 || context->booleanWarnings.maxElementsExceeded) {
         context->booleanWarnings.maxElementsExceeded = true;
         return;
@@ -2036,7 +3615,13 @@ void Clay__OpenElementWithId(Clay_ElementId elementId) {
 
 void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig) {
     Clay_Context* context = Clay_GetCurrentContext();
-    if (context->layoutElements.length == context->layoutElements.capacity - 1 || context->booleanWarnings.maxElementsExceeded) {
+    Clay__CaptureDeclaration(context, CLAY__INIT(Clay_CaptureEvent) {
+        .type = CLAY_CAPTURE_EVENT_TEXT_ELEMENT,
+        .textIsStaticallyAllocated = text.isStaticallyAllocated,
+        .text = { .length = text.length, .chars = text.chars, .baseChars = text.chars },
+        .textConfig = textConfig
+    });
+    if (context->layoutElements.length == context->layoutElements.capacity - 1 || Clay__CapacityExceeded(context->textElementData.length, context->textElementData.capacity)) {
         context->booleanWarnings.maxElementsExceeded = true;
         return;
     }
@@ -2052,6 +3637,13 @@ void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig)
 
     Clay__int32_tArray_Add(&context->layoutElementChildrenBuffer, context->layoutElements.length - 1);
     Clay__MeasureTextCacheItem *textMeasured = Clay__MeasureTextCached(&text, textConfig);
+    // The element is declared with a size that will still change, which the enclosing CLAY_CACHED blocks mustn't record.
+    // This includes items queued earlier in the frame, which are cache hits rather than new misses.
+    if (textMeasured->measurementPending || textMeasured->measurementQueued) {
+        for (int32_t i = 0; i < context->openCachedSubtrees.length; i++) {
+            context->openCachedSubtrees.internalArray[i].textPending = true;
+        }
+    }
     Clay_ElementId elementId = Clay__HashNumber(parentElement->childrenOrTextContent.children.length + parentElement->floatingChildrenCount, parentElement->id);
     textElement->id = elementId.id;
     Clay__AddHashMapItem(elementId, textElement);
@@ -2065,11 +3657,86 @@ void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig)
             .internalArray = Clay__ElementConfigArray_Add(&context->elementConfigs, CLAY__INIT(Clay_ElementConfig) { .type = CLAY__ELEMENT_CONFIG_TYPE_TEXT, .config = { .textElementConfig = textConfig }})
     };
     textElement->layoutConfig = &CLAY_LAYOUT_DEFAULT;
+    if (context->incrementalLayoutEnabled) {
+        // The measure cache id already covers the text contents, font, size and letter spacing. Placeholders hash differently so that their sizes aren't reused once measured.
+        uint32_t textHash = textMeasured != &Clay__MeasureTextCacheItem_DEFAULT ? textMeasured->id + textMeasured->measurementPending : Clay__HashStringContentsWithConfig(&text, textConfig);
+        textElement->layoutHash = Clay__HashLayoutElement(textElement, textHash);
+    }
+#ifdef CLAY_SOA_LAYOUT
+    Clay__StoreLayoutAxisData(textElement, context->layoutElements.length - 1);
+#endif
     parentElement->childrenOrTextContent.children.length++;
 }
 
+// Text that was batch measured had no size yet when its element was declared, so update the text elements with their measured
+// sizes and then recalculate the sizes of all other elements from their children. Children always come after their parents in
+// the layout element array, so iterating backwards visits every child before its parent.
+// Only elements from firstElementIndex onwards are updated, which must all be closed.
+void Clay__UpdateDimensionsAfterTextMeasurement(int32_t firstElementIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (int32_t i = context->textElementData.length - 1; i >= 0 && context->textElementData.internalArray[i].elementIndex >= firstElementIndex; --i) {
+        Clay__TextElementData *textElementData = &context->textElementData.internalArray[i];
+        Clay_LayoutElement *textElement = Clay_LayoutElementArray_Get(&context->layoutElements, textElementData->elementIndex);
+        Clay_TextElementConfig *textConfig = Clay__FindElementConfigWithType(textElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig;
+        Clay__MeasureTextCacheItem *textMeasured = Clay__MeasureTextCached(&textElementData->text, textConfig);
+        Clay_Dimensions textDimensions = { .width = textMeasured->unwrappedDimensions.width, .height = textConfig->lineHeight > 0 ? (float)textConfig->lineHeight : textMeasured->unwrappedDimensions.height };
+        textElement->dimensions = textDimensions;
+        textElement->minDimensions = CLAY__INIT(Clay_Dimensions) { .width = textMeasured->minWidth, .height = textDimensions.height };
+        textElementData->preferredDimensions = textMeasured->unwrappedDimensions;
+        if (context->incrementalLayoutEnabled) {
+            uint32_t textHash = textMeasured != &Clay__MeasureTextCacheItem_DEFAULT ? textMeasured->id + textMeasured->measurementPending : Clay__HashStringContentsWithConfig(&textElementData->text, textConfig);
+            textElement->layoutHash = Clay__HashLayoutElement(textElement, textHash);
+        }
+#ifdef CLAY_SOA_LAYOUT
+        Clay__StoreLayoutAxisData(textElement, textElementData->elementIndex);
+#endif
+    }
+    for (int32_t i = context->layoutElements.length - 1; i >= firstElementIndex; --i) {
+        Clay_LayoutElement *layoutElement = &context->layoutElements.internalArray[i];
+        if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+            continue;
+        }
+        Clay_ClipElementConfig *clipConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_CLIP).clipElementConfig;
+        Clay__CalculateElementFitDimensions(layoutElement, clipConfig && clipConfig->horizontal, clipConfig && clipConfig->vertical);
+        if (context->incrementalLayoutEnabled) {
+            layoutElement->layoutHash = Clay__HashLayoutElement(layoutElement, 0);
+        }
+#ifdef CLAY_SOA_LAYOUT
+        Clay__StoreLayoutAxisData(layoutElement, i);
+#endif
+    }
+    if (firstElementIndex == 0) {
+        context->textMeasurementBatchResolved = false;
+    }
+}
+
+// Retrieve or create cached data to track scroll position across frames
+void Clay__OpenScrollContainerData(Clay_LayoutElement *layoutElement) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__ScrollContainerDataInternal *scrollOffset = CLAY__NULL;
+    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
+        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
+        if (layoutElement->id == mapping->elementId) {
+            scrollOffset = mapping;
+            scrollOffset->layoutElement = layoutElement;
+            scrollOffset->openThisFrame = true;
+        }
+    }
+    if (!scrollOffset) {
+        scrollOffset = Clay__ScrollContainerDataInternalArray_Add(&context->scrollContainerDatas, CLAY__INIT(Clay__ScrollContainerDataInternal){.layoutElement = layoutElement, .scrollOrigin = {-1,-1}, .elementId = layoutElement->id, .openThisFrame = true});
+    }
+    if (context->externalScrollHandlingEnabled) {
+        #ifdef CLAY_WASM
+        scrollOffset->scrollPosition = Clay__QueryScrollOffset(scrollOffset->elementId, context->queryScrollOffsetUserData);
+        #else
+        scrollOffset->scrollPosition = context->queryScrollOffsetFunction(scrollOffset->elementId, context->queryScrollOffsetUserData);
+        #endif
+    }
+}
+
 void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration *declaration) {
     Clay_Context* context = Clay_GetCurrentContext();
+    Clay__CaptureDeclaration(context, CLAY__INIT(Clay_CaptureEvent) { .type = CLAY_CAPTURE_EVENT_CONFIGURE_ELEMENT, .declaration = declaration });
     Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
     openLayoutElement->layoutConfig = Clay__StoreLayoutConfig(declaration->layout);
     if ((declaration->layout.sizing.width.type == CLAY__SIZING_TYPE_PERCENT && declaration->layout.sizing.width.size.percent > 1) || (declaration->layout.sizing.height.type == CLAY__SIZING_TYPE_PERCENT && declaration->layout.sizing.height.size.percent > 1)) {
@@ -2106,7 +3773,10 @@ void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration *declaration) {
     }
     if (declaration->aspectRatio.aspectRatio > 0) {
         Clay__AttachElementConfig(CLAY__INIT(Clay_ElementConfigUnion) { .aspectRatioElementConfig = Clay__StoreAspectRatioElementConfig(declaration->aspectRatio) }, CLAY__ELEMENT_CONFIG_TYPE_ASPECT);
-        Clay__int32_tArray_Add(&context->aspectRatioElementIndexes, context->layoutElements.length - 1);
+        // Shares the capacity of aspect ratio configs, so only fails if storing the config already did
+        if (!context->booleanWarnings.maxElementsExceeded) {
+            Clay__int32_tArray_Add(&context->aspectRatioElementIndexes, context->layoutElements.length - 1);
+        }
     }
     if (declaration->floating.attachTo != CLAY_ATTACH_TO_NONE) {
         Clay_FloatingElementConfig floatingConfig = declaration->floating;
@@ -2139,13 +3809,16 @@ void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration *declaration) {
             int32_t currentElementIndex = Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 1);
             Clay__int32_tArray_Set(&context->layoutElementClipElementIds, currentElementIndex, clipElementId);
             Clay__int32_tArray_Add(&context->openClipElementStack, clipElementId);
-            Clay__LayoutElementTreeRootArray_Add(&context->layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) {
-                    .layoutElementIndex = Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 1),
-                    .parentId = floatingConfig.parentId,
-                    .clipElementId = clipElementId,
-                    .zIndex = floatingConfig.zIndex,
-            });
             Clay__AttachElementConfig(CLAY__INIT(Clay_ElementConfigUnion) { .floatingElementConfig = Clay__StoreFloatingElementConfig(floatingConfig) }, CLAY__ELEMENT_CONFIG_TYPE_FLOATING);
+            // Has room for one more than the floating configs, for the root, so only fails if storing the config already did
+            if (!context->booleanWarnings.maxElementsExceeded) {
+                Clay__LayoutElementTreeRootArray_Add(&context->layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) {
+                        .layoutElementIndex = Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 1),
+                        .parentId = floatingConfig.parentId,
+                        .clipElementId = clipElementId,
+                        .zIndex = floatingConfig.zIndex,
+                });
+            }
         }
     }
     if (declaration->custom.customData) {
@@ -2155,22 +3828,7 @@ void Clay__ConfigureOpenElementPtr(const Clay_ElementDeclaration *declaration) {
     if (declaration->clip.horizontal | declaration->clip.vertical) {
         Clay__AttachElementConfig(CLAY__INIT(Clay_ElementConfigUnion) { .clipElementConfig = Clay__StoreClipElementConfig(declaration->clip) }, CLAY__ELEMENT_CONFIG_TYPE_CLIP);
         Clay__int32_tArray_Add(&context->openClipElementStack, (int)openLayoutElement->id);
-        // Retrieve or create cached data to track scroll position across frames
-        Clay__ScrollContainerDataInternal *scrollOffset = CLAY__NULL;
-        for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
-            Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
-            if (openLayoutElement->id == mapping->elementId) {
-                scrollOffset = mapping;
-                scrollOffset->layoutElement = openLayoutElement;
-                scrollOffset->openThisFrame = true;
-            }
-        }
-        if (!scrollOffset) {
-            scrollOffset = Clay__ScrollContainerDataInternalArray_Add(&context->scrollContainerDatas, CLAY__INIT(Clay__ScrollContainerDataInternal){.layoutElement = openLayoutElement, .scrollOrigin = {-1,-1}, .elementId = openLayoutElement->id, .openThisFrame = true});
-        }
-        if (context->externalScrollHandlingEnabled) {
-            scrollOffset->scrollPosition = Clay__QueryScrollOffset(scrollOffset->elementId, context->queryScrollOffsetUserData);
-        }
+        Clay__OpenScrollContainerData(openLayoutElement);
     }
     if (!Clay__MemCmp((char *)(&declaration->border.width), (char *)(&Clay__BorderWidth_DEFAULT), sizeof(Clay_BorderWidth))) {
         Clay__AttachElementConfig(CLAY__INIT(Clay_ElementConfigUnion) { .borderElementConfig = Clay__StoreBorderElementConfig(declaration->border) }, CLAY__ELEMENT_CONFIG_TYPE_BORDER);
@@ -2181,8 +3839,264 @@ void Clay__ConfigureOpenElement(const Clay_ElementDeclaration declaration) {
     Clay__ConfigureOpenElementPtr(&declaration);
 }
 
+#define CLAY__CACHED_ARRAY_VIEW(array) CLAY__INIT(Clay__CachedArrayView) { .length = &(array).length, .capacity = (array).capacity, .internalArray = (char *)(array).internalArray, .itemSize = (int32_t)sizeof(*(array).internalArray) }
+
+void Clay__GetCachedArrayViews(Clay_Context *context, Clay__CachedArrayView *views) {
+    views[CLAY__CACHED_ARRAY_LAYOUT_ELEMENTS] = CLAY__CACHED_ARRAY_VIEW(context->layoutElements);
+    views[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN] = CLAY__CACHED_ARRAY_VIEW(context->layoutElementChildren);
+    views[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN_BUFFER] = CLAY__CACHED_ARRAY_VIEW(context->layoutElementChildrenBuffer);
+    views[CLAY__CACHED_ARRAY_TEXT_ELEMENT_DATA] = CLAY__CACHED_ARRAY_VIEW(context->textElementData);
+    views[CLAY__CACHED_ARRAY_ASPECT_RATIO_ELEMENT_INDEXES] = CLAY__CACHED_ARRAY_VIEW(context->aspectRatioElementIndexes);
+    views[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_TREE_ROOTS] = CLAY__CACHED_ARRAY_VIEW(context->layoutElementTreeRoots);
+    views[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_ID_STRINGS] = CLAY__CACHED_ARRAY_VIEW(context->layoutElementIdStrings);
+    views[CLAY__CACHED_ARRAY_LAYOUT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->layoutConfigs);
+    views[CLAY__CACHED_ARRAY_ELEMENT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->elementConfigs);
+    views[CLAY__CACHED_ARRAY_TEXT_ELEMENT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->textElementConfigs);
+    views[CLAY__CACHED_ARRAY_ASPECT_RATIO_ELEMENT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->aspectRatioElementConfigs);
+    views[CLAY__CACHED_ARRAY_IMAGE_ELEMENT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->imageElementConfigs);
+    views[CLAY__CACHED_ARRAY_FLOATING_ELEMENT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->floatingElementConfigs);
+    views[CLAY__CACHED_ARRAY_CLIP_ELEMENT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->clipElementConfigs);
+    views[CLAY__CACHED_ARRAY_CUSTOM_ELEMENT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->customElementConfigs);
+    views[CLAY__CACHED_ARRAY_BORDER_ELEMENT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->borderElementConfigs);
+    views[CLAY__CACHED_ARRAY_SHARED_ELEMENT_CONFIGS] = CLAY__CACHED_ARRAY_VIEW(context->sharedElementConfigs);
+}
+
+#undef CLAY__CACHED_ARRAY_VIEW
+
+// Returns the item in the replayed copy of an array that corresponds to a pointer into the recorded items of that array.
+// Pointers that didn't point into the recorded items, such as those to default configs, are returned unchanged.
+void *Clay__RebaseCachedPointer(const Clay__CachedSubtree *subtree, const Clay__CachedArrayView *views, const int32_t *replayStarts, int32_t arrayIndex, void *pointer) {
+    int32_t itemSize = views[arrayIndex].itemSize;
+    char *recordedStart = subtree->arrayBases[arrayIndex] + subtree->arrayStarts[arrayIndex] * itemSize;
+    char *recordedEnd = recordedStart + subtree->arrayCounts[arrayIndex] * itemSize;
+    if ((char *)pointer < recordedStart || (char *)pointer > recordedEnd) { // Empty slices point to the end of the recorded items
+        return pointer;
+    }
+    return views[arrayIndex].internalArray + replayStarts[arrayIndex] * itemSize + ((char *)pointer - recordedStart);
+}
+
+// Appends the recorded declarations of a CLAY_CACHED block to the end of the current layout, as if the block had been declared again.
+// Returns false without changing anything if there isn't enough capacity left to replay the block.
+bool Clay__ReplayCachedSubtree(const Clay__CachedSubtree *subtree, const Clay__charArray *data) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__CachedArrayView views[CLAY__CACHED_ARRAY_COUNT];
+    Clay__GetCachedArrayViews(context, views);
+    for (int32_t i = 0; i < CLAY__CACHED_ARRAY_COUNT; i++) {
+        if (*views[i].length + subtree->arrayCounts[i] >= views[i].capacity) {
+            return false;
+        }
+    }
+    int32_t replayStarts[CLAY__CACHED_ARRAY_COUNT];
+    const char *source = data->internalArray + subtree->dataOffset;
+    for (int32_t i = 0; i < CLAY__CACHED_ARRAY_COUNT; i++) {
+        int32_t size = subtree->arrayCounts[i] * views[i].itemSize;
+        replayStarts[i] = *views[i].length;
+        Clay__CopyMemory(views[i].internalArray + replayStarts[i] * views[i].itemSize, source, size);
+        *views[i].length += subtree->arrayCounts[i];
+        source += size;
+    }
+
+    for (int32_t i = 0; i < subtree->arrayCounts[CLAY__CACHED_ARRAY_ELEMENT_CONFIGS]; i++) {
+        Clay_ElementConfig *config = &context->elementConfigs.internalArray[replayStarts[CLAY__CACHED_ARRAY_ELEMENT_CONFIGS] + i];
+        switch (config->type) {
+            case CLAY__ELEMENT_CONFIG_TYPE_BORDER: config->config.borderElementConfig = (Clay_BorderElementConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_BORDER_ELEMENT_CONFIGS, config->config.borderElementConfig); break;
+            case CLAY__ELEMENT_CONFIG_TYPE_FLOATING: config->config.floatingElementConfig = (Clay_FloatingElementConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_FLOATING_ELEMENT_CONFIGS, config->config.floatingElementConfig); break;
+            case CLAY__ELEMENT_CONFIG_TYPE_CLIP: config->config.clipElementConfig = (Clay_ClipElementConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_CLIP_ELEMENT_CONFIGS, config->config.clipElementConfig); break;
+            case CLAY__ELEMENT_CONFIG_TYPE_ASPECT: config->config.aspectRatioElementConfig = (Clay_AspectRatioElementConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_ASPECT_RATIO_ELEMENT_CONFIGS, config->config.aspectRatioElementConfig); break;
+            case CLAY__ELEMENT_CONFIG_TYPE_IMAGE: config->config.imageElementConfig = (Clay_ImageElementConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_IMAGE_ELEMENT_CONFIGS, config->config.imageElementConfig); break;
+            case CLAY__ELEMENT_CONFIG_TYPE_TEXT: config->config.textElementConfig = (Clay_TextElementConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_TEXT_ELEMENT_CONFIGS, config->config.textElementConfig); break;
+            case CLAY__ELEMENT_CONFIG_TYPE_CUSTOM: config->config.customElementConfig = (Clay_CustomElementConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_CUSTOM_ELEMENT_CONFIGS, config->config.customElementConfig); break;
+            case CLAY__ELEMENT_CONFIG_TYPE_SHARED: config->config.sharedElementConfig = (Clay_SharedElementConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_SHARED_ELEMENT_CONFIGS, config->config.sharedElementConfig); break;
+            default: break;
+        }
+    }
+
+    // Element indexes are offset by the difference in where the block's elements started
+    int32_t elementCount = subtree->arrayCounts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENTS];
+    int32_t elementsStart = replayStarts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENTS];
+    int32_t elementIndexOffset = elementsStart - subtree->arrayStarts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENTS];
+    for (int32_t i = 0; i < subtree->arrayCounts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN]; i++) {
+        context->layoutElementChildren.internalArray[replayStarts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN] + i] += elementIndexOffset;
+    }
+    for (int32_t i = 0; i < subtree->arrayCounts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN_BUFFER]; i++) {
+        context->layoutElementChildrenBuffer.internalArray[replayStarts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN_BUFFER] + i] += elementIndexOffset;
+    }
+    for (int32_t i = 0; i < subtree->arrayCounts[CLAY__CACHED_ARRAY_TEXT_ELEMENT_DATA]; i++) {
+        context->textElementData.internalArray[replayStarts[CLAY__CACHED_ARRAY_TEXT_ELEMENT_DATA] + i].elementIndex += elementIndexOffset;
+    }
+    for (int32_t i = 0; i < subtree->arrayCounts[CLAY__CACHED_ARRAY_ASPECT_RATIO_ELEMENT_INDEXES]; i++) {
+        context->aspectRatioElementIndexes.internalArray[replayStarts[CLAY__CACHED_ARRAY_ASPECT_RATIO_ELEMENT_INDEXES] + i] += elementIndexOffset;
+    }
+    for (int32_t i = 0; i < subtree->arrayCounts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_TREE_ROOTS]; i++) {
+        context->layoutElementTreeRoots.internalArray[replayStarts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_TREE_ROOTS] + i].layoutElementIndex += elementIndexOffset;
+    }
+
+    for (int32_t i = 0; i < elementCount; i++) {
+        Clay_LayoutElement *layoutElement = &context->layoutElements.internalArray[elementsStart + i];
+        layoutElement->layoutConfig = (Clay_LayoutConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_LAYOUT_CONFIGS, layoutElement->layoutConfig);
+        layoutElement->elementConfigs.internalArray = (Clay_ElementConfig *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_ELEMENT_CONFIGS, layoutElement->elementConfigs.internalArray);
+        if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+            layoutElement->childrenOrTextContent.textElementData = (Clay__TextElementData *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_TEXT_ELEMENT_DATA, layoutElement->childrenOrTextContent.textElementData);
+        } else {
+            layoutElement->childrenOrTextContent.children.elements = (int32_t *)Clay__RebaseCachedPointer(subtree, views, replayStarts, CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN, layoutElement->childrenOrTextContent.children.elements);
+        }
+        int32_t clipElementId;
+        Clay__CopyMemory((char *)&clipElementId, source, (int32_t)sizeof(int32_t));
+        source += sizeof(int32_t);
+        Clay__int32_tArray_Set(&context->layoutElementClipElementIds, elementsStart + i, clipElementId);
+    }
+    // Re-register the elements so that they can be found by ID, and take part in scrolling and pointer handling as normal
+    for (int32_t i = 0; i < elementCount; i++) {
+        Clay_LayoutElement *layoutElement = &context->layoutElements.internalArray[elementsStart + i];
+        Clay_ElementId elementId;
+        Clay__CopyMemory((char *)&elementId, source, (int32_t)sizeof(Clay_ElementId));
+        source += sizeof(Clay_ElementId);
+        Clay__CachedHoverHandler hoverHandler;
+        Clay__CopyMemory((char *)&hoverHandler, source, (int32_t)sizeof(Clay__CachedHoverHandler));
+        source += sizeof(Clay__CachedHoverHandler);
+        layoutElement->hashMapItem = NULL;
+        Clay_LayoutElementHashMapItem *hashMapItem = Clay__AddHashMapItem(elementId, layoutElement);
+        if (hashMapItem && hashMapItem->layoutElement == layoutElement) {
+            hashMapItem->onHoverFunction = hoverHandler.onHoverFunction;
+            hashMapItem->hoverFunctionUserData = hoverHandler.hoverFunctionUserData;
+        }
+        if (Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_CLIP)) {
+            Clay__OpenScrollContainerData(layoutElement);
+        }
+#ifdef CLAY_SOA_LAYOUT
+        Clay__StoreLayoutAxisData(layoutElement, elementsStart + i);
+#endif
+    }
+
+    Clay_LayoutElement *parentElement = Clay__GetOpenLayoutElement();
+    parentElement->childrenOrTextContent.children.length = (uint16_t)(parentElement->childrenOrTextContent.children.length + subtree->arrayCounts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENT_CHILDREN_BUFFER]);
+    parentElement->floatingChildrenCount = (uint16_t)(parentElement->floatingChildrenCount + subtree->floatingChildCount);
+    return true;
+}
+
+// Copies a recorded block and its array items to the end of the blocks that will be available to replay next frame
+void Clay__RetainCachedSubtree(Clay__CachedSubtree subtree, const char *source) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->cachedSubtrees.length == context->cachedSubtrees.capacity || context->cachedSubtreeData.length + subtree.dataSize > context->cachedSubtreeData.capacity) {
+        return;
+    }
+    Clay__CopyMemory(context->cachedSubtreeData.internalArray + context->cachedSubtreeData.length, source, subtree.dataSize);
+    subtree.dataOffset = context->cachedSubtreeData.length;
+    context->cachedSubtreeData.length += subtree.dataSize;
+    Clay__CachedSubtreeArray_Add(&context->cachedSubtrees, subtree);
+}
+
+bool Clay__BeginCachedSubtree(Clay_ElementId id, uint32_t stateHash) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElement *parentElement = Clay__GetOpenLayoutElement();
+    // Anonymous element IDs depend on the parent ID and the position within it, so the block is only replayed in the same place
+    uint32_t childOffset = (uint32_t)(parentElement->childrenOrTextContent.children.length + parentElement->floatingChildrenCount);
+    // While capturing, blocks are declared in full so that their declarations are captured
+    if (!context->booleanWarnings.maxElementsExceeded && !context->captureFunction) {
+        for (int32_t i = 0; i < context->previousCachedSubtrees.length; i++) {
+            Clay__CachedSubtree *subtree = &context->previousCachedSubtrees.internalArray[i];
+            if (subtree->id == id.id && subtree->stateHash == stateHash && subtree->parentId == parentElement->id && subtree->childOffset == childOffset) {
+                if (Clay__ReplayCachedSubtree(subtree, &context->previousCachedSubtreeData)) {
+                    Clay__RetainCachedSubtree(*subtree, context->previousCachedSubtreeData.internalArray + subtree->dataOffset);
+                    return false;
+                }
+                break;
+            }
+        }
+    }
+    context->openCachedSubtreeDepth++;
+    if (context->openCachedSubtrees.length < context->openCachedSubtrees.capacity) {
+        Clay__OpenCachedSubtree openSubtree = {
+            .subtree = { .id = id.id, .stateHash = stateHash, .parentId = parentElement->id, .childOffset = childOffset },
+            .parentFloatingChildrenCount = parentElement->floatingChildrenCount,
+        };
+        Clay__CachedArrayView views[CLAY__CACHED_ARRAY_COUNT];
+        Clay__GetCachedArrayViews(context, views);
+        for (int32_t i = 0; i < CLAY__CACHED_ARRAY_COUNT; i++) {
+            openSubtree.subtree.arrayStarts[i] = *views[i].length;
+        }
+        Clay__OpenCachedSubtreeArray_Add(&context->openCachedSubtrees, openSubtree);
+    }
+    return true;
+}
+
+void Clay__EndCachedSubtree(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->openCachedSubtreeDepth--;
+    if (context->openCachedSubtreeDepth >= context->openCachedSubtrees.length) {
+        return;
+    }
+    Clay__OpenCachedSubtree openSubtree = Clay__OpenCachedSubtreeArray_RemoveSwapback(&context->openCachedSubtrees, context->openCachedSubtrees.length - 1);
+    Clay__CachedSubtree subtree = openSubtree.subtree;
+    Clay_LayoutElement *parentElement = Clay__GetOpenLayoutElement();
+    if (context->booleanWarnings.maxElementsExceeded || parentElement->id != subtree.parentId) {
+        return;
+    }
+    // Text waiting for a batch measurement or a prefetch doesn't have its final size yet, so the block can't be recorded until a later frame
+    if (openSubtree.textPending) {
+        return;
+    }
+    Clay__CachedArrayView views[CLAY__CACHED_ARRAY_COUNT];
+    Clay__GetCachedArrayViews(context, views);
+    subtree.dataSize = 0;
+    for (int32_t i = 0; i < CLAY__CACHED_ARRAY_COUNT; i++) {
+        subtree.arrayBases[i] = views[i].internalArray;
+        subtree.arrayCounts[i] = *views[i].length - subtree.arrayStarts[i];
+        subtree.dataSize += subtree.arrayCounts[i] * views[i].itemSize;
+    }
+    int32_t elementCount = subtree.arrayCounts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENTS];
+    int32_t elementsStart = subtree.arrayStarts[CLAY__CACHED_ARRAY_LAYOUT_ELEMENTS];
+    subtree.dataSize += elementCount * (int32_t)(sizeof(int32_t) + sizeof(Clay_ElementId) + sizeof(Clay__CachedHoverHandler));
+    subtree.floatingChildCount = parentElement->floatingChildrenCount - openSubtree.parentFloatingChildrenCount;
+    if (context->cachedSubtrees.length == context->cachedSubtrees.capacity || context->cachedSubtreeData.length + subtree.dataSize > context->cachedSubtreeData.capacity) {
+        return;
+    }
+
+    subtree.dataOffset = context->cachedSubtreeData.length;
+    char *destination = context->cachedSubtreeData.internalArray + subtree.dataOffset;
+    for (int32_t i = 0; i < CLAY__CACHED_ARRAY_COUNT; i++) {
+        int32_t size = subtree.arrayCounts[i] * views[i].itemSize;
+        Clay__CopyMemory(destination, views[i].internalArray + subtree.arrayStarts[i] * views[i].itemSize, size);
+        destination += size;
+    }
+    Clay__CopyMemory(destination, (char *)&context->layoutElementClipElementIds.internalArray[elementsStart], elementCount * (int32_t)sizeof(int32_t));
+    destination += elementCount * (int32_t)sizeof(int32_t);
+    for (int32_t i = 0; i < elementCount; i++) {
+        Clay_LayoutElement *layoutElement = &context->layoutElements.internalArray[elementsStart + i];
+        Clay_ElementId elementId = layoutElement->hashMapItem ? layoutElement->hashMapItem->elementId : CLAY__INIT(Clay_ElementId) { .id = layoutElement->id };
+        Clay__CopyMemory(destination, (char *)&elementId, (int32_t)sizeof(Clay_ElementId));
+        destination += sizeof(Clay_ElementId);
+        Clay__CachedHoverHandler hoverHandler = CLAY__DEFAULT_STRUCT;
+        if (layoutElement->hashMapItem) {
+            hoverHandler.onHoverFunction = layoutElement->hashMapItem->onHoverFunction;
+            hoverHandler.hoverFunctionUserData = layoutElement->hashMapItem->hoverFunctionUserData;
+        }
+        Clay__CopyMemory(destination, (char *)&hoverHandler, (int32_t)sizeof(Clay__CachedHoverHandler));
+        destination += sizeof(Clay__CachedHoverHandler);
+    }
+    context->cachedSubtreeData.length += subtree.dataSize;
+    Clay__CachedSubtreeArray_Add(&context->cachedSubtrees, subtree);
+}
+
+// Fills in the capacities that weren't set with Clay_SetCapacities()
+Clay_CapacityConfig Clay__ResolveCapacities(Clay_Context* context) {
+    Clay_CapacityConfig capacities = context->capacities;
+    // Points are queried a few at a time rather than once per element, so they have a small default of their own
+    if (capacities.pointQueries <= 0) {
+        capacities.pointQueries = Clay__defaultPointQueryCount;
+    }
+    int32_t *fields = (int32_t *)&capacities;
+    for (int32_t i = 0; i < (int32_t)(sizeof(Clay_CapacityConfig) / sizeof(int32_t)); ++i) {
+        if (fields[i] <= 0) {
+            fields[i] = context->maxElementCount;
+        }
+    }
+    return capacities;
+}
+
 void Clay__InitializeEphemeralMemory(Clay_Context* context) {
     int32_t maxElementCount = context->maxElementCount;
+    Clay_CapacityConfig capacities = Clay__ResolveCapacities(context);
     // Ephemeral Memory - reset every frame
     Clay_Arena *arena = &context->internalArena;
     arena->nextAllocation = context->arenaResetOffset;
@@ -2193,48 +4107,105 @@ void Clay__InitializeEphemeralMemory(Clay_Context* context) {
 
     context->layoutConfigs = Clay__LayoutConfigArray_Allocate_Arena(maxElementCount, arena);
     context->elementConfigs = Clay__ElementConfigArray_Allocate_Arena(maxElementCount, arena);
-    context->textElementConfigs = Clay__TextElementConfigArray_Allocate_Arena(maxElementCount, arena);
-    context->aspectRatioElementConfigs = Clay__AspectRatioElementConfigArray_Allocate_Arena(maxElementCount, arena);
-    context->imageElementConfigs = Clay__ImageElementConfigArray_Allocate_Arena(maxElementCount, arena);
-    context->floatingElementConfigs = Clay__FloatingElementConfigArray_Allocate_Arena(maxElementCount, arena);
-    context->clipElementConfigs = Clay__ClipElementConfigArray_Allocate_Arena(maxElementCount, arena);
-    context->customElementConfigs = Clay__CustomElementConfigArray_Allocate_Arena(maxElementCount, arena);
-    context->borderElementConfigs = Clay__BorderElementConfigArray_Allocate_Arena(maxElementCount, arena);
-    context->sharedElementConfigs = Clay__SharedElementConfigArray_Allocate_Arena(maxElementCount, arena);
+    context->textElementConfigs = Clay__TextElementConfigArray_Allocate_Arena(capacities.textElements, arena);
+    context->aspectRatioElementConfigs = Clay__AspectRatioElementConfigArray_Allocate_Arena(capacities.aspectRatioElements, arena);
+    context->imageElementConfigs = Clay__ImageElementConfigArray_Allocate_Arena(capacities.imageElements, arena);
+    context->floatingElementConfigs = Clay__FloatingElementConfigArray_Allocate_Arena(capacities.floatingElements, arena);
+    context->clipElementConfigs = Clay__ClipElementConfigArray_Allocate_Arena(capacities.clipElements, arena);
+    context->customElementConfigs = Clay__CustomElementConfigArray_Allocate_Arena(capacities.customElements, arena);
+    context->borderElementConfigs = Clay__BorderElementConfigArray_Allocate_Arena(capacities.borderElements, arena);
+    context->sharedElementConfigs = Clay__SharedElementConfigArray_Allocate_Arena(capacities.sharedElements, arena);
 
     context->layoutElementIdStrings = Clay__StringArray_Allocate_Arena(maxElementCount, arena);
-    context->wrappedTextLines = Clay__WrappedTextLineArray_Allocate_Arena(maxElementCount, arena);
+    context->wrappedTextLines = Clay__WrappedTextLineArray_Allocate_Arena(capacities.wrappedTextLines, arena);
     context->layoutElementTreeNodeArray1 = Clay__LayoutElementTreeNodeArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementTreeRoots = Clay__LayoutElementTreeRootArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementTreeRoots = Clay__LayoutElementTreeRootArray_Allocate_Arena(capacities.floatingElements + 1, arena);
     context->layoutElementChildren = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->openLayoutElementStack = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->textElementData = Clay__TextElementDataArray_Allocate_Arena(maxElementCount, arena);
-    context->aspectRatioElementIndexes = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->renderCommands = Clay_RenderCommandArray_Allocate_Arena(maxElementCount, arena);
+    context->textElementData = Clay__TextElementDataArray_Allocate_Arena(capacities.textElements, arena);
+    context->aspectRatioElementIndexes = Clay__int32_tArray_Allocate_Arena(capacities.aspectRatioElements, arena);
+    if (context->renderOutputBufferCount <= 1) {
+        context->renderCommands = Clay_RenderCommandArray_Allocate_Arena(capacities.renderCommands, arena);
+    }
     context->treeNodeVisited = Clay__boolArray_Allocate_Arena(maxElementCount, arena);
     context->treeNodeVisited.length = context->treeNodeVisited.capacity; // This array is accessed directly rather than behaving as a list
+    context->layoutElementSubtreeBounds = Clay__SubtreeBoundsArray_Allocate_Arena(maxElementCount, arena);
+    context->parallelSizingRoots = Clay__ParallelSizingRootArray_Allocate_Arena(maxElementCount, arena);
+    context->parallelSizingOrder = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutElementRootIndexes = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->openCachedSubtrees = Clay__OpenCachedSubtreeArray_Allocate_Arena(32, arena);
+#ifdef CLAY_SOA_LAYOUT
+    context->layoutAxisSizes = Clay__floatArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutMinWidths = Clay__floatArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutMinHeights = Clay__floatArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutMaxWidths = Clay__floatArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutMaxHeights = Clay__floatArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutWidthSizingTypes = Clay__uint8_tArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutHeightSizingTypes = Clay__uint8_tArray_Allocate_Arena(maxElementCount, arena);
+    context->layoutAxisFlags = Clay__uint8_tArray_Allocate_Arena(maxElementCount, arena);
+#endif
     context->openClipElementStack = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->reusableElementIndexBuffer = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->layoutElementClipElementIds = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
-    context->dynamicStringData = Clay__charArray_Allocate_Arena(maxElementCount, arena);
+    if (context->renderOutputBufferCount <= 1) {
+        context->dynamicStringData = Clay__charArray_Allocate_Arena(capacities.dynamicStringBytes, arena);
+    }
+    // Every interned string takes at least 8 bytes, including its header and alignment
+    context->internedStrings = Clay__InternedStringArray_Allocate_Arena(CLAY__MAX(capacities.dynamicStringBytes / 8, 1), arena);
+    context->internedStringBuckets = Clay__int32_tArray_Allocate_Arena(CLAY__MAX(capacities.dynamicStringBytes / 8, 1), arena);
+    context->renderCommandChanges = Clay_RenderCommandChangeArray_Allocate_Arena(capacities.renderCommands * 2, arena);
+    context->dirtyRects = Clay_BoundingBoxArray_Allocate_Arena(Clay__dirtyRectCapacity, arena);
 }
 
 void Clay__InitializePersistentMemory(Clay_Context* context) {
     // Persistent memory - initialized once and not reset
     int32_t maxElementCount = context->maxElementCount;
     int32_t maxMeasureTextCacheWordCount = context->maxMeasureTextCacheWordCount;
+    Clay_CapacityConfig capacities = Clay__ResolveCapacities(context);
     Clay_Arena *arena = &context->internalArena;
 
     context->scrollContainerDatas = Clay__ScrollContainerDataInternalArray_Allocate_Arena(100, arena);
     context->layoutElementsHashMapInternal = Clay__LayoutElementHashMapItemArray_Allocate_Arena(maxElementCount, arena);
-    context->layoutElementsHashMap = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    // Keep the load factor of the open addressed table at or below one half
+    int32_t hashMapSlotCount = 1;
+    while (hashMapSlotCount < maxElementCount * 2) {
+        hashMapSlotCount *= 2;
+    }
+    context->layoutElementsHashMap = Clay__LayoutElementHashMapSlotArray_Allocate_Arena(hashMapSlotCount, arena);
     context->measureTextHashMapInternal = Clay__MeasureTextCacheItemArray_Allocate_Arena(maxElementCount, arena);
     context->measureTextHashMapInternalFreeList = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->measureTextBatchItems = Clay_MeasureTextBatchItemArray_Allocate_Arena(Clay__measureTextBatchCapacity, arena);
+    context->pendingTextMeasurements = Clay__PendingTextMeasurementArray_Allocate_Arena(Clay__measureTextBatchCapacity, arena);
+    context->textPrefetches = Clay__PendingTextMeasurementArray_Allocate_Arena(Clay__textPrefetchCapacity, arena);
+    context->textPrefetchConfigs = Clay__TextElementConfigArray_Allocate_Arena(Clay__textPrefetchCapacity, arena);
+    context->textPrefetchItems = Clay_MeasureTextBatchItemArray_Allocate_Arena(Clay__textPrefetchCapacity * Clay__textPrefetchWordsPerText, arena);
+    context->textPrefetchChars = Clay__charArray_Allocate_Arena(Clay__textPrefetchCapacity * Clay__textPrefetchCharsPerText, arena);
     context->measuredWordsFreeList = Clay__int32_tArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
     context->measureTextHashMap = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
+    context->renderCommandSnapshots = Clay__RenderCommandSnapshotArray_Allocate_Arena(capacities.renderCommands, arena);
+    context->previousRenderCommandSnapshots = Clay__RenderCommandSnapshotArray_Allocate_Arena(capacities.renderCommands, arena);
+    context->renderCommandSnapshotHashMap = Clay__int32_tArray_Allocate_Arena(capacities.renderCommands, arena);
+    context->cachedSubtrees = Clay__CachedSubtreeArray_Allocate_Arena(Clay__cachedSubtreeCapacity, arena);
+    context->previousCachedSubtrees = Clay__CachedSubtreeArray_Allocate_Arena(Clay__cachedSubtreeCapacity, arena);
+    context->cachedSubtreeData = Clay__charArray_Allocate_Arena(maxElementCount * Clay__cachedSubtreeBytesPerElement, arena);
+    context->previousCachedSubtreeData = Clay__charArray_Allocate_Arena(maxElementCount * Clay__cachedSubtreeBytesPerElement, arena);
+    context->retainedLayoutDimensions = Clay__DimensionsArray_Allocate_Arena(maxElementCount, arena);
+    context->retainedWrappedTextLines = Clay__WrappedTextLineArray_Allocate_Arena(capacities.wrappedTextLines, arena);
+    context->retainedWrappedLineCounts = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->measuredWords = Clay__MeasuredWordArray_Allocate_Arena(maxMeasureTextCacheWordCount, arena);
+    context->wrappedLineCache = Clay__MeasuredWordArray_Allocate_Arena(capacities.wrappedTextLines, arena);
+    context->wrappedLineCacheFreeList = Clay__int32_tArray_Allocate_Arena(capacities.wrappedTextLines, arena);
     context->pointerOverIds = Clay_ElementIdArray_Allocate_Arena(maxElementCount, arena);
+    context->previousPointerOverIds = Clay_ElementIdArray_Allocate_Arena(maxElementCount, arena);
+    context->hoverEvents = Clay_HoverEventArray_Allocate_Arena(Clay__hoverEventCapacity, arena);
+    context->pointQueryResults = Clay_PointQueryResultArray_Allocate_Arena(capacities.pointQueries, arena);
+    context->pointQueryElementIds = Clay_ElementIdArray_Allocate_Arena(maxElementCount, arena);
     context->debugElementData = Clay__DebugElementDataArray_Allocate_Arena(maxElementCount, arena);
+    if (context->renderOutputBufferCount > 1) {
+        context->renderOutputCommands = Clay_RenderCommandArray_Allocate_Arena(capacities.renderCommands * context->renderOutputBufferCount, arena);
+        context->renderOutputStrings = Clay__charArray_Allocate_Arena(capacities.dynamicStringBytes * context->renderOutputBufferCount, arena);
+        context->renderOutputBuffersHeld = Clay__boolArray_Allocate_Arena(context->renderOutputBufferCount, arena);
+    }
     context->arenaResetOffset = arena->nextAllocation;
 }
 
@@ -2245,229 +4216,546 @@ bool Clay__FloatEqual(float left, float right) {
     return subtracted < CLAY__EPSILON && subtracted > -CLAY__EPSILON;
 }
 
-void Clay__SizeContainersAlongAxis(bool xAxis) {
+// Accessors for the properties of an element along the axis currently being sized.
+// With CLAY_SOA_LAYOUT defined, these read from dense arrays indexed by element index rather than chasing layout and element config pointers.
+// The sizing properties are stored when each element is closed, and the sizes along the current axis are gathered at the start of each sizing pass and written back at the end.
+#ifdef CLAY_SOA_LAYOUT
+void Clay__GatherLayoutAxis(bool xAxis) {
     Clay_Context* context = Clay_GetCurrentContext();
-    Clay__int32_tArray bfsBuffer = context->layoutElementChildrenBuffer;
-    Clay__int32_tArray resizableContainerBuffer = context->openLayoutElementStack;
-    for (int32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
-        bfsBuffer.length = 0;
-        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
-        Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex);
-        Clay__int32_tArray_Add(&bfsBuffer, (int32_t)root->layoutElementIndex);
-
-        // Size floating containers to their parents
-        if (Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING)) {
-            Clay_FloatingElementConfig *floatingElementConfig = Clay__FindElementConfigWithType(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING).floatingElementConfig;
-            Clay_LayoutElementHashMapItem *parentItem = Clay__GetHashMapItem(floatingElementConfig->parentId);
-            if (parentItem && parentItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
-                Clay_LayoutElement *parentLayoutElement = parentItem->layoutElement;
-                switch (rootElement->layoutConfig->sizing.width.type) {
-                    case CLAY__SIZING_TYPE_GROW: {
-                        rootElement->dimensions.width = parentLayoutElement->dimensions.width;
-                        break;
-                    }
-                    case CLAY__SIZING_TYPE_PERCENT: {
-                        rootElement->dimensions.width = parentLayoutElement->dimensions.width * rootElement->layoutConfig->sizing.width.size.percent;
-                        break;
-                    }
-                    default: break;
-                }
-                switch (rootElement->layoutConfig->sizing.height.type) {
-                    case CLAY__SIZING_TYPE_GROW: {
-                        rootElement->dimensions.height = parentLayoutElement->dimensions.height;
-                        break;
-                    }
-                    case CLAY__SIZING_TYPE_PERCENT: {
-                        rootElement->dimensions.height = parentLayoutElement->dimensions.height * rootElement->layoutConfig->sizing.height.size.percent;
-                        break;
-                    }
-                    default: break;
-                }
-            }
+    for (int32_t i = 0; i < context->layoutElements.length; ++i) {
+        Clay_Dimensions dimensions = context->layoutElements.internalArray[i].dimensions;
+        context->layoutAxisSizes.internalArray[i] = xAxis ? dimensions.width : dimensions.height;
+    }
+    context->layoutAxisSizes.length = context->layoutElements.length;
+}
+
+void Clay__ScatterLayoutAxis(bool xAxis) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (int32_t i = 0; i < context->layoutAxisSizes.length; ++i) {
+        if (xAxis) {
+            context->layoutElements.internalArray[i].dimensions.width = context->layoutAxisSizes.internalArray[i];
+        } else {
+            context->layoutElements.internalArray[i].dimensions.height = context->layoutAxisSizes.internalArray[i];
         }
+    }
+}
+#endif
+
+static inline float *Clay__LayoutAxisSize(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis) {
+#ifdef CLAY_SOA_LAYOUT
+    (void)layoutElement; (void)xAxis;
+    return &Clay_GetCurrentContext()->layoutAxisSizes.internalArray[elementIndex];
+#else
+    (void)elementIndex;
+    return xAxis ? &layoutElement->dimensions.width : &layoutElement->dimensions.height;
+#endif
+}
+
+static inline float Clay__LayoutAxisMinSize(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis) {
+#ifdef CLAY_SOA_LAYOUT
+    (void)layoutElement;
+    Clay_Context* context = Clay_GetCurrentContext();
+    return (xAxis ? context->layoutMinWidths : context->layoutMinHeights).internalArray[elementIndex];
+#else
+    (void)elementIndex;
+    return xAxis ? layoutElement->minDimensions.width : layoutElement->minDimensions.height;
+#endif
+}
+
+static inline float Clay__LayoutAxisMaxSize(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis) {
+#ifdef CLAY_SOA_LAYOUT
+    (void)layoutElement;
+    Clay_Context* context = Clay_GetCurrentContext();
+    return (xAxis ? context->layoutMaxWidths : context->layoutMaxHeights).internalArray[elementIndex];
+#else
+    (void)elementIndex;
+    return xAxis ? layoutElement->layoutConfig->sizing.width.size.minMax.max : layoutElement->layoutConfig->sizing.height.size.minMax.max;
+#endif
+}
+
+static inline float Clay__LayoutAxisPercent(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis) {
+#ifdef CLAY_SOA_LAYOUT
+    return Clay__LayoutAxisMaxSize(layoutElement, elementIndex, xAxis);
+#else
+    (void)elementIndex;
+    return xAxis ? layoutElement->layoutConfig->sizing.width.size.percent : layoutElement->layoutConfig->sizing.height.size.percent;
+#endif
+}
+
+static inline Clay__SizingType Clay__LayoutAxisSizingType(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis) {
+#ifdef CLAY_SOA_LAYOUT
+    (void)layoutElement;
+    Clay_Context* context = Clay_GetCurrentContext();
+    return (Clay__SizingType)(xAxis ? context->layoutWidthSizingTypes : context->layoutHeightSizingTypes).internalArray[elementIndex];
+#else
+    (void)elementIndex;
+    return xAxis ? layoutElement->layoutConfig->sizing.width.type : layoutElement->layoutConfig->sizing.height.type;
+#endif
+}
+
+// Returns true if the element can be grown or compressed by its parent along this axis
+static inline bool Clay__LayoutAxisIsResizable(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis) {
+#ifdef CLAY_SOA_LAYOUT
+    (void)layoutElement;
+    return Clay_GetCurrentContext()->layoutAxisFlags.internalArray[elementIndex] & (xAxis ? CLAY__LAYOUT_AXIS_FLAG_RESIZABLE_X : CLAY__LAYOUT_AXIS_FLAG_RESIZABLE_Y);
+#else
+    (void)elementIndex;
+    Clay__SizingType sizingType = xAxis ? layoutElement->layoutConfig->sizing.width.type : layoutElement->layoutConfig->sizing.height.type;
+    return sizingType != CLAY__SIZING_TYPE_PERCENT
+        && sizingType != CLAY__SIZING_TYPE_FIXED
+        && (!Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || (Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig->wrapMode == CLAY_TEXT_WRAP_WORDS)); // todo too many loops
+#endif
+}
+
+static inline bool Clay__LayoutElementHasChildContainers(Clay_LayoutElement *layoutElement, int32_t elementIndex) {
+#ifdef CLAY_SOA_LAYOUT
+    (void)layoutElement;
+    return Clay_GetCurrentContext()->layoutAxisFlags.internalArray[elementIndex] & CLAY__LAYOUT_AXIS_FLAG_HAS_CHILD_CONTAINERS;
+#else
+    (void)elementIndex;
+    return !Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && layoutElement->childrenOrTextContent.children.length > 0;
+#endif
+}
 
-        if (rootElement->layoutConfig->sizing.width.type != CLAY__SIZING_TYPE_PERCENT) {
-            rootElement->dimensions.width = CLAY__MIN(CLAY__MAX(rootElement->dimensions.width, rootElement->layoutConfig->sizing.width.size.minMax.min), rootElement->layoutConfig->sizing.width.size.minMax.max);
+static inline bool Clay__LayoutAxisClipsChildren(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis) {
+#ifdef CLAY_SOA_LAYOUT
+    (void)layoutElement;
+    return Clay_GetCurrentContext()->layoutAxisFlags.internalArray[elementIndex] & (xAxis ? CLAY__LAYOUT_AXIS_FLAG_CLIPS_CHILDREN_X : CLAY__LAYOUT_AXIS_FLAG_CLIPS_CHILDREN_Y);
+#else
+    (void)elementIndex;
+    Clay_ClipElementConfig *clipElementConfig = Clay__FindElementConfigWithType(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_CLIP).clipElementConfig;
+    return clipElementConfig && (xAxis ? clipElementConfig->horizontal : clipElementConfig->vertical);
+#endif
+}
+
+// Returns the element's dimensions, taking the size along the current axis from the dense arrays when CLAY_SOA_LAYOUT is defined
+static inline Clay_Dimensions Clay__LayoutAxisDimensions(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis) {
+    Clay_Dimensions dimensions = layoutElement->dimensions;
+    float size = *Clay__LayoutAxisSize(layoutElement, elementIndex, xAxis);
+    if (xAxis) {
+        dimensions.width = size;
+    } else {
+        dimensions.height = size;
+    }
+    return dimensions;
+}
+
+static inline void Clay__SetLayoutAxisDimensions(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis, Clay_Dimensions dimensions) {
+    layoutElement->dimensions = dimensions;
+    *Clay__LayoutAxisSize(layoutElement, elementIndex, xAxis) = xAxis ? dimensions.width : dimensions.height;
+}
+
+static inline void Clay__LayoutAxisUpdateAspectRatioBox(Clay_LayoutElement *layoutElement, int32_t elementIndex, bool xAxis) {
+#ifdef CLAY_SOA_LAYOUT
+    Clay__SetLayoutAxisDimensions(layoutElement, elementIndex, xAxis, Clay__LayoutAxisDimensions(layoutElement, elementIndex, xAxis));
+    Clay__UpdateAspectRatioBox(layoutElement);
+    *Clay__LayoutAxisSize(layoutElement, elementIndex, xAxis) = xAxis ? layoutElement->dimensions.width : layoutElement->dimensions.height;
+#else
+    (void)elementIndex; (void)xAxis;
+    Clay__UpdateAspectRatioBox(layoutElement);
+#endif
+}
+
+// Returns true if an element and the size it has been given along this axis are identical to the previous frame, meaning its children will resolve to their cached sizes.
+// Heights also depend on the widths chosen for the subtree (e.g. through text wrapping), so a height is only reused if the width was reused as well.
+bool Clay__LayoutCacheHit(Clay_LayoutElement *layoutElement, bool xAxis) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElementHashMapItem *hashMapItem = layoutElement->hashMapItem;
+    if (layoutElement->layoutHash == 0) {
+        return false;
+    }
+    float size = *Clay__LayoutAxisSize(layoutElement, (int32_t)(layoutElement - context->layoutElements.internalArray), xAxis);
+    if (xAxis) {
+        return hashMapItem->layoutCacheGeneration == context->generation - 1 && hashMapItem->layoutHash == layoutElement->layoutHash && hashMapItem->cachedDimensions.width == size;
+    }
+    return hashMapItem->layoutCacheWidthValid && hashMapItem->cachedDimensions.height == size;
+}
+
+void Clay__StoreLayoutCache(Clay_LayoutElement *layoutElement, bool xAxis) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElementHashMapItem *hashMapItem = layoutElement->hashMapItem;
+    if (!hashMapItem) {
+        return;
+    }
+    float size = *Clay__LayoutAxisSize(layoutElement, (int32_t)(layoutElement - context->layoutElements.internalArray), xAxis);
+    if (xAxis) {
+        hashMapItem->layoutCacheWidthValid = hashMapItem->layoutCacheGeneration == context->generation - 1 && hashMapItem->layoutHash == layoutElement->layoutHash && hashMapItem->cachedDimensions.width == size;
+        hashMapItem->layoutHash = layoutElement->layoutHash;
+        hashMapItem->cachedDimensions.width = size;
+    } else {
+        hashMapItem->cachedDimensions.height = size;
+        hashMapItem->layoutCacheGeneration = context->generation;
+    }
+}
+
+// Returns the element that a floating tree root is sized relative to, or NULL if the root isn't floating or its parent doesn't exist
+Clay_LayoutElement *Clay__FloatingRootParent(Clay_LayoutElement *rootElement) {
+    if (!Clay__ElementHasConfig(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING)) {
+        return NULL;
+    }
+    Clay_FloatingElementConfig *floatingElementConfig = Clay__FindElementConfigWithType(rootElement, CLAY__ELEMENT_CONFIG_TYPE_FLOATING).floatingElementConfig;
+    Clay_LayoutElementHashMapItem *parentItem = Clay__GetHashMapItem(floatingElementConfig->parentId);
+    if (parentItem && parentItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+        return parentItem->layoutElement;
+    }
+    return NULL;
+}
+
+// Sizes a single layout tree along one axis. Only the elements of this tree and the provided scratch buffers are written to,
+// so trees that don't depend on each other can be sized simultaneously on different threads.
+void Clay__SizeRootAlongAxis(int32_t rootIndex, bool xAxis, bool useLayoutCache, Clay_LayoutElement *floatingParent, Clay__int32_tArray bfsBuffer, Clay__int32_tArray resizableContainerBuffer) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    bfsBuffer.length = 0;
+    Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+    Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex);
+    Clay_Dimensions rootDimensions = Clay__LayoutAxisDimensions(rootElement, root->layoutElementIndex, xAxis);
+    Clay__int32_tArray_Add(&bfsBuffer, (int32_t)root->layoutElementIndex);
+
+    // Size floating containers to their parents
+    if (floatingParent) {
+        Clay_Dimensions parentDimensions = Clay__LayoutAxisDimensions(floatingParent, (int32_t)(floatingParent - context->layoutElements.internalArray), xAxis);
+        switch (rootElement->layoutConfig->sizing.width.type) {
+            case CLAY__SIZING_TYPE_GROW: {
+                rootDimensions.width = parentDimensions.width;
+                break;
+            }
+            case CLAY__SIZING_TYPE_PERCENT: {
+                rootDimensions.width = parentDimensions.width * rootElement->layoutConfig->sizing.width.size.percent;
+                break;
+            }
+            default: break;
         }
-        if (rootElement->layoutConfig->sizing.height.type != CLAY__SIZING_TYPE_PERCENT) {
-            rootElement->dimensions.height = CLAY__MIN(CLAY__MAX(rootElement->dimensions.height, rootElement->layoutConfig->sizing.height.size.minMax.min), rootElement->layoutConfig->sizing.height.size.minMax.max);
+        switch (rootElement->layoutConfig->sizing.height.type) {
+            case CLAY__SIZING_TYPE_GROW: {
+                rootDimensions.height = parentDimensions.height;
+                break;
+            }
+            case CLAY__SIZING_TYPE_PERCENT: {
+                rootDimensions.height = parentDimensions.height * rootElement->layoutConfig->sizing.height.size.percent;
+                break;
+            }
+            default: break;
         }
+    }
 
-        for (int32_t i = 0; i < bfsBuffer.length; ++i) {
-            int32_t parentIndex = Clay__int32_tArray_GetValue(&bfsBuffer, i);
-            Clay_LayoutElement *parent = Clay_LayoutElementArray_Get(&context->layoutElements, parentIndex);
-            Clay_LayoutConfig *parentStyleConfig = parent->layoutConfig;
-            int32_t growContainerCount = 0;
-            float parentSize = xAxis ? parent->dimensions.width : parent->dimensions.height;
-            float parentPadding = (float)(xAxis ? (parent->layoutConfig->padding.left + parent->layoutConfig->padding.right) : (parent->layoutConfig->padding.top + parent->layoutConfig->padding.bottom));
-            float innerContentSize = 0, totalPaddingAndChildGaps = parentPadding;
-            bool sizingAlongAxis = (xAxis && parentStyleConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) || (!xAxis && parentStyleConfig->layoutDirection == CLAY_TOP_TO_BOTTOM);
-            resizableContainerBuffer.length = 0;
-            float parentChildGap = parentStyleConfig->childGap;
+    if (rootElement->layoutConfig->sizing.width.type != CLAY__SIZING_TYPE_PERCENT) {
+        rootDimensions.width = CLAY__MIN(CLAY__MAX(rootDimensions.width, rootElement->layoutConfig->sizing.width.size.minMax.min), rootElement->layoutConfig->sizing.width.size.minMax.max);
+    }
+    if (rootElement->layoutConfig->sizing.height.type != CLAY__SIZING_TYPE_PERCENT) {
+        rootDimensions.height = CLAY__MIN(CLAY__MAX(rootDimensions.height, rootElement->layoutConfig->sizing.height.size.minMax.min), rootElement->layoutConfig->sizing.height.size.minMax.max);
+    }
+    Clay__SetLayoutAxisDimensions(rootElement, root->layoutElementIndex, xAxis, rootDimensions);
 
+    for (int32_t i = 0; i < bfsBuffer.length; ++i) {
+        int32_t parentIndex = Clay__int32_tArray_GetValue(&bfsBuffer, i);
+        Clay_LayoutElement *parent = Clay_LayoutElementArray_Get(&context->layoutElements, parentIndex);
+        if (useLayoutCache && Clay__LayoutCacheHit(parent, xAxis)) {
             for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
                 int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
                 Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
-                Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                float childSize = xAxis ? childElement->dimensions.width : childElement->dimensions.height;
-
-                if (!Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && childElement->childrenOrTextContent.children.length > 0) {
+                *Clay__LayoutAxisSize(childElement, childElementIndex, xAxis) = xAxis ? childElement->hashMapItem->cachedDimensions.width : childElement->hashMapItem->cachedDimensions.height;
+                if (Clay__LayoutElementHasChildContainers(childElement, childElementIndex)) {
                     Clay__int32_tArray_Add(&bfsBuffer, childElementIndex);
                 }
+            }
+            continue;
+        }
+        Clay_LayoutConfig *parentStyleConfig = parent->layoutConfig;
+        int32_t growContainerCount = 0;
+        float parentSize = *Clay__LayoutAxisSize(parent, parentIndex, xAxis);
+        float parentPadding = (float)(xAxis ? (parent->layoutConfig->padding.left + parent->layoutConfig->padding.right) : (parent->layoutConfig->padding.top + parent->layoutConfig->padding.bottom));
+        float innerContentSize = 0, totalPaddingAndChildGaps = parentPadding;
+        bool sizingAlongAxis = (xAxis && parentStyleConfig->layoutDirection == CLAY_LEFT_TO_RIGHT) || (!xAxis && parentStyleConfig->layoutDirection == CLAY_TOP_TO_BOTTOM);
+        resizableContainerBuffer.length = 0;
+        float parentChildGap = parentStyleConfig->childGap;
+
+        for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
+            int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
+            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+            Clay__SizingType childSizingType = Clay__LayoutAxisSizingType(childElement, childElementIndex, xAxis);
+            float childSize = *Clay__LayoutAxisSize(childElement, childElementIndex, xAxis);
+
+            if (Clay__LayoutElementHasChildContainers(childElement, childElementIndex)) {
+                Clay__int32_tArray_Add(&bfsBuffer, childElementIndex);
+            }
 
-                if (childSizing.type != CLAY__SIZING_TYPE_PERCENT
-                    && childSizing.type != CLAY__SIZING_TYPE_FIXED
-                    && (!Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || (Clay__FindElementConfigWithType(childElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig->wrapMode == CLAY_TEXT_WRAP_WORDS)) // todo too many loops
-//                    && (xAxis || !Clay__ElementHasConfig(childElement, CLAY__ELEMENT_CONFIG_TYPE_ASPECT))
-                ) {
-                    Clay__int32_tArray_Add(&resizableContainerBuffer, childElementIndex);
-                }
+            if (Clay__LayoutAxisIsResizable(childElement, childElementIndex, xAxis)) {
+                Clay__int32_tArray_Add(&resizableContainerBuffer, childElementIndex);
+            }
 
-                if (sizingAlongAxis) {
-                    innerContentSize += (childSizing.type == CLAY__SIZING_TYPE_PERCENT ? 0 : childSize);
-                    if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                        growContainerCount++;
-                    }
-                    if (childOffset > 0) {
-                        innerContentSize += parentChildGap; // For children after index 0, the childAxisOffset is the gap from the previous child
-                        totalPaddingAndChildGaps += parentChildGap;
-                    }
-                } else {
-                    innerContentSize = CLAY__MAX(childSize, innerContentSize);
+            if (sizingAlongAxis) {
+                innerContentSize += (childSizingType == CLAY__SIZING_TYPE_PERCENT ? 0 : childSize);
+                if (childSizingType == CLAY__SIZING_TYPE_GROW) {
+                    growContainerCount++;
+                }
+                if (childOffset > 0) {
+                    innerContentSize += parentChildGap; // For children after index 0, the childAxisOffset is the gap from the previous child
+                    totalPaddingAndChildGaps += parentChildGap;
                 }
+            } else {
+                innerContentSize = CLAY__MAX(childSize, innerContentSize);
             }
+        }
 
-            // Expand percentage containers to size
-            for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
-                int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
-                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
-                Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-                if (childSizing.type == CLAY__SIZING_TYPE_PERCENT) {
-                    *childSize = (parentSize - totalPaddingAndChildGaps) * childSizing.size.percent;
-                    if (sizingAlongAxis) {
-                        innerContentSize += *childSize;
-                    }
-                    Clay__UpdateAspectRatioBox(childElement);
+        // Expand percentage containers to size
+        for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
+            int32_t childElementIndex = parent->childrenOrTextContent.children.elements[childOffset];
+            Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+            if (Clay__LayoutAxisSizingType(childElement, childElementIndex, xAxis) == CLAY__SIZING_TYPE_PERCENT) {
+                float *childSize = Clay__LayoutAxisSize(childElement, childElementIndex, xAxis);
+                *childSize = (parentSize - totalPaddingAndChildGaps) * Clay__LayoutAxisPercent(childElement, childElementIndex, xAxis);
+                if (sizingAlongAxis) {
+                    innerContentSize += *childSize;
                 }
+                Clay__LayoutAxisUpdateAspectRatioBox(childElement, childElementIndex, xAxis);
             }
+        }
 
-            if (sizingAlongAxis) {
-                float sizeToDistribute = parentSize - parentPadding - innerContentSize;
-                // The content is too large, compress the children as much as possible
-                if (sizeToDistribute < 0) {
-                    // If the parent clips content in this axis direction, don't compress children, just leave them alone
-                    Clay_ClipElementConfig *clipElementConfig = Clay__FindElementConfigWithType(parent, CLAY__ELEMENT_CONFIG_TYPE_CLIP).clipElementConfig;
-                    if (clipElementConfig) {
-                        if (((xAxis && clipElementConfig->horizontal) || (!xAxis && clipElementConfig->vertical))) {
-                            continue;
+        if (sizingAlongAxis) {
+            float sizeToDistribute = parentSize - parentPadding - innerContentSize;
+            // The content is too large, compress the children as much as possible
+            if (sizeToDistribute < 0) {
+                // If the parent clips content in this axis direction, don't compress children, just leave them alone
+                if (Clay__LayoutAxisClipsChildren(parent, parentIndex, xAxis)) {
+                    continue;
+                }
+                // Scrolling containers preferentially compress before others
+                while (sizeToDistribute < -CLAY__EPSILON && resizableContainerBuffer.length > 0) {
+                    float largest = 0;
+                    float secondLargest = 0;
+                    float widthToAdd = sizeToDistribute;
+                    for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
+                        int32_t childElementIndex = Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex);
+                        Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+                        float childSize = *Clay__LayoutAxisSize(child, childElementIndex, xAxis);
+                        if (Clay__FloatEqual(childSize, largest)) { continue; }
+                        if (childSize > largest) {
+                            secondLargest = largest;
+                            largest = childSize;
                         }
-                    }
-                    // Scrolling containers preferentially compress before others
-                    while (sizeToDistribute < -CLAY__EPSILON && resizableContainerBuffer.length > 0) {
-                        float largest = 0;
-                        float secondLargest = 0;
-                        float widthToAdd = sizeToDistribute;
-                        for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                            float childSize = xAxis ? child->dimensions.width : child->dimensions.height;
-                            if (Clay__FloatEqual(childSize, largest)) { continue; }
-                            if (childSize > largest) {
-                                secondLargest = largest;
-                                largest = childSize;
-                            }
-                            if (childSize < largest) {
-                                secondLargest = CLAY__MAX(secondLargest, childSize);
-                                widthToAdd = secondLargest - largest;
-                            }
+                        if (childSize < largest) {
+                            secondLargest = CLAY__MAX(secondLargest, childSize);
+                            widthToAdd = secondLargest - largest;
                         }
+                    }
 
-                        widthToAdd = CLAY__MAX(widthToAdd, sizeToDistribute / resizableContainerBuffer.length);
-
-                        for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                            float *childSize = xAxis ? &child->dimensions.width : &child->dimensions.height;
-                            float minSize = xAxis ? child->minDimensions.width : child->minDimensions.height;
-                            float previousWidth = *childSize;
-                            if (Clay__FloatEqual(*childSize, largest)) {
-                                *childSize += widthToAdd;
-                                if (*childSize <= minSize) {
-                                    *childSize = minSize;
-                                    Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childIndex--);
-                                }
-                                sizeToDistribute -= (*childSize - previousWidth);
+                    widthToAdd = CLAY__MAX(widthToAdd, sizeToDistribute / resizableContainerBuffer.length);
+
+                    for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
+                        int32_t childElementIndex = Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex);
+                        Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+                        float *childSize = Clay__LayoutAxisSize(child, childElementIndex, xAxis);
+                        float minSize = Clay__LayoutAxisMinSize(child, childElementIndex, xAxis);
+                        float previousWidth = *childSize;
+                        if (Clay__FloatEqual(*childSize, largest)) {
+                            *childSize += widthToAdd;
+                            if (*childSize <= minSize) {
+                                *childSize = minSize;
+                                Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childIndex--);
                             }
+                            sizeToDistribute -= (*childSize - previousWidth);
                         }
                     }
-                // The content is too small, allow SIZING_GROW containers to expand
-                } else if (sizeToDistribute > 0 && growContainerCount > 0) {
+                }
+            // The content is too small, allow SIZING_GROW containers to expand
+            } else if (sizeToDistribute > 0 && growContainerCount > 0) {
+                for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
+                    int32_t childElementIndex = Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex);
+                    Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+                    if (Clay__LayoutAxisSizingType(child, childElementIndex, xAxis) != CLAY__SIZING_TYPE_GROW) {
+                        Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childIndex--);
+                    }
+                }
+                while (sizeToDistribute > CLAY__EPSILON && resizableContainerBuffer.length > 0) {
+                    float smallest = CLAY__MAXFLOAT;
+                    float secondSmallest = CLAY__MAXFLOAT;
+                    float widthToAdd = sizeToDistribute;
                     for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                        Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                        Clay__SizingType childSizing = xAxis ? child->layoutConfig->sizing.width.type : child->layoutConfig->sizing.height.type;
-                        if (childSizing != CLAY__SIZING_TYPE_GROW) {
-                            Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childIndex--);
+                        int32_t childElementIndex = Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex);
+                        Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+                        float childSize = *Clay__LayoutAxisSize(child, childElementIndex, xAxis);
+                        if (Clay__FloatEqual(childSize, smallest)) { continue; }
+                        if (childSize < smallest) {
+                            secondSmallest = smallest;
+                            smallest = childSize;
                         }
-                    }
-                    while (sizeToDistribute > CLAY__EPSILON && resizableContainerBuffer.length > 0) {
-                        float smallest = CLAY__MAXFLOAT;
-                        float secondSmallest = CLAY__MAXFLOAT;
-                        float widthToAdd = sizeToDistribute;
-                        for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                            float childSize = xAxis ? child->dimensions.width : child->dimensions.height;
-                            if (Clay__FloatEqual(childSize, smallest)) { continue; }
-                            if (childSize < smallest) {
-                                secondSmallest = smallest;
-                                smallest = childSize;
-                            }
-                            if (childSize > smallest) {
-                                secondSmallest = CLAY__MIN(secondSmallest, childSize);
-                                widthToAdd = secondSmallest - smallest;
-                            }
+                        if (childSize > smallest) {
+                            secondSmallest = CLAY__MIN(secondSmallest, childSize);
+                            widthToAdd = secondSmallest - smallest;
                         }
+                    }
 
-                        widthToAdd = CLAY__MIN(widthToAdd, sizeToDistribute / resizableContainerBuffer.length);
-
-                        for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
-                            Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex));
-                            float *childSize = xAxis ? &child->dimensions.width : &child->dimensions.height;
-                            float maxSize = xAxis ? child->layoutConfig->sizing.width.size.minMax.max : child->layoutConfig->sizing.height.size.minMax.max;
-                            float previousWidth = *childSize;
-                            if (Clay__FloatEqual(*childSize, smallest)) {
-                                *childSize += widthToAdd;
-                                if (*childSize >= maxSize) {
-                                    *childSize = maxSize;
-                                    Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childIndex--);
-                                }
-                                sizeToDistribute -= (*childSize - previousWidth);
+                    widthToAdd = CLAY__MIN(widthToAdd, sizeToDistribute / resizableContainerBuffer.length);
+
+                    for (int childIndex = 0; childIndex < resizableContainerBuffer.length; childIndex++) {
+                        int32_t childElementIndex = Clay__int32_tArray_GetValue(&resizableContainerBuffer, childIndex);
+                        Clay_LayoutElement *child = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+                        float *childSize = Clay__LayoutAxisSize(child, childElementIndex, xAxis);
+                        float maxSize = Clay__LayoutAxisMaxSize(child, childElementIndex, xAxis);
+                        float previousWidth = *childSize;
+                        if (Clay__FloatEqual(*childSize, smallest)) {
+                            *childSize += widthToAdd;
+                            if (*childSize >= maxSize) {
+                                *childSize = maxSize;
+                                Clay__int32_tArray_RemoveSwapback(&resizableContainerBuffer, childIndex--);
                             }
+                            sizeToDistribute -= (*childSize - previousWidth);
                         }
                     }
                 }
-            // Sizing along the non layout axis ("off axis")
-            } else {
-                for (int32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
-                    Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&resizableContainerBuffer, childOffset));
-                    Clay_SizingAxis childSizing = xAxis ? childElement->layoutConfig->sizing.width : childElement->layoutConfig->sizing.height;
-                    float minSize = xAxis ? childElement->minDimensions.width : childElement->minDimensions.height;
-                    float *childSize = xAxis ? &childElement->dimensions.width : &childElement->dimensions.height;
-
-                    float maxSize = parentSize - parentPadding;
-                    // If we're laying out the children of a scroll panel, grow containers expand to the size of the inner content, not the outer container
-                    if (Clay__ElementHasConfig(parent, CLAY__ELEMENT_CONFIG_TYPE_CLIP)) {
-                        Clay_ClipElementConfig *clipElementConfig = Clay__FindElementConfigWithType(parent, CLAY__ELEMENT_CONFIG_TYPE_CLIP).clipElementConfig;
-                        if (((xAxis && clipElementConfig->horizontal) || (!xAxis && clipElementConfig->vertical))) {
-                            maxSize = CLAY__MAX(maxSize, innerContentSize);
-                        }
-                    }
-                    if (childSizing.type == CLAY__SIZING_TYPE_GROW) {
-                        *childSize = CLAY__MIN(maxSize, childSizing.size.minMax.max);
-                    }
-                    *childSize = CLAY__MAX(minSize, CLAY__MIN(*childSize, maxSize));
+            }
+        // Sizing along the non layout axis ("off axis")
+        } else {
+            float maxSize = parentSize - parentPadding;
+            // If we're laying out the children of a scroll panel, grow containers expand to the size of the inner content, not the outer container
+            if (Clay__LayoutAxisClipsChildren(parent, parentIndex, xAxis)) {
+                maxSize = CLAY__MAX(maxSize, innerContentSize);
+            }
+            for (int32_t childOffset = 0; childOffset < resizableContainerBuffer.length; childOffset++) {
+                int32_t childElementIndex = Clay__int32_tArray_GetValue(&resizableContainerBuffer, childOffset);
+                Clay_LayoutElement *childElement = Clay_LayoutElementArray_Get(&context->layoutElements, childElementIndex);
+                float minSize = Clay__LayoutAxisMinSize(childElement, childElementIndex, xAxis);
+                float *childSize = Clay__LayoutAxisSize(childElement, childElementIndex, xAxis);
+                if (Clay__LayoutAxisSizingType(childElement, childElementIndex, xAxis) == CLAY__SIZING_TYPE_GROW) {
+                    *childSize = CLAY__MIN(maxSize, Clay__LayoutAxisMaxSize(childElement, childElementIndex, xAxis));
                 }
+                *childSize = CLAY__MAX(minSize, CLAY__MIN(*childSize, maxSize));
+            }
+        }
+    }
+
+    // Every element in this tree now has its final size along this axis, cache them for the next frame
+    if (context->incrementalLayoutEnabled) {
+        Clay__StoreLayoutCache(rootElement, xAxis);
+        for (int32_t i = 0; i < bfsBuffer.length; ++i) {
+            Clay_LayoutElement *parent = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&bfsBuffer, i));
+            for (int32_t childOffset = 0; childOffset < parent->childrenOrTextContent.children.length; childOffset++) {
+                Clay__StoreLayoutCache(Clay_LayoutElementArray_Get(&context->layoutElements, parent->childrenOrTextContent.children.elements[childOffset]), xAxis);
+            }
+        }
+    }
+}
+
+typedef struct {
+    Clay_Context *context;
+    int32_t *rootIndexes;
+    bool xAxis;
+    bool useLayoutCache;
+} Clay__ParallelSizingTaskData;
+
+void Clay__ParallelSizingTask(int32_t taskIndex, void *taskData) {
+    Clay__ParallelSizingTaskData *data = (Clay__ParallelSizingTaskData *)taskData;
+    Clay_Context *previousContext = Clay_GetCurrentContext();
+    // Worker threads may not have a current context if it's thread local
+    if (previousContext != data->context) {
+        Clay_SetCurrentContext(data->context);
+    }
+    int32_t rootIndex = data->rootIndexes[taskIndex];
+    Clay__ParallelSizingRoot *sizingRoot = Clay__ParallelSizingRootArray_Get(&data->context->parallelSizingRoots, rootIndex);
+    Clay__int32_tArray bfsBuffer = { .capacity = sizingRoot->scratchCapacity, .internalArray = data->context->layoutElementChildrenBuffer.internalArray + sizingRoot->scratchOffset };
+    Clay__int32_tArray resizableContainerBuffer = { .capacity = sizingRoot->scratchCapacity, .internalArray = data->context->openLayoutElementStack.internalArray + sizingRoot->scratchOffset };
+    Clay__SizeRootAlongAxis(rootIndex, data->xAxis, data->useLayoutCache, sizingRoot->floatingParent, bfsBuffer, resizableContainerBuffer);
+    if (previousContext != data->context) {
+        Clay_SetCurrentContext(previousContext);
+    }
+}
+
+// Works out which tree roots can be sized at the same time. A floating root reads the size of the element it's attached to,
+// so it has to be sized after that element's tree if the tree comes earlier in the root list, or before it if it comes later,
+// to give the same results as sizing every root in order. Each root also gets its own slice of the scratch buffers.
+void Clay__PrepareParallelSizing(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__int32_tArray dfsBuffer = context->layoutElementChildrenBuffer;
+    context->parallelSizingRoots.length = 0;
+    context->parallelSizingOrder.length = 0;
+    context->layoutElementRootIndexes.length = context->layoutElements.length;
+    int32_t scratchOffset = 0;
+    for (int32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
+        Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+        int32_t elementCount = 0;
+        dfsBuffer.length = 0;
+        Clay__int32_tArray_Add(&dfsBuffer, (int32_t)root->layoutElementIndex);
+        while (dfsBuffer.length > 0) {
+            int32_t elementIndex = Clay__int32_tArray_RemoveSwapback(&dfsBuffer, dfsBuffer.length - 1);
+            Clay_LayoutElement *element = Clay_LayoutElementArray_Get(&context->layoutElements, elementIndex);
+            context->layoutElementRootIndexes.internalArray[elementIndex] = rootIndex;
+            elementCount++;
+            if (!Clay__ElementHasConfig(element, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+                for (int32_t i = 0; i < element->childrenOrTextContent.children.length; ++i) {
+                    Clay__int32_tArray_Add(&dfsBuffer, element->childrenOrTextContent.children.elements[i]);
+                }
+            }
+        }
+        Clay__ParallelSizingRootArray_Add(&context->parallelSizingRoots, CLAY__INIT(Clay__ParallelSizingRoot) {
+            .floatingParent = Clay__FloatingRootParent(Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex)),
+            .scratchOffset = scratchOffset,
+            .scratchCapacity = elementCount,
+        });
+        scratchOffset += elementCount;
+    }
+
+    // Dependencies always point from a lower root index to a higher one, so waves can be assigned in a single pass
+    int32_t maxWave = 0;
+    for (int32_t rootIndex = 0; rootIndex < context->parallelSizingRoots.length; ++rootIndex) {
+        Clay__ParallelSizingRoot *sizingRoot = Clay__ParallelSizingRootArray_Get(&context->parallelSizingRoots, rootIndex);
+        if (sizingRoot->floatingParent) {
+            int32_t parentRootIndex = context->layoutElementRootIndexes.internalArray[sizingRoot->floatingParent - context->layoutElements.internalArray];
+            if (parentRootIndex < rootIndex) {
+                sizingRoot->wave = CLAY__MAX(sizingRoot->wave, Clay__ParallelSizingRootArray_Get(&context->parallelSizingRoots, parentRootIndex)->wave + 1);
+            } else if (parentRootIndex > rootIndex) {
+                Clay__ParallelSizingRoot *parentRoot = Clay__ParallelSizingRootArray_Get(&context->parallelSizingRoots, parentRootIndex);
+                parentRoot->wave = CLAY__MAX(parentRoot->wave, sizingRoot->wave + 1);
+            }
+        }
+        maxWave = CLAY__MAX(maxWave, sizingRoot->wave);
+    }
+    for (int32_t wave = 0; wave <= maxWave; ++wave) {
+        for (int32_t rootIndex = 0; rootIndex < context->parallelSizingRoots.length; ++rootIndex) {
+            if (context->parallelSizingRoots.internalArray[rootIndex].wave == wave) {
+                Clay__int32_tArray_Add(&context->parallelSizingOrder, rootIndex);
+            }
+        }
+    }
+}
+
+void Clay__SizeContainersAlongAxis(bool xAxis) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    // Cached sizes can't be used once the hash map is full, as some elements will be missing their entries
+    bool useLayoutCache = context->incrementalLayoutEnabled && context->layoutElementsHashMapInternal.length < context->layoutElementsHashMapInternal.capacity - 1;
+#ifdef CLAY_SOA_LAYOUT
+    Clay__GatherLayoutAxis(xAxis);
+#endif
+    if (context->parallelForFunction && context->layoutElementTreeRoots.length > 1) {
+        // Dependencies between roots are the same for both axes, so they're only worked out once per frame
+        if (xAxis) {
+            Clay__PrepareParallelSizing();
+        }
+        Clay__ParallelSizingTaskData taskData = { .context = context, .xAxis = xAxis, .useLayoutCache = useLayoutCache };
+        int32_t waveStart = 0;
+        while (waveStart < context->parallelSizingOrder.length) {
+            int32_t wave = context->parallelSizingRoots.internalArray[context->parallelSizingOrder.internalArray[waveStart]].wave;
+            int32_t waveEnd = waveStart;
+            while (waveEnd < context->parallelSizingOrder.length && context->parallelSizingRoots.internalArray[context->parallelSizingOrder.internalArray[waveEnd]].wave == wave) {
+                waveEnd++;
+            }
+            taskData.rootIndexes = context->parallelSizingOrder.internalArray + waveStart;
+            if (waveEnd - waveStart > 1) {
+                context->parallelForFunction(waveEnd - waveStart, Clay__ParallelSizingTask, &taskData, context->parallelForUserData);
+            } else {
+                Clay__ParallelSizingTask(0, &taskData);
             }
+            waveStart = waveEnd;
+        }
+    } else {
+        for (int32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
+            Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
+            Clay_LayoutElement *floatingParent = Clay__FloatingRootParent(Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex));
+            Clay__SizeRootAlongAxis(rootIndex, xAxis, useLayoutCache, floatingParent, context->layoutElementChildrenBuffer, context->openLayoutElementStack);
         }
     }
+#ifdef CLAY_SOA_LAYOUT
+    Clay__ScatterLayoutAxis(xAxis);
+#endif
 }
 
 Clay_String Clay__IntToString(int32_t integer) {
@@ -2475,6 +4763,9 @@ Clay_String Clay__IntToString(int32_t integer) {
         return CLAY__INIT(Clay_String) { .length = 1, .chars = "0" };
     }
     Clay_Context* context = Clay_GetCurrentContext();
+    if (context->dynamicStringData.length + 11 > context->dynamicStringData.capacity) { // Enough for a sign and 10 digits
+        return CLAY__INIT(Clay_String) { .length = 1, .chars = "?" };
+    }
     char *chars = (char *)(context->dynamicStringData.internalArray + context->dynamicStringData.length);
     int32_t length = 0;
     int32_t sign = integer;
@@ -2516,22 +4807,130 @@ void Clay__AddRenderCommand(Clay_RenderCommand renderCommand) {
     }
 }
 
-bool Clay__ElementIsOffscreen(Clay_BoundingBox *boundingBox) {
+bool Clay__ElementIsCulled(Clay_BoundingBox *boundingBox, Clay_BoundingBox *cullBox) {
     Clay_Context* context = Clay_GetCurrentContext();
     if (context->disableCulling) {
         return false;
     }
+    // An empty cull box means an enclosing clip container is entirely hidden, so nothing inside it is visible
+    if (cullBox->width < 0 || cullBox->height < 0) {
+        return true;
+    }
 
-    return (boundingBox->x > (float)context->layoutDimensions.width) ||
-           (boundingBox->y > (float)context->layoutDimensions.height) ||
-           (boundingBox->x + boundingBox->width < 0) ||
-           (boundingBox->y + boundingBox->height < 0);
+    return (boundingBox->x > cullBox->x + cullBox->width) ||
+           (boundingBox->y > cullBox->y + cullBox->height) ||
+           (boundingBox->x + boundingBox->width < cullBox->x) ||
+           (boundingBox->y + boundingBox->height < cullBox->y);
 }
 
-void Clay__CalculateFinalLayout(void) {
+bool Clay__ElementIsOffscreen(Clay_BoundingBox *boundingBox) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_BoundingBox screen = { 0, 0, context->layoutDimensions.width, context->layoutDimensions.height };
+    return Clay__ElementIsCulled(boundingBox, &screen);
+}
+
+// Narrows a cull box to the area that a clip container shows its children in, on the axes that it clips
+Clay_BoundingBox Clay__ClipCullBox(Clay_BoundingBox cullBox, Clay_BoundingBox clipBox, Clay_ClipElementConfig *clipConfig) {
+    if (clipConfig->horizontal) {
+        float left = CLAY__MAX(cullBox.x, clipBox.x);
+        float right = CLAY__MIN(cullBox.x + cullBox.width, clipBox.x + clipBox.width);
+        cullBox.x = left;
+        cullBox.width = right - left;
+    }
+    if (clipConfig->vertical) {
+        float top = CLAY__MAX(cullBox.y, clipBox.y);
+        float bottom = CLAY__MIN(cullBox.y + cullBox.height, clipBox.y + clipBox.height);
+        cullBox.y = top;
+        cullBox.height = bottom - top;
+    }
+    return cullBox;
+}
+
+// Treats the layout tree as a bounding volume hierarchy for hit testing, by storing the union of the final bounding boxes of each element and its descendants.
+// Children are always declared after their parents, so walking the elements backwards visits every child before its parent.
+void Clay__CalculateSubtreeBounds(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    for (int32_t elementIndex = context->layoutElements.length - 1; elementIndex >= 0; --elementIndex) {
+        Clay_LayoutElement *layoutElement = &context->layoutElements.internalArray[elementIndex];
+        Clay__SubtreeBounds bounds = { -CLAY__MAXFLOAT, -CLAY__MAXFLOAT, CLAY__MAXFLOAT, CLAY__MAXFLOAT };
+        // Elements without their own hash map item are hit tested against whichever item shares their ID, so they are never skipped
+        if (layoutElement->hashMapItem) {
+            Clay_BoundingBox boundingBox = layoutElement->hashMapItem->boundingBox;
+            bounds = CLAY__INIT(Clay__SubtreeBounds) { boundingBox.x, boundingBox.y, boundingBox.x + boundingBox.width, boundingBox.y + boundingBox.height };
+        }
+        // Elements left open when the layout was aborted by a capacity error never had their children array attached
+        if (!Clay__ElementHasConfig(layoutElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) && layoutElement->childrenOrTextContent.children.elements) {
+            for (int32_t i = 0; i < layoutElement->childrenOrTextContent.children.length; ++i) {
+                Clay__SubtreeBounds childBounds = context->layoutElementSubtreeBounds.internalArray[layoutElement->childrenOrTextContent.children.elements[i]];
+                bounds.left = CLAY__MIN(bounds.left, childBounds.left);
+                bounds.top = CLAY__MIN(bounds.top, childBounds.top);
+                bounds.right = CLAY__MAX(bounds.right, childBounds.right);
+                bounds.bottom = CLAY__MAX(bounds.bottom, childBounds.bottom);
+            }
+        }
+        Clay__SubtreeBoundsArray_Set(&context->layoutElementSubtreeBounds, elementIndex, bounds);
+    }
+}
+
+// Appends the lines cached by the last wrap of this text, if it was wrapped to the same width. Returns false if the lines need to be wrapped again.
+bool Clay__RestoreWrappedLines(Clay__MeasureTextCacheItem *measured, Clay__TextElementData *textElementData, float width, float lineHeight) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (measured->id == 0 || measured->wrappedLinesStartIndex == -1 || measured->wrappedWidth != width || context->wrappedTextLines.length + measured->wrappedLineCount > context->wrappedTextLines.capacity) {
+        return false;
+    }
+    int32_t lineIndex = measured->wrappedLinesStartIndex;
+    while (lineIndex != -1) {
+        Clay__MeasuredWord *line = Clay__MeasuredWordArray_Get(&context->wrappedLineCache, lineIndex);
+        Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { line->width, lineHeight }, { .length = line->length, .chars = &textElementData->text.chars[line->startOffset] } });
+        lineIndex = line->next;
+    }
+    textElementData->wrappedLines.length = measured->wrappedLineCount;
+    return true;
+}
+
+// Stores freshly wrapped lines in the measure text cache so that following frames can skip wrapping while the width is unchanged.
+// Lines are kept as offsets into the text, as the string contents may be the same while the chars pointer changes between frames.
+void Clay__CacheWrappedLines(Clay__MeasureTextCacheItem *measured, Clay__TextElementData *textElementData, float width) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (measured->id == 0) {
+        return;
+    }
+    Clay__FreeWrappedLines(measured->wrappedLinesStartIndex);
+    measured->wrappedLinesStartIndex = -1;
+    // Text that doesn't fit in the line storage is simply wrapped again next frame
+    Clay__MeasuredWordArray *lines = &context->wrappedLineCache;
+    Clay__int32_tArray *freeList = &context->wrappedLineCacheFreeList;
+    if (freeList->length + (lines->capacity - lines->length) < textElementData->wrappedLines.length) {
+        return;
+    }
+    Clay__MeasuredWord tempLine = { .next = -1 };
+    Clay__MeasuredWord *previousLine = &tempLine;
+    for (int32_t i = 0; i < textElementData->wrappedLines.length; ++i) {
+        Clay__WrappedTextLine *line = &textElementData->wrappedLines.internalArray[i];
+        Clay__MeasuredWord cachedLine = { .startOffset = (int32_t)(line->line.chars - textElementData->text.chars), .length = line->line.length, .width = line->dimensions.width, .next = -1 };
+        int32_t lineIndex;
+        if (freeList->length > 0) {
+            lineIndex = Clay__int32_tArray_GetValue(freeList, freeList->length - 1);
+            freeList->length--;
+            Clay__MeasuredWordArray_Set(lines, lineIndex, cachedLine);
+        } else {
+            lineIndex = lines->length;
+            Clay__MeasuredWordArray_Add(lines, cachedLine);
+        }
+        previousLine->next = lineIndex;
+        previousLine = Clay__MeasuredWordArray_Get(lines, lineIndex);
+    }
+    measured->wrappedLinesStartIndex = tempLine.next;
+    measured->wrappedLineCount = textElementData->wrappedLines.length;
+    measured->wrappedWidth = width;
+}
+
+// Calculates the final size of every element, which only depends on the declarations that are hashed by Clay__HashLayoutDeclaration()
+void Clay__CalculateElementSizes(void) {
     Clay_Context* context = Clay_GetCurrentContext();
     // Calculate sizing along the X axis
     Clay__SizeContainersAlongAxis(true);
+    CLAY__PROFILE_END(sizingXTime);
 
     // Wrap text
     for (int32_t textElementIndex = 0; textElementIndex < context->textElementData.length; ++textElementIndex) {
@@ -2544,15 +4943,33 @@ void Clay__CalculateFinalLayout(void) {
         float lineHeight = textConfig->lineHeight > 0 ? (float)textConfig->lineHeight : textElementData->preferredDimensions.height;
         int32_t lineLengthChars = 0;
         int32_t lineStartOffset = 0;
+        if (measureTextCacheItem->measurementPending) {
+            // Reserve space for the estimated number of lines, but don't draw anything until the text has been measured
+            float width = textElementData->preferredDimensions.width;
+            float containerWidth = CLAY__MAX(containerElement->dimensions.width, 1);
+            int32_t lineCount = (int32_t)(width / containerWidth);
+            lineCount += (float)lineCount * containerWidth < width ? 1 : 0;
+            containerElement->dimensions.height = lineHeight * (float)CLAY__MAX(lineCount, 1);
+            continue;
+        }
         if (!measureTextCacheItem->containsNewlines && textElementData->preferredDimensions.width <= containerElement->dimensions.width) {
+            if (Clay__CapacityExceeded(context->wrappedTextLines.length, context->wrappedTextLines.capacity)) {
+                continue;
+            }
             Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { containerElement->dimensions,  textElementData->text });
             textElementData->wrappedLines.length++;
             continue;
         }
-        float spaceWidth = Clay__MeasureText(CLAY__INIT(Clay_StringSlice) { .length = 1, .chars = CLAY__SPACECHAR.chars, .baseChars = CLAY__SPACECHAR.chars }, textConfig, context->measureTextUserData).width;
+        if (Clay__RestoreWrappedLines(measureTextCacheItem, textElementData, containerElement->dimensions.width, lineHeight)) {
+            containerElement->dimensions.height = lineHeight * (float)textElementData->wrappedLines.length;
+            continue;
+        }
+        float spaceWidth = measureTextCacheItem->spaceWidth;
         int32_t wordIndex = measureTextCacheItem->measuredWordsStartIndex;
+        bool linesOverflowed = false;
         while (wordIndex != -1) {
-            if (context->wrappedTextLines.length > context->wrappedTextLines.capacity - 1) {
+            if (Clay__CapacityExceeded(context->wrappedTextLines.length, context->wrappedTextLines.capacity)) {
+                linesOverflowed = true;
                 break;
             }
             Clay__MeasuredWord *measuredWord = Clay__MeasuredWordArray_Get(&context->measuredWords, wordIndex);
@@ -2581,12 +4998,16 @@ void Clay__CalculateFinalLayout(void) {
                 wordIndex = measuredWord->next;
             }
         }
-        if (lineLengthChars > 0) {
+        if (lineLengthChars > 0 && !Clay__CapacityExceeded(context->wrappedTextLines.length, context->wrappedTextLines.capacity)) {
             Clay__WrappedTextLineArray_Add(&context->wrappedTextLines, CLAY__INIT(Clay__WrappedTextLine) { { lineWidth - textConfig->letterSpacing, lineHeight }, {.length = lineLengthChars, .chars = &textElementData->text.chars[lineStartOffset] } });
             textElementData->wrappedLines.length++;
         }
+        if (!linesOverflowed) {
+            Clay__CacheWrappedLines(measureTextCacheItem, textElementData, containerElement->dimensions.width);
+        }
         containerElement->dimensions.height = lineHeight * (float)textElementData->wrappedLines.length;
     }
+    CLAY__PROFILE_END(textWrapTime);
 
     // Scale vertical heights according to aspect ratio
     for (int32_t i = 0; i < context->aspectRatioElementIndexes.length; ++i) {
@@ -2595,6 +5016,7 @@ void Clay__CalculateFinalLayout(void) {
         aspectElement->dimensions.height = (1 / config->aspectRatio) * aspectElement->dimensions.width;
         aspectElement->layoutConfig->sizing.height.size.minMax.max = aspectElement->dimensions.height;
     }
+    CLAY__PROFILE_END(aspectRatioTime);
 
     // Propagate effect of text wrapping, aspect scaling etc. on height of parents
     Clay__LayoutElementTreeNodeArray dfsBuffer = context->layoutElementTreeNodeArray1;
@@ -2646,6 +5068,7 @@ void Clay__CalculateFinalLayout(void) {
 
     // Calculate sizing along the Y axis
     Clay__SizeContainersAlongAxis(false);
+    CLAY__PROFILE_END(sizingYTime);
 
     // Scale horizontal widths according to aspect ratio
     for (int32_t i = 0; i < context->aspectRatioElementIndexes.length; ++i) {
@@ -2653,6 +5076,83 @@ void Clay__CalculateFinalLayout(void) {
         Clay_AspectRatioElementConfig *config = Clay__FindElementConfigWithType(aspectElement, CLAY__ELEMENT_CONFIG_TYPE_ASPECT).aspectRatioElementConfig;
         aspectElement->dimensions.width = config->aspectRatio * aspectElement->dimensions.height;
     }
+    CLAY__PROFILE_END(aspectRatioTime);
+}
+
+uint32_t Clay__HashLayoutDeclaration(void);
+
+// Restores the sizes calculated during the previous frame if nothing that affects the size of any element has been declared differently since,
+// which is the case when only scroll offsets or visual properties have changed. Returns false if the sizes need to be calculated.
+bool Clay__RestoreRetainedLayoutSizes(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (!context->incrementalLayoutEnabled) {
+        context->retainedLayoutSizesValid = false;
+        return false;
+    }
+    uint32_t declarationHash = Clay__HashLayoutDeclaration();
+    bool sizesValid = context->retainedLayoutSizesValid
+        && declarationHash == context->retainedLayoutDeclarationHash
+        && context->retainedLayoutDimensions.length == context->layoutElements.length
+        && context->retainedWrappedLineCounts.length == context->textElementData.length;
+    context->retainedLayoutDeclarationHash = declarationHash;
+    if (!sizesValid) {
+        return false;
+    }
+    for (int32_t i = 0; i < context->layoutElements.length; ++i) {
+        Clay_LayoutElement *layoutElement = &context->layoutElements.internalArray[i];
+        layoutElement->dimensions = context->retainedLayoutDimensions.internalArray[i];
+        // Sizes cached for incremental layout are still valid for the next frame
+        if (layoutElement->hashMapItem && layoutElement->hashMapItem->layoutCacheGeneration == context->generation - 1) {
+            layoutElement->hashMapItem->layoutCacheGeneration = context->generation;
+        }
+    }
+    for (int32_t i = 0; i < context->retainedWrappedTextLines.length; ++i) {
+        context->wrappedTextLines.internalArray[i] = context->retainedWrappedTextLines.internalArray[i];
+    }
+    context->wrappedTextLines.length = context->retainedWrappedTextLines.length;
+    // Each text element's lines directly follow those of the text element before it
+    int32_t lineStart = 0;
+    for (int32_t i = 0; i < context->textElementData.length; ++i) {
+        int32_t lineCount = context->retainedWrappedLineCounts.internalArray[i];
+        context->textElementData.internalArray[i].wrappedLines = CLAY__INIT(Clay__WrappedTextLineArraySlice) { .length = lineCount, .internalArray = &context->wrappedTextLines.internalArray[lineStart] };
+        lineStart += lineCount;
+    }
+    context->currentFrameStats.layoutSizesReused = true;
+    return true;
+}
+
+void Clay__RetainLayoutSizes(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (!context->incrementalLayoutEnabled) {
+        return;
+    }
+    // Text that ran out of wrapped lines was cut short, so its sizes shouldn't be reused
+    if (context->booleanWarnings.maxElementsExceeded) {
+        context->retainedLayoutSizesValid = false;
+        return;
+    }
+    for (int32_t i = 0; i < context->layoutElements.length; ++i) {
+        context->retainedLayoutDimensions.internalArray[i] = context->layoutElements.internalArray[i].dimensions;
+    }
+    context->retainedLayoutDimensions.length = context->layoutElements.length;
+    for (int32_t i = 0; i < context->wrappedTextLines.length; ++i) {
+        context->retainedWrappedTextLines.internalArray[i] = context->wrappedTextLines.internalArray[i];
+    }
+    context->retainedWrappedTextLines.length = context->wrappedTextLines.length;
+    for (int32_t i = 0; i < context->textElementData.length; ++i) {
+        context->retainedWrappedLineCounts.internalArray[i] = context->textElementData.internalArray[i].wrappedLines.length;
+    }
+    context->retainedWrappedLineCounts.length = context->textElementData.length;
+    context->retainedLayoutSizesValid = true;
+}
+
+void Clay__CalculateFinalLayout(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    CLAY__PROFILE_BEGIN();
+    if (!Clay__RestoreRetainedLayoutSizes()) {
+        Clay__CalculateElementSizes();
+        Clay__RetainLayoutSizes();
+    }
 
     // Sort tree roots by z-index
     int32_t sortMax = context->layoutElementTreeRoots.length - 1;
@@ -2670,6 +5170,7 @@ void Clay__CalculateFinalLayout(void) {
 
     // Calculate final positions and generate render commands
     context->renderCommands.length = 0;
+    Clay__LayoutElementTreeNodeArray dfsBuffer = context->layoutElementTreeNodeArray1;
     dfsBuffer.length = 0;
     for (int32_t rootIndex = 0; rootIndex < context->layoutElementTreeRoots.length; ++rootIndex) {
         dfsBuffer.length = 0;
@@ -2732,9 +5233,11 @@ void Clay__CalculateFinalLayout(void) {
             targetAttachPosition.y += config->offset.y;
             rootPosition = targetAttachPosition;
         }
+        Clay_BoundingBox rootCullBox = { 0, 0, context->layoutDimensions.width, context->layoutDimensions.height };
         if (root->clipElementId) {
             Clay_LayoutElementHashMapItem *clipHashMapItem = Clay__GetHashMapItem(root->clipElementId);
             if (clipHashMapItem) {
+                rootCullBox = Clay__ClipCullBox(rootCullBox, clipHashMapItem->boundingBox, Clay__FindElementConfigWithType(clipHashMapItem->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_CLIP).clipElementConfig);
                 // Floating elements that are attached to scrolling contents won't be correctly positioned if external scroll handling is enabled, fix here
                 if (context->externalScrollHandlingEnabled) {
                     Clay_ClipElementConfig *clipConfig = Clay__FindElementConfigWithType(clipHashMapItem->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_CLIP).clipElementConfig;
@@ -2754,7 +5257,7 @@ void Clay__CalculateFinalLayout(void) {
                 });
             }
         }
-        Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = rootElement, .position = rootPosition, .nextChildOffset = { .x = (float)rootElement->layoutConfig->padding.left, .y = (float)rootElement->layoutConfig->padding.top } });
+        Clay__LayoutElementTreeNodeArray_Add(&dfsBuffer, CLAY__INIT(Clay__LayoutElementTreeNode) { .layoutElement = rootElement, .position = rootPosition, .nextChildOffset = { .x = (float)rootElement->layoutConfig->padding.left, .y = (float)rootElement->layoutConfig->padding.top }, .cullBox = rootCullBox });
 
         context->treeNodeVisited.internalArray[0] = false;
         while (dfsBuffer.length > 0) {
@@ -2762,6 +5265,7 @@ void Clay__CalculateFinalLayout(void) {
             Clay_LayoutElement *currentElement = currentElementTreeNode->layoutElement;
             Clay_LayoutConfig *layoutConfig = currentElement->layoutConfig;
             Clay_Vector2 scrollOffset = CLAY__DEFAULT_STRUCT;
+            Clay_BoundingBox childCullBox = currentElementTreeNode->cullBox;
 
             // This will only be run a single time for each element in downwards DFS order
             if (!context->treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
@@ -2781,6 +5285,7 @@ void Clay__CalculateFinalLayout(void) {
                 // Apply scroll offsets to container
                 if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_CLIP)) {
                     Clay_ClipElementConfig *clipConfig = Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_CLIP).clipElementConfig;
+                    childCullBox = Clay__ClipCullBox(childCullBox, currentElementBoundingBox, clipConfig);
 
                     // This linear scan could theoretically be slow under very strange conditions, but I can't imagine a real UI with more than a few 10's of scroll containers
                     for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
@@ -2802,11 +5307,14 @@ void Clay__CalculateFinalLayout(void) {
                     hashMapItem->boundingBox = currentElementBoundingBox;
                 }
 
+                // Culling - Don't bother to generate render commands for elements entirely outside the screen or their clip containers.
+                // This won't stop their children from being rendered if they overflow, unless this element clips them as well.
+                bool offscreen = Clay__ElementIsCulled(&currentElementBoundingBox, &currentElementTreeNode->cullBox);
                 int32_t sortedConfigIndexes[20];
-                for (int32_t elementConfigIndex = 0; elementConfigIndex < currentElement->elementConfigs.length; ++elementConfigIndex) {
+                for (int32_t elementConfigIndex = 0; !offscreen && elementConfigIndex < currentElement->elementConfigs.length; ++elementConfigIndex) {
                     sortedConfigIndexes[elementConfigIndex] = elementConfigIndex;
                 }
-                sortMax = currentElement->elementConfigs.length - 1;
+                sortMax = offscreen ? 0 : currentElement->elementConfigs.length - 1;
                 while (sortMax > 0) { // todo dumb bubble sort
                     for (int32_t i = 0; i < sortMax; ++i) {
                         int32_t current = sortedConfigIndexes[i];
@@ -2831,7 +5339,7 @@ void Clay__CalculateFinalLayout(void) {
                     emitRectangle = false;
                     sharedConfig = &Clay_SharedElementConfig_DEFAULT;
                 }
-                for (int32_t elementConfigIndex = 0; elementConfigIndex < currentElement->elementConfigs.length; ++elementConfigIndex) {
+                for (int32_t elementConfigIndex = 0; !offscreen && elementConfigIndex < currentElement->elementConfigs.length; ++elementConfigIndex) {
                     Clay_ElementConfig *elementConfig = Clay__ElementConfigArraySlice_Get(&currentElement->elementConfigs, sortedConfigIndexes[elementConfigIndex]);
                     Clay_RenderCommand renderCommand = {
                         .boundingBox = currentElementBoundingBox,
@@ -2839,9 +5347,7 @@ void Clay__CalculateFinalLayout(void) {
                         .id = currentElement->id,
                     };
 
-                    bool offscreen = Clay__ElementIsOffscreen(&currentElementBoundingBox);
-                    // Culling - Don't bother to generate render commands for rectangles entirely outside the screen - this won't stop their children from being rendered if they overflow
-                    bool shouldRender = !offscreen;
+                    bool shouldRender = true;
                     switch (elementConfig->type) {
                         case CLAY__ELEMENT_CONFIG_TYPE_ASPECT:
                         case CLAY__ELEMENT_CONFIG_TYPE_FLOATING:
@@ -2873,9 +5379,6 @@ void Clay__CalculateFinalLayout(void) {
                             break;
                         }
                         case CLAY__ELEMENT_CONFIG_TYPE_TEXT: {
-                            if (!shouldRender) {
-                                break;
-                            }
                             shouldRender = false;
                             Clay_ElementConfigUnion configUnion = elementConfig->config;
                             Clay_TextElementConfig *textElementConfig = configUnion.textElementConfig;
@@ -2883,9 +5386,11 @@ void Clay__CalculateFinalLayout(void) {
                             float finalLineHeight = textElementConfig->lineHeight > 0 ? (float)textElementConfig->lineHeight : naturalLineHeight;
                             float lineHeightOffset = (finalLineHeight - naturalLineHeight) / 2;
                             float yPosition = lineHeightOffset;
+                            Clay_BoundingBox *cullBox = &currentElementTreeNode->cullBox;
                             for (int32_t lineIndex = 0; lineIndex < currentElement->childrenOrTextContent.textElementData->wrappedLines.length; ++lineIndex) {
                                 Clay__WrappedTextLine *wrappedLine = Clay__WrappedTextLineArraySlice_Get(&currentElement->childrenOrTextContent.textElementData->wrappedLines, lineIndex);
-                                if (wrappedLine->line.length == 0) {
+                                // Lines scrolled above the cull box are skipped individually, lines below it end the loop
+                                if (wrappedLine->line.length == 0 || (!context->disableCulling && currentElementBoundingBox.y + yPosition + wrappedLine->dimensions.height < cullBox->y)) {
                                     yPosition += finalLineHeight;
                                     continue;
                                 }
@@ -2913,7 +5418,7 @@ void Clay__CalculateFinalLayout(void) {
                                 });
                                 yPosition += finalLineHeight;
 
-                                if (!context->disableCulling && (currentElementBoundingBox.y + yPosition > context->layoutDimensions.height)) {
+                                if (!context->disableCulling && (currentElementBoundingBox.y + yPosition > cullBox->y + cullBox->height)) {
                                     break;
                                 }
                             }
@@ -2936,14 +5441,13 @@ void Clay__CalculateFinalLayout(void) {
                     if (shouldRender) {
                         Clay__AddRenderCommand(renderCommand);
                     }
-                    if (offscreen) {
-                        // NOTE: You may be tempted to try an early return / continue if an element is off screen. Why bother calculating layout for its children, right?
-                        // Unfortunately, a FLOATING_CONTAINER may be defined that attaches to a child or grandchild of this element, which is large enough to still
-                        // be on screen, even if this element isn't. That depends on this element and it's children being laid out correctly (even if they are entirely off screen)
-                    }
                 }
+                // NOTE: You may be tempted to try an early return / continue if an element is off screen. Why bother calculating layout for its children, right?
+                // Unfortunately, a FLOATING_CONTAINER may be defined that attaches to a child or grandchild of this element, which is large enough to still
+                // be on screen, even if this element isn't. That depends on this element and it's children being laid out correctly (even if they are entirely off screen)
+                // Children of a hidden clip container inherit an empty cullBox instead, which skips their render commands without skipping their layout.
 
-                if (emitRectangle) {
+                if (emitRectangle && !offscreen) {
                     Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) {
                         .boundingBox = currentElementBoundingBox,
                         .renderData = { .rectangle = {
@@ -3002,7 +5506,8 @@ void Clay__CalculateFinalLayout(void) {
                 bool closeClipElement = false;
                 Clay_ClipElementConfig *clipConfig = Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_CLIP).clipElementConfig;
                 if (clipConfig) {
-                    closeClipElement = true;
+                    // The scissor only needs to end if it was started, i.e. this element wasn't culled
+                    closeClipElement = !Clay__ElementIsCulled(&Clay__GetHashMapItem(currentElement->id)->boundingBox, &currentElementTreeNode->cullBox);
                     for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
                         Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
                         if (mapping->layoutElement == currentElement) {
@@ -3019,8 +5524,8 @@ void Clay__CalculateFinalLayout(void) {
                     Clay_LayoutElementHashMapItem *currentElementData = Clay__GetHashMapItem(currentElement->id);
                     Clay_BoundingBox currentElementBoundingBox = currentElementData->boundingBox;
 
-                    // Culling - Don't bother to generate render commands for rectangles entirely outside the screen - this won't stop their children from being rendered if they overflow
-                    if (!Clay__ElementIsOffscreen(&currentElementBoundingBox)) {
+                    // Culling - Don't bother to generate render commands for borders entirely outside the screen or their clip containers
+                    if (!Clay__ElementIsCulled(&currentElementBoundingBox, &currentElementTreeNode->cullBox)) {
                         Clay_SharedElementConfig *sharedConfig = Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SHARED) ? Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_SHARED).sharedElementConfig : &Clay_SharedElementConfig_DEFAULT;
                         Clay_BorderElementConfig *borderConfig = Clay__FindElementConfigWithType(currentElement, CLAY__ELEMENT_CONFIG_TYPE_BORDER).borderElementConfig;
                         Clay_RenderCommand renderCommand = {
@@ -3121,6 +5626,7 @@ void Clay__CalculateFinalLayout(void) {
                         .layoutElement = childElement,
                         .position = { childPosition.x, childPosition.y },
                         .nextChildOffset = { .x = (float)childElement->layoutConfig->padding.left, .y = (float)childElement->layoutConfig->padding.top },
+                        .cullBox = childCullBox,
                     };
                     context->treeNodeVisited.internalArray[newNodeIndex] = false;
 
@@ -3138,6 +5644,274 @@ void Clay__CalculateFinalLayout(void) {
             Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) { .id = Clay__HashNumber(rootElement->id, rootElement->childrenOrTextContent.children.length + 11).id, .commandType = CLAY_RENDER_COMMAND_TYPE_SCISSOR_END });
         }
     }
+
+    Clay__CalculateSubtreeBounds();
+    CLAY__PROFILE_END(positioningTime);
+}
+
+uint32_t Clay__HashColor(uint32_t hash, Clay_Color color) {
+    hash = Clay__HashMixFloat(hash, color.r);
+    hash = Clay__HashMixFloat(hash, color.g);
+    hash = Clay__HashMixFloat(hash, color.b);
+    return Clay__HashMixFloat(hash, color.a);
+}
+
+uint32_t Clay__HashCornerRadius(uint32_t hash, Clay_CornerRadius cornerRadius) {
+    hash = Clay__HashMixFloat(hash, cornerRadius.topLeft);
+    hash = Clay__HashMixFloat(hash, cornerRadius.topRight);
+    hash = Clay__HashMixFloat(hash, cornerRadius.bottomLeft);
+    return Clay__HashMixFloat(hash, cornerRadius.bottomRight);
+}
+
+uint32_t Clay__HashPointer(uint32_t hash, const void *pointer) {
+    uint64_t value = (uint64_t)(uintptr_t)pointer;
+    hash = Clay__HashMixValue(hash, (uint32_t)value);
+    return Clay__HashMixValue(hash, (uint32_t)(value >> 32));
+}
+
+// Hashes everything about a render command except its id and bounding box, field by field so that padding and inactive union members are ignored
+uint32_t Clay__HashRenderCommandContents(Clay_RenderCommand *renderCommand) {
+    uint32_t hash = Clay__HashMixValue(renderCommand->commandType, (uint16_t)renderCommand->zIndex);
+    hash = Clay__HashPointer(hash, renderCommand->userData);
+    Clay_RenderData *renderData = &renderCommand->renderData;
+    switch (renderCommand->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            hash = Clay__HashColor(hash, renderData->rectangle.backgroundColor);
+            hash = Clay__HashCornerRadius(hash, renderData->rectangle.cornerRadius);
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            hash = Clay__HashColor(hash, renderData->border.color);
+            hash = Clay__HashCornerRadius(hash, renderData->border.cornerRadius);
+            hash = Clay__HashMixValue(hash, renderData->border.width.left | ((uint32_t)renderData->border.width.right << 16));
+            hash = Clay__HashMixValue(hash, renderData->border.width.top | ((uint32_t)renderData->border.width.bottom << 16));
+            hash = Clay__HashMixValue(hash, renderData->border.width.betweenChildren);
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            // Text is hashed by contents rather than by pointer, as dynamic strings are usually reallocated every frame
+            uint64_t textHash = Clay__HashData((const uint8_t *)renderData->text.stringContents.chars, renderData->text.stringContents.length);
+            hash = Clay__HashMixValue(hash, (uint32_t)textHash);
+            hash = Clay__HashMixValue(hash, (uint32_t)(textHash >> 32));
+            hash = Clay__HashMixValue(hash, renderData->text.stringContents.length);
+            hash = Clay__HashColor(hash, renderData->text.textColor);
+            hash = Clay__HashMixValue(hash, renderData->text.fontId | ((uint32_t)renderData->text.fontSize << 16));
+            hash = Clay__HashMixValue(hash, renderData->text.letterSpacing | ((uint32_t)renderData->text.lineHeight << 16));
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
+            hash = Clay__HashColor(hash, renderData->image.backgroundColor);
+            hash = Clay__HashCornerRadius(hash, renderData->image.cornerRadius);
+            hash = Clay__HashPointer(hash, renderData->image.imageData);
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
+            hash = Clay__HashColor(hash, renderData->custom.backgroundColor);
+            hash = Clay__HashCornerRadius(hash, renderData->custom.cornerRadius);
+            hash = Clay__HashPointer(hash, renderData->custom.customData);
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
+            hash = Clay__HashMixValue(hash, renderData->clip.horizontal | (renderData->clip.vertical << 1));
+            break;
+        }
+        default: break;
+    }
+    return Clay__HashMixFinish(hash);
+}
+
+// Hashes everything declared this frame that can affect the size of an element, including the structure of the tree.
+// Positions and render commands are generated from the current declarations every frame, so visual properties and clip child offsets are left out.
+uint32_t Clay__HashLayoutDeclaration(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    uint32_t hash = Clay__HashMixValue(0, (uint32_t)context->layoutElements.length);
+    for (int32_t i = 0; i < context->layoutElements.length; ++i) {
+        Clay_LayoutElement *layoutElement = &context->layoutElements.internalArray[i];
+        Clay_LayoutConfig *layoutConfig = layoutElement->layoutConfig;
+        hash = Clay__HashMixValue(hash, layoutElement->id);
+        hash = Clay__HashMixFloat(hash, layoutElement->dimensions.width);
+        hash = Clay__HashMixFloat(hash, layoutElement->dimensions.height);
+        hash = Clay__HashMixFloat(hash, layoutElement->minDimensions.width);
+        hash = Clay__HashMixFloat(hash, layoutElement->minDimensions.height);
+        hash = Clay__HashLayoutSizingAxis(hash, layoutConfig->sizing.width);
+        hash = Clay__HashLayoutSizingAxis(hash, layoutConfig->sizing.height);
+        hash = Clay__HashMixValue(hash, layoutConfig->padding.left | ((uint32_t)layoutConfig->padding.right << 16));
+        hash = Clay__HashMixValue(hash, layoutConfig->padding.top | ((uint32_t)layoutConfig->padding.bottom << 16));
+        hash = Clay__HashMixValue(hash, layoutConfig->childGap | ((uint32_t)layoutConfig->layoutDirection << 16));
+        hash = Clay__HashMixValue(hash, layoutElement->floatingChildrenCount);
+        bool isTextElement = false;
+        for (int32_t j = 0; j < layoutElement->elementConfigs.length; j++) {
+            Clay_ElementConfig *config = &layoutElement->elementConfigs.internalArray[j];
+            switch (config->type) {
+                case CLAY__ELEMENT_CONFIG_TYPE_CLIP: {
+                    hash = Clay__HashMixValue(hash, config->type | (config->config.clipElementConfig->horizontal << 8) | (config->config.clipElementConfig->vertical << 9));
+                    break;
+                }
+                case CLAY__ELEMENT_CONFIG_TYPE_ASPECT: {
+                    hash = Clay__HashMixFloat(Clay__HashMixValue(hash, config->type), config->config.aspectRatioElementConfig->aspectRatio);
+                    break;
+                }
+                case CLAY__ELEMENT_CONFIG_TYPE_FLOATING: {
+                    hash = Clay__HashMixValue(hash, config->type);
+                    break;
+                }
+                case CLAY__ELEMENT_CONFIG_TYPE_TEXT: {
+                    // Wrapped lines point into the text, so the same memory has to be used as well as the same contents
+                    Clay_TextElementConfig *textConfig = config->config.textElementConfig;
+                    Clay_String *text = &layoutElement->childrenOrTextContent.textElementData->text;
+                    hash = Clay__HashMixValue(hash, config->type | (textConfig->wrapMode << 8) | ((uint32_t)textConfig->lineHeight << 16));
+                    hash = Clay__HashMixValue(hash, Clay__HashStringContentsWithConfig(text, textConfig));
+                    hash = Clay__HashPointer(Clay__HashMixValue(hash, (uint32_t)text->length), text->chars);
+                    isTextElement = true;
+                    break;
+                }
+                default: break;
+            }
+        }
+        if (!isTextElement) {
+            for (int32_t j = 0; j < layoutElement->childrenOrTextContent.children.length; j++) {
+                hash = Clay__HashMixValue(hash, (uint32_t)layoutElement->childrenOrTextContent.children.elements[j]);
+            }
+        }
+    }
+    // Floating roots are sized relative to the element they're attached to
+    for (int32_t i = 0; i < context->layoutElementTreeRoots.length; ++i) {
+        Clay__LayoutElementTreeRoot *root = &context->layoutElementTreeRoots.internalArray[i];
+        hash = Clay__HashMixValue(Clay__HashMixValue(hash, (uint32_t)root->layoutElementIndex), root->parentId);
+    }
+    return Clay__HashMixFinish(hash);
+}
+
+bool Clay__BoundingBoxesOverlap(Clay_BoundingBox a, Clay_BoundingBox b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+Clay_BoundingBox Clay__BoundingBoxUnion(Clay_BoundingBox a, Clay_BoundingBox b) {
+    float left = CLAY__MIN(a.x, b.x);
+    float top = CLAY__MIN(a.y, b.y);
+    float right = CLAY__MAX(a.x + a.width, b.x + b.width);
+    float bottom = CLAY__MAX(a.y + a.height, b.y + b.height);
+    return CLAY__INIT(Clay_BoundingBox) { left, top, right - left, bottom - top };
+}
+
+void Clay__AddDirtyRect(Clay_BoundingBox rect) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_BoundingBoxArray *dirtyRects = &context->dirtyRects;
+    // Nothing outside the layout dimensions is ever visible, so clamp to them
+    float left = CLAY__MAX(rect.x, 0);
+    float top = CLAY__MAX(rect.y, 0);
+    float right = CLAY__MIN(rect.x + rect.width, context->layoutDimensions.width);
+    float bottom = CLAY__MIN(rect.y + rect.height, context->layoutDimensions.height);
+    if (right <= left || bottom <= top) {
+        return;
+    }
+    rect = CLAY__INIT(Clay_BoundingBox) { left, top, right - left, bottom - top };
+    while (true) {
+        // Absorb every rect that this one overlaps, so that the list stays disjoint
+        bool merged = false;
+        for (int32_t i = 0; i < dirtyRects->length; ++i) {
+            if (Clay__BoundingBoxesOverlap(rect, dirtyRects->internalArray[i])) {
+                rect = Clay__BoundingBoxUnion(rect, Clay_BoundingBoxArray_RemoveSwapback(dirtyRects, i));
+                merged = true;
+                break;
+            }
+        }
+        if (merged) {
+            continue;
+        }
+        if (dirtyRects->length < dirtyRects->capacity) {
+            Clay_BoundingBoxArray_Add(dirtyRects, rect);
+            return;
+        }
+        // The list is full, so fold this rect into whichever existing rect grows the least by doing so
+        int32_t bestIndex = 0;
+        float bestGrowth = CLAY__MAXFLOAT;
+        for (int32_t i = 0; i < dirtyRects->length; ++i) {
+            Clay_BoundingBox existing = dirtyRects->internalArray[i];
+            Clay_BoundingBox combined = Clay__BoundingBoxUnion(rect, existing);
+            float growth = combined.width * combined.height - existing.width * existing.height;
+            if (growth < bestGrowth) {
+                bestGrowth = growth;
+                bestIndex = i;
+            }
+        }
+        rect = Clay__BoundingBoxUnion(rect, Clay_BoundingBoxArray_RemoveSwapback(dirtyRects, bestIndex));
+    }
+}
+
+void Clay__AddRenderCommandChange(Clay_RenderCommandChange change, Clay_BoundingBox currentBoundingBox) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_RenderCommandChangeArray_Add(&context->renderCommandChanges, change);
+    if (change.changeType != CLAY_RENDER_COMMAND_CHANGE_REMOVED) {
+        Clay__AddDirtyRect(currentBoundingBox);
+    }
+    if (change.changeType != CLAY_RENDER_COMMAND_CHANGE_ADDED) {
+        Clay__AddDirtyRect(change.previousBoundingBox);
+    }
+}
+
+// Compares this frame's render commands against the snapshots taken during the previous call, then replaces those snapshots with this frame's
+void Clay__DiffRenderCommands(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__RenderCommandSnapshotArray *previousSnapshots = &context->previousRenderCommandSnapshots;
+    Clay__RenderCommandSnapshotArray *currentSnapshots = &context->renderCommandSnapshots;
+    Clay__int32_tArray *hashMap = &context->renderCommandSnapshotHashMap;
+    context->renderCommandChanges.length = 0;
+    context->dirtyRects.length = 0;
+
+    // Index the previous frame's snapshots by id
+    for (int32_t i = 0; i < hashMap->capacity; ++i) {
+        hashMap->internalArray[i] = -1;
+    }
+    for (int32_t i = 0; i < previousSnapshots->length; ++i) {
+        Clay__RenderCommandSnapshot *snapshot = &previousSnapshots->internalArray[i];
+        uint32_t hashBucket = snapshot->id % hashMap->capacity;
+        snapshot->nextIndex = hashMap->internalArray[hashBucket];
+        snapshot->matched = false;
+        hashMap->internalArray[hashBucket] = i;
+    }
+
+    currentSnapshots->length = 0;
+    for (int32_t i = 0; i < context->renderCommands.length; ++i) {
+        Clay_RenderCommand *renderCommand = &context->renderCommands.internalArray[i];
+        Clay__RenderCommandSnapshot *snapshot = Clay__RenderCommandSnapshotArray_Add(currentSnapshots, CLAY__INIT(Clay__RenderCommandSnapshot) {
+            .boundingBox = renderCommand->boundingBox,
+            .id = renderCommand->id,
+            .contentHash = Clay__HashRenderCommandContents(renderCommand),
+            .commandType = renderCommand->commandType,
+        });
+        Clay__RenderCommandSnapshot *previous = CLAY__NULL;
+        int32_t previousIndex = hashMap->internalArray[renderCommand->id % hashMap->capacity];
+        while (previousIndex != -1) {
+            Clay__RenderCommandSnapshot *candidate = &previousSnapshots->internalArray[previousIndex];
+            if (candidate->id == snapshot->id && candidate->commandType == snapshot->commandType && !candidate->matched) {
+                previous = candidate;
+                break;
+            }
+            previousIndex = candidate->nextIndex;
+        }
+        if (!previous) {
+            Clay__AddRenderCommandChange(CLAY__INIT(Clay_RenderCommandChange) { .id = snapshot->id, .renderCommandIndex = i, .commandType = snapshot->commandType, .changeType = CLAY_RENDER_COMMAND_CHANGE_ADDED }, snapshot->boundingBox);
+            continue;
+        }
+        previous->matched = true;
+        bool boundingBoxChanged = !Clay__MemCmp((char *)&previous->boundingBox, (char *)&snapshot->boundingBox, sizeof(Clay_BoundingBox));
+        if (boundingBoxChanged || previous->contentHash != snapshot->contentHash) {
+            Clay__AddRenderCommandChange(CLAY__INIT(Clay_RenderCommandChange) { .previousBoundingBox = previous->boundingBox, .id = snapshot->id, .renderCommandIndex = i, .commandType = snapshot->commandType, .changeType = CLAY_RENDER_COMMAND_CHANGE_MODIFIED }, snapshot->boundingBox);
+        }
+    }
+
+    for (int32_t i = 0; i < previousSnapshots->length; ++i) {
+        Clay__RenderCommandSnapshot *previous = &previousSnapshots->internalArray[i];
+        if (!previous->matched) {
+            Clay__AddRenderCommandChange(CLAY__INIT(Clay_RenderCommandChange) { .previousBoundingBox = previous->boundingBox, .id = previous->id, .renderCommandIndex = -1, .commandType = previous->commandType, .changeType = CLAY_RENDER_COMMAND_CHANGE_REMOVED }, previous->boundingBox);
+        }
+    }
+
+    // This frame's snapshots become the previous frame's for the next diff
+    Clay__RenderCommandSnapshotArray swap = *previousSnapshots;
+    *previousSnapshots = *currentSnapshots;
+    *currentSnapshots = swap;
 }
 
 CLAY_WASM_EXPORT("Clay_GetPointerOverIds")
@@ -3154,8 +5928,11 @@ Clay_Color CLAY__DEBUGVIEW_COLOR_SELECTED_ROW = {102, 80, 78, 255};
 const int32_t CLAY__DEBUGVIEW_ROW_HEIGHT = 30;
 const int32_t CLAY__DEBUGVIEW_OUTER_PADDING = 10;
 const int32_t CLAY__DEBUGVIEW_INDENT_WIDTH = 16;
+#ifdef CLAY_ENABLE_PROFILING
+const int32_t CLAY__DEBUGVIEW_FRAME_STATS_ROW_HEIGHT = 20;
+const int32_t CLAY__DEBUGVIEW_FRAME_STATS_ROW_COUNT = 9;
+#endif
 Clay_TextElementConfig Clay__DebugView_TextNameConfig = {.textColor = {238, 226, 231, 255}, .fontSize = 16, .wrapMode = CLAY_TEXT_WRAP_NONE };
-Clay_LayoutConfig Clay__DebugView_ScrollViewItemLayoutConfig = CLAY__DEFAULT_STRUCT;
 
 typedef struct {
     Clay_String label;
@@ -3186,7 +5963,7 @@ typedef struct {
 Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialRootsLength, int32_t highlightedRowIndex) {
     Clay_Context* context = Clay_GetCurrentContext();
     Clay__int32_tArray dfsBuffer = context->reusableElementIndexBuffer;
-    Clay__DebugView_ScrollViewItemLayoutConfig = CLAY__INIT(Clay_LayoutConfig) { .sizing = { .height = CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_ROW_HEIGHT) }, .childGap = 6, .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }};
+    Clay_LayoutConfig scrollViewItemLayoutConfig = CLAY__INIT(Clay_LayoutConfig) { .sizing = { .height = CLAY_SIZING_FIXED(CLAY__DEBUGVIEW_ROW_HEIGHT) }, .childGap = 6, .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }};
     Clay__RenderDebugLayoutData layoutData = CLAY__DEFAULT_STRUCT;
 
     uint32_t highlightedElementId = 0;
@@ -3228,7 +6005,7 @@ Clay__RenderDebugLayoutData Clay__RenderDebugLayoutElementsList(int32_t initialR
             if (context->debugSelectedElementId == currentElement->id) {
                 layoutData.selectedElementRowIndex = layoutData.rowCount;
             }
-            CLAY(CLAY_IDI("Clay__DebugView_ElementOuter", currentElement->id), { .layout = Clay__DebugView_ScrollViewItemLayoutConfig }) {
+            CLAY(CLAY_IDI("Clay__DebugView_ElementOuter", currentElement->id), { .layout = scrollViewItemLayoutConfig }) {
                 // Collapse icon / button
                 if (!(Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT) || currentElement->childrenOrTextContent.children.length == 0)) {
                     CLAY(CLAY_IDI("Clay__DebugView_CollapseElement", currentElement->id), {
@@ -3423,6 +6200,41 @@ void HandleDebugViewCloseButtonInteraction(Clay_ElementId elementId, Clay_Pointe
     }
 }
 
+#ifdef CLAY_ENABLE_PROFILING
+void Clay__RenderDebugViewFrameStat(Clay_String label, uint64_t value, Clay_TextElementConfig *labelConfig, Clay_TextElementConfig *valueConfig) {
+    CLAY_AUTO_ID({ .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } } }) {
+        CLAY_TEXT(label, labelConfig);
+        CLAY_AUTO_ID({ .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } } }) {}
+        CLAY_TEXT(Clay__IntToString((int32_t)CLAY__MIN(value, 0x7fffffff)), valueConfig);
+    }
+}
+
+void Clay__RenderDebugViewFrameStats(Clay_TextElementConfig *infoTextConfig, Clay_TextElementConfig *infoTitleConfig) {
+    Clay_FrameStats stats = Clay_GetCurrentContext()->frameStats;
+    struct { Clay_String label; uint64_t value; } rows[][2] = {
+        { { CLAY_STRING("Tree Build"), stats.treeBuildTime }, { CLAY_STRING("Elements"), (uint64_t)stats.elementCount } },
+        { { CLAY_STRING("Sizing X"), stats.sizingXTime }, { CLAY_STRING("Text Elements"), (uint64_t)stats.textElementCount } },
+        { { CLAY_STRING("Text Wrap"), stats.textWrapTime }, { CLAY_STRING("Wrapped Lines"), (uint64_t)stats.wrappedLineCount } },
+        { { CLAY_STRING("Sizing Y"), stats.sizingYTime }, { CLAY_STRING("Commands"), (uint64_t)stats.renderCommandCount } },
+        { { CLAY_STRING("Aspect Ratio"), stats.aspectRatioTime }, { CLAY_STRING("ID Lookups"), (uint64_t)stats.hashMapLookupCount } },
+        { { CLAY_STRING("Positioning"), stats.positioningTime }, { CLAY_STRING("ID Probes"), (uint64_t)stats.hashMapProbeCount } },
+        { { CLAY_STRING("Pointer"), stats.pointerUpdateTime }, { CLAY_STRING("Max Probe"), (uint64_t)stats.hashMapMaxProbeLength } },
+        { { CLAY_STRING("Scroll"), stats.scrollUpdateTime }, { CLAY_STRING("Arena KB"), (uint64_t)(stats.arenaBytesUsed / 1024) } },
+    };
+    CLAY_AUTO_ID({ .layout = { .sizing = {CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED((float)(CLAY__DEBUGVIEW_FRAME_STATS_ROW_HEIGHT * CLAY__DEBUGVIEW_FRAME_STATS_ROW_COUNT))}, .padding = {CLAY__DEBUGVIEW_OUTER_PADDING, CLAY__DEBUGVIEW_OUTER_PADDING, 0, 0 }, .layoutDirection = CLAY_TOP_TO_BOTTOM }, .backgroundColor = CLAY__DEBUGVIEW_COLOR_2 }) {
+        CLAY_AUTO_ID({ .layout = { .sizing = {CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED((float)CLAY__DEBUGVIEW_FRAME_STATS_ROW_HEIGHT)}, .childAlignment = {.y = CLAY_ALIGN_Y_CENTER} } }) {
+            CLAY_TEXT(CLAY_STRING("Frame Stats"), infoTextConfig);
+        }
+        for (int32_t i = 0; i < (int32_t)(sizeof(rows) / sizeof(rows[0])); ++i) {
+            CLAY_AUTO_ID({ .layout = { .sizing = {CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED((float)CLAY__DEBUGVIEW_FRAME_STATS_ROW_HEIGHT)}, .childGap = 16, .childAlignment = {.y = CLAY_ALIGN_Y_CENTER} } }) {
+                Clay__RenderDebugViewFrameStat(rows[i][0].label, rows[i][0].value, infoTitleConfig, infoTextConfig);
+                Clay__RenderDebugViewFrameStat(rows[i][1].label, rows[i][1].value, infoTitleConfig, infoTextConfig);
+            }
+        }
+    }
+}
+#endif
+
 void Clay__RenderDebugView(void) {
     Clay_Context* context = Clay_GetCurrentContext();
     Clay_ElementId closeButtonId = Clay__HashString(CLAY_STRING("Clay__DebugViewTopHeaderCloseButtonOuter"), 0);
@@ -3442,14 +6254,18 @@ void Clay__RenderDebugView(void) {
     Clay_TextElementConfig *infoTitleConfig = CLAY_TEXT_CONFIG({ .textColor = CLAY__DEBUGVIEW_COLOR_3, .fontSize = 16, .wrapMode = CLAY_TEXT_WRAP_NONE });
     Clay_ElementId scrollId = Clay__HashString(CLAY_STRING("Clay__DebugViewOuterScrollPane"), 0);
     float scrollYOffset = 0;
-    bool pointerInDebugView = context->pointerInfo.position.y < context->layoutDimensions.height - 300;
+    float bottomPanelsHeight = 300;
+#ifdef CLAY_ENABLE_PROFILING
+    bottomPanelsHeight += (float)(CLAY__DEBUGVIEW_FRAME_STATS_ROW_HEIGHT * CLAY__DEBUGVIEW_FRAME_STATS_ROW_COUNT);
+#endif
+    bool pointerInDebugView = context->pointerInfo.position.y < context->layoutDimensions.height - bottomPanelsHeight;
     for (int32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
         Clay__ScrollContainerDataInternal *scrollContainerData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
         if (scrollContainerData->elementId == scrollId.id) {
             if (!context->externalScrollHandlingEnabled) {
                 scrollYOffset = scrollContainerData->scrollPosition.y;
             } else {
-                pointerInDebugView = context->pointerInfo.position.y + scrollContainerData->scrollPosition.y < context->layoutDimensions.height - 300;
+                pointerInDebugView = context->pointerInfo.position.y + scrollContainerData->scrollPosition.y < context->layoutDimensions.height - bottomPanelsHeight;
             }
             break;
         }
@@ -3490,7 +6306,13 @@ void Clay__RenderDebugView(void) {
                         layoutData = Clay__RenderDebugLayoutElementsList((int32_t)initialRootsLength, highlightedRow);
                     }
                 }
-                float contentWidth = Clay__GetHashMapItem(panelContentsId.id)->layoutElement->dimensions.width;
+                Clay_LayoutElement *panelContents = Clay__GetHashMapItem(panelContentsId.id)->layoutElement;
+                // The element list may contain text that is still waiting to be batch measured
+                if (context->measureTextBatchFunction) {
+                    Clay__ResolveTextMeasurementBatch();
+                    Clay__UpdateDimensionsAfterTextMeasurement((int32_t)(panelContents - context->layoutElements.internalArray));
+                }
+                float contentWidth = panelContents->dimensions.width;
                 CLAY_AUTO_ID({ .layout = { .sizing = {.width = CLAY_SIZING_FIXED(contentWidth) }, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {}
                 for (int32_t i = 0; i < layoutData.rowCount; i++) {
                     Clay_Color rowColor = (i & 1) == 0 ? CLAY__DEBUGVIEW_COLOR_2 : CLAY__DEBUGVIEW_COLOR_1;
@@ -3507,6 +6329,10 @@ void Clay__RenderDebugView(void) {
             }
         }
         CLAY_AUTO_ID({ .layout = { .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1)} }, .backgroundColor = CLAY__DEBUGVIEW_COLOR_3 }) {}
+#ifdef CLAY_ENABLE_PROFILING
+        Clay__RenderDebugViewFrameStats(infoTextConfig, infoTitleConfig);
+        CLAY_AUTO_ID({ .layout = { .sizing = {.width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1)} }, .backgroundColor = CLAY__DEBUGVIEW_COLOR_3 }) {}
+#endif
         if (context->debugSelectedElementId != 0) {
             Clay_LayoutElementHashMapItem *selectedItem = Clay__GetHashMapItem(context->debugSelectedElementId);
             CLAY_AUTO_ID({
@@ -3915,23 +6741,17 @@ bool Clay__Array_AddCapacityCheck(int32_t length, int32_t capacity)
     return false;
 }
 
-// PUBLIC API FROM HERE ---------------------------------------
-
-CLAY_WASM_EXPORT("Clay_MinMemorySize")
-uint32_t Clay_MinMemorySize(void) {
+uint32_t Clay__MinMemorySize(int32_t maxElementCount, int32_t maxMeasureTextCacheWordCount, Clay_CapacityConfig capacities, int32_t renderOutputBufferCount) {
     Clay_Context fakeContext = {
-        .maxElementCount = Clay__defaultMaxElementCount,
-        .maxMeasureTextCacheWordCount = Clay__defaultMaxMeasureTextWordCacheCount,
+        .maxElementCount = maxElementCount,
+        .maxMeasureTextCacheWordCount = maxMeasureTextCacheWordCount,
+        .capacities = capacities,
+        .renderOutputBufferCount = renderOutputBufferCount,
         .internalArena = {
             .capacity = SIZE_MAX,
             .memory = NULL,
         }
     };
-    Clay_Context* currentContext = Clay_GetCurrentContext();
-    if (currentContext) {
-        fakeContext.maxElementCount = currentContext->maxElementCount;
-        fakeContext.maxMeasureTextCacheWordCount = currentContext->maxMeasureTextCacheWordCount;
-    }
     // Reserve space in the arena for the context, important for calculating min memory size correctly
     Clay__Context_Allocate_Arena(&fakeContext.internalArena);
     Clay__InitializePersistentMemory(&fakeContext);
@@ -3939,24 +6759,249 @@ uint32_t Clay_MinMemorySize(void) {
     return (uint32_t)fakeContext.internalArena.nextAllocation + 128;
 }
 
-CLAY_WASM_EXPORT("Clay_CreateArenaWithCapacityAndMemory")
-Clay_Arena Clay_CreateArenaWithCapacityAndMemory(size_t capacity, void *memory) {
-    Clay_Arena arena = {
-        .capacity = capacity,
-        .memory = (char *)memory
-    };
-    return arena;
+// Empties the persistent structures that can't start out with arbitrary contents
+void Clay__InitializePersistentState(Clay_Context *context) {
+    for (int32_t i = 0; i < context->layoutElementsHashMap.capacity; ++i) {
+        context->layoutElementsHashMap.internalArray[i] = CLAY__INIT(Clay__LayoutElementHashMapSlot) { .itemIndex = -1 };
+    }
+    for (int32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
+        context->measureTextHashMap.internalArray[i] = 0;
+    }
+    context->measureTextHashMapInternal.length = 1; // Reserve the 0 value to mean "no next element"
+    context->renderOutputBuffersHeld.length = context->renderOutputBuffersHeld.capacity; // This array is accessed directly rather than behaving as a list
+    for (int32_t i = 0; i < context->renderOutputBuffersHeld.capacity; ++i) {
+        context->renderOutputBuffersHeld.internalArray[i] = false;
+    }
+    context->renderOutputBufferIndex = context->renderOutputBufferCount - 1;
+}
+
+// Copies as much of an array as fits into the array of the same name in another context
+#define CLAY__MIGRATE_ARRAY(destination, source, name) \
+    (destination)->name.length = CLAY__MIN((source)->name.length, (destination)->name.capacity); \
+    Clay__CopyMemory((char *)(destination)->name.internalArray, (const char *)(source)->name.internalArray, (destination)->name.length * (int32_t)sizeof(*(destination)->name.internalArray))
+
+// Moves the context into a larger block from the arena grow function, keeping the state that would be expensive to rebuild.
+// Returns the context that should be used from now on, which is unchanged if the grow function didn't provide a block.
+Clay_Context* Clay__GrowArena(Clay_Context *context) {
+    // Wait until the renderer has released the frames still held in the block before last, and until other threads have finished measuring prefetched text
+    if (context->retiredArenaMemory || context->textPrefetchesInFlight > 0) {
+        return context;
+    }
+    int32_t maxElementCount = context->maxElementCount * 2;
+    int32_t maxMeasureTextCacheWordCount = context->maxMeasureTextCacheWordCount * 2;
+    Clay_CapacityConfig capacities = context->capacities;
+    int32_t *fields = (int32_t *)&capacities;
+    for (int32_t i = 0; i < (int32_t)(sizeof(Clay_CapacityConfig) / sizeof(int32_t)); ++i) {
+        fields[i] *= 2;
+    }
+    // Leave room to cacheline align the block
+    size_t capacity = Clay__MinMemorySize(maxElementCount, maxMeasureTextCacheWordCount, capacities, context->renderOutputBufferCount) + 64;
+    void *memory = context->arenaGrowFunction(context->arenaMemory, capacity, context->arenaGrowUserData);
+    if (!memory) {
+        return context;
+    }
+    Clay_Arena arena = Clay_CreateArenaWithCapacityAndMemory(capacity, memory);
+    uintptr_t baseOffset = 64 - ((uintptr_t)arena.memory % 64);
+    baseOffset = baseOffset == 64 ? 0 : baseOffset;
+    arena.memory += baseOffset;
+    Clay_Context *newContext = Clay__Context_Allocate_Arena(&arena);
+    // Settings and other values are carried across as they are, and every array is then reallocated from the new block
+    *newContext = *context;
+    newContext->maxElementCount = maxElementCount;
+    newContext->maxMeasureTextCacheWordCount = maxMeasureTextCacheWordCount;
+    newContext->capacities = capacities;
+    newContext->internalArena = arena;
+    newContext->arenaMemory = memory;
+    Clay_SetCurrentContext(newContext);
+    Clay__InitializePersistentMemory(newContext);
+    Clay__InitializeEphemeralMemory(newContext);
+    Clay__InitializePersistentState(newContext);
+
+    // Element hash map. The items keep their indexes, but the slot table is larger so they're inserted again.
+    CLAY__MIGRATE_ARRAY(newContext, context, layoutElementsHashMapInternal);
+    CLAY__MIGRATE_ARRAY(newContext, context, debugElementData);
+    Clay__LayoutElementHashMapSlot *slots = newContext->layoutElementsHashMap.internalArray;
+    int32_t slotMask = newContext->layoutElementsHashMap.capacity - 1;
+    for (int32_t i = 0; i < newContext->layoutElementsHashMapInternal.length; ++i) {
+        Clay_LayoutElementHashMapItem *hashItem = &newContext->layoutElementsHashMapInternal.internalArray[i];
+        // The layout elements are rebuilt by the next layout
+        hashItem->layoutElement = CLAY__NULL;
+        hashItem->debugData = &newContext->debugElementData.internalArray[hashItem->debugData - context->debugElementData.internalArray];
+        int32_t slotIndex = (int32_t)Clay__LayoutElementHashMapSlotIndex(hashItem->elementId.id, newContext->layoutElementsHashMap.capacity);
+        while (slots[slotIndex].itemIndex != -1) {
+            slotIndex = (slotIndex + 1) & slotMask;
+        }
+        slots[slotIndex] = CLAY__INIT(Clay__LayoutElementHashMapSlot) { .id = hashItem->elementId.id, .itemIndex = i };
+    }
+
+    // Text measurement cache. Items and words keep their indexes, so the free lists and eviction order are still valid, but the items are rehashed into the new buckets.
+    CLAY__MIGRATE_ARRAY(newContext, context, measureTextHashMapInternal);
+    CLAY__MIGRATE_ARRAY(newContext, context, measureTextHashMapInternalFreeList);
+    CLAY__MIGRATE_ARRAY(newContext, context, measuredWords);
+    CLAY__MIGRATE_ARRAY(newContext, context, measuredWordsFreeList);
+    CLAY__MIGRATE_ARRAY(newContext, context, wrappedLineCache);
+    CLAY__MIGRATE_ARRAY(newContext, context, wrappedLineCacheFreeList);
+    for (int32_t bucket = 0; bucket < context->measureTextHashMap.capacity; ++bucket) {
+        int32_t itemIndex = context->measureTextHashMap.internalArray[bucket];
+        while (itemIndex != 0) {
+            Clay__MeasureTextCacheItem *item = &newContext->measureTextHashMapInternal.internalArray[itemIndex];
+            int32_t nextIndex = item->nextIndex;
+            uint32_t hashBucket = item->id % (newContext->maxMeasureTextCacheWordCount / 32);
+            item->nextIndex = newContext->measureTextHashMap.internalArray[hashBucket];
+            newContext->measureTextHashMap.internalArray[hashBucket] = itemIndex;
+            itemIndex = nextIndex;
+        }
+    }
+
+    // Scroll positions, hover state and the snapshots compared against by Clay_EndLayoutDiff()
+    CLAY__MIGRATE_ARRAY(newContext, context, scrollContainerDatas);
+    for (int32_t i = 0; i < newContext->scrollContainerDatas.length; ++i) {
+        newContext->scrollContainerDatas.internalArray[i].layoutElement = CLAY__NULL;
+        newContext->scrollContainerDatas.internalArray[i].openThisFrame = false;
+    }
+    CLAY__MIGRATE_ARRAY(newContext, context, pointerOverIds);
+    CLAY__MIGRATE_ARRAY(newContext, context, previousPointerOverIds);
+    CLAY__MIGRATE_ARRAY(newContext, context, hoverEvents);
+    CLAY__MIGRATE_ARRAY(newContext, context, previousRenderCommandSnapshots);
+
+    // Sizes retained from the previous frame and recorded CLAY_CACHED blocks are indexed by element, so they aren't carried across
+    newContext->retainedLayoutSizesValid = false;
+    newContext->measureTextBatchItems.length = 0;
+    newContext->pendingTextMeasurements.length = 0;
+    Clay__MoveTextPrefetches(newContext, context, 0);
+
+    // Frames the renderer still holds keep the previous block alive until they're released
+    int32_t heldCount = 0;
+    for (int32_t i = 0; i < context->renderOutputBuffersHeld.length; ++i) {
+        heldCount += context->renderOutputBuffersHeld.internalArray[i] ? 1 : 0;
+    }
+    if (heldCount > 0) {
+        newContext->retiredArenaMemory = context->arenaMemory;
+        newContext->retiredRenderOutputCommands = context->renderOutputCommands;
+        newContext->retiredRenderOutputBuffersHeld = context->renderOutputBuffersHeld;
+        newContext->retiredRenderOutputCount = heldCount;
+    } else {
+        newContext->arenaGrowFunction(context->arenaMemory, 0, newContext->arenaGrowUserData);
+    }
+    return newContext;
+}
+
+// Points the render commands and dynamic strings of the frame being laid out at the next render output buffer that isn't held, and holds it
+void Clay__AcquireRenderOutputBuffer(Clay_Context *context) {
+    int32_t bufferCount = context->renderOutputBufferCount;
+    int32_t bufferIndex = -1;
+    for (int32_t i = 1; i <= bufferCount; ++i) {
+        int32_t candidate = (context->renderOutputBufferIndex + i) % bufferCount;
+        if (!context->renderOutputBuffersHeld.internalArray[candidate]) {
+            bufferIndex = candidate;
+            break;
+        }
+    }
+    if (bufferIndex == -1) {
+        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_RENDER_OUTPUT_BUFFERS_IN_USE,
+            .errorText = CLAY_STRING("Clay_BeginLayout was called while every render output buffer was still held, so the oldest frame was overwritten. Release frames with Clay_ReleaseRenderCommands(), or check Clay_RenderOutputBufferAvailable() before beginning a layout."),
+            .userData = context->errorHandler.userData });
+        bufferIndex = (context->renderOutputBufferIndex + 1) % bufferCount;
+    }
+    context->renderOutputBufferIndex = bufferIndex;
+    context->renderOutputBuffersHeld.internalArray[bufferIndex] = true;
+    int32_t commandCapacity = context->renderOutputCommands.capacity / bufferCount;
+    int32_t stringCapacity = context->renderOutputStrings.capacity / bufferCount;
+    context->renderCommands = CLAY__INIT(Clay_RenderCommandArray) { .capacity = commandCapacity, .length = 0, .internalArray = context->renderOutputCommands.internalArray + bufferIndex * commandCapacity };
+    context->dynamicStringData = CLAY__INIT(Clay__charArray) { .capacity = stringCapacity, .length = 0, .internalArray = context->renderOutputStrings.internalArray + bufferIndex * stringCapacity };
+}
+
+// PUBLIC API FROM HERE ---------------------------------------
+
+CLAY_WASM_EXPORT("Clay_MinMemorySize")
+uint32_t Clay_MinMemorySize(void) {
+    Clay_Context* currentContext = Clay_GetCurrentContext();
+    if (currentContext) {
+        return Clay__MinMemorySize(currentContext->maxElementCount, currentContext->maxMeasureTextCacheWordCount, currentContext->capacities, currentContext->requestedRenderOutputBufferCount);
+    }
+    return Clay__MinMemorySize(Clay__defaultMaxElementCount, Clay__defaultMaxMeasureTextWordCacheCount, Clay__defaultCapacities, Clay__defaultRenderOutputBufferCount);
+}
+
+CLAY_WASM_EXPORT("Clay_CreateArenaWithCapacityAndMemory")
+Clay_Arena Clay_CreateArenaWithCapacityAndMemory(size_t capacity, void *memory) {
+    Clay_Arena arena = {
+        .capacity = capacity,
+        .memory = (char *)memory
+    };
+    return arena;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMeasureTextBatchFunction")
+void Clay_SetMeasureTextBatchFunction(void (*measureTextBatchFunction)(Clay_MeasureTextBatchItem *items, int32_t itemCount, void *userData), void *userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    // Measure anything still waiting on the previous function before it is replaced
+    if (context->measureTextBatchFunction) {
+        Clay__ResolveTextMeasurementBatch();
+    }
+    context->measureTextBatchFunction = measureTextBatchFunction;
+    context->measureTextBatchUserData = userData;
+}
+
+CLAY_WASM_EXPORT("Clay_PrefetchText")
+bool Clay_PrefetchText(Clay_String text, Clay_TextElementConfig *config) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->prefetchingText = true;
+    Clay__MeasureTextCacheItem *item = Clay__MeasureTextCached(&text, config);
+    context->prefetchingText = false;
+    return item != &Clay__MeasureTextCacheItem_DEFAULT;
+}
+
+CLAY_WASM_EXPORT("Clay_BeginTextPrefetchBatch")
+Clay_MeasureTextBatchItemArray Clay_BeginTextPrefetchBatch(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->textPrefetchesInFlight > 0) {
+        return CLAY__INIT(Clay_MeasureTextBatchItemArray) CLAY__DEFAULT_STRUCT;
+    }
+    context->textPrefetchesInFlight = context->textPrefetches.length;
+    Clay_MeasureTextBatchItemArray items = context->textPrefetchItems;
+    items.capacity = items.length;
+    return items;
+}
+
+CLAY_WASM_EXPORT("Clay_EndTextPrefetchBatch")
+void Clay_EndTextPrefetchBatch(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    int32_t inFlight = context->textPrefetchesInFlight;
+    if (inFlight == 0) {
+        return;
+    }
+    int32_t itemCount = inFlight < context->textPrefetches.length ? context->textPrefetches.internalArray[inFlight].batchItemsStartIndex : context->textPrefetchItems.length;
+    for (int32_t i = 0; i < itemCount && context->captureFunction; ++i) {
+        Clay_MeasureTextBatchItem *item = &context->textPrefetchItems.internalArray[i];
+        Clay__CaptureMeasuredText(context, item->text, item->config, item->dimensions);
+    }
+    for (int32_t i = 0; i < inFlight; ++i) {
+        Clay__PendingTextMeasurement *prefetch = &context->textPrefetches.internalArray[i];
+        context->prefetchedTextItems = &context->textPrefetchItems.internalArray[prefetch->batchItemsStartIndex];
+        Clay__MeasureTextCachedWithId(&prefetch->text, prefetch->config, prefetch->id);
+    }
+    context->prefetchedTextItems = NULL;
+    // Text queued while the batch was being measured goes in the next batch
+    Clay__MoveTextPrefetches(context, context, inFlight);
+    context->textPrefetchesInFlight = 0;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMeasureTextPlaceholdersEnabled")
+void Clay_SetMeasureTextPlaceholdersEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->measureTextPlaceholdersEnabled = enabled;
 }
 
 #ifndef CLAY_WASM
 void Clay_SetMeasureTextFunction(Clay_Dimensions (*measureTextFunction)(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData), void *userData) {
     Clay_Context* context = Clay_GetCurrentContext();
-    Clay__MeasureText = measureTextFunction;
+    context->measureTextFunction = measureTextFunction;
     context->measureTextUserData = userData;
 }
 void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)(uint32_t elementId, void *userData), void *userData) {
     Clay_Context* context = Clay_GetCurrentContext();
-    Clay__QueryScrollOffset = queryScrollOffsetFunction;
+    context->queryScrollOffsetFunction = queryScrollOffsetFunction;
     context->queryScrollOffsetUserData = userData;
 }
 #endif
@@ -3966,19 +7011,25 @@ void Clay_SetLayoutDimensions(Clay_Dimensions dimensions) {
     Clay_GetCurrentContext()->layoutDimensions = dimensions;
 }
 
-CLAY_WASM_EXPORT("Clay_SetPointerState")
-void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
+bool Clay__SubtreeMayContainPoint(Clay_Vector2 point, int32_t layoutElementIndex) {
+    Clay__SubtreeBounds bounds = Clay_GetCurrentContext()->layoutElementSubtreeBounds.internalArray[layoutElementIndex];
+    return point.x >= bounds.left && point.x <= bounds.right && point.y >= bounds.top && point.y <= bounds.bottom;
+}
+
+// Finds the elements under a point by walking each layout tree from the top z-index down, skipping any subtree whose bounds don't contain the point.
+void Clay__QueryPointOver(Clay_Vector2 position, Clay_ElementIdArray *elementIds, bool callHoverFunctions) {
     Clay_Context* context = Clay_GetCurrentContext();
-    if (context->booleanWarnings.maxElementsExceeded) {
-        return;
-    }
-    context->pointerInfo.position = position;
-    context->pointerOverIds.length = 0;
+    // Subtree bounds are only available once the current layout has been calculated, so they can't be used during declaration
+    bool useSubtreeBounds = context->layoutElementSubtreeBounds.length == context->layoutElements.length;
     Clay__int32_tArray dfsBuffer = context->layoutElementChildrenBuffer;
     for (int32_t rootIndex = context->layoutElementTreeRoots.length - 1; rootIndex >= 0; --rootIndex) {
         dfsBuffer.length = 0;
         Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
-        Clay__int32_tArray_Add(&dfsBuffer, (int32_t)root->layoutElementIndex);
+        // Bounding boxes are offset by the root's pointer offset during hit testing, so offset the point by the opposite amount when testing subtree bounds
+        Clay_Vector2 boundsPosition = { position.x + root->pointerOffset.x, position.y + root->pointerOffset.y };
+        if (!useSubtreeBounds || Clay__SubtreeMayContainPoint(boundsPosition, root->layoutElementIndex)) {
+            Clay__int32_tArray_Add(&dfsBuffer, (int32_t)root->layoutElementIndex);
+        }
         context->treeNodeVisited.internalArray[0] = false;
         bool found = false;
         while (dfsBuffer.length > 0) {
@@ -3988,26 +7039,31 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
             }
             context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = true;
             Clay_LayoutElement *currentElement = Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&dfsBuffer, (int)dfsBuffer.length - 1));
-            Clay_LayoutElementHashMapItem *mapItem = Clay__GetHashMapItem(currentElement->id); // TODO think of a way around this, maybe the fact that it's essentially a binary tree limits the cost, but the worst case is not great
-            int32_t clipElementId = Clay__int32_tArray_GetValue(&context->layoutElementClipElementIds, (int32_t)(currentElement - context->layoutElements.internalArray));
-            Clay_LayoutElementHashMapItem *clipItem = Clay__GetHashMapItem(clipElementId);
+            Clay_LayoutElementHashMapItem *mapItem = currentElement->hashMapItem ? currentElement->hashMapItem : Clay__GetHashMapItem(currentElement->id);
             if (mapItem) {
                 Clay_BoundingBox elementBox = mapItem->boundingBox;
                 elementBox.x -= root->pointerOffset.x;
                 elementBox.y -= root->pointerOffset.y;
-                if ((Clay__PointIsInsideRect(position, elementBox)) && (clipElementId == 0 || (Clay__PointIsInsideRect(position, clipItem->boundingBox)) || context->externalScrollHandlingEnabled)) {
-                    if (mapItem->onHoverFunction) {
-                        mapItem->onHoverFunction(mapItem->elementId, context->pointerInfo, mapItem->hoverFunctionUserData);
+                if (Clay__PointIsInsideRect(position, elementBox)) {
+                    int32_t clipElementId = Clay__int32_tArray_GetValue(&context->layoutElementClipElementIds, (int32_t)(currentElement - context->layoutElements.internalArray));
+                    if (clipElementId == 0 || context->externalScrollHandlingEnabled || Clay__PointIsInsideRect(position, Clay__GetHashMapItem(clipElementId)->boundingBox)) {
+                        if (callHoverFunctions && mapItem->onHoverFunction) {
+                            mapItem->onHoverFunction(mapItem->elementId, context->pointerInfo, mapItem->hoverFunctionUserData);
+                        }
+                        Clay_ElementIdArray_Add(elementIds, mapItem->elementId);
+                        found = true;
                     }
-                    Clay_ElementIdArray_Add(&context->pointerOverIds, mapItem->elementId);
-                    found = true;
                 }
                 if (Clay__ElementHasConfig(currentElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
                     dfsBuffer.length--;
                     continue;
                 }
                 for (int32_t i = currentElement->childrenOrTextContent.children.length - 1; i >= 0; --i) {
-                    Clay__int32_tArray_Add(&dfsBuffer, currentElement->childrenOrTextContent.children.elements[i]);
+                    int32_t childIndex = currentElement->childrenOrTextContent.children.elements[i];
+                    if (useSubtreeBounds && !Clay__SubtreeMayContainPoint(boundsPosition, childIndex)) {
+                        continue;
+                    }
+                    Clay__int32_tArray_Add(&dfsBuffer, childIndex);
                     context->treeNodeVisited.internalArray[dfsBuffer.length - 1] = false; // TODO needs to be ranged checked
                 }
             } else {
@@ -4021,6 +7077,107 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
             break;
         }
     }
+}
+
+bool Clay__ElementIdArrayContains(Clay_ElementIdArray *elementIds, uint32_t id) {
+    for (int32_t i = 0; i < elementIds->length; ++i) {
+        if (elementIds->internalArray[i].id == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Makes room in a full queue without losing track of which elements the pointer is over.
+// HOVER events only report positions between ENTER and LEAVE events, so they are removed first. If every event is an ENTER or LEAVE,
+// an element's first two remaining events are removed, as two consecutive changes for the same element cancel out.
+void Clay__CompactHoverEvents(Clay_Context *context) {
+    Clay_HoverEvent *events = context->hoverEvents.internalArray;
+    int32_t length = 0;
+    for (int32_t i = 0; i < context->hoverEvents.length; ++i) {
+        if (events[i].type != CLAY_HOVER_EVENT_HOVER) {
+            events[length++] = events[i];
+        }
+    }
+    for (int32_t i = 0; i < length && length == context->hoverEvents.capacity; ++i) {
+        for (int32_t j = i + 1; j < length; ++j) {
+            if (events[j].elementId.id == events[i].elementId.id) {
+                int32_t to = i;
+                for (int32_t from = i + 1; from < length; ++from) {
+                    if (from != j) {
+                        events[to++] = events[from];
+                    }
+                }
+                length = to;
+                break;
+            }
+        }
+    }
+    context->hoverEvents.length = length;
+}
+
+// Appends an event to the queue. Once an application hasn't read the queue in Clay__hoverEventCapacity events, newer HOVER events are dropped,
+// and older events are compacted to make room for ENTER and LEAVE events.
+static inline void Clay__QueueHoverEvent(Clay_Context *context, Clay_HoverEvent event) {
+    if (context->hoverEvents.length == context->hoverEvents.capacity && event.type != CLAY_HOVER_EVENT_HOVER) {
+        Clay__CompactHoverEvents(context);
+    }
+    if (context->hoverEvents.length < context->hoverEvents.capacity) {
+        context->hoverEvents.internalArray[context->hoverEvents.length++] = event;
+    }
+}
+
+// Records the changes between previousPointerOverIds and pointerOverIds, and a HOVER event for the elements in both
+void Clay__QueueHoverEvents(Clay_Context *context) {
+    if (context->hoverEventsRead) {
+        context->hoverEvents.length = 0;
+        context->hoverEventsRead = false;
+    }
+    // n & m are the depth of the hovered branches, so these stay small
+    for (int32_t i = 0; i < context->previousPointerOverIds.length; ++i) {
+        Clay_ElementId elementId = context->previousPointerOverIds.internalArray[i];
+        if (!Clay__ElementIdArrayContains(&context->pointerOverIds, elementId.id)) {
+            Clay__QueueHoverEvent(context, CLAY__INIT(Clay_HoverEvent) { .elementId = elementId, .pointerData = context->pointerInfo, .type = CLAY_HOVER_EVENT_LEAVE });
+        }
+    }
+    for (int32_t i = 0; i < context->pointerOverIds.length; ++i) {
+        Clay_ElementId elementId = context->pointerOverIds.internalArray[i];
+        Clay_LayoutElementHashMapItem *mapItem = Clay__GetHashMapItem(elementId.id);
+        Clay_HoverEventType type = CLAY_HOVER_EVENT_ENTER;
+        if (Clay__ElementIdArrayContains(&context->previousPointerOverIds, elementId.id)) {
+            type = CLAY_HOVER_EVENT_HOVER;
+            int32_t index = mapItem->hoverEventIndex;
+            if (index < context->hoverEvents.length) {
+                Clay_HoverEvent *previousEvent = &context->hoverEvents.internalArray[index];
+                if (previousEvent->elementId.id == elementId.id && previousEvent->type == CLAY_HOVER_EVENT_HOVER && previousEvent->pointerData.state == context->pointerInfo.state) {
+                    previousEvent->pointerData.position = context->pointerInfo.position;
+                    continue;
+                }
+            }
+        }
+        if (context->hoverEvents.length < context->hoverEvents.capacity && mapItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+            mapItem->hoverEventIndex = context->hoverEvents.length;
+        }
+        Clay__QueueHoverEvent(context, CLAY__INIT(Clay_HoverEvent) { .elementId = elementId, .pointerData = context->pointerInfo, .type = type });
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SetPointerState")
+void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->booleanWarnings.maxElementsExceeded) {
+        return;
+    }
+    CLAY__PROFILE_BEGIN();
+    context->pointerInfo.position = position;
+    if (context->hoverEventQueueEnabled) {
+        // Keep the elements the pointer was over to compare against once the new ones are found
+        Clay_ElementIdArray previousPointerOverIds = context->previousPointerOverIds;
+        context->previousPointerOverIds = context->pointerOverIds;
+        context->pointerOverIds = previousPointerOverIds;
+    }
+    context->pointerOverIds.length = 0;
+    Clay__QueryPointOver(position, &context->pointerOverIds, !context->hoverEventQueueEnabled);
 
     if (isPointerDown) {
         if (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME) {
@@ -4035,10 +7192,72 @@ void Clay_SetPointerState(Clay_Vector2 position, bool isPointerDown) {
             context->pointerInfo.state = CLAY_POINTER_DATA_RELEASED_THIS_FRAME;
         }
     }
+    if (context->hoverEventQueueEnabled) {
+        Clay__QueueHoverEvents(context);
+    }
+    CLAY__PROFILE_END(pointerUpdateTime);
+}
+
+CLAY_WASM_EXPORT("Clay_SetHoverEventQueueEnabled")
+void Clay_SetHoverEventQueueEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->hoverEventQueueEnabled = enabled;
+}
+
+CLAY_WASM_EXPORT("Clay_GetHoverEvents")
+Clay_HoverEventArray Clay_GetHoverEvents(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    // Events returned by an earlier call are only cleared by the next pointer update, so don't return them twice
+    Clay_HoverEventArray events = context->hoverEvents;
+    if (context->hoverEventsRead) {
+        events.length = 0;
+    }
+    context->hoverEventsRead = true;
+    return events;
+}
+
+CLAY_WASM_EXPORT("Clay_QueryPointsOver")
+Clay_PointQueryResultArray Clay_QueryPointsOver(Clay_Vector2 *points, int32_t pointCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->pointQueryResults.length = 0;
+    context->pointQueryElementIds.length = 0;
+    if (context->booleanWarnings.maxElementsExceeded) {
+        return context->pointQueryResults;
+    }
+    if (pointCount > context->pointQueryResults.capacity) {
+        context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+            .errorType = CLAY_ERROR_TYPE_POINT_QUERY_CAPACITY_EXCEEDED,
+            .errorText = CLAY_STRING("Clay_QueryPointsOver() was passed more points than it can hold results for, so only the first ones were queried. Try using Clay_SetMaxPointQueryCount() with a higher value."),
+            .userData = context->errorHandler.userData });
+        pointCount = context->pointQueryResults.capacity;
+    }
+    for (int32_t i = 0; i < pointCount; ++i) {
+        // Each point's results are a slice of the shared element ID buffer
+        Clay_ElementIdArray elementIds = {
+            .capacity = context->pointQueryElementIds.capacity - context->pointQueryElementIds.length,
+            .internalArray = context->pointQueryElementIds.internalArray + context->pointQueryElementIds.length,
+        };
+        Clay__QueryPointOver(points[i], &elementIds, false);
+        elementIds.capacity = elementIds.length;
+        context->pointQueryElementIds.length += elementIds.length;
+        Clay_PointQueryResultArray_Add(&context->pointQueryResults, CLAY__INIT(Clay_PointQueryResult) { .point = points[i], .elementIds = elementIds });
+    }
+    return context->pointQueryResults;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMaxPointQueryCount")
+void Clay_SetMaxPointQueryCount(int32_t maxPointQueryCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->capacities.pointQueries = CLAY__MAX(maxPointQueryCount, 1);
+    } else {
+        Clay__defaultCapacities.pointQueries = CLAY__MAX(maxPointQueryCount, 1);
+    }
 }
 
 CLAY_WASM_EXPORT("Clay_Initialize")
 Clay_Context* Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions, Clay_ErrorHandler errorHandler) {
+    void *arenaMemory = arena.memory;
     // Cacheline align memory passed in
     uintptr_t baseOffset = 64 - ((uintptr_t)arena.memory % 64);
     baseOffset = baseOffset == 64 ? 0 : baseOffset;
@@ -4050,20 +7269,25 @@ Clay_Context* Clay_Initialize(Clay_Arena arena, Clay_Dimensions layoutDimensions
     *context = CLAY__INIT(Clay_Context) {
         .maxElementCount = oldContext ? oldContext->maxElementCount : Clay__defaultMaxElementCount,
         .maxMeasureTextCacheWordCount = oldContext ? oldContext->maxMeasureTextCacheWordCount : Clay__defaultMaxMeasureTextWordCacheCount,
+        .capacities = oldContext ? oldContext->capacities : Clay__defaultCapacities,
+        .renderOutputBufferCount = oldContext ? oldContext->requestedRenderOutputBufferCount : Clay__defaultRenderOutputBufferCount,
+        .requestedRenderOutputBufferCount = oldContext ? oldContext->requestedRenderOutputBufferCount : Clay__defaultRenderOutputBufferCount,
         .errorHandler = errorHandler.errorHandlerFunction ? errorHandler : CLAY__INIT(Clay_ErrorHandler) { Clay__ErrorHandlerFunctionDefault, 0 },
         .layoutDimensions = layoutDimensions,
+        .arenaMemory = arenaMemory,
         .internalArena = arena,
     };
+    #ifndef CLAY_WASM
+    // The measure and scroll functions used to be shared by every context, so new contexts still start out with the previous context's functions
+    if (oldContext) {
+        context->measureTextFunction = oldContext->measureTextFunction;
+        context->queryScrollOffsetFunction = oldContext->queryScrollOffsetFunction;
+    }
+    #endif
     Clay_SetCurrentContext(context);
     Clay__InitializePersistentMemory(context);
     Clay__InitializeEphemeralMemory(context);
-    for (int32_t i = 0; i < context->layoutElementsHashMap.capacity; ++i) {
-        context->layoutElementsHashMap.internalArray[i] = -1;
-    }
-    for (int32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
-        context->measureTextHashMap.internalArray[i] = 0;
-    }
-    context->measureTextHashMapInternal.length = 1; // Reserve the 0 value to mean "no next element"
+    Clay__InitializePersistentState(context);
     context->layoutDimensions = layoutDimensions;
     return context;
 }
@@ -4098,9 +7322,118 @@ Clay_Vector2 Clay_GetScrollOffset(void) {
     return CLAY__INIT(Clay_Vector2) CLAY__DEFAULT_STRUCT;
 }
 
+float Clay__VirtualListItemSize(Clay_VirtualListConfig *config, int32_t itemIndex) {
+    return config->itemSizeFunction ? config->itemSizeFunction(itemIndex, config->userData) : config->itemSize;
+}
+
+// Declares an empty element standing in for items that haven't been declared
+void Clay__DeclareVirtualListSpacer(float size) {
+    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
+    bool vertical = openLayoutElement->layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM;
+    CLAY_AUTO_ID({ .layout = { .sizing = { .width = vertical ? CLAY_SIZING_FIT(0) : CLAY_SIZING_FIXED(size), .height = vertical ? CLAY_SIZING_FIXED(size) : CLAY_SIZING_FIT(0) } } }) {}
+}
+
+CLAY_WASM_EXPORT("Clay_VirtualListBegin")
+Clay_VirtualListRange Clay_VirtualListBegin(Clay_VirtualListConfig config) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_VirtualListRange range = CLAY__DEFAULT_STRUCT;
+    if (config.itemCount <= 0 || context->booleanWarnings.maxElementsExceeded) {
+        return range;
+    }
+    Clay_LayoutElement *openLayoutElement = Clay__GetOpenLayoutElement();
+    Clay_LayoutConfig *layoutConfig = openLayoutElement->layoutConfig;
+    bool vertical = layoutConfig->layoutDirection == CLAY_TOP_TO_BOTTOM;
+    float gap = (float)layoutConfig->childGap;
+
+    // The visible window uses the clip element's current scroll position and its size from the previous frame, if it existed.
+    // Before that, the layout dimensions are an upper bound for how much of the list can be visible.
+    Clay_Dimensions viewport = context->layoutDimensions;
+    Clay_Vector2 scrollPosition = CLAY__DEFAULT_STRUCT;
+    for (int32_t i = 0; i < context->scrollContainerDatas.length; i++) {
+        Clay__ScrollContainerDataInternal *mapping = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
+        if (mapping->layoutElement == openLayoutElement) {
+            if (mapping->boundingBox.width > 0 || mapping->boundingBox.height > 0) {
+                viewport = CLAY__INIT(Clay_Dimensions) { mapping->boundingBox.width, mapping->boundingBox.height };
+            }
+            scrollPosition = mapping->scrollPosition;
+            break;
+        }
+    }
+    float visibleStart = vertical ? -scrollPosition.y - (float)layoutConfig->padding.top : -scrollPosition.x - (float)layoutConfig->padding.left;
+    float visibleEnd = visibleStart + (vertical ? viewport.height : viewport.width);
+
+    range.itemCount = config.itemCount;
+    float totalSize = 0;
+    if (!config.itemSizeFunction) {
+        float stride = config.itemSize + gap;
+        range.endIndex = config.itemCount;
+        if (stride > 0) {
+            // Both values are clamped to be non negative before truncating, which makes the casts equivalent to floor()
+            float firstVisible = CLAY__MIN(CLAY__MAX(visibleStart / stride, 0), (float)config.itemCount);
+            float lastVisible = CLAY__MIN(CLAY__MAX(visibleEnd / stride, 0), (float)config.itemCount);
+            range.startIndex = (int32_t)firstVisible;
+            range.endIndex = (int32_t)lastVisible;
+            if ((float)range.endIndex < lastVisible) {
+                range.endIndex++;
+            }
+        }
+        range.startIndex = CLAY__MIN(CLAY__MAX(range.startIndex - config.overscan, 0), range.endIndex);
+        range.endIndex = CLAY__MIN(range.endIndex + config.overscan, config.itemCount);
+        range.leadingSize = (float)range.startIndex * stride;
+        range.trailingSize = (float)(config.itemCount - range.endIndex) * stride;
+    } else {
+        // Without a fixed size the offset of every item has to be accumulated, first to find the visible items, then the size of everything before them
+        bool foundStart = false;
+        for (int32_t i = 0; i < config.itemCount; ++i) {
+            float itemStart = totalSize;
+            totalSize += Clay__VirtualListItemSize(&config, i) + gap;
+            if (!foundStart && totalSize - gap > visibleStart) {
+                range.startIndex = i;
+                foundStart = true;
+            }
+            if (itemStart < visibleEnd) {
+                range.endIndex = i + 1;
+            }
+        }
+        if (!foundStart) {
+            range.startIndex = config.itemCount;
+        }
+        range.startIndex = CLAY__MIN(CLAY__MAX(range.startIndex - config.overscan, 0), range.endIndex);
+        range.endIndex = CLAY__MIN(range.endIndex + config.overscan, config.itemCount);
+        float declaredSize = 0;
+        for (int32_t i = 0; i < range.endIndex; ++i) {
+            float itemSize = Clay__VirtualListItemSize(&config, i) + gap;
+            if (i < range.startIndex) {
+                range.leadingSize += itemSize;
+            } else {
+                declaredSize += itemSize;
+            }
+        }
+        range.trailingSize = totalSize - range.leadingSize - declaredSize;
+    }
+
+    // The spacers are separated from the declared items by childGap, so they're a gap smaller than the items they replace
+    if (range.startIndex > 0) {
+        range.leadingSize -= gap;
+        Clay__DeclareVirtualListSpacer(range.leadingSize);
+    }
+    if (range.endIndex < config.itemCount) {
+        range.trailingSize -= gap;
+    }
+    return range;
+}
+
+CLAY_WASM_EXPORT("Clay_VirtualListEnd")
+void Clay_VirtualListEnd(Clay_VirtualListRange range) {
+    if (range.endIndex < range.itemCount) {
+        Clay__DeclareVirtualListSpacer(range.trailingSize);
+    }
+}
+
 CLAY_WASM_EXPORT("Clay_UpdateScrollContainers")
 void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDelta, float deltaTime) {
     Clay_Context* context = Clay_GetCurrentContext();
+    CLAY__PROFILE_BEGIN();
     bool isPointerActive = enableDragScrolling && (context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED || context->pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME);
     // Don't apply scroll events to ancestors of the inner element
     int32_t highestPriorityElementIndex = -1;
@@ -4210,12 +7543,35 @@ void Clay_UpdateScrollContainers(bool enableDragScrolling, Clay_Vector2 scrollDe
             highestPriorityScrollData->scrollPosition.x = CLAY__MAX(CLAY__MIN(highestPriorityScrollData->scrollPosition.x, 0), -(highestPriorityScrollData->contentSize.width - scrollElement->dimensions.width));
         }
     }
+    CLAY__PROFILE_END(scrollUpdateTime);
 }
 
 CLAY_WASM_EXPORT("Clay_BeginLayout")
 void Clay_BeginLayout(void) {
     Clay_Context* context = Clay_GetCurrentContext();
+    // The warnings are still those of the previous frame
+    Clay_BooleanWarnings previousWarnings = context->booleanWarnings;
+    if (context->arenaGrowFunction && (previousWarnings.maxElementsExceeded || previousWarnings.maxRenderCommandsExceeded || previousWarnings.maxTextMeasureCacheExceeded || previousWarnings.maxDynamicStringsExceeded)) {
+        context = Clay__GrowArena(context);
+    }
     Clay__InitializeEphemeralMemory(context);
+    if (context->renderOutputBufferCount > 1) {
+        Clay__AcquireRenderOutputBuffer(context);
+    }
+    context->internedStringBuckets.length = context->internedStringBuckets.capacity; // This array is accessed directly rather than behaving as a list
+    for (int32_t i = 0; i < context->internedStringBuckets.length; ++i) {
+        context->internedStringBuckets.internalArray[i] = -1;
+    }
+    // Blocks recorded last frame become the ones that can be replayed this frame
+    Clay__CachedSubtreeArray previousCachedSubtrees = context->previousCachedSubtrees;
+    Clay__charArray previousCachedSubtreeData = context->previousCachedSubtreeData;
+    context->previousCachedSubtrees = context->cachedSubtrees;
+    context->previousCachedSubtreeData = context->cachedSubtreeData;
+    context->cachedSubtrees = previousCachedSubtrees;
+    context->cachedSubtreeData = previousCachedSubtreeData;
+    context->cachedSubtrees.length = 0;
+    context->cachedSubtreeData.length = 0;
+    context->openCachedSubtreeDepth = 0;
     context->generation++;
     context->dynamicElementIndex = 0;
     // Set up the root container that covers the entire window
@@ -4230,11 +7586,17 @@ void Clay_BeginLayout(void) {
     });
     Clay__int32_tArray_Add(&context->openLayoutElementStack, 0);
     Clay__LayoutElementTreeRootArray_Add(&context->layoutElementTreeRoots, CLAY__INIT(Clay__LayoutElementTreeRoot) { .layoutElementIndex = 0 });
+    // The root container is declared again by Clay_BeginLayout() when a capture is replayed, so capturing starts after it
+    context->captureActive = context->captureFunction != NULL;
+    Clay__CaptureDeclaration(context, CLAY__INIT(Clay_CaptureEvent) { .type = CLAY_CAPTURE_EVENT_BEGIN_LAYOUT, .dimensions = context->layoutDimensions });
+    CLAY__PROFILE_BEGIN();
 }
 
 CLAY_WASM_EXPORT("Clay_EndLayout")
 Clay_RenderCommandArray Clay_EndLayout(void) {
     Clay_Context* context = Clay_GetCurrentContext();
+    Clay__CaptureDeclaration(context, CLAY__INIT(Clay_CaptureEvent) { .type = CLAY_CAPTURE_EVENT_END_LAYOUT });
+    context->captureActive = false;
     Clay__CloseElement();
     bool elementsExceededBeforeDebugView = context->booleanWarnings.maxElementsExceeded;
     if (context->debugModeEnabled && !elementsExceededBeforeDebugView) {
@@ -4261,10 +7623,103 @@ Clay_RenderCommandArray Clay_EndLayout(void) {
                 .errorText = CLAY_STRING("There were still open layout elements when EndLayout was called. This results from an unequal number of calls to Clay__OpenElement and Clay__CloseElement."),
                 .userData = context->errorHandler.userData });
     }
+    if (context->measureTextBatchFunction) {
+        Clay__ResolveTextMeasurementBatch();
+    }
+    if (context->textMeasurementBatchResolved && !context->booleanWarnings.maxElementsExceeded) {
+        Clay__UpdateDimensionsAfterTextMeasurement(0);
+    }
+    CLAY__PROFILE_END(treeBuildTime);
     Clay__CalculateFinalLayout();
+
+    Clay_FrameStats *frameStats = &context->currentFrameStats;
+    frameStats->elementCount = context->layoutElements.length;
+    frameStats->textElementCount = context->textElementData.length;
+    frameStats->wrappedLineCount = context->wrappedTextLines.length;
+    frameStats->renderCommandCount = context->renderCommands.length;
+    frameStats->arenaBytesUsed = context->internalArena.nextAllocation;
+    frameStats->arenaCapacity = context->internalArena.capacity;
+    frameStats->capacityUsage = CLAY__INIT(Clay_CapacityConfig) {
+        .textElements = context->textElementData.length,
+        .aspectRatioElements = context->aspectRatioElementConfigs.length,
+        .imageElements = context->imageElementConfigs.length,
+        .floatingElements = context->floatingElementConfigs.length,
+        .clipElements = context->clipElementConfigs.length,
+        .customElements = context->customElementConfigs.length,
+        .borderElements = context->borderElementConfigs.length,
+        .sharedElements = context->sharedElementConfigs.length,
+        .wrappedTextLines = context->wrappedTextLines.length,
+        .renderCommands = context->renderCommands.length,
+        .dynamicStringBytes = context->dynamicStringData.length,
+        .pointQueries = context->pointQueryResults.length,
+    };
+    context->frameStats = *frameStats;
+    *frameStats = CLAY__INIT(Clay_FrameStats) CLAY__DEFAULT_STRUCT;
     return context->renderCommands;
 }
 
+CLAY_WASM_EXPORT("Clay_BeginLayoutCtx")
+void Clay_BeginLayoutCtx(Clay_Context *context) {
+    Clay_SetCurrentContext(context);
+    Clay_BeginLayout();
+}
+
+CLAY_WASM_EXPORT("Clay_EndLayoutCtx")
+Clay_RenderCommandArray Clay_EndLayoutCtx(Clay_Context *context) {
+    Clay_SetCurrentContext(context);
+    return Clay_EndLayout();
+}
+
+CLAY_WASM_EXPORT("Clay_EndLayoutDiff")
+Clay_RenderCommandDiff Clay_EndLayoutDiff(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+    Clay__DiffRenderCommands();
+    return CLAY__INIT(Clay_RenderCommandDiff) { .renderCommands = renderCommands, .changes = context->renderCommandChanges, .dirtyRects = context->dirtyRects };
+}
+
+CLAY_WASM_EXPORT("Clay_GetRenderCommandLayout")
+Clay_RenderCommandLayout Clay_GetRenderCommandLayout(void) {
+    return CLAY__INIT(Clay_RenderCommandLayout) {
+        .commandSize = sizeof(Clay_RenderCommand),
+        .boundingBox = offsetof(Clay_RenderCommand, boundingBox),
+        .userData = offsetof(Clay_RenderCommand, userData),
+        .id = offsetof(Clay_RenderCommand, id),
+        .zIndex = offsetof(Clay_RenderCommand, zIndex),
+        .commandType = offsetof(Clay_RenderCommand, commandType),
+        .rectangleBackgroundColor = offsetof(Clay_RenderCommand, renderData.rectangle.backgroundColor),
+        .rectangleCornerRadius = offsetof(Clay_RenderCommand, renderData.rectangle.cornerRadius),
+        .textStringLength = offsetof(Clay_RenderCommand, renderData.text.stringContents.length),
+        .textStringChars = offsetof(Clay_RenderCommand, renderData.text.stringContents.chars),
+        .textColor = offsetof(Clay_RenderCommand, renderData.text.textColor),
+        .textFontId = offsetof(Clay_RenderCommand, renderData.text.fontId),
+        .textFontSize = offsetof(Clay_RenderCommand, renderData.text.fontSize),
+        .textLetterSpacing = offsetof(Clay_RenderCommand, renderData.text.letterSpacing),
+        .textLineHeight = offsetof(Clay_RenderCommand, renderData.text.lineHeight),
+        .imageBackgroundColor = offsetof(Clay_RenderCommand, renderData.image.backgroundColor),
+        .imageCornerRadius = offsetof(Clay_RenderCommand, renderData.image.cornerRadius),
+        .imageData = offsetof(Clay_RenderCommand, renderData.image.imageData),
+        .customBackgroundColor = offsetof(Clay_RenderCommand, renderData.custom.backgroundColor),
+        .customCornerRadius = offsetof(Clay_RenderCommand, renderData.custom.cornerRadius),
+        .customData = offsetof(Clay_RenderCommand, renderData.custom.customData),
+        .borderColor = offsetof(Clay_RenderCommand, renderData.border.color),
+        .borderCornerRadius = offsetof(Clay_RenderCommand, renderData.border.cornerRadius),
+        .borderWidth = offsetof(Clay_RenderCommand, renderData.border.width),
+        .clipHorizontal = offsetof(Clay_RenderCommand, renderData.clip.horizontal),
+        .clipVertical = offsetof(Clay_RenderCommand, renderData.clip.vertical),
+        .textConfigFontId = offsetof(Clay_TextElementConfig, fontId),
+        .textConfigFontSize = offsetof(Clay_TextElementConfig, fontSize),
+        .textConfigLetterSpacing = offsetof(Clay_TextElementConfig, letterSpacing),
+        .textConfigLineHeight = offsetof(Clay_TextElementConfig, lineHeight),
+        .stringLength = offsetof(Clay_String, length),
+        .stringChars = offsetof(Clay_String, chars),
+        .stringSliceLength = offsetof(Clay_StringSlice, length),
+        .stringSliceChars = offsetof(Clay_StringSlice, chars),
+        .arrayLength = offsetof(Clay_RenderCommandArray, length),
+        .arrayInternalArray = offsetof(Clay_RenderCommandArray, internalArray),
+    };
+}
+
 CLAY_WASM_EXPORT("Clay_GetElementId")
 Clay_ElementId Clay_GetElementId(Clay_String idString) {
     return Clay__HashString(idString, 0);
@@ -4324,6 +7779,9 @@ Clay_ScrollContainerData Clay_GetScrollContainerData(Clay_ElementId id) {
     for (int32_t i = 0; i < context->scrollContainerDatas.length; ++i) {
         Clay__ScrollContainerDataInternal *scrollContainerData = Clay__ScrollContainerDataInternalArray_Get(&context->scrollContainerDatas, i);
         if (scrollContainerData->elementId == id.id) {
+            if (!scrollContainerData->layoutElement) { // The arena has grown since the container was last declared
+                return CLAY__INIT(Clay_ScrollContainerData) CLAY__DEFAULT_STRUCT;
+            }
             Clay_ClipElementConfig *clipElementConfig = Clay__FindElementConfigWithType(scrollContainerData->layoutElement, CLAY__ELEMENT_CONFIG_TYPE_CLIP).clipElementConfig;
             if (!clipElementConfig) { // This can happen on the first frame before a scroll container is declared
                 return CLAY__INIT(Clay_ScrollContainerData) CLAY__DEFAULT_STRUCT;
@@ -4377,6 +7835,12 @@ void Clay_SetExternalScrollHandlingEnabled(bool enabled) {
     context->externalScrollHandlingEnabled = enabled;
 }
 
+CLAY_WASM_EXPORT("Clay_SetIncrementalLayoutEnabled")
+void Clay_SetIncrementalLayoutEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->incrementalLayoutEnabled = enabled;
+}
+
 CLAY_WASM_EXPORT("Clay_GetMaxElementCount")
 int32_t Clay_GetMaxElementCount(void) {
     Clay_Context* context = Clay_GetCurrentContext();
@@ -4410,6 +7874,74 @@ void Clay_SetMaxMeasureTextCacheWordCount(int32_t maxMeasureTextCacheWordCount)
     }
 }
 
+CLAY_WASM_EXPORT("Clay_GetCapacities")
+Clay_CapacityConfig Clay_GetCapacities(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context ? context->capacities : Clay__defaultCapacities;
+}
+
+CLAY_WASM_EXPORT("Clay_SetCapacities")
+void Clay_SetCapacities(Clay_CapacityConfig capacities) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->capacities = capacities;
+    } else {
+        Clay__defaultCapacities = capacities;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_SetRenderOutputBufferCount")
+void Clay_SetRenderOutputBufferCount(int32_t bufferCount) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context) {
+        context->requestedRenderOutputBufferCount = bufferCount;
+    } else {
+        Clay__defaultRenderOutputBufferCount = bufferCount;
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_RenderOutputBufferAvailable")
+bool Clay_RenderOutputBufferAvailable(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    if (context->renderOutputBufferCount <= 1) {
+        return true;
+    }
+    for (int32_t i = 0; i < context->renderOutputBuffersHeld.length; ++i) {
+        if (!context->renderOutputBuffersHeld.internalArray[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+CLAY_WASM_EXPORT("Clay_ReleaseRenderCommands")
+void Clay_ReleaseRenderCommands(Clay_RenderCommandArray renderCommands) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_RenderCommand *commands = renderCommands.internalArray;
+    if (context->renderOutputBufferCount <= 1 || !commands) {
+        return;
+    }
+    Clay_RenderCommandArray *buffers = &context->renderOutputCommands;
+    if (commands >= buffers->internalArray && commands < buffers->internalArray + buffers->capacity) {
+        context->renderOutputBuffersHeld.internalArray[(commands - buffers->internalArray) / (buffers->capacity / context->renderOutputBufferCount)] = false;
+        return;
+    }
+    // A frame laid out before the arena grew
+    Clay_RenderCommandArray *retired = &context->retiredRenderOutputCommands;
+    if (context->retiredArenaMemory && commands >= retired->internalArray && commands < retired->internalArray + retired->capacity) {
+        bool *held = &context->retiredRenderOutputBuffersHeld.internalArray[(commands - retired->internalArray) / (retired->capacity / context->retiredRenderOutputBuffersHeld.capacity)];
+        if (!*held) {
+            return;
+        }
+        *held = false;
+        context->retiredRenderOutputCount--;
+        if (context->retiredRenderOutputCount == 0) {
+            context->arenaGrowFunction(context->retiredArenaMemory, 0, context->arenaGrowUserData);
+            context->retiredArenaMemory = CLAY__NULL;
+        }
+    }
+}
+
 CLAY_WASM_EXPORT("Clay_ResetMeasureTextCache")
 void Clay_ResetMeasureTextCache(void) {
     Clay_Context* context = Clay_GetCurrentContext();
@@ -4418,11 +7950,230 @@ void Clay_ResetMeasureTextCache(void) {
     context->measureTextHashMap.length = 0;
     context->measuredWords.length = 0;
     context->measuredWordsFreeList.length = 0;
+    context->wrappedLineCache.length = 0;
+    context->wrappedLineCacheFreeList.length = 0;
     
     for (int32_t i = 0; i < context->measureTextHashMap.capacity; ++i) {
         context->measureTextHashMap.internalArray[i] = 0;
     }
     context->measureTextHashMapInternal.length = 1; // Reserve the 0 value to mean "no next element"
+    context->measureTextBatchItems.length = 0;
+    context->pendingTextMeasurements.length = 0;
+    context->measureTextCacheStats = CLAY__INIT(Clay_MeasureTextCacheStats) CLAY__DEFAULT_STRUCT;
+    context->measureTextCacheLruHead = 0;
+    context->measureTextCacheLruTail = 0;
+    context->measureTextCacheClockHand = 0;
+    context->measureTextCacheOldestGeneration = context->generation;
+
+    // Sizes cached by incremental layout were derived from the old measurements
+    for (int32_t i = 0; i < context->layoutElementsHashMapInternal.length; ++i) {
+        Clay_LayoutElementHashMapItem *hashMapItem = Clay__LayoutElementHashMapItemArray_Get(&context->layoutElementsHashMapInternal, i);
+        hashMapItem->layoutCacheGeneration = 0;
+        hashMapItem->layoutCacheWidthValid = false;
+    }
+    // As are the sizes of text in recorded CLAY_CACHED blocks, and the sizes retained from the previous frame
+    context->retainedLayoutSizesValid = false;
+    context->cachedSubtrees.length = 0;
+    context->previousCachedSubtrees.length = 0;
+    context->cachedSubtreeData.length = 0;
+    context->previousCachedSubtreeData.length = 0;
+}
+
+CLAY_WASM_EXPORT("Clay_SetProfilingClockFunction")
+void Clay_SetProfilingClockFunction(uint64_t (*clockFunction)(void *userData), void *userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->profilingClockFunction = clockFunction;
+    context->profilingClockUserData = userData;
+}
+
+CLAY_WASM_EXPORT("Clay_SetParallelForFunction")
+void Clay_SetParallelForFunction(void (*parallelForFunction)(int32_t taskCount, void (*taskFunction)(int32_t taskIndex, void *taskData), void *taskData, void *userData), void *userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->parallelForFunction = parallelForFunction;
+    context->parallelForUserData = userData;
+}
+
+CLAY_WASM_EXPORT("Clay_SetArenaGrowFunction")
+void Clay_SetArenaGrowFunction(void *(*growFunction)(void *previousMemory, size_t capacity, void *userData), void *userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->arenaGrowFunction = growFunction;
+    context->arenaGrowUserData = userData;
+}
+
+CLAY_WASM_EXPORT("Clay_SetCaptureFunction")
+void Clay_SetCaptureFunction(void (*captureFunction)(const Clay_CaptureEvent *event, void *userData), void *userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->captureFunction = captureFunction;
+    context->captureUserData = userData;
+    context->captureActive = false;
+    if (captureFunction) {
+        Clay_ResetMeasureTextCache();
+    }
+}
+
+CLAY_WASM_EXPORT("Clay_GetFrameStats")
+Clay_FrameStats Clay_GetFrameStats(void) {
+    return Clay_GetCurrentContext()->frameStats;
+}
+
+CLAY_WASM_EXPORT("Clay_SetMeasureTextCachePolicy")
+void Clay_SetMeasureTextCachePolicy(Clay_MeasureTextCachePolicy policy) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->measureTextCachePolicy = policy;
+}
+
+CLAY_WASM_EXPORT("Clay_GetMeasureTextCacheStats")
+Clay_MeasureTextCacheStats Clay_GetMeasureTextCacheStats(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_MeasureTextCacheStats stats = context->measureTextCacheStats;
+    stats.itemCount = context->measureTextHashMapInternal.length - 1 - context->measureTextHashMapInternalFreeList.length; // Index 0 is reserved
+    stats.itemCapacity = context->measureTextHashMapInternal.capacity - 2;
+    stats.wordCount = context->measuredWords.length - context->measuredWordsFreeList.length;
+    stats.wordCapacity = context->measuredWords.capacity - 1;
+    stats.wordFreeListLength = context->measuredWordsFreeList.length;
+    return stats;
+}
+
+CLAY_WASM_EXPORT("Clay_InternString")
+Clay_String Clay_InternString(Clay_String string) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    uint32_t hash = Clay__HashData((const uint8_t *)string.chars, string.length) % UINT32_MAX;
+    int32_t *bucket = &context->internedStringBuckets.internalArray[hash % context->internedStringBuckets.capacity];
+    for (int32_t index = *bucket; index != -1; index = context->internedStrings.internalArray[index].nextIndex) {
+        Clay__InternedString *item = &context->internedStrings.internalArray[index];
+        if (item->hash != hash || item->length != string.length) {
+            continue;
+        }
+        const char *chars = context->dynamicStringData.internalArray + item->offset;
+        int32_t i = 0;
+        while (i < string.length && chars[i] == string.chars[i]) {
+            i++;
+        }
+        if (i == string.length) {
+            return CLAY__INIT(Clay_String) { .length = string.length, .chars = chars };
+        }
+    }
+
+    // The chars are preceded by the index of their item, aligned so that it can be read back directly
+    int32_t offset = ((context->dynamicStringData.length + 3) & ~3) + (int32_t)sizeof(int32_t);
+    if (offset + string.length > context->dynamicStringData.capacity || context->internedStrings.length == context->internedStrings.capacity) {
+        if (!context->booleanWarnings.maxDynamicStringsExceeded) {
+            context->booleanWarnings.maxDynamicStringsExceeded = true;
+            context->errorHandler.errorHandlerFunction(CLAY__INIT(Clay_ErrorData) {
+                .errorType = CLAY_ERROR_TYPE_DYNAMIC_STRING_CAPACITY_EXCEEDED,
+                .errorText = CLAY_STRING("Clay ran out of capacity while interning or formatting dynamic strings. Try using Clay_SetCapacities() with a higher dynamicStringBytes."),
+                .userData = context->errorHandler.userData });
+        }
+        return CLAY__STRING_DEFAULT;
+    }
+    char *chars = context->dynamicStringData.internalArray + offset;
+    *(int32_t *)(chars - sizeof(int32_t)) = context->internedStrings.length;
+    for (int32_t i = 0; i < string.length; i++) {
+        chars[i] = string.chars[i];
+    }
+    context->dynamicStringData.length = offset + string.length;
+    Clay__InternedStringArray_Add(&context->internedStrings, CLAY__INIT(Clay__InternedString) { .hash = hash, .offset = offset, .length = string.length, .nextIndex = *bucket });
+    *bucket = context->internedStrings.length - 1;
+    return CLAY__INIT(Clay_String) { .length = string.length, .chars = chars };
+}
+
+// Writes the digits of value right aligned into the end of buffer, with a decimal point before the last fractionDigits of them, and returns the number of chars written
+int32_t Clay__FormatDigits(char *bufferEnd, uint64_t value, int32_t fractionDigits, bool negative) {
+    char *chars = bufferEnd;
+    for (int32_t i = 0; i < fractionDigits; i++) {
+        *--chars = (char)('0' + value % 10);
+        value /= 10;
+    }
+    if (fractionDigits > 0) {
+        *--chars = '.';
+    }
+    do {
+        *--chars = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    if (negative) {
+        *--chars = '-';
+    }
+    return (int32_t)(bufferEnd - chars);
+}
+
+CLAY_WASM_EXPORT("Clay_FormatFixed")
+Clay_String Clay_FormatFixed(int64_t value, int32_t fractionDigits) {
+    char buffer[24]; // Enough for a sign, a decimal point and the 20 digits of the largest uint64_t, plus a leading zero
+    fractionDigits = CLAY__MAX(CLAY__MIN(fractionDigits, 18), 0);
+    // Negate as unsigned, as the negative of the smallest int64_t doesn't fit in one
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    int32_t length = Clay__FormatDigits(buffer + sizeof(buffer), magnitude, fractionDigits, value < 0);
+    return Clay_InternString(CLAY__INIT(Clay_String) { .length = length, .chars = buffer + sizeof(buffer) - length });
+}
+
+CLAY_WASM_EXPORT("Clay_FormatInt")
+Clay_String Clay_FormatInt(int64_t value) {
+    return Clay_FormatFixed(value, 0);
+}
+
+CLAY_WASM_EXPORT("Clay_FormatFloat")
+Clay_String Clay_FormatFloat(float value, int32_t fractionDigits) {
+    fractionDigits = CLAY__MAX(CLAY__MIN(fractionDigits, 9), 0);
+    if (value != value) {
+        return Clay_InternString(CLAY_STRING("nan"));
+    }
+    if (value > 3.402823466e38f || value < -3.402823466e38f) {
+        return Clay_InternString(value < 0 ? CLAY_STRING("-inf") : CLAY_STRING("inf"));
+    }
+    double magnitude = value < 0 ? -(double)value : (double)value;
+    // Floats from 2^63 up are whole numbers with at most 24 significant bits, so halving them is exact until the whole part fits in a uint64_t
+    int32_t doublings = 0;
+    while (magnitude >= 9223372036854775808.0) {
+        magnitude *= 0.5;
+        doublings++;
+    }
+    uint64_t whole = (uint64_t)magnitude;
+    uint64_t fractionScale = 1;
+    for (int32_t i = 0; i < fractionDigits; i++) {
+        fractionScale *= 10;
+    }
+    uint64_t fraction = (uint64_t)((magnitude - (double)whole) * (double)fractionScale + 0.5);
+    if (fraction >= fractionScale) {
+        fraction -= fractionScale;
+        whole++;
+    }
+    // The whole part is kept in base 1e9 limbs, least significant first, which fit the 39 digits of the largest float
+    uint32_t limbs[5] = { (uint32_t)(whole % 1000000000), (uint32_t)(whole / 1000000000 % 1000000000), (uint32_t)(whole / 1000000000000000000) };
+    for (int32_t i = 0; i < doublings; i++) {
+        uint32_t carry = 0;
+        for (int32_t j = 0; j < 5; j++) {
+            uint32_t doubled = limbs[j] * 2 + carry;
+            carry = doubled >= 1000000000;
+            limbs[j] = carry ? doubled - 1000000000 : doubled;
+        }
+    }
+    char buffer[56]; // Enough for a sign, 45 digits of limbs, a decimal point and 9 fraction digits
+    char *chars = buffer + sizeof(buffer);
+    for (int32_t i = 0; i < fractionDigits; i++) {
+        *--chars = (char)('0' + fraction % 10);
+        fraction /= 10;
+    }
+    if (fractionDigits > 0) {
+        *--chars = '.';
+    }
+    int32_t topLimb = 4;
+    while (topLimb > 0 && limbs[topLimb] == 0) {
+        topLimb--;
+    }
+    for (int32_t i = 0; i <= topLimb; i++) {
+        uint32_t limb = limbs[i];
+        // Limbs below the top one are padded to all 9 of their digits
+        for (int32_t digit = 0; digit < 9 && (i < topLimb || digit == 0 || limb > 0); digit++) {
+            *--chars = (char)('0' + limb % 10);
+            limb /= 10;
+        }
+    }
+    // Keeps the sign of small negative values that round to zero, e.g. -0.001 with 2 digits gives "-0.00"
+    if (value < 0) {
+        *--chars = '-';
+    }
+    return Clay_InternString(CLAY__INIT(Clay_String) { .length = (int32_t)(buffer + sizeof(buffer) - chars), .chars = chars });
 }
 
 #endif // CLAY_IMPLEMENTATION
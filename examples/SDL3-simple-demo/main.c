@@ -26,20 +26,6 @@ typedef struct app_state {
 SDL_Texture *sample_image;
 bool show_demo = true;
 
-static inline Clay_Dimensions SDL_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData)
-{
-    TTF_Font **fonts = userData;
-    TTF_Font *font = fonts[config->fontId];
-    int width, height;
-
-    TTF_SetFontSize(font, config->fontSize);
-    if (!TTF_GetStringSize(font, text.chars, text.length, &width, &height)) {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to measure text: %s", SDL_GetError());
-    }
-
-    return (Clay_Dimensions) { (float) width, (float) height };
-}
-
 void HandleClayErrors(Clay_ErrorData errorData) {
     printf("%s", errorData.errorText.chars);
 }
@@ -133,7 +119,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
     int width, height;
     SDL_GetWindowSize(state->window, &width, &height);
     Clay_Initialize(clayMemory, (Clay_Dimensions) { (float) width, (float) height }, (Clay_ErrorHandler) { HandleClayErrors });
-    Clay_SetMeasureTextFunction(SDL_MeasureText, state->rendererData.fonts);
+    Clay_SetMeasureTextFunction(SDL_Clay_MeasureText, &state->rendererData);
 
     state->demoData = ClayVideoDemo_Initialize();
 
@@ -209,6 +195,8 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result)
     }
 
     if (state) {
+        SDL_Clay_DestroyTextCache(&state->rendererData);
+
         if (state->rendererData.renderer)
             SDL_DestroyRenderer(state->rendererData.renderer);
 
@@ -109,6 +109,52 @@ void Layout() {
 	}
 }
 
+#define REPORT_ROW_COUNT 5000
+#define REPORT_ROW_HEIGHT 18
+
+// Layout one page of a report that is far too long to lay out at
+// once.  The rows live in the "ReportRows" clip element, which
+// Clay_Cairo_RenderPages scrolls one page further every time this is
+// called, and only the rows that land on this page are declared.
+void ReportPage(int page, void *userData) {
+	static Clay_Color PRIMARY = { 0xa8, 0x42, 0x1c, 255 };
+	static Clay_Color BACKGROUND = { 0xF4, 0xEB, 0xE6, 255 };
+	static Clay_Color ACCENT = { 0xFA, 0xE0, 0xD4, 255 };
+	(void)userData;
+
+	CLAY_AUTO_ID({
+        .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) },
+             .padding = { 70, 70, 50, 50 },
+             .layoutDirection = CLAY_TOP_TO_BOTTOM,
+             .childGap = 10 },
+		.backgroundColor = BACKGROUND
+    }) {
+		CLAY_AUTO_ID({ .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .childAlignment = { .y = CLAY_ALIGN_Y_CENTER } }}) {
+			CLAY_TEXT(CLAY_STRING("Order Report"), CLAY_TEXT_CONFIG({ .fontId = FONT_CALLISTOGA, .textColor = PRIMARY, .fontSize = 24 }));
+			CLAY_AUTO_ID({ .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) } }});
+			CLAY_TEXT(Clay_FormatInt(page + 2), CLAY_TEXT_CONFIG({ .fontId = FONT_QUICKSAND, .textColor = PRIMARY, .fontSize = 14 }));
+		}
+
+		CLAY(CLAY_ID("ReportRows"), {
+            .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM },
+            .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
+        }) {
+			Clay_VirtualListRange rows = Clay_VirtualListBegin((Clay_VirtualListConfig) { .itemCount = REPORT_ROW_COUNT, .itemSize = REPORT_ROW_HEIGHT });
+			for (int32_t i = rows.startIndex; i < rows.endIndex; i++) {
+				CLAY_AUTO_ID({
+                    .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(REPORT_ROW_HEIGHT) }, .padding = { 8, 8, 0, 0 }, .childAlignment = { .y = CLAY_ALIGN_Y_CENTER } },
+                    .backgroundColor = i % 2 ? BACKGROUND : ACCENT
+                }) {
+					CLAY_TEXT(Clay_FormatInt(1000 + i), CLAY_TEXT_CONFIG({ .fontId = FONT_QUICKSAND, .textColor = PRIMARY, .fontSize = 12 }));
+					CLAY_AUTO_ID({ .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) } }});
+					CLAY_TEXT(Clay_FormatFixed((int64_t)(i % 97) * 1250 + 399, 2), CLAY_TEXT_CONFIG({ .fontId = FONT_QUICKSAND, .textColor = PRIMARY, .fontSize = 12 }));
+				}
+			}
+			Clay_VirtualListEnd(rows);
+		}
+	}
+}
+
 void HandleClayErrors(Clay_ErrorData errorData) {
     printf("%s", errorData.errorText.chars);
 }
@@ -157,14 +203,16 @@ int main(void) {
 	// Pass our layout to the cairo backend
 	Clay_Cairo_Render(commands, fonts);
 
-	// To keep this example short, we will not emit a second page in the PDF.
-	// But to do so, you have to
-	// 1. cairo_show_page(cr)
-	// 2. Clay_BeginLayout();
-	// 3. Create your layout
-	// 4. commands = Clay_EndLayout();
-	// 5. Clay_Cairo_Render(commands);
+	// Finish the first page, cairo writes it to output.pdf right away.
+	cairo_show_page(cr);
+
+	// The rest of the document is a report spanning a few hundred
+	// pages.  Each page is laid out, rendered and written out before
+	// the next, so memory use doesn't depend on the report's length.
+	int pages = Clay_Cairo_RenderPages(CLAY_ID("ReportRows"), ReportPage, NULL, fonts);
+	printf("Emitted %d report pages\n", pages);
 
+	Clay_Cairo_Shutdown();
 	cairo_destroy(cr);
 	return 0;
 }
@@ -89,7 +89,7 @@ ClayVideoDemo_Data ClayVideoDemo_Initialize() {
     return data;
 }
 
-Clay_RenderCommandArray ClayVideoDemo_CreateLayout(ClayVideoDemo_Data *data) {
+static void ClayVideoDemo_DeclareLayout(ClayVideoDemo_Data *data) {
     data->frameArena.offset = 0;
 
     Clay_BeginLayout();
@@ -255,7 +255,10 @@ Clay_RenderCommandArray ClayVideoDemo_CreateLayout(ClayVideoDemo_Data *data) {
             }
         }
     }
+}
 
+Clay_RenderCommandArray ClayVideoDemo_CreateLayout(ClayVideoDemo_Data *data) {
+    ClayVideoDemo_DeclareLayout(data);
     Clay_RenderCommandArray renderCommands = Clay_EndLayout();
     for (int32_t i = 0; i < renderCommands.length; i++) {
         Clay_RenderCommandArray_Get(&renderCommands, i)->boundingBox.y += data->yOffset;
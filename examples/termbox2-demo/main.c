@@ -781,7 +781,6 @@ int main(void)
 
         commands = CreateLayout(&shark_image1, &shark_image2);
 
-        tb_clear();
         Clay_Termbox_Render(commands);
         tb_present();
     }
@@ -16,6 +16,7 @@
 #include "../shared-layouts/clay-video-demo.c"
 
 ClayVideoDemo_Data demo_data;
+Clay_RenderCommandArray render_commands;
 
 #define APPNAME "Clay GDI Example"
 char szAppName[] = APPNAME; // The name of this application
@@ -34,6 +35,15 @@ HFONT fonts[1];
 #define RECTHEIGHT(rc)  ((rc).bottom - (rc).top)
 #endif
 
+// Lays out the UI again, and invalidates only the parts of the window that changed
+void UpdateLayout(HWND hwnd)
+{
+    ClayVideoDemo_DeclareLayout(&demo_data);
+    Clay_RenderCommandDiff diff = Clay_EndLayoutDiff();
+    render_commands = diff.renderCommands;
+    Clay_Win32_InvalidateDiff(hwnd, diff);
+}
+
 LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
 {
 
@@ -46,6 +56,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
         break;
 
     case WM_DESTROY:
+        Clay_Win32_Shutdown();
         PostQuitMessage(0);
         break;
 
@@ -66,7 +77,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
 
         Clay_UpdateScrollContainers(true, (Clay_Vector2){.x = 0, .y = zDelta}, dt);
 
-        InvalidateRect(hwnd, NULL, false); // force a wm_paint event
+        UpdateLayout(hwnd); // force a wm_paint event for what changed
         break;
     }
     case WM_RBUTTONUP:
@@ -81,7 +92,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
 
         Clay_SetPointerState((Clay_Vector2){mouseX, mouseY}, mouseButtons & 0b01);
 
-        InvalidateRect(hwnd, NULL, false); // force a wm_paint event
+        UpdateLayout(hwnd); // force a wm_paint event for what changed
         break;
     }
 
@@ -95,7 +106,8 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
             Clay_SetLayoutDimensions(dim);
         }
 
-        InvalidateRect(hwnd, NULL, false); // force a wm_paint event
+        UpdateLayout(hwnd);
+        InvalidateRect(hwnd, NULL, false); // force a wm_paint event, the off-screen buffer is recreated at the new size
 
         break;
     }
@@ -114,14 +126,17 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
         }
 
         printf("Key Pressed: %d\r\n", wParam);
-        InvalidateRect(hwnd, NULL, false); // force a wm_paint event
+        UpdateLayout(hwnd); // force a wm_paint event for what changed
         break;
 
     // ----------------------- render
     case WM_PAINT:
     {
-        Clay_RenderCommandArray renderCommands = ClayVideoDemo_CreateLayout(&demo_data);
-        Clay_Win32_Render(hwnd, renderCommands, fonts);
+        // The layout is only updated by input, a repaint for any other reason redraws the last one
+        if (render_commands.length == 0)
+            UpdateLayout(hwnd);
+
+        Clay_Win32_Render(hwnd, render_commands, fonts);
         break;
     }
 
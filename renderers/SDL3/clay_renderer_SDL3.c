@@ -4,10 +4,49 @@
 #include <SDL3_ttf/SDL_ttf.h>
 #include <SDL3_image/SDL_image.h>
 
+#ifndef CLAY_SDL3_TEXT_CACHE_SIZE
+#define CLAY_SDL3_TEXT_CACHE_SIZE 4096
+#endif
+
+#ifndef CLAY_SDL3_MAX_FONT_SIZES
+#define CLAY_SDL3_MAX_FONT_SIZES 64
+#endif
+
+typedef struct {
+    uint32_t id; // Hash of the string contents, font and size. 0 means the item is on the free list.
+    int32_t length;
+    uint32_t generation;
+    int32_t nextIndex;
+    TTF_Text *text;
+} Clay_SDL3TextCacheItem;
+
+// A copy of one of the user's fonts at a fixed size. TTF_Text objects are laid out again whenever the size of their font
+// changes, so cached text needs one font per size rather than calling TTF_SetFontSize on a shared font.
+typedef struct {
+    uint16_t fontId;
+    uint16_t fontSize;
+    TTF_Font *font;
+} Clay_SDL3SizedFont;
+
+// Shaped TTF_Text objects, retained between frames and shared by text measurement and rendering.
+// Items that haven't been used for a few frames are destroyed, in the same way as clay's internal text measurement cache.
+typedef struct {
+    Clay_SDL3TextCacheItem *items; // Index 0 is reserved to mark the end of a bucket
+    int32_t itemCount;
+    int32_t *buckets;
+    int32_t *freeList;
+    int32_t freeListLength;
+    Clay_SDL3SizedFont sizedFonts[CLAY_SDL3_MAX_FONT_SIZES];
+    int32_t sizedFontCount;
+    uint32_t generation;
+} Clay_SDL3TextCache;
+
 typedef struct {
     SDL_Renderer *renderer;
     TTF_TextEngine *textEngine;
     TTF_Font **fonts;
+    // Allocated on first use, and freed with SDL_Clay_DestroyTextCache()
+    Clay_SDL3TextCache textCache;
 } Clay_SDL3RendererData;
 
 /* Global for convenience. Even in 4K this is enough for smooth curves (low radius or rect size coupled with
@@ -141,6 +180,176 @@ static void SDL_Clay_RenderArc(Clay_SDL3RendererData *rendererData, const SDL_FP
     }
 }
 
+static TTF_Font *SDL_Clay_GetSizedFont(Clay_SDL3RendererData *rendererData, uint16_t fontId, uint16_t fontSize) {
+    Clay_SDL3TextCache *cache = &rendererData->textCache;
+    for (int i = 0; i < cache->sizedFontCount; i++) {
+        if (cache->sizedFonts[i].fontId == fontId && cache->sizedFonts[i].fontSize == fontSize) {
+            return cache->sizedFonts[i].font;
+        }
+    }
+    TTF_Font *font = NULL;
+    if (cache->sizedFontCount < CLAY_SDL3_MAX_FONT_SIZES) {
+        font = TTF_CopyFont(rendererData->fonts[fontId]);
+    }
+    if (!font) {
+        // Out of sized fonts, fall back to resizing the shared font
+        font = rendererData->fonts[fontId];
+        TTF_SetFontSize(font, fontSize);
+        return font;
+    }
+    TTF_SetFontSize(font, fontSize);
+    cache->sizedFonts[cache->sizedFontCount++] = (Clay_SDL3SizedFont) { fontId, fontSize, font };
+    return font;
+}
+
+static uint32_t SDL_Clay_HashText(Clay_StringSlice text, uint16_t fontId, uint16_t fontSize) {
+    uint32_t hash = 0;
+    for (int32_t i = 0; i < text.length; i++) {
+        hash += text.chars[i];
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    hash += fontId;
+    hash += (hash << 10);
+    hash ^= (hash >> 6);
+    hash += fontSize;
+    hash += (hash << 10);
+    hash ^= (hash >> 6);
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return hash + 1; // Reserve the hash ID of zero to mean "free"
+}
+
+static void SDL_Clay_FreeTextCacheItem(Clay_SDL3TextCache *cache, int32_t index) {
+    TTF_DestroyText(cache->items[index].text);
+    cache->items[index] = (Clay_SDL3TextCacheItem) {0};
+    cache->freeList[cache->freeListLength++] = index;
+}
+
+// Destroys every item that hasn't been used in the last few frames
+static void SDL_Clay_EvictStaleText(Clay_SDL3TextCache *cache) {
+    for (int32_t i = 0; i < CLAY_SDL3_TEXT_CACHE_SIZE / 4; i++) {
+        int32_t *previousNext = &cache->buckets[i];
+        int32_t index = *previousNext;
+        while (index != 0) {
+            Clay_SDL3TextCacheItem *item = &cache->items[index];
+            int32_t nextIndex = item->nextIndex;
+            if (cache->generation - item->generation > 2) {
+                *previousNext = nextIndex;
+                SDL_Clay_FreeTextCacheItem(cache, index);
+            } else {
+                previousNext = &item->nextIndex;
+            }
+            index = nextIndex;
+        }
+    }
+}
+
+// Returns a shaped TTF_Text for the given string, font and size, creating it if it isn't already cached.
+// Returns NULL if the text couldn't be created, or the cache is full of text that is still in use, in which case *temporary is set
+// to a TTF_Text that the caller must destroy.
+static TTF_Text *SDL_Clay_GetCachedText(Clay_SDL3RendererData *rendererData, Clay_StringSlice text, uint16_t fontId, uint16_t fontSize, TTF_Text **temporary) {
+    Clay_SDL3TextCache *cache = &rendererData->textCache;
+    *temporary = NULL;
+    if (!cache->items) {
+        cache->items = SDL_calloc(CLAY_SDL3_TEXT_CACHE_SIZE, sizeof(Clay_SDL3TextCacheItem));
+        cache->buckets = SDL_calloc(CLAY_SDL3_TEXT_CACHE_SIZE / 4, sizeof(int32_t));
+        cache->freeList = SDL_calloc(CLAY_SDL3_TEXT_CACHE_SIZE, sizeof(int32_t));
+        cache->itemCount = 1;
+        if (!cache->items || !cache->buckets || !cache->freeList) {
+            SDL_free(cache->items);
+            SDL_free(cache->buckets);
+            SDL_free(cache->freeList);
+            cache->items = NULL;
+            cache->buckets = NULL;
+            cache->freeList = NULL;
+        }
+    }
+    TTF_Font *font = SDL_Clay_GetSizedFont(rendererData, fontId, fontSize);
+    if (!cache->items) {
+        *temporary = TTF_CreateText(rendererData->textEngine, font, text.chars, text.length);
+        return *temporary;
+    }
+
+    uint32_t id = SDL_Clay_HashText(text, fontId, fontSize);
+    int32_t *bucket = &cache->buckets[id % (CLAY_SDL3_TEXT_CACHE_SIZE / 4)];
+    int32_t *previousNext = bucket;
+    int32_t index = *bucket;
+    while (index != 0) {
+        Clay_SDL3TextCacheItem *item = &cache->items[index];
+        if (item->id == id && item->length == text.length) {
+            item->generation = cache->generation;
+            return item->text;
+        }
+        // This text hasn't been used in a few frames, destroy it
+        if (cache->generation - item->generation > 2) {
+            int32_t nextIndex = item->nextIndex;
+            *previousNext = nextIndex;
+            SDL_Clay_FreeTextCacheItem(cache, index);
+            index = nextIndex;
+        } else {
+            previousNext = &item->nextIndex;
+            index = item->nextIndex;
+        }
+    }
+
+    TTF_Text *ttfText = TTF_CreateText(rendererData->textEngine, font, text.chars, text.length);
+    if (!ttfText) {
+        return NULL;
+    }
+    if (cache->freeListLength == 0 && cache->itemCount == CLAY_SDL3_TEXT_CACHE_SIZE) {
+        SDL_Clay_EvictStaleText(cache);
+    }
+    int32_t newIndex = 0;
+    if (cache->freeListLength > 0) {
+        newIndex = cache->freeList[--cache->freeListLength];
+    } else if (cache->itemCount < CLAY_SDL3_TEXT_CACHE_SIZE) {
+        newIndex = cache->itemCount++;
+    } else {
+        *temporary = ttfText;
+        return ttfText;
+    }
+    cache->items[newIndex] = (Clay_SDL3TextCacheItem) { .id = id, .length = text.length, .generation = cache->generation, .nextIndex = *bucket, .text = ttfText };
+    *bucket = newIndex;
+    return ttfText;
+}
+
+// A Clay_MeasureTextFunction that shapes text through the renderer's text cache, so that each unique string is only shaped once
+// for both measurement and rendering. userData must point to the Clay_SDL3RendererData passed to SDL_Clay_RenderClayCommands.
+static inline Clay_Dimensions SDL_Clay_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData) {
+    Clay_SDL3RendererData *rendererData = userData;
+    TTF_Text *temporary;
+    TTF_Text *ttfText = SDL_Clay_GetCachedText(rendererData, text, config->fontId, config->fontSize, &temporary);
+    int width = 0, height = 0;
+    if (!ttfText || !TTF_GetTextSize(ttfText, &width, &height)) {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to measure text: %s", SDL_GetError());
+    }
+    if (temporary) {
+        TTF_DestroyText(temporary);
+    }
+    return (Clay_Dimensions) { (float) width, (float) height };
+}
+
+// Destroys all cached text and sized fonts. Must be called before the fonts or the text engine are destroyed.
+static void SDL_Clay_DestroyTextCache(Clay_SDL3RendererData *rendererData) {
+    Clay_SDL3TextCache *cache = &rendererData->textCache;
+    if (cache->items) {
+        for (int32_t i = 1; i < cache->itemCount; i++) {
+            if (cache->items[i].id != 0) {
+                TTF_DestroyText(cache->items[i].text);
+            }
+        }
+    }
+    for (int i = 0; i < cache->sizedFontCount; i++) {
+        TTF_CloseFont(cache->sizedFonts[i].font);
+    }
+    SDL_free(cache->items);
+    SDL_free(cache->buckets);
+    SDL_free(cache->freeList);
+    *cache = (Clay_SDL3TextCache) {0};
+}
+
 SDL_Rect currentClippingRectangle;
 
 static void SDL_Clay_RenderClayCommands(Clay_SDL3RendererData *rendererData, Clay_RenderCommandArray *rcommands)
@@ -163,12 +372,15 @@ static void SDL_Clay_RenderClayCommands(Clay_SDL3RendererData *rendererData, Cla
             } break;
             case CLAY_RENDER_COMMAND_TYPE_TEXT: {
                 Clay_TextRenderData *config = &rcmd->renderData.text;
-                TTF_Font *font = rendererData->fonts[config->fontId];
-                TTF_SetFontSize(font, config->fontSize);
-                TTF_Text *text = TTF_CreateText(rendererData->textEngine, font, config->stringContents.chars, config->stringContents.length);
-                TTF_SetTextColor(text, config->textColor.r, config->textColor.g, config->textColor.b, config->textColor.a);
-                TTF_DrawRendererText(text, rect.x, rect.y);
-                TTF_DestroyText(text);
+                TTF_Text *temporary;
+                TTF_Text *text = SDL_Clay_GetCachedText(rendererData, config->stringContents, config->fontId, config->fontSize, &temporary);
+                if (text) {
+                    TTF_SetTextColor(text, config->textColor.r, config->textColor.g, config->textColor.b, config->textColor.a);
+                    TTF_DrawRendererText(text, rect.x, rect.y);
+                }
+                if (temporary) {
+                    TTF_DestroyText(temporary);
+                }
             } break;
             case CLAY_RENDER_COMMAND_TYPE_BORDER: {
                 Clay_BorderRenderData *config = &rcmd->renderData.border;
@@ -261,4 +473,5 @@ static void SDL_Clay_RenderClayCommands(Clay_SDL3RendererData *rendererData, Cla
                 SDL_Log("Unknown render command type: %d", rcmd->commandType);
         }
     }
+    rendererData->textCache.generation++;
 }
@@ -0,0 +1,265 @@
+#ifndef CLAY_RENDER_BATCH_INCLUDED
+#define CLAY_RENDER_BATCH_INCLUDED (1)
+/*
+    clay_render_batch.h -- renderer independent batching of Clay render commands
+
+    Do this:
+        #define CLAY_RENDER_BATCH_IMPLEMENTATION
+
+    before you include this file in *one* C file to create the
+    implementation. clay.h must be included first.
+
+    Optionally define CLAY_RENDER_BATCH_REALLOC and CLAY_RENDER_BATCH_FREE
+    before the implementation to replace realloc() and free().
+
+    FEATURE OVERVIEW:
+    =================
+    Most renderers issue one draw call per render command. This header sorts
+    the commands of a frame into batches that can each be drawn with a single
+    draw call, while producing exactly the same image:
+
+        - a batch only contains commands with the same zIndex and scissor
+          rectangle, and of the same kind: rectangles and borders (drawn as
+          quads), images with the same imageData, text with the same fontId,
+          or a single custom command.
+        - a command is only moved into an earlier batch if it doesn't overlap
+          anything drawn in between, so the painter's order of overlapping
+          commands never changes.
+
+    Rectangles and borders are also written out as one Clay_RenderBatchQuad
+    per command (bounding box, color, corner radius and border widths), which
+    can be uploaded as-is as an instance buffer for a rounded rectangle shader.
+    A quad with all border widths set to zero is a filled rectangle.
+
+    HOWTO:
+    ======
+        static Clay_RenderBatcher batcher; // Zero initialised
+
+        Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+        Clay_RenderBatcher_Batch(&batcher, renderCommands);
+        for (int32_t i = 0; i < batcher.batchCount; i++) {
+            Clay_RenderBatch *batch = &batcher.batches[i];
+            // set the scissor rectangle from batch->scissorEnabled / batch->scissorBox, then either
+            // draw batcher.quads[batch->quadsStart .. batch->quadsStart + batch->quadCount] for CLAY_RENDER_BATCH_TYPE_QUADS, or
+            // draw renderCommands.internalArray[batcher.commandIndices[batch->commandsStart + j]] for j < batch->commandCount
+        }
+
+        Clay_RenderBatcher_Free(&batcher); // on shutdown
+
+    Scissor commands are consumed by the batcher and don't appear in any
+    batch. As in the other renderers, a SCISSOR_START replaces the current
+    scissor rectangle and a SCISSOR_END disables scissoring.
+ */
+
+typedef enum {
+    // Rectangle and border commands, see Clay_RenderBatch.quadsStart
+    CLAY_RENDER_BATCH_TYPE_QUADS,
+    // Image commands sharing the same Clay_RenderBatch.imageData
+    CLAY_RENDER_BATCH_TYPE_IMAGES,
+    // Text commands sharing the same Clay_RenderBatch.fontId
+    CLAY_RENDER_BATCH_TYPE_TEXT,
+    // A single custom command, which is never merged with anything else
+    CLAY_RENDER_BATCH_TYPE_CUSTOM,
+} Clay_RenderBatchType;
+
+// A rectangle or border, laid out as 16 floats for use as GPU instance data
+typedef struct {
+    Clay_BoundingBox boundingBox;
+    Clay_Color color;
+    Clay_CornerRadius cornerRadius;
+    // In the order left, right, top, bottom. All zero for filled rectangles.
+    float borderWidth[4];
+} Clay_RenderBatchQuad;
+
+typedef struct {
+    Clay_RenderBatchType type;
+    int16_t zIndex;
+    bool scissorEnabled;
+    Clay_BoundingBox scissorBox;
+    // The batch key for CLAY_RENDER_BATCH_TYPE_IMAGES and CLAY_RENDER_BATCH_TYPE_TEXT respectively
+    void *imageData;
+    uint16_t fontId;
+    // The union of the bounding boxes of every command in the batch
+    Clay_BoundingBox bounds;
+    // A range of Clay_RenderBatcher.commandIndices, in their original order
+    int32_t commandsStart;
+    int32_t commandCount;
+    // A range of Clay_RenderBatcher.quads, only used by CLAY_RENDER_BATCH_TYPE_QUADS
+    int32_t quadsStart;
+    int32_t quadCount;
+} Clay_RenderBatch;
+
+typedef struct {
+    Clay_RenderBatch *batches;
+    int32_t batchCount;
+    // Indices into the batched Clay_RenderCommandArray, grouped by batch
+    int32_t *commandIndices;
+    int32_t commandIndexCount;
+    Clay_RenderBatchQuad *quads;
+    int32_t quadCount;
+    // Internal storage, grown as required
+    int32_t batchCapacity;
+    int32_t commandCapacity;
+    int32_t *commandBatches;
+} Clay_RenderBatcher;
+
+// Sorts a frame's render commands into batches, replacing the batches of the previous call
+void Clay_RenderBatcher_Batch(Clay_RenderBatcher *batcher, Clay_RenderCommandArray renderCommands);
+// Frees the memory used by the batcher, which can then be reused
+void Clay_RenderBatcher_Free(Clay_RenderBatcher *batcher);
+
+#endif /* CLAY_RENDER_BATCH_INCLUDED */
+
+#ifdef CLAY_RENDER_BATCH_IMPLEMENTATION
+#undef CLAY_RENDER_BATCH_IMPLEMENTATION
+#ifndef CLAY_HEADER
+#error "Please include clay.h before clay_render_batch.h"
+#endif
+
+#if !defined(CLAY_RENDER_BATCH_REALLOC) || !defined(CLAY_RENDER_BATCH_FREE)
+#include <stdlib.h>
+#define CLAY_RENDER_BATCH_REALLOC(pointer, size) realloc(pointer, size)
+#define CLAY_RENDER_BATCH_FREE(pointer) free(pointer)
+#endif
+
+// How many earlier batches in the same layer a command may be moved back across, which bounds the cost of batching
+#ifndef CLAY_RENDER_BATCH_MAX_LOOKBACK
+#define CLAY_RENDER_BATCH_MAX_LOOKBACK 32
+#endif
+
+static inline bool Clay__RenderBatchBoxesOverlap(Clay_BoundingBox a, Clay_BoundingBox b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static inline Clay_BoundingBox Clay__RenderBatchBoxUnion(Clay_BoundingBox a, Clay_BoundingBox b) {
+    float x = CLAY__MIN(a.x, b.x);
+    float y = CLAY__MIN(a.y, b.y);
+    return (Clay_BoundingBox) { x, y, CLAY__MAX(a.x + a.width, b.x + b.width) - x, CLAY__MAX(a.y + a.height, b.y + b.height) - y };
+}
+
+static inline bool Clay__RenderBatchKeyMatches(Clay_RenderBatch *batch, Clay_RenderBatchType type, Clay_RenderCommand *command) {
+    switch (type) {
+        case CLAY_RENDER_BATCH_TYPE_QUADS: return batch->type == type;
+        case CLAY_RENDER_BATCH_TYPE_IMAGES: return batch->type == type && batch->imageData == command->renderData.image.imageData;
+        case CLAY_RENDER_BATCH_TYPE_TEXT: return batch->type == type && batch->fontId == command->renderData.text.fontId;
+        default: return false;
+    }
+}
+
+void Clay_RenderBatcher_Batch(Clay_RenderBatcher *batcher, Clay_RenderCommandArray renderCommands) {
+    if (renderCommands.length > batcher->commandCapacity) {
+        batcher->commandCapacity = renderCommands.length;
+        batcher->commandIndices = (int32_t *)CLAY_RENDER_BATCH_REALLOC(batcher->commandIndices, (size_t)batcher->commandCapacity * sizeof(int32_t));
+        batcher->commandBatches = (int32_t *)CLAY_RENDER_BATCH_REALLOC(batcher->commandBatches, (size_t)batcher->commandCapacity * sizeof(int32_t));
+        batcher->quads = (Clay_RenderBatchQuad *)CLAY_RENDER_BATCH_REALLOC(batcher->quads, (size_t)batcher->commandCapacity * sizeof(Clay_RenderBatchQuad));
+    }
+    batcher->batchCount = 0;
+    batcher->commandIndexCount = 0;
+    batcher->quadCount = 0;
+
+    // Assign each command to a batch. Batches from layerStart onwards share the current zIndex and scissor rectangle.
+    int32_t layerStart = 0;
+    bool scissorEnabled = false;
+    Clay_BoundingBox scissorBox = CLAY__DEFAULT_STRUCT;
+    for (int32_t i = 0; i < renderCommands.length; i++) {
+        Clay_RenderCommand *command = &renderCommands.internalArray[i];
+        batcher->commandBatches[i] = -1;
+        Clay_RenderBatchType type;
+        switch (command->commandType) {
+            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: scissorEnabled = true; scissorBox = command->boundingBox; layerStart = batcher->batchCount; continue;
+            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: scissorEnabled = false; layerStart = batcher->batchCount; continue;
+            case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: type = CLAY_RENDER_BATCH_TYPE_QUADS; break;
+            case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+                Clay_BorderWidth width = command->renderData.border.width;
+                // A quad without border widths is a filled rectangle, so skip borders that wouldn't draw anything
+                if (width.left == 0 && width.right == 0 && width.top == 0 && width.bottom == 0) {
+                    continue;
+                }
+                type = CLAY_RENDER_BATCH_TYPE_QUADS;
+                break;
+            }
+            case CLAY_RENDER_COMMAND_TYPE_IMAGE: type = CLAY_RENDER_BATCH_TYPE_IMAGES; break;
+            case CLAY_RENDER_COMMAND_TYPE_TEXT: type = CLAY_RENDER_BATCH_TYPE_TEXT; break;
+            case CLAY_RENDER_COMMAND_TYPE_CUSTOM: type = CLAY_RENDER_BATCH_TYPE_CUSTOM; break;
+            default: continue;
+        }
+        if (layerStart < batcher->batchCount && batcher->batches[layerStart].zIndex != command->zIndex) {
+            layerStart = batcher->batchCount;
+        }
+        // Search backwards for a batch with the same key, stopping at anything this command would be drawn underneath by moving it
+        int32_t batchIndex = -1;
+        int32_t lookbackEnd = CLAY__MAX(layerStart, batcher->batchCount - CLAY_RENDER_BATCH_MAX_LOOKBACK);
+        for (int32_t j = batcher->batchCount - 1; j >= lookbackEnd; j--) {
+            Clay_RenderBatch *candidate = &batcher->batches[j];
+            if (Clay__RenderBatchKeyMatches(candidate, type, command)) {
+                batchIndex = j;
+                break;
+            }
+            if (Clay__RenderBatchBoxesOverlap(candidate->bounds, command->boundingBox) || candidate->type == CLAY_RENDER_BATCH_TYPE_CUSTOM) {
+                break;
+            }
+        }
+        if (batchIndex == -1) {
+            if (batcher->batchCount == batcher->batchCapacity) {
+                batcher->batchCapacity = CLAY__MAX(batcher->batchCapacity * 2, 64);
+                batcher->batches = (Clay_RenderBatch *)CLAY_RENDER_BATCH_REALLOC(batcher->batches, (size_t)batcher->batchCapacity * sizeof(Clay_RenderBatch));
+            }
+            batchIndex = batcher->batchCount++;
+            batcher->batches[batchIndex] = (Clay_RenderBatch) {
+                .type = type,
+                .zIndex = command->zIndex,
+                .scissorEnabled = scissorEnabled,
+                .scissorBox = scissorBox,
+                .imageData = type == CLAY_RENDER_BATCH_TYPE_IMAGES ? command->renderData.image.imageData : NULL,
+                .fontId = type == CLAY_RENDER_BATCH_TYPE_TEXT ? command->renderData.text.fontId : 0,
+                .bounds = command->boundingBox,
+            };
+        }
+        Clay_RenderBatch *batch = &batcher->batches[batchIndex];
+        batch->bounds = Clay__RenderBatchBoxUnion(batch->bounds, command->boundingBox);
+        batch->commandCount++;
+        if (type == CLAY_RENDER_BATCH_TYPE_QUADS) {
+            batch->quadCount++;
+        }
+        batcher->commandBatches[i] = batchIndex;
+    }
+
+    // Lay the batches' commands and quads out contiguously, keeping each batch's commands in their original order
+    int32_t commandsStart = 0;
+    int32_t quadsStart = 0;
+    for (int32_t i = 0; i < batcher->batchCount; i++) {
+        Clay_RenderBatch *batch = &batcher->batches[i];
+        batch->commandsStart = commandsStart;
+        batch->quadsStart = quadsStart;
+        commandsStart += batch->commandCount;
+        quadsStart += batch->quadCount;
+        batch->commandCount = 0;
+        batch->quadCount = 0;
+    }
+    for (int32_t i = 0; i < renderCommands.length; i++) {
+        if (batcher->commandBatches[i] == -1) {
+            continue;
+        }
+        Clay_RenderCommand *command = &renderCommands.internalArray[i];
+        Clay_RenderBatch *batch = &batcher->batches[batcher->commandBatches[i]];
+        batcher->commandIndices[batch->commandsStart + batch->commandCount++] = i;
+        if (command->commandType == CLAY_RENDER_COMMAND_TYPE_RECTANGLE) {
+            Clay_RectangleRenderData *rectangle = &command->renderData.rectangle;
+            batcher->quads[batch->quadsStart + batch->quadCount++] = (Clay_RenderBatchQuad) { command->boundingBox, rectangle->backgroundColor, rectangle->cornerRadius, { 0, 0, 0, 0 } };
+        } else if (command->commandType == CLAY_RENDER_COMMAND_TYPE_BORDER) {
+            Clay_BorderRenderData *border = &command->renderData.border;
+            batcher->quads[batch->quadsStart + batch->quadCount++] = (Clay_RenderBatchQuad) { command->boundingBox, border->color, border->cornerRadius, { border->width.left, border->width.right, border->width.top, border->width.bottom } };
+        }
+    }
+    batcher->commandIndexCount = commandsStart;
+    batcher->quadCount = quadsStart;
+}
+
+void Clay_RenderBatcher_Free(Clay_RenderBatcher *batcher) {
+    CLAY_RENDER_BATCH_FREE(batcher->batches);
+    CLAY_RENDER_BATCH_FREE(batcher->commandIndices);
+    CLAY_RENDER_BATCH_FREE(batcher->commandBatches);
+    CLAY_RENDER_BATCH_FREE(batcher->quads);
+    *batcher = (Clay_RenderBatcher) { 0 };
+}
+#endif /* CLAY_RENDER_BATCH_IMPLEMENTATION */
@@ -43,6 +43,24 @@ void Clay_Cairo_Initialize(cairo_t *cairo);
 // Render the command queue to the `cairo_t*` instance you called
 // `Clay_Cairo_Initialize` on.
 void Clay_Cairo_Render(Clay_RenderCommandArray commands, char** fonts);
+
+// Lay out and render a document that is longer than one page, one
+// page at a time.  `layout` is called between Clay_BeginLayout and
+// Clay_EndLayout for every page and declares the same layout each
+// time, with the flowing content inside the vertical clip element
+// `contentId`, which uses `.childOffset = Clay_GetScrollOffset()`.
+// Before each page that element is scrolled to where the previous
+// page ended, so long lists declared with Clay_VirtualListBegin only
+// produce the items that land on the current page.  An item cut off
+// by the bottom of a page starts the next page instead.
+//
+// Each page is emitted with cairo_show_page() once it is rendered,
+// which lets a PDF surface write it out before the next page is laid
+// out.  Returns the number of pages emitted.
+int Clay_Cairo_RenderPages(Clay_ElementId contentId, void (*layout)(int page, void *userData), void *userData, char** fonts);
+
+// Release the font faces and images cached by Clay_Cairo_Render.
+void Clay_Cairo_Shutdown(void);
 ////////////////////////////////
 
 
@@ -61,6 +79,24 @@ void Clay_Cairo_Render(Clay_RenderCommandArray commands, char** fonts);
 // Cairo instance
 static cairo_t *Clay__Cairo = NULL;
 
+// Font faces indexed by fontId, created on first use and kept across
+// frames and pages, rather than looking the family up again for
+// every text command.
+static cairo_font_face_t **Clay__CairoFontFaces = NULL;
+static int Clay__CairoFontFaceCount = 0;
+static char **Clay__CairoFonts = NULL;
+
+// Images loaded by path.  Drawing the same surface again lets the PDF
+// backend refer to the copy it already embedded.
+typedef struct {
+	char *path;
+	cairo_surface_t *surface;
+} Clay_Cairo__Image;
+
+static Clay_Cairo__Image *Clay__CairoImages = NULL;
+static int Clay__CairoImageCount = 0;
+static int Clay__CairoImageCapacity = 0;
+
 // Return a null-terminated copy of Clay_String `str`.
 // Callee is required to free.
 static inline char *Clay_Cairo__NullTerminate(Clay_String *str) {
@@ -74,6 +110,78 @@ static inline char *Clay_Cairo__NullTerminate(Clay_String *str) {
 	return copy;
 }
 
+static void Clay_Cairo__ReleaseFontFaces(void) {
+	for (int i = 0; i < Clay__CairoFontFaceCount; i++) {
+		if (Clay__CairoFontFaces[i]) {
+			cairo_font_face_destroy(Clay__CairoFontFaces[i]);
+		}
+	}
+	free(Clay__CairoFontFaces);
+	Clay__CairoFontFaces = NULL;
+	Clay__CairoFontFaceCount = 0;
+}
+
+// Return the cached font face for `fontId`, creating it from
+// `fonts[fontId]` on first use.
+static cairo_font_face_t *Clay_Cairo__GetFontFace(char **fonts, uint16_t fontId) {
+	// The faces belong to the font table they were created from.
+	if (fonts != Clay__CairoFonts) {
+		Clay_Cairo__ReleaseFontFaces();
+		Clay__CairoFonts = fonts;
+	}
+
+	if (fontId >= Clay__CairoFontFaceCount) {
+		int count = fontId + 1;
+		cairo_font_face_t **faces = (cairo_font_face_t**) realloc(Clay__CairoFontFaces, count * sizeof(cairo_font_face_t*));
+		if (!faces) {
+			fprintf(stderr, "Memory allocation failed\n");
+			return NULL;
+		}
+		memset(faces + Clay__CairoFontFaceCount, 0, (count - Clay__CairoFontFaceCount) * sizeof(cairo_font_face_t*));
+		Clay__CairoFontFaces = faces;
+		Clay__CairoFontFaceCount = count;
+	}
+
+	if (!Clay__CairoFontFaces[fontId]) {
+		Clay__CairoFontFaces[fontId] = cairo_toy_font_face_create(fonts[fontId], CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+	}
+	return Clay__CairoFontFaces[fontId];
+}
+
+// Return the cached surface for the PNG at `path`, loading it on
+// first use.
+static cairo_surface_t *Clay_Cairo__GetImage(const char *path) {
+	for (int i = 0; i < Clay__CairoImageCount; i++) {
+		if (strcmp(Clay__CairoImages[i].path, path) == 0) {
+			return Clay__CairoImages[i].surface;
+		}
+	}
+
+	if (Clay__CairoImageCount == Clay__CairoImageCapacity) {
+		int capacity = Clay__CairoImageCapacity ? Clay__CairoImageCapacity * 2 : 8;
+		Clay_Cairo__Image *images = (Clay_Cairo__Image*) realloc(Clay__CairoImages, capacity * sizeof(Clay_Cairo__Image));
+		if (!images) {
+			fprintf(stderr, "Memory allocation failed\n");
+			return NULL;
+		}
+		Clay__CairoImages = images;
+		Clay__CairoImageCapacity = capacity;
+	}
+
+	size_t length = strlen(path);
+	char *copy = (char*) malloc(length + 1);
+	if (!copy) {
+		fprintf(stderr, "Memory allocation failed\n");
+		return NULL;
+	}
+	memcpy(copy, path, length + 1);
+
+	Clay_Cairo__Image *image = &Clay__CairoImages[Clay__CairoImageCount++];
+	image->path = copy;
+	image->surface = cairo_image_surface_create_from_png(path);
+	return image->surface;
+}
+
 // Measure text using cairo's *toy* text API.
 static inline Clay_Dimensions Clay_Cairo_MeasureText(Clay_StringSlice str, Clay_TextElementConfig *config, void *userData) {
 	// Edge case: Clay computes the width of a whitespace character
@@ -97,14 +205,13 @@ static inline Clay_Dimensions Clay_Cairo_MeasureText(Clay_StringSlice str, Clay_
 	// Ensure string is null-terminated for Cairo
     Clay_String toTerminate = (Clay_String){ .chars = str.chars, .length = str.length, .isStaticallyAllocated = false };
 	char *text = Clay_Cairo__NullTerminate(&toTerminate);
-	char *font_family = fonts[config->fontId];
 
 	// Save and reset the Cairo context to avoid unwanted transformations
 	cairo_save(Clay__Cairo);
 	cairo_identity_matrix(Clay__Cairo);
 
 	// Set font properties
-	cairo_select_font_face(Clay__Cairo, font_family, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+	cairo_set_font_face(Clay__Cairo, Clay_Cairo__GetFontFace(fonts, config->fontId));
 	cairo_set_font_size(Clay__Cairo, config->fontSize);
 
 	// Use glyph extents for better precision
@@ -155,11 +262,9 @@ void Clay_Cairo_Initialize(cairo_t *cairo) {
 }
 
 // Internally used to copy images onto our document/active workspace.
-void Clay_Cairo__Blit_Surface(cairo_surface_t *src_surface, cairo_surface_t *dest_surface,
+// Draws through `cr` so that the image is clipped like everything else.
+void Clay_Cairo__Blit_Surface(cairo_surface_t *src_surface, cairo_t *cr,
 							  double x, double y, double scale_x, double scale_y) {
-	// Create a cairo context for the destination surface
-	cairo_t *cr = cairo_create(dest_surface);
-
 	// Save the context's state
 	cairo_save(cr);
 
@@ -177,9 +282,6 @@ void Clay_Cairo__Blit_Surface(cairo_surface_t *src_surface, cairo_surface_t *des
 
 	// Restore the context's state to remove transformations
 	cairo_restore(cr);
-
-	// Clean up
-	cairo_destroy(cr);
 }
 
 void Clay_Cairo_Render(Clay_RenderCommandArray commands, char** fonts) {
@@ -222,12 +324,11 @@ void Clay_Cairo_Render(Clay_RenderCommandArray commands, char** fonts) {
             Clay_TextRenderData *config = &command->renderData.text;
             Clay_String toTerminate = (Clay_String){ .chars = config->stringContents.chars, .length = config->stringContents.length, .isStaticallyAllocated = false };
 			char *text = Clay_Cairo__NullTerminate(&toTerminate);
-			char *font_family = fonts[config->fontId];
 
 			Clay_BoundingBox bb = command->boundingBox;
 			Clay_Color color = config->textColor;
 
-			cairo_select_font_face(Clay__Cairo, font_family, CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+			cairo_set_font_face(cr, Clay_Cairo__GetFontFace(fonts, config->fontId));
 			cairo_set_font_size(cr, config->fontSize);
 
 			cairo_move_to(cr, bb.x, bb.y + bb.height);
@@ -331,8 +432,12 @@ void Clay_Cairo_Render(Clay_RenderCommandArray commands, char** fonts) {
 
 			char *path = config->imageData;
 
-			cairo_surface_t *surf = cairo_image_surface_create_from_png(path),
-							*origin = cairo_get_target(cr);
+			// Loaded once and kept for later frames and pages
+			cairo_surface_t *surf = Clay_Cairo__GetImage(path);
+			if (!surf || cairo_surface_status(surf) != CAIRO_STATUS_SUCCESS) {
+				fprintf(stderr, "Failed to load image %s\n", path);
+				break;
+			}
 
 			// Calculate the original image dimensions
 			double image_w = cairo_image_surface_get_width(surf),
@@ -356,10 +461,19 @@ void Clay_Cairo_Render(Clay_RenderCommandArray commands, char** fonts) {
 			double centered_y = bb.y + (bb.height - scaled_h) / 2.0;
 
 			// Blit the scaled and centered image
-			Clay_Cairo__Blit_Surface(surf, origin, centered_x, centered_y, scale_x, scale_y);
+			Clay_Cairo__Blit_Surface(surf, cr, centered_x, centered_y, scale_x, scale_y);
+			break;
+		}
+		case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
+			Clay_BoundingBox bb = command->boundingBox;
 
-			// Clean up the source surface
-			cairo_surface_destroy(surf);
+			cairo_save(cr);
+			cairo_rectangle(cr, bb.x, bb.y, bb.width, bb.height);
+			cairo_clip(cr);
+			break;
+		}
+		case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
+			cairo_restore(cr);
 			break;
 		}
 		case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
@@ -371,3 +485,80 @@ void Clay_Cairo_Render(Clay_RenderCommandArray commands, char** fonts) {
 		}
 	}
 }
+
+// How far to scroll the content element for the next page.  That is
+// up to the top of the first item cut off by the bottom of the
+// content element on this page, or a whole page if nothing is cut off
+// or the cut item already started above this page.
+static float Clay_Cairo__PageAdvance(Clay_RenderCommandArray commands, Clay_ElementId contentId, float pageHeight) {
+	float top = 0, bottom = 0, cut = 0;
+	int depth = 0;
+	for(int32_t i = 0; i < commands.length; i++) {
+		Clay_RenderCommand *command = Clay_RenderCommandArray_Get(&commands, i);
+		Clay_BoundingBox bb = command->boundingBox;
+
+		if (command->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) {
+			if (depth > 0) {
+				depth++;
+			} else if (command->id == contentId.id) {
+				depth = 1;
+				top = bb.y;
+				bottom = cut = bb.y + bb.height;
+			}
+			continue;
+		}
+		if (command->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_END) {
+			if (depth > 0 && --depth == 0) {
+				break;
+			}
+			continue;
+		}
+		if (depth > 0 && bb.y < cut && bb.y + bb.height > bottom) {
+			cut = bb.y;
+		}
+	}
+	return cut > top ? cut - top : pageHeight;
+}
+
+int Clay_Cairo_RenderPages(Clay_ElementId contentId, void (*layout)(int page, void *userData), void *userData, char** fonts) {
+	int page = 0;
+	float offset = 0;
+	for(;;) {
+		// Scroll the content to where this page starts, the first page
+		// also resets a position left over from an earlier document.
+		Clay_ScrollContainerData content = Clay_GetScrollContainerData(contentId);
+		if (content.found) {
+			content.scrollPosition->y = -offset;
+		}
+
+		Clay_BeginLayout();
+		layout(page, userData);
+		Clay_RenderCommandArray commands = Clay_EndLayout();
+
+		Clay_Cairo_Render(commands, fonts);
+		cairo_show_page(Clay__Cairo);
+		page++;
+
+		content = Clay_GetScrollContainerData(contentId);
+		float pageHeight = content.scrollContainerDimensions.height;
+		if (!content.found || pageHeight <= 0 || offset + pageHeight >= content.contentDimensions.height) {
+			break;
+		}
+		offset += Clay_Cairo__PageAdvance(commands, contentId, pageHeight);
+	}
+	return page;
+}
+
+void Clay_Cairo_Shutdown(void) {
+	Clay_Cairo__ReleaseFontFaces();
+	Clay__CairoFonts = NULL;
+
+	for (int i = 0; i < Clay__CairoImageCount; i++) {
+		cairo_surface_destroy(Clay__CairoImages[i].surface);
+		free(Clay__CairoImages[i].path);
+	}
+	free(Clay__CairoImages);
+	Clay__CairoImages = NULL;
+	Clay__CairoImageCount = 0;
+	Clay__CairoImageCapacity = 0;
+}
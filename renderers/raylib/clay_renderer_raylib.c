@@ -135,131 +135,174 @@ void Clay_Raylib_Initialize(int width, int height, const char *title, unsigned i
 static char *temp_render_buffer = NULL;
 static int temp_render_buffer_len = 0;
 
+#ifdef CLAY_RENDER_BATCH_INCLUDED
+// Reused by Clay_Raylib_RenderBatched() each frame, also freed by Clay_Raylib_Close()
+static Clay_RenderBatcher Raylib_batcher;
+#endif
+
 // Call after closing the window to clean up the render buffer
 void Clay_Raylib_Close()
 {
     if(temp_render_buffer) free(temp_render_buffer);
     temp_render_buffer_len = 0;
+#ifdef CLAY_RENDER_BATCH_INCLUDED
+    Clay_RenderBatcher_Free(&Raylib_batcher);
+#endif
 
     CloseWindow();
 }
 
 
-void Clay_Raylib_Render(Clay_RenderCommandArray renderCommands, Font* fonts)
+static void Clay_Raylib_RenderCommand(Clay_RenderCommandArray renderCommands, Clay_RenderCommand *renderCommand, Font* fonts)
 {
-    for (int j = 0; j < renderCommands.length; j++)
+    Clay_BoundingBox boundingBox = {roundf(renderCommand->boundingBox.x), roundf(renderCommand->boundingBox.y), roundf(renderCommand->boundingBox.width), roundf(renderCommand->boundingBox.height)};
+    switch (renderCommand->commandType)
     {
-        Clay_RenderCommand *renderCommand = Clay_RenderCommandArray_Get(&renderCommands, j);
-        Clay_BoundingBox boundingBox = {roundf(renderCommand->boundingBox.x), roundf(renderCommand->boundingBox.y), roundf(renderCommand->boundingBox.width), roundf(renderCommand->boundingBox.height)};
-        switch (renderCommand->commandType)
-        {
-            case CLAY_RENDER_COMMAND_TYPE_TEXT: {
-                Clay_TextRenderData *textData = &renderCommand->renderData.text;
-                Font fontToUse = fonts[textData->fontId];
-    
-                int strlen = textData->stringContents.length + 1;
-    
-                if(strlen > temp_render_buffer_len) {
-                    // Grow the temp buffer if we need a larger string
-                    if(temp_render_buffer) free(temp_render_buffer);
-                    temp_render_buffer = (char *) malloc(strlen);
-                    temp_render_buffer_len = strlen;
-                }
-    
-                // Raylib uses standard C strings so isn't compatible with cheap slices, we need to clone the string to append null terminator
-                memcpy(temp_render_buffer, textData->stringContents.chars, textData->stringContents.length);
-                temp_render_buffer[textData->stringContents.length] = '\0';
-                DrawTextEx(fontToUse, temp_render_buffer, (Vector2){boundingBox.x, boundingBox.y}, (float)textData->fontSize, (float)textData->letterSpacing, CLAY_COLOR_TO_RAYLIB_COLOR(textData->textColor));
-    
-                break;
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            Clay_TextRenderData *textData = &renderCommand->renderData.text;
+            Font fontToUse = fonts[textData->fontId];
+
+            int strlen = textData->stringContents.length + 1;
+
+            if(strlen > temp_render_buffer_len) {
+                // Grow the temp buffer if we need a larger string
+                if(temp_render_buffer) free(temp_render_buffer);
+                temp_render_buffer = (char *) malloc(strlen);
+                temp_render_buffer_len = strlen;
             }
-            case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
-                Texture2D imageTexture = *(Texture2D *)renderCommand->renderData.image.imageData;
-                Clay_Color tintColor = renderCommand->renderData.image.backgroundColor;
-                if (tintColor.r == 0 && tintColor.g == 0 && tintColor.b == 0 && tintColor.a == 0) {
-                    tintColor = (Clay_Color) { 255, 255, 255, 255 };
-                }
-                DrawTexturePro(
-                    imageTexture,
-                    (Rectangle) { 0, 0, imageTexture.width, imageTexture.height },
-                    (Rectangle){boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height},
-                    (Vector2) {},
-                    0,
-                    CLAY_COLOR_TO_RAYLIB_COLOR(tintColor));
-                break;
+
+            // Raylib uses standard C strings so isn't compatible with cheap slices, we need to clone the string to append null terminator
+            memcpy(temp_render_buffer, textData->stringContents.chars, textData->stringContents.length);
+            temp_render_buffer[textData->stringContents.length] = '\0';
+            DrawTextEx(fontToUse, temp_render_buffer, (Vector2){boundingBox.x, boundingBox.y}, (float)textData->fontSize, (float)textData->letterSpacing, CLAY_COLOR_TO_RAYLIB_COLOR(textData->textColor));
+
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
+            Texture2D imageTexture = *(Texture2D *)renderCommand->renderData.image.imageData;
+            Clay_Color tintColor = renderCommand->renderData.image.backgroundColor;
+            if (tintColor.r == 0 && tintColor.g == 0 && tintColor.b == 0 && tintColor.a == 0) {
+                tintColor = (Clay_Color) { 255, 255, 255, 255 };
             }
-            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
-                BeginScissorMode((int)roundf(boundingBox.x), (int)roundf(boundingBox.y), (int)roundf(boundingBox.width), (int)roundf(boundingBox.height));
-                break;
+            DrawTexturePro(
+                imageTexture,
+                (Rectangle) { 0, 0, imageTexture.width, imageTexture.height },
+                (Rectangle){boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height},
+                (Vector2) {},
+                0,
+                CLAY_COLOR_TO_RAYLIB_COLOR(tintColor));
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
+            BeginScissorMode((int)roundf(boundingBox.x), (int)roundf(boundingBox.y), (int)roundf(boundingBox.width), (int)roundf(boundingBox.height));
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
+            EndScissorMode();
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            Clay_RectangleRenderData *config = &renderCommand->renderData.rectangle;
+            if (config->cornerRadius.topLeft > 0) {
+                float radius = (config->cornerRadius.topLeft * 2) / (float)((boundingBox.width > boundingBox.height) ? boundingBox.height : boundingBox.width);
+                DrawRectangleRounded((Rectangle) { boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height }, radius, 8, CLAY_COLOR_TO_RAYLIB_COLOR(config->backgroundColor));
+            } else {
+                DrawRectangle(boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height, CLAY_COLOR_TO_RAYLIB_COLOR(config->backgroundColor));
             }
-            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
-                EndScissorMode();
-                break;
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            Clay_BorderRenderData *config = &renderCommand->renderData.border;
+            // Left border
+            if (config->width.left > 0) {
+                DrawRectangle((int)roundf(boundingBox.x), (int)roundf(boundingBox.y + config->cornerRadius.topLeft), (int)config->width.left, (int)roundf(boundingBox.height - config->cornerRadius.topLeft - config->cornerRadius.bottomLeft), CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
             }
-            case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
-                Clay_RectangleRenderData *config = &renderCommand->renderData.rectangle;
-                if (config->cornerRadius.topLeft > 0) {
-                    float radius = (config->cornerRadius.topLeft * 2) / (float)((boundingBox.width > boundingBox.height) ? boundingBox.height : boundingBox.width);
-                    DrawRectangleRounded((Rectangle) { boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height }, radius, 8, CLAY_COLOR_TO_RAYLIB_COLOR(config->backgroundColor));
-                } else {
-                    DrawRectangle(boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height, CLAY_COLOR_TO_RAYLIB_COLOR(config->backgroundColor));
-                }
-                break;
+            // Right border
+            if (config->width.right > 0) {
+                DrawRectangle((int)roundf(boundingBox.x + boundingBox.width - config->width.right), (int)roundf(boundingBox.y + config->cornerRadius.topRight), (int)config->width.right, (int)roundf(boundingBox.height - config->cornerRadius.topRight - config->cornerRadius.bottomRight), CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
             }
-            case CLAY_RENDER_COMMAND_TYPE_BORDER: {
-                Clay_BorderRenderData *config = &renderCommand->renderData.border;
-                // Left border
-                if (config->width.left > 0) {
-                    DrawRectangle((int)roundf(boundingBox.x), (int)roundf(boundingBox.y + config->cornerRadius.topLeft), (int)config->width.left, (int)roundf(boundingBox.height - config->cornerRadius.topLeft - config->cornerRadius.bottomLeft), CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                // Right border
-                if (config->width.right > 0) {
-                    DrawRectangle((int)roundf(boundingBox.x + boundingBox.width - config->width.right), (int)roundf(boundingBox.y + config->cornerRadius.topRight), (int)config->width.right, (int)roundf(boundingBox.height - config->cornerRadius.topRight - config->cornerRadius.bottomRight), CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                // Top border
-                if (config->width.top > 0) {
-                    DrawRectangle((int)roundf(boundingBox.x + config->cornerRadius.topLeft), (int)roundf(boundingBox.y), (int)roundf(boundingBox.width - config->cornerRadius.topLeft - config->cornerRadius.topRight), (int)config->width.top, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                // Bottom border
-                if (config->width.bottom > 0) {
-                    DrawRectangle((int)roundf(boundingBox.x + config->cornerRadius.bottomLeft), (int)roundf(boundingBox.y + boundingBox.height - config->width.bottom), (int)roundf(boundingBox.width - config->cornerRadius.bottomLeft - config->cornerRadius.bottomRight), (int)config->width.bottom, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                if (config->cornerRadius.topLeft > 0) {
-                    DrawRing((Vector2) { roundf(boundingBox.x + config->cornerRadius.topLeft), roundf(boundingBox.y + config->cornerRadius.topLeft) }, roundf(config->cornerRadius.topLeft - config->width.top), config->cornerRadius.topLeft, 180, 270, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                if (config->cornerRadius.topRight > 0) {
-                    DrawRing((Vector2) { roundf(boundingBox.x + boundingBox.width - config->cornerRadius.topRight), roundf(boundingBox.y + config->cornerRadius.topRight) }, roundf(config->cornerRadius.topRight - config->width.top), config->cornerRadius.topRight, 270, 360, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                if (config->cornerRadius.bottomLeft > 0) {
-                    DrawRing((Vector2) { roundf(boundingBox.x + config->cornerRadius.bottomLeft), roundf(boundingBox.y + boundingBox.height - config->cornerRadius.bottomLeft) }, roundf(config->cornerRadius.bottomLeft - config->width.bottom), config->cornerRadius.bottomLeft, 90, 180, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                if (config->cornerRadius.bottomRight > 0) {
-                    DrawRing((Vector2) { roundf(boundingBox.x + boundingBox.width - config->cornerRadius.bottomRight), roundf(boundingBox.y + boundingBox.height - config->cornerRadius.bottomRight) }, roundf(config->cornerRadius.bottomRight - config->width.bottom), config->cornerRadius.bottomRight, 0.1, 90, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                break;
+            // Top border
+            if (config->width.top > 0) {
+                DrawRectangle((int)roundf(boundingBox.x + config->cornerRadius.topLeft), (int)roundf(boundingBox.y), (int)roundf(boundingBox.width - config->cornerRadius.topLeft - config->cornerRadius.topRight), (int)config->width.top, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
             }
-            case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
-                Clay_CustomRenderData *config = &renderCommand->renderData.custom;
-                CustomLayoutElement *customElement = (CustomLayoutElement *)config->customData;
-                if (!customElement) continue;
-                switch (customElement->type) {
-                    case CUSTOM_LAYOUT_ELEMENT_TYPE_3D_MODEL: {
-                        Clay_BoundingBox rootBox = renderCommands.internalArray[0].boundingBox;
-                        float scaleValue = CLAY__MIN(CLAY__MIN(1, 768 / rootBox.height) * CLAY__MAX(1, rootBox.width / 1024), 1.5f);
-                        Ray positionRay = GetScreenToWorldPointWithZDistance((Vector2) { renderCommand->boundingBox.x + renderCommand->boundingBox.width / 2, renderCommand->boundingBox.y + (renderCommand->boundingBox.height / 2) + 20 }, Raylib_camera, (int)roundf(rootBox.width), (int)roundf(rootBox.height), 140);
-                        BeginMode3D(Raylib_camera);
-                            DrawModel(customElement->customData.model.model, positionRay.position, customElement->customData.model.scale * scaleValue, WHITE);        // Draw 3d model with texture
-                        EndMode3D();
-                        break;
-                    }
-                    default: break;
+            // Bottom border
+            if (config->width.bottom > 0) {
+                DrawRectangle((int)roundf(boundingBox.x + config->cornerRadius.bottomLeft), (int)roundf(boundingBox.y + boundingBox.height - config->width.bottom), (int)roundf(boundingBox.width - config->cornerRadius.bottomLeft - config->cornerRadius.bottomRight), (int)config->width.bottom, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
+            }
+            if (config->cornerRadius.topLeft > 0) {
+                DrawRing((Vector2) { roundf(boundingBox.x + config->cornerRadius.topLeft), roundf(boundingBox.y + config->cornerRadius.topLeft) }, roundf(config->cornerRadius.topLeft - config->width.top), config->cornerRadius.topLeft, 180, 270, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
+            }
+            if (config->cornerRadius.topRight > 0) {
+                DrawRing((Vector2) { roundf(boundingBox.x + boundingBox.width - config->cornerRadius.topRight), roundf(boundingBox.y + config->cornerRadius.topRight) }, roundf(config->cornerRadius.topRight - config->width.top), config->cornerRadius.topRight, 270, 360, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
+            }
+            if (config->cornerRadius.bottomLeft > 0) {
+                DrawRing((Vector2) { roundf(boundingBox.x + config->cornerRadius.bottomLeft), roundf(boundingBox.y + boundingBox.height - config->cornerRadius.bottomLeft) }, roundf(config->cornerRadius.bottomLeft - config->width.bottom), config->cornerRadius.bottomLeft, 90, 180, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
+            }
+            if (config->cornerRadius.bottomRight > 0) {
+                DrawRing((Vector2) { roundf(boundingBox.x + boundingBox.width - config->cornerRadius.bottomRight), roundf(boundingBox.y + boundingBox.height - config->cornerRadius.bottomRight) }, roundf(config->cornerRadius.bottomRight - config->width.bottom), config->cornerRadius.bottomRight, 0.1, 90, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
+            }
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
+            Clay_CustomRenderData *config = &renderCommand->renderData.custom;
+            CustomLayoutElement *customElement = (CustomLayoutElement *)config->customData;
+            if (!customElement) return;
+            switch (customElement->type) {
+                case CUSTOM_LAYOUT_ELEMENT_TYPE_3D_MODEL: {
+                    Clay_BoundingBox rootBox = renderCommands.internalArray[0].boundingBox;
+                    float scaleValue = CLAY__MIN(CLAY__MIN(1, 768 / rootBox.height) * CLAY__MAX(1, rootBox.width / 1024), 1.5f);
+                    Ray positionRay = GetScreenToWorldPointWithZDistance((Vector2) { renderCommand->boundingBox.x + renderCommand->boundingBox.width / 2, renderCommand->boundingBox.y + (renderCommand->boundingBox.height / 2) + 20 }, Raylib_camera, (int)roundf(rootBox.width), (int)roundf(rootBox.height), 140);
+                    BeginMode3D(Raylib_camera);
+                        DrawModel(customElement->customData.model.model, positionRay.position, customElement->customData.model.scale * scaleValue, WHITE);        // Draw 3d model with texture
+                    EndMode3D();
+                    break;
                 }
-                break;
+                default: break;
             }
-            default: {
-                printf("Error: unhandled render command.");
-                exit(1);
+            break;
+        }
+        default: {
+            printf("Error: unhandled render command.");
+            exit(1);
+        }
+    }
+}
+
+void Clay_Raylib_Render(Clay_RenderCommandArray renderCommands, Font* fonts)
+{
+    for (int j = 0; j < renderCommands.length; j++)
+    {
+        Clay_Raylib_RenderCommand(renderCommands, Clay_RenderCommandArray_Get(&renderCommands, j), fonts);
+    }
+}
+
+#ifdef CLAY_RENDER_BATCH_INCLUDED
+// Renders the same result as Clay_Raylib_Render, but groups the commands with clay_render_batch.h first.
+// raylib merges consecutive draws that share a texture, so grouping shapes, images and text by texture and font reduces the number of draw calls.
+void Clay_Raylib_RenderBatched(Clay_RenderCommandArray renderCommands, Font* fonts)
+{
+    Clay_RenderBatcher_Batch(&Raylib_batcher, renderCommands);
+    bool scissorEnabled = false;
+    Clay_BoundingBox scissorBox = { 0 };
+    for (int i = 0; i < Raylib_batcher.batchCount; i++)
+    {
+        Clay_RenderBatch *batch = &Raylib_batcher.batches[i];
+        if (batch->scissorEnabled != scissorEnabled || (scissorEnabled && memcmp(&batch->scissorBox, &scissorBox, sizeof(scissorBox)) != 0)) {
+            if (batch->scissorEnabled) {
+                BeginScissorMode((int)roundf(batch->scissorBox.x), (int)roundf(batch->scissorBox.y), (int)roundf(batch->scissorBox.width), (int)roundf(batch->scissorBox.height));
+            } else {
+                EndScissorMode();
             }
+            scissorEnabled = batch->scissorEnabled;
+            scissorBox = batch->scissorBox;
         }
+        for (int j = 0; j < batch->commandCount; j++)
+        {
+            Clay_Raylib_RenderCommand(renderCommands, &renderCommands.internalArray[Raylib_batcher.commandIndices[batch->commandsStart + j]], fonts);
+        }
+    }
+    if (scissorEnabled) {
+        EndScissorMode();
     }
 }
+#endif
@@ -13,6 +13,8 @@
     the declaration and implementation:
 
     SOKOL_CLAY_NO_SOKOL_APP    - don't depend on sokol_app.h (see below for details)
+    SOKOL_CLAY_FIRST_TEXT_LAYER - the first sokol_gl layer used by sclay_render_instanced
+                                  (default: 1, see below for details)
 
     Include the following headers before sokol_clay.h (both before including
     the declaration and implementation):
@@ -83,6 +85,32 @@
 
         before calling sclay_render.
 
+    --- To reduce the number of draw calls, include clay_render_batch.h (from
+        renderers/batching) before sokol_clay.h and call sclay_render_batched
+        instead of sclay_render. Rectangles and borders that can be drawn
+        together without changing the result are then emitted as a single
+        triangle strip, and images and text are grouped by texture and font.
+
+    --- On UIs with a lot of rounded corners, sclay_render_instanced (which also
+        needs clay_render_batch.h) is usually much cheaper than both. Every
+        rectangle, border and image becomes a single instance of a signed
+        distance field shader, so corner radii cost no extra vertices, and the
+        instances are only split into separate draw calls by scissor or texture
+        changes. Unlike sclay_render it draws immediately, so it must be called
+        inside the pass:
+
+            sg_begin_pass(...)
+            sclay_render_instanced(renderCommands, &fonts);
+            sgl_draw(); // only needed for your own sokol_gl drawing
+            sg_end_pass();
+
+        Text is still drawn with sokol_gl from the fontstash glyph atlas, which
+        is updated once for the whole frame. Each run of text between two
+        instanced draws is recorded into its own sokol_gl layer, starting from
+        SOKOL_CLAY_FIRST_TEXT_LAYER, so avoid those layer ids in your own code.
+        The shader is compiled from source for the GL, GLES3, D3D11, Metal and
+        WebGPU backends. Other backends fall back to sclay_render_batched.
+
     --- if you're using sokol_app.h, from inside the sokol_app.h event callback,
         call:
 
@@ -138,6 +166,13 @@ void sclay_set_layout_dimensions(Clay_Dimensions size, float dpi_scale);
 
 void sclay_render(Clay_RenderCommandArray renderCommands, sclay_font_t *fonts);
 
+#ifdef CLAY_RENDER_BATCH_INCLUDED
+/* Like sclay_render, but groups the commands with clay_render_batch.h first */
+void sclay_render_batched(Clay_RenderCommandArray renderCommands, sclay_font_t *fonts);
+/* Draws rectangles, borders and images with an instanced SDF shader, must be called inside a pass */
+void sclay_render_instanced(Clay_RenderCommandArray renderCommands, sclay_font_t *fonts);
+#endif
+
 #endif /* SOKOL_CLAY_INCLUDED */
 
 #ifdef SOKOL_CLAY_IMPL
@@ -152,6 +187,47 @@ void sclay_render(Clay_RenderCommandArray renderCommands, sclay_font_t *fonts);
 #error "Please include clay.h before sokol_clay.h"
 #endif
 
+#ifdef CLAY_RENDER_BATCH_INCLUDED
+#include <stdlib.h> /* realloc, free */
+#ifndef SOKOL_CLAY_FIRST_TEXT_LAYER
+#define SOKOL_CLAY_FIRST_TEXT_LAYER (1)
+#endif
+
+/* One rectangle, border or image, the per-instance vertex data of the SDF shader */
+typedef struct {
+    Clay_BoundingBox bbox;
+    Clay_Color color;
+    Clay_CornerRadius radius;
+    float border[4]; /* left, right, top, bottom, all zero for filled shapes */
+    float uv[4];     /* u0, v0, u1, v1 */
+} _sclay_instance_t;
+
+/* Either a range of instances sharing a texture and scissor rect, or a run of text in a sokol_gl layer */
+typedef struct {
+    int text_layer; /* 0 for instances */
+    int first_instance;
+    int instance_count;
+    sg_view view;
+    sg_sampler smp;
+    Clay_BoundingBox scissor;
+} _sclay_draw_t;
+
+typedef struct {
+    bool initialized;
+    bool unsupported; /* no shader for this backend, use sclay_render_batched */
+    sg_shader shd;
+    sg_pipeline pip;
+    sg_buffer buf;
+    sg_image white_img;
+    sg_view white_view;
+    sg_sampler smp;
+    _sclay_instance_t *instances;
+    int instance_count, instance_capacity;
+    _sclay_draw_t *draws;
+    int draw_count, draw_capacity;
+} _sclay_inst_state_t;
+#endif
+
 typedef struct {
     sgl_pipeline pip;
 #ifndef SOKOL_CLAY_NO_SOKOL_APP
@@ -161,6 +237,10 @@ typedef struct {
     Clay_Dimensions size;
     float dpi_scale;
     FONScontext *fonts;
+#ifdef CLAY_RENDER_BATCH_INCLUDED
+    Clay_RenderBatcher batcher;
+    _sclay_inst_state_t inst;
+#endif
 } _sclay_state_t;
 static _sclay_state_t _sclay;
 
@@ -188,6 +268,20 @@ void sclay_setup() {
 void sclay_shutdown() {
     sgl_destroy_pipeline(_sclay.pip);
     sfons_destroy(_sclay.fonts);
+#ifdef CLAY_RENDER_BATCH_INCLUDED
+    Clay_RenderBatcher_Free(&_sclay.batcher);
+    if(_sclay.inst.initialized){
+        sg_destroy_pipeline(_sclay.inst.pip);
+        sg_destroy_shader(_sclay.inst.shd);
+        sg_destroy_buffer(_sclay.inst.buf);
+        sg_destroy_view(_sclay.inst.white_view);
+        sg_destroy_image(_sclay.inst.white_img);
+        sg_destroy_sampler(_sclay.inst.smp);
+    }
+    free(_sclay.inst.instances);
+    free(_sclay.inst.draws);
+    _sclay.inst = (_sclay_inst_state_t){ 0 };
+#endif
 }
 
 #ifndef SOKOL_CLAY_NO_SOKOL_APP
@@ -322,6 +416,274 @@ static void _draw_corner_border(float x, float y, float rx, float ry, float ix,
     sgl_v2f(x+(rx*_SIN[0]), y+(ry*_SIN[15]));
 }
 
+/* Appends a rounded rectangle to the current triangle strip */
+static void _draw_rounded_rect(Clay_BoundingBox bbox, Clay_CornerRadius r){
+    if(r.topLeft > 0 || r.topRight > 0){
+        _draw_corner(bbox.x, bbox.y, -r.topLeft, -r.topLeft);
+        _draw_corner(bbox.x+bbox.width, bbox.y, r.topRight, -r.topRight);
+        _draw_rect(bbox.x+r.topLeft, bbox.y,
+                   bbox.width-r.topLeft-r.topRight, CLAY__MAX(r.topLeft, r.topRight));
+    }
+    if(r.bottomLeft > 0 || r.bottomRight > 0){
+        _draw_corner(bbox.x, bbox.y+bbox.height, -r.bottomLeft, r.bottomLeft);
+        _draw_corner(bbox.x+bbox.width, bbox.y+bbox.height, r.bottomRight, r.bottomRight);
+        _draw_rect(bbox.x+r.bottomLeft,
+                   bbox.y+bbox.height-CLAY__MAX(r.bottomLeft, r.bottomRight),
+                   bbox.width-r.bottomLeft-r.bottomRight, CLAY__MAX(r.bottomLeft, r.bottomRight));
+    }
+    if(r.topLeft < r.bottomLeft){
+        if(r.topLeft < r.topRight){
+            _draw_rect(bbox.x, bbox.y+r.topLeft, r.topLeft, bbox.height-r.topLeft-r.bottomLeft);
+            _draw_rect(bbox.x+r.topLeft, bbox.y+r.topRight,
+                       r.bottomLeft-r.topLeft, bbox.height-r.topRight-r.bottomLeft);
+        } else {
+            _draw_rect(bbox.x, bbox.y+r.topLeft, r.bottomLeft, bbox.height-r.topLeft-r.bottomLeft);
+        }
+    } else {
+        if(r.bottomLeft < r.bottomRight){
+            _draw_rect(bbox.x, bbox.y+r.topLeft, r.bottomLeft, bbox.height-r.topLeft-r.bottomLeft);
+            _draw_rect(bbox.x+r.bottomLeft, bbox.y+r.topLeft,
+                       r.topLeft-r.bottomLeft, bbox.height-r.topLeft-r.bottomRight);
+        } else {
+            _draw_rect(bbox.x, bbox.y+r.topLeft, r.topLeft, bbox.height-r.topLeft-r.bottomLeft);
+        }
+    }
+    if(r.topRight < r.bottomRight){
+        if(r.topRight < r.topLeft){
+            _draw_rect(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topLeft,
+                       r.bottomRight-r.topRight, bbox.height-r.topLeft-r.bottomRight);
+            _draw_rect(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
+                       r.topRight, bbox.height-r.topRight-r.bottomRight);
+        } else {
+            _draw_rect(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topRight,
+                       r.bottomRight, bbox.height-r.topRight-r.bottomRight);
+        }
+    } else {
+        if(r.bottomRight < r.bottomLeft){
+            _draw_rect(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
+                       r.topRight-r.bottomRight, bbox.height-r.topRight-r.bottomLeft);
+            _draw_rect(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topRight,
+                       r.bottomRight, bbox.height-r.topRight-r.bottomRight);
+        } else {
+            _draw_rect(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
+                       r.topRight, bbox.height-r.topRight-r.bottomRight);
+        }
+    }
+    _draw_rect(bbox.x+CLAY__MAX(r.topLeft, r.bottomLeft),
+               bbox.y+CLAY__MAX(r.topLeft, r.topRight),
+               bbox.width-CLAY__MAX(r.topLeft, r.bottomLeft)-CLAY__MAX(r.topRight, r.bottomRight),
+               bbox.height-CLAY__MAX(r.topLeft, r.topRight)-CLAY__MAX(r.bottomLeft, r.bottomRight));
+}
+
+/* Appends a border to the current triangle strip */
+static void _draw_border(Clay_BoundingBox bbox, float left, float right, float top, float bottom, Clay_CornerRadius r){
+    if(left > 0){
+        _draw_rect(bbox.x, bbox.y + r.topLeft,
+                   left, bbox.height - r.topLeft - r.bottomLeft);
+    }
+    if(right > 0){
+        _draw_rect(bbox.x + bbox.width - right, bbox.y + r.topRight,
+                   right, bbox.height - r.topRight - r.bottomRight);
+    }
+    if(top > 0){
+        _draw_rect(bbox.x + r.topLeft, bbox.y,
+                   bbox.width - r.topLeft - r.topRight, top);
+    }
+    if(bottom > 0){
+        _draw_rect(bbox.x + r.bottomLeft, bbox.y + bbox.height - bottom,
+                   bbox.width - r.bottomLeft - r.bottomRight, bottom);
+    }
+    if(r.topLeft > 0 && (top > 0 || left > 0)){
+        _draw_corner_border(bbox.x, bbox.y,
+                            -r.topLeft, -r.topLeft,
+                            -r.topLeft+left, -r.topLeft+top);
+    }
+    if(r.topRight > 0 && (top > 0 || right > 0)){
+        _draw_corner_border(bbox.x+bbox.width, bbox.y,
+                            r.topRight, -r.topRight,
+                            r.topRight-right, -r.topRight+top);
+    }
+    if(r.bottomLeft > 0 && (bottom > 0 || left > 0)){
+        _draw_corner_border(bbox.x, bbox.y+bbox.height,
+                            -r.bottomLeft, r.bottomLeft,
+                            -r.bottomLeft+left, r.bottomLeft-bottom);
+    }
+    if(r.bottomRight > 0 && (bottom > 0 || right > 0)){
+        _draw_corner_border(bbox.x+bbox.width, bbox.y+bbox.height,
+                            r.bottomRight, r.bottomRight,
+                            r.bottomRight-right, r.bottomRight-bottom);
+    }
+}
+
+static void _sclay_render_command(Clay_RenderCommand *renderCommand, sclay_font_t *fonts) {
+    Clay_BoundingBox bbox = renderCommand->boundingBox;
+    switch (renderCommand->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            Clay_RectangleRenderData *config = &renderCommand->renderData.rectangle;
+            sgl_c4f(config->backgroundColor.r / 255.0f,
+                    config->backgroundColor.g / 255.0f,
+                    config->backgroundColor.b / 255.0f,
+                    config->backgroundColor.a / 255.0f);
+            sgl_begin_triangle_strip();
+            _draw_rounded_rect(bbox, config->cornerRadius);
+            sgl_end();
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            if(!fonts) break;
+            Clay_TextRenderData *config = &renderCommand->renderData.text;
+            Clay_StringSlice text = config->stringContents;
+            fonsSetFont(_sclay.fonts, fonts[config->fontId]);
+            uint32_t color = sfons_rgba(
+                    config->textColor.r,
+                    config->textColor.g,
+                    config->textColor.b,
+                    config->textColor.a);
+            fonsSetColor(_sclay.fonts, color);
+            fonsSetSpacing(_sclay.fonts, config->letterSpacing * _sclay.dpi_scale);
+            fonsSetAlign(_sclay.fonts, FONS_ALIGN_LEFT | FONS_ALIGN_TOP);
+            fonsSetSize(_sclay.fonts, config->fontSize * _sclay.dpi_scale);
+            sgl_matrix_mode_modelview();
+            sgl_push_matrix();
+            sgl_scale(1.0f/_sclay.dpi_scale, 1.0f/_sclay.dpi_scale, 1.0f);
+            fonsDrawText(_sclay.fonts, bbox.x*_sclay.dpi_scale, bbox.y*_sclay.dpi_scale,
+                         text.chars, text.chars + text.length);
+            sgl_pop_matrix();
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
+            sgl_scissor_rectf(bbox.x*_sclay.dpi_scale, bbox.y*_sclay.dpi_scale,
+                              bbox.width*_sclay.dpi_scale, bbox.height*_sclay.dpi_scale,
+                              true);
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
+            sgl_scissor_rectf(0, 0,
+                              _sclay.size.width*_sclay.dpi_scale, _sclay.size.height*_sclay.dpi_scale,
+                              true);
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
+            Clay_ImageRenderData *config = &renderCommand->renderData.image;
+            sclay_image* img = (sclay_image*)config->imageData;
+            // by default, u1 and v1 are 1. if we pass 0.
+            // note, we are modifying a copy !
+            float u0 = img->uv.u0;
+            float v0 = img->uv.v0;
+            float u1 = img->uv.u1;
+            float v1 = img->uv.v1;
+            if (u1 == 0.f) {
+                u1 = 1.f;
+            }
+            if (v1 == 0.f) {
+                v1 = 1.f;
+            }
+
+            int untinted = config->backgroundColor.r == 0 && config->backgroundColor.g == 0 && config->backgroundColor.b == 0 && config->backgroundColor.a == 0;
+            float cr = untinted ? 1.f : (config->backgroundColor.r / 255.0f);
+            float gr = untinted ? 1.f : (config->backgroundColor.g / 255.0f);
+            float br = untinted ? 1.f : (config->backgroundColor.b / 255.0f);
+            float ar = untinted ? 1.f : (config->backgroundColor.a / 255.0f);
+
+            sgl_c4f(cr, gr, br, ar);
+
+            Clay_CornerRadius r = config->cornerRadius;
+
+            sgl_enable_texture();
+            sgl_texture(img->view, img->sampler);
+
+            sgl_begin_triangle_strip();
+            if(r.topLeft > 0 || r.topRight > 0){
+                _draw_corner_textured(bbox.x, bbox.y, -r.topLeft, -r.topLeft, bbox.x, bbox.y, bbox.width, bbox.height, u0, v0, u1, v1);
+                _draw_corner_textured(bbox.x+bbox.width, bbox.y, r.topRight, -r.topRight, bbox.x, bbox.y, bbox.width, bbox.height, u0, v0, u1, v1);
+                _draw_rect_textured(bbox.x+r.topLeft, bbox.y,
+                           bbox.width-r.topLeft-r.topRight, CLAY__MAX(r.topLeft, r.topRight),
+                           u0 + (r.topLeft/bbox.width)*(u1-u0), v0, u1 - (r.topRight/bbox.width)*(u1-u0), v0 + (CLAY__MAX(r.topLeft, r.topRight)/bbox.height)*(v1-v0));
+            }
+            if(r.bottomLeft > 0 || r.bottomRight > 0){
+                _draw_corner_textured(bbox.x, bbox.y+bbox.height, -r.bottomLeft, r.bottomLeft, bbox.x, bbox.y, bbox.width, bbox.height, u0, v0, u1, v1);
+                _draw_corner_textured(bbox.x+bbox.width, bbox.y+bbox.height, r.bottomRight, r.bottomRight, bbox.x, bbox.y, bbox.width, bbox.height, u0, v0, u1, v1);
+                _draw_rect_textured(bbox.x+r.bottomLeft,
+                           bbox.y+bbox.height-CLAY__MAX(r.bottomLeft, r.bottomRight),
+                           bbox.width-r.bottomLeft-r.bottomRight, CLAY__MAX(r.bottomLeft, r.bottomRight),
+                           u0 + (r.bottomLeft/bbox.width)*(u1-u0), v1 - (CLAY__MAX(r.bottomLeft, r.bottomRight)/bbox.height)*(v1-v0), u1 - (r.bottomRight/bbox.width)*(u1-u0), v1);
+            }
+            if(r.topLeft < r.bottomLeft){
+                if(r.topLeft < r.topRight){
+                    _draw_rect_textured(bbox.x, bbox.y+r.topLeft, r.topLeft, bbox.height-r.topLeft-r.bottomLeft,
+                            u0, v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.topLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
+                    _draw_rect_textured(bbox.x+r.topLeft, bbox.y+r.topRight,
+                           r.bottomLeft-r.topLeft, bbox.height-r.topRight-r.bottomLeft,
+                           u0 + (r.topLeft/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u0 + (r.topLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
+                } else {
+                    _draw_rect_textured(bbox.x, bbox.y+r.topLeft, r.bottomLeft, bbox.height-r.topLeft-r.bottomLeft,
+                            u0, v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.bottomLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
+                }
+            } else {
+                if(r.bottomLeft < r.bottomRight){
+                    _draw_rect_textured(bbox.x, bbox.y+r.topLeft, r.bottomLeft, bbox.height-r.topLeft-r.bottomLeft,
+                           u0, v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.bottomLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
+                    _draw_rect_textured(bbox.x+r.bottomLeft, bbox.y+r.topLeft,
+                               r.topLeft-r.bottomLeft, bbox.height-r.topLeft-r.bottomRight,
+                               u0 + (r.bottomLeft/bbox.width)*(u1-u0), v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.topLeft/bbox.width)*(u1-u0), v1 - (r.bottomRight/bbox.height)*(v1-v0));
+                } else {
+                    _draw_rect_textured(bbox.x, bbox.y+r.topLeft, r.topLeft, bbox.height-r.topLeft-r.bottomLeft,
+                            u0, v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.topLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
+                }
+            }
+            if(r.topRight < r.bottomRight){
+                if(r.topRight < r.topLeft){
+                    _draw_rect_textured(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topLeft,
+                               r.bottomRight-r.topRight, bbox.height-r.topLeft-r.bottomRight,
+                               u1 - (r.bottomRight/bbox.width)*(u1-u0), v0 + (r.topLeft/bbox.height)*(v1-v0), u1 - (r.topRight/bbox.width)*(u1-u0), v1 - (r.bottomRight/bbox.height)*(v1-v0));
+                    _draw_rect_textured(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
+                               r.topRight, bbox.height-r.topRight-r.bottomRight,
+                               u1 - (r.topRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1, v1 - (r.bottomRight/bbox.height)*(v1-v0));
+                } else {
+                    _draw_rect_textured(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topRight,
+                               r.bottomRight, bbox.height-r.topRight-r.bottomRight,
+                               u1 - (r.bottomRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1, v1 - (r.bottomRight/bbox.height)*(v1-v0));
+                }
+            } else {
+                if(r.bottomRight < r.bottomLeft){
+                    _draw_rect_textured(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
+                               r.topRight-r.bottomRight, bbox.height-r.topRight-r.bottomLeft,
+                               u1 - (r.topRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1 - (r.bottomRight/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
+                    _draw_rect_textured(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topRight,
+                               r.bottomRight, bbox.height-r.topRight-r.bottomRight,
+                               u1 - (r.bottomRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1, v1 - (r.bottomRight/bbox.height)*(v1-v0));
+                } else {
+                    _draw_rect_textured(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
+                               r.topRight, bbox.height-r.topRight-r.bottomRight,
+                               u1 - (r.topRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1, v1 - (r.bottomRight/bbox.height)*(v1-v0));
+                }
+            }
+            _draw_rect_textured(bbox.x+CLAY__MAX(r.topLeft, r.bottomLeft),
+                       bbox.y+CLAY__MAX(r.topLeft, r.topRight),
+                       bbox.width-CLAY__MAX(r.topLeft, r.bottomLeft)-CLAY__MAX(r.topRight, r.bottomRight),
+                       bbox.height-CLAY__MAX(r.topLeft, r.topRight)-CLAY__MAX(r.bottomLeft, r.bottomRight),
+                       u0+CLAY__MAX(r.topLeft,r.bottomLeft)/bbox.width*(u1-u0), v0+CLAY__MAX(r.topLeft,r.topRight)/bbox.height*(v1-v0),
+                       u1-CLAY__MAX(r.topRight,r.bottomRight)/bbox.width*(u1-u0), v1-CLAY__MAX(r.bottomLeft,r.bottomRight)/bbox.height*(v1-v0));
+            sgl_end();
+            sgl_disable_texture();
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            Clay_BorderRenderData *config = &renderCommand->renderData.border;
+            sgl_c4f(config->color.r / 255.0f,
+                    config->color.g / 255.0f,
+                    config->color.b / 255.0f,
+                    config->color.a / 255.0f);
+            sgl_begin_triangle_strip();
+            _draw_border(bbox, config->width.left, config->width.right, config->width.top, config->width.bottom, config->cornerRadius);
+            sgl_end();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
 void sclay_render(Clay_RenderCommandArray renderCommands, sclay_font_t *fonts) {
     sgl_matrix_mode_modelview();
     sgl_translate(-1.0f, 1.0f, 0.0f);
@@ -330,267 +692,520 @@ void sclay_render(Clay_RenderCommandArray renderCommands, sclay_font_t *fonts) {
     sgl_push_pipeline();
     sgl_load_pipeline(_sclay.pip);
     for (uint32_t i = 0; i < renderCommands.length; i++) {
-        Clay_RenderCommand *renderCommand = Clay_RenderCommandArray_Get(&renderCommands, i);
-        Clay_BoundingBox bbox = renderCommand->boundingBox;
-        switch (renderCommand->commandType) {
-            case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
-                Clay_RectangleRenderData *config = &renderCommand->renderData.rectangle;
-                sgl_c4f(config->backgroundColor.r / 255.0f,
-                        config->backgroundColor.g / 255.0f,
-                        config->backgroundColor.b / 255.0f,
-                        config->backgroundColor.a / 255.0f);
-                Clay_CornerRadius r = config->cornerRadius;
-                sgl_begin_triangle_strip();
-                if(r.topLeft > 0 || r.topRight > 0){
-                    _draw_corner(bbox.x, bbox.y, -r.topLeft, -r.topLeft);
-                    _draw_corner(bbox.x+bbox.width, bbox.y, r.topRight, -r.topRight);
-                    _draw_rect(bbox.x+r.topLeft, bbox.y,
-                               bbox.width-r.topLeft-r.topRight, CLAY__MAX(r.topLeft, r.topRight));
-                }
-                if(r.bottomLeft > 0 || r.bottomRight > 0){
-                    _draw_corner(bbox.x, bbox.y+bbox.height, -r.bottomLeft, r.bottomLeft);
-                    _draw_corner(bbox.x+bbox.width, bbox.y+bbox.height, r.bottomRight, r.bottomRight);
-                    _draw_rect(bbox.x+r.bottomLeft,
-                               bbox.y+bbox.height-CLAY__MAX(r.bottomLeft, r.bottomRight),
-                               bbox.width-r.bottomLeft-r.bottomRight, CLAY__MAX(r.bottomLeft, r.bottomRight));
-                }
-                if(r.topLeft < r.bottomLeft){
-                    if(r.topLeft < r.topRight){
-                        _draw_rect(bbox.x, bbox.y+r.topLeft, r.topLeft, bbox.height-r.topLeft-r.bottomLeft);
-                        _draw_rect(bbox.x+r.topLeft, bbox.y+r.topRight,
-                                   r.bottomLeft-r.topLeft, bbox.height-r.topRight-r.bottomLeft);
-                    } else {
-                        _draw_rect(bbox.x, bbox.y+r.topLeft, r.bottomLeft, bbox.height-r.topLeft-r.bottomLeft);
-                    }
-                } else {
-                    if(r.bottomLeft < r.bottomRight){
-                        _draw_rect(bbox.x, bbox.y+r.topLeft, r.bottomLeft, bbox.height-r.topLeft-r.bottomLeft);
-                        _draw_rect(bbox.x+r.bottomLeft, bbox.y+r.topLeft,
-                                   r.topLeft-r.bottomLeft, bbox.height-r.topLeft-r.bottomRight);
-                    } else {
-                        _draw_rect(bbox.x, bbox.y+r.topLeft, r.topLeft, bbox.height-r.topLeft-r.bottomLeft);
-                    }
-                }
-                if(r.topRight < r.bottomRight){
-                    if(r.topRight < r.topLeft){
-                        _draw_rect(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topLeft,
-                                   r.bottomRight-r.topRight, bbox.height-r.topLeft-r.bottomRight);
-                        _draw_rect(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
-                                   r.topRight, bbox.height-r.topRight-r.bottomRight);
-                    } else {
-                        _draw_rect(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topRight,
-                                   r.bottomRight, bbox.height-r.topRight-r.bottomRight);
-                    }
+        _sclay_render_command(Clay_RenderCommandArray_Get(&renderCommands, i), fonts);
+    }
+    sgl_pop_pipeline();
+    sfons_flush(_sclay.fonts);
+}
+
+#ifdef CLAY_RENDER_BATCH_INCLUDED
+void sclay_render_batched(Clay_RenderCommandArray renderCommands, sclay_font_t *fonts) {
+    sgl_matrix_mode_modelview();
+    sgl_translate(-1.0f, 1.0f, 0.0f);
+    sgl_scale(2.0f/_sclay.size.width, -2.0f/_sclay.size.height, 1.0f);
+    sgl_disable_texture();
+    sgl_push_pipeline();
+    sgl_load_pipeline(_sclay.pip);
+    Clay_RenderBatcher_Batch(&_sclay.batcher, renderCommands);
+    for (int32_t i = 0; i < _sclay.batcher.batchCount; i++) {
+        Clay_RenderBatch *batch = &_sclay.batcher.batches[i];
+        Clay_BoundingBox scissor = batch->scissorEnabled ? batch->scissorBox : (Clay_BoundingBox){ 0, 0, _sclay.size.width, _sclay.size.height };
+        sgl_scissor_rectf(scissor.x*_sclay.dpi_scale, scissor.y*_sclay.dpi_scale,
+                          scissor.width*_sclay.dpi_scale, scissor.height*_sclay.dpi_scale,
+                          true);
+        if (batch->type == CLAY_RENDER_BATCH_TYPE_QUADS) {
+            /* every rectangle and border of the batch goes into a single triangle strip */
+            sgl_begin_triangle_strip();
+            for (int32_t j = 0; j < batch->quadCount; j++) {
+                Clay_RenderBatchQuad *quad = &_sclay.batcher.quads[batch->quadsStart + j];
+                sgl_c4f(quad->color.r / 255.0f, quad->color.g / 255.0f, quad->color.b / 255.0f, quad->color.a / 255.0f);
+                if (quad->borderWidth[0] == 0 && quad->borderWidth[1] == 0 && quad->borderWidth[2] == 0 && quad->borderWidth[3] == 0) {
+                    _draw_rounded_rect(quad->boundingBox, quad->cornerRadius);
                 } else {
-                    if(r.bottomRight < r.bottomLeft){
-                        _draw_rect(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
-                                   r.topRight-r.bottomRight, bbox.height-r.topRight-r.bottomLeft);
-                        _draw_rect(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topRight,
-                                   r.bottomRight, bbox.height-r.topRight-r.bottomRight);
-                    } else {
-                        _draw_rect(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
-                                   r.topRight, bbox.height-r.topRight-r.bottomRight);
-                    }
+                    _draw_border(quad->boundingBox, quad->borderWidth[0], quad->borderWidth[1], quad->borderWidth[2], quad->borderWidth[3], quad->cornerRadius);
                 }
-                _draw_rect(bbox.x+CLAY__MAX(r.topLeft, r.bottomLeft),
-                           bbox.y+CLAY__MAX(r.topLeft, r.topRight),
-                           bbox.width-CLAY__MAX(r.topLeft, r.bottomLeft)-CLAY__MAX(r.topRight, r.bottomRight),
-                           bbox.height-CLAY__MAX(r.topLeft, r.topRight)-CLAY__MAX(r.bottomLeft, r.bottomRight));
-                sgl_end();
-                break;
             }
-            case CLAY_RENDER_COMMAND_TYPE_TEXT: {
-                if(!fonts) break;
-                Clay_TextRenderData *config = &renderCommand->renderData.text;
-                Clay_StringSlice text = config->stringContents;
-                fonsSetFont(_sclay.fonts, fonts[config->fontId]);
-                uint32_t color = sfons_rgba(
-                        config->textColor.r,
-                        config->textColor.g,
-                        config->textColor.b,
-                        config->textColor.a);
-                fonsSetColor(_sclay.fonts, color);
-                fonsSetSpacing(_sclay.fonts, config->letterSpacing * _sclay.dpi_scale);
-                fonsSetAlign(_sclay.fonts, FONS_ALIGN_LEFT | FONS_ALIGN_TOP);
-                fonsSetSize(_sclay.fonts, config->fontSize * _sclay.dpi_scale);
-                sgl_matrix_mode_modelview();
-                sgl_push_matrix();
-                sgl_scale(1.0f/_sclay.dpi_scale, 1.0f/_sclay.dpi_scale, 1.0f);
-                fonsDrawText(_sclay.fonts, bbox.x*_sclay.dpi_scale, bbox.y*_sclay.dpi_scale,
-                             text.chars, text.chars + text.length);
-                sgl_pop_matrix();
-                break;
+            sgl_end();
+        } else {
+            for (int32_t j = 0; j < batch->commandCount; j++) {
+                _sclay_render_command(&renderCommands.internalArray[_sclay.batcher.commandIndices[batch->commandsStart + j]], fonts);
             }
-            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
-                sgl_scissor_rectf(bbox.x*_sclay.dpi_scale, bbox.y*_sclay.dpi_scale,
-                                  bbox.width*_sclay.dpi_scale, bbox.height*_sclay.dpi_scale,
-                                  true);
-                break;
-            }
-            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
-                sgl_scissor_rectf(0, 0,
-                                  _sclay.size.width*_sclay.dpi_scale, _sclay.size.height*_sclay.dpi_scale,
-                                  true);
-                break;
-            }
-            case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
-                Clay_ImageRenderData *config = &renderCommand->renderData.image;
-                sclay_image* img = (sclay_image*)config->imageData;
-                // by default, u1 and v1 are 1. if we pass 0.
-                // note, we are modifying a copy !
-                float u0 = img->uv.u0;
-                float v0 = img->uv.v0;
-                float u1 = img->uv.u1;
-                float v1 = img->uv.v1;
-                if (u1 == 0.f) {
-                    u1 = 1.f;
-                }
-                if (v1 == 0.f) {
-                    v1 = 1.f;
-                }
+        }
+    }
+    sgl_scissor_rectf(0, 0,
+                      _sclay.size.width*_sclay.dpi_scale, _sclay.size.height*_sclay.dpi_scale,
+                      true);
+    sgl_pop_pipeline();
+    sfons_flush(_sclay.fonts);
+}
 
-                int untinted = config->backgroundColor.r == 0 && config->backgroundColor.g == 0 && config->backgroundColor.b == 0 && config->backgroundColor.a == 0;
-                float cr = untinted ? 1.f : (config->backgroundColor.r / 255.0f);
-                float gr = untinted ? 1.f : (config->backgroundColor.g / 255.0f);
-                float br = untinted ? 1.f : (config->backgroundColor.b / 255.0f);
-                float ar = untinted ? 1.f : (config->backgroundColor.a / 255.0f);
+/* The SDF shader, one instance per rectangle, border or image. The four corners of
+ * each instance are generated from the vertex index, and the fragment shader cuts
+ * out the rounded shape (minus the rounded inner shape for borders) with a one
+ * pixel wide anti-aliased edge. */
+#define _SCLAY_GLSL_VS \
+    "uniform vec4 params;\n" \
+    "layout(location=0) in vec4 bbox;\n" \
+    "layout(location=1) in vec4 color;\n" \
+    "layout(location=2) in vec4 radius;\n" \
+    "layout(location=3) in vec4 border;\n" \
+    "layout(location=4) in vec4 uv;\n" \
+    "out vec4 v_rect;\n" \
+    "out vec4 v_color;\n" \
+    "out vec4 v_radius;\n" \
+    "out vec4 v_border;\n" \
+    "out vec3 v_uv;\n" \
+    "void main() {\n" \
+    "    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n" \
+    "    vec2 pos = bbox.xy + corner * bbox.zw;\n" \
+    "    gl_Position = vec4(pos.x * 2.0 / params.x - 1.0, 1.0 - pos.y * 2.0 / params.y, 0.0, 1.0);\n" \
+    "    v_rect = vec4((corner - 0.5) * bbox.zw, 0.5 * bbox.zw);\n" \
+    "    v_color = color / 255.0;\n" \
+    "    v_radius = radius;\n" \
+    "    v_border = border;\n" \
+    "    v_uv = vec3(mix(uv.xy, uv.zw, corner), params.z);\n" \
+    "}\n"
 
-                sgl_c4f(cr, gr, br, ar);
+#define _SCLAY_GLSL_FS \
+    "uniform sampler2D tex_smp;\n" \
+    "in vec4 v_rect;\n" \
+    "in vec4 v_color;\n" \
+    "in vec4 v_radius;\n" \
+    "in vec4 v_border;\n" \
+    "in vec3 v_uv;\n" \
+    "out vec4 frag_color;\n" \
+    "float sd_rounded_box(vec2 p, vec2 h, vec4 r) {\n" \
+    "    float rr = p.x < 0.0 ? (p.y < 0.0 ? r.x : r.z) : (p.y < 0.0 ? r.y : r.w);\n" \
+    "    rr = min(rr, min(h.x, h.y));\n" \
+    "    vec2 q = abs(p) - h + rr;\n" \
+    "    return min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - rr;\n" \
+    "}\n" \
+    "void main() {\n" \
+    "    vec4 tex = texture(tex_smp, v_uv.xy);\n" \
+    "    float alpha = clamp(0.5 - sd_rounded_box(v_rect.xy, v_rect.zw, v_radius) * v_uv.z, 0.0, 1.0);\n" \
+    "    vec2 lo = v_border.xz - v_rect.zw;\n" \
+    "    vec2 hi = v_rect.zw - v_border.yw;\n" \
+    "    if (dot(v_border, vec4(1.0)) > 0.0 && hi.x > lo.x && hi.y > lo.y) {\n" \
+    "        vec4 ir = max(v_radius - max(v_border.xyxy, v_border.zzww), 0.0);\n" \
+    "        alpha *= 1.0 - clamp(0.5 - sd_rounded_box(v_rect.xy - 0.5 * (lo + hi), 0.5 * (hi - lo), ir) * v_uv.z, 0.0, 1.0);\n" \
+    "    }\n" \
+    "    frag_color = vec4(v_color.rgb * tex.rgb, v_color.a * tex.a * alpha);\n" \
+    "}\n"
 
-                Clay_CornerRadius r = config->cornerRadius;
+static const char *_sclay_vs_glsl410 = "#version 410\n" _SCLAY_GLSL_VS;
+static const char *_sclay_fs_glsl410 = "#version 410\n" _SCLAY_GLSL_FS;
+static const char *_sclay_vs_glsl300es = "#version 300 es\n" _SCLAY_GLSL_VS;
+static const char *_sclay_fs_glsl300es = "#version 300 es\nprecision highp float;\n" _SCLAY_GLSL_FS;
 
-                sgl_enable_texture();
-                sgl_texture(img->view, img->sampler);
+static const char *_sclay_vs_hlsl =
+    "cbuffer params_t : register(b0) {\n"
+    "    float4 params;\n"
+    "};\n"
+    "struct vs_in {\n"
+    "    float4 bbox : TEXCOORD0;\n"
+    "    float4 color : TEXCOORD1;\n"
+    "    float4 radius : TEXCOORD2;\n"
+    "    float4 border : TEXCOORD3;\n"
+    "    float4 uv : TEXCOORD4;\n"
+    "    uint vid : SV_VertexID;\n"
+    "};\n"
+    "struct vs_out {\n"
+    "    float4 rect : TEXCOORD0;\n"
+    "    float4 color : TEXCOORD1;\n"
+    "    float4 radius : TEXCOORD2;\n"
+    "    float4 border : TEXCOORD3;\n"
+    "    float3 uv : TEXCOORD4;\n"
+    "    float4 pos : SV_Position;\n"
+    "};\n"
+    "vs_out vs_main(vs_in i) {\n"
+    "    vs_out o;\n"
+    "    float2 corner = float2(float(i.vid & 1), float(i.vid >> 1));\n"
+    "    float2 pos = i.bbox.xy + corner * i.bbox.zw;\n"
+    "    o.pos = float4(pos.x * 2.0 / params.x - 1.0, 1.0 - pos.y * 2.0 / params.y, 0.0, 1.0);\n"
+    "    o.rect = float4((corner - 0.5) * i.bbox.zw, 0.5 * i.bbox.zw);\n"
+    "    o.color = i.color / 255.0;\n"
+    "    o.radius = i.radius;\n"
+    "    o.border = i.border;\n"
+    "    o.uv = float3(lerp(i.uv.xy, i.uv.zw, corner), params.z);\n"
+    "    return o;\n"
+    "}\n";
 
-                sgl_begin_triangle_strip();
-                if(r.topLeft > 0 || r.topRight > 0){
-                    _draw_corner_textured(bbox.x, bbox.y, -r.topLeft, -r.topLeft, bbox.x, bbox.y, bbox.width, bbox.height, u0, v0, u1, v1);
-                    _draw_corner_textured(bbox.x+bbox.width, bbox.y, r.topRight, -r.topRight, bbox.x, bbox.y, bbox.width, bbox.height, u0, v0, u1, v1);
-                    _draw_rect_textured(bbox.x+r.topLeft, bbox.y,
-                               bbox.width-r.topLeft-r.topRight, CLAY__MAX(r.topLeft, r.topRight),
-                               u0 + (r.topLeft/bbox.width)*(u1-u0), v0, u1 - (r.topRight/bbox.width)*(u1-u0), v0 + (CLAY__MAX(r.topLeft, r.topRight)/bbox.height)*(v1-v0));
-                }
-                if(r.bottomLeft > 0 || r.bottomRight > 0){
-                    _draw_corner_textured(bbox.x, bbox.y+bbox.height, -r.bottomLeft, r.bottomLeft, bbox.x, bbox.y, bbox.width, bbox.height, u0, v0, u1, v1);
-                    _draw_corner_textured(bbox.x+bbox.width, bbox.y+bbox.height, r.bottomRight, r.bottomRight, bbox.x, bbox.y, bbox.width, bbox.height, u0, v0, u1, v1);
-                    _draw_rect_textured(bbox.x+r.bottomLeft,
-                               bbox.y+bbox.height-CLAY__MAX(r.bottomLeft, r.bottomRight),
-                               bbox.width-r.bottomLeft-r.bottomRight, CLAY__MAX(r.bottomLeft, r.bottomRight),
-                               u0 + (r.bottomLeft/bbox.width)*(u1-u0), v1 - (CLAY__MAX(r.bottomLeft, r.bottomRight)/bbox.height)*(v1-v0), u1 - (r.bottomRight/bbox.width)*(u1-u0), v1);
-                }
-                if(r.topLeft < r.bottomLeft){
-                    if(r.topLeft < r.topRight){
-                        _draw_rect_textured(bbox.x, bbox.y+r.topLeft, r.topLeft, bbox.height-r.topLeft-r.bottomLeft,
-                                u0, v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.topLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
-                        _draw_rect_textured(bbox.x+r.topLeft, bbox.y+r.topRight,
-                               r.bottomLeft-r.topLeft, bbox.height-r.topRight-r.bottomLeft,
-                               u0 + (r.topLeft/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u0 + (r.topLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
-                    } else {
-                        _draw_rect_textured(bbox.x, bbox.y+r.topLeft, r.bottomLeft, bbox.height-r.topLeft-r.bottomLeft,
-                                u0, v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.bottomLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
-                    }
-                } else {
-                    if(r.bottomLeft < r.bottomRight){
-                        _draw_rect_textured(bbox.x, bbox.y+r.topLeft, r.bottomLeft, bbox.height-r.topLeft-r.bottomLeft,
-                               u0, v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.bottomLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
-                        _draw_rect_textured(bbox.x+r.bottomLeft, bbox.y+r.topLeft,
-                                   r.topLeft-r.bottomLeft, bbox.height-r.topLeft-r.bottomRight,
-                                   u0 + (r.bottomLeft/bbox.width)*(u1-u0), v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.topLeft/bbox.width)*(u1-u0), v1 - (r.bottomRight/bbox.height)*(v1-v0));
-                    } else {
-                        _draw_rect_textured(bbox.x, bbox.y+r.topLeft, r.topLeft, bbox.height-r.topLeft-r.bottomLeft,
-                                u0, v0 + (r.topLeft/bbox.height)*(v1-v0), u0 + (r.topLeft/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
-                    }
-                }
-                if(r.topRight < r.bottomRight){
-                    if(r.topRight < r.topLeft){
-                        _draw_rect_textured(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topLeft,
-                                   r.bottomRight-r.topRight, bbox.height-r.topLeft-r.bottomRight,
-                                   u1 - (r.bottomRight/bbox.width)*(u1-u0), v0 + (r.topLeft/bbox.height)*(v1-v0), u1 - (r.topRight/bbox.width)*(u1-u0), v1 - (r.bottomRight/bbox.height)*(v1-v0));
-                        _draw_rect_textured(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
-                                   r.topRight, bbox.height-r.topRight-r.bottomRight,
-                                   u1 - (r.topRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1, v1 - (r.bottomRight/bbox.height)*(v1-v0));
-                    } else {
-                        _draw_rect_textured(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topRight,
-                                   r.bottomRight, bbox.height-r.topRight-r.bottomRight,
-                                   u1 - (r.bottomRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1, v1 - (r.bottomRight/bbox.height)*(v1-v0));
-                    }
-                } else {
-                    if(r.bottomRight < r.bottomLeft){
-                        _draw_rect_textured(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
-                                   r.topRight-r.bottomRight, bbox.height-r.topRight-r.bottomLeft,
-                                   u1 - (r.topRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1 - (r.bottomRight/bbox.width)*(u1-u0), v1 - (r.bottomLeft/bbox.height)*(v1-v0));
-                        _draw_rect_textured(bbox.x+bbox.width-r.bottomRight, bbox.y+r.topRight,
-                                   r.bottomRight, bbox.height-r.topRight-r.bottomRight,
-                                   u1 - (r.bottomRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1, v1 - (r.bottomRight/bbox.height)*(v1-v0));
-                    } else {
-                        _draw_rect_textured(bbox.x+bbox.width-r.topRight, bbox.y+r.topRight,
-                                   r.topRight, bbox.height-r.topRight-r.bottomRight,
-                                   u1 - (r.topRight/bbox.width)*(u1-u0), v0 + (r.topRight/bbox.height)*(v1-v0), u1, v1 - (r.bottomRight/bbox.height)*(v1-v0));
-                    }
-                }
-                _draw_rect_textured(bbox.x+CLAY__MAX(r.topLeft, r.bottomLeft),
-                           bbox.y+CLAY__MAX(r.topLeft, r.topRight),
-                           bbox.width-CLAY__MAX(r.topLeft, r.bottomLeft)-CLAY__MAX(r.topRight, r.bottomRight),
-                           bbox.height-CLAY__MAX(r.topLeft, r.topRight)-CLAY__MAX(r.bottomLeft, r.bottomRight),
-                           u0+CLAY__MAX(r.topLeft,r.bottomLeft)/bbox.width*(u1-u0), v0+CLAY__MAX(r.topLeft,r.topRight)/bbox.height*(v1-v0),
-                           u1-CLAY__MAX(r.topRight,r.bottomRight)/bbox.width*(u1-u0), v1-CLAY__MAX(r.bottomLeft,r.bottomRight)/bbox.height*(v1-v0));
-                sgl_end();
-                sgl_disable_texture();
-                break;
+static const char *_sclay_fs_hlsl =
+    "Texture2D<float4> tex : register(t0);\n"
+    "SamplerState smp : register(s0);\n"
+    "struct ps_in {\n"
+    "    float4 rect : TEXCOORD0;\n"
+    "    float4 color : TEXCOORD1;\n"
+    "    float4 radius : TEXCOORD2;\n"
+    "    float4 border : TEXCOORD3;\n"
+    "    float3 uv : TEXCOORD4;\n"
+    "};\n"
+    "float sd_rounded_box(float2 p, float2 h, float4 r) {\n"
+    "    float rr = p.x < 0.0 ? (p.y < 0.0 ? r.x : r.z) : (p.y < 0.0 ? r.y : r.w);\n"
+    "    rr = min(rr, min(h.x, h.y));\n"
+    "    float2 q = abs(p) - h + rr;\n"
+    "    return min(max(q.x, q.y), 0.0) + length(max(q, float2(0.0, 0.0))) - rr;\n"
+    "}\n"
+    "float4 fs_main(ps_in i) : SV_Target0 {\n"
+    "    float4 t = tex.Sample(smp, i.uv.xy);\n"
+    "    float alpha = saturate(0.5 - sd_rounded_box(i.rect.xy, i.rect.zw, i.radius) * i.uv.z);\n"
+    "    float2 lo = i.border.xz - i.rect.zw;\n"
+    "    float2 hi = i.rect.zw - i.border.yw;\n"
+    "    if (dot(i.border, float4(1.0, 1.0, 1.0, 1.0)) > 0.0 && hi.x > lo.x && hi.y > lo.y) {\n"
+    "        float4 ir = max(i.radius - max(i.border.xyxy, i.border.zzww), float4(0.0, 0.0, 0.0, 0.0));\n"
+    "        alpha *= 1.0 - saturate(0.5 - sd_rounded_box(i.rect.xy - 0.5 * (lo + hi), 0.5 * (hi - lo), ir) * i.uv.z);\n"
+    "    }\n"
+    "    return float4(i.color.rgb * t.rgb, i.color.a * t.a * alpha);\n"
+    "}\n";
+
+static const char *_sclay_shader_msl =
+    "#include <metal_stdlib>\n"
+    "using namespace metal;\n"
+    "struct params_t {\n"
+    "    float4 params;\n"
+    "};\n"
+    "struct vs_in {\n"
+    "    float4 bbox [[attribute(0)]];\n"
+    "    float4 color [[attribute(1)]];\n"
+    "    float4 radius [[attribute(2)]];\n"
+    "    float4 border [[attribute(3)]];\n"
+    "    float4 uv [[attribute(4)]];\n"
+    "};\n"
+    "struct vs_out {\n"
+    "    float4 pos [[position]];\n"
+    "    float4 rect;\n"
+    "    float4 color;\n"
+    "    float4 radius;\n"
+    "    float4 border;\n"
+    "    float3 uv;\n"
+    "};\n"
+    "vertex vs_out vs_main(vs_in i [[stage_in]], constant params_t& u [[buffer(0)]], uint vid [[vertex_id]]) {\n"
+    "    vs_out o;\n"
+    "    float2 corner = float2(float(vid & 1), float(vid >> 1));\n"
+    "    float2 pos = i.bbox.xy + corner * i.bbox.zw;\n"
+    "    o.pos = float4(pos.x * 2.0 / u.params.x - 1.0, 1.0 - pos.y * 2.0 / u.params.y, 0.0, 1.0);\n"
+    "    o.rect = float4((corner - 0.5) * i.bbox.zw, 0.5 * i.bbox.zw);\n"
+    "    o.color = i.color / 255.0;\n"
+    "    o.radius = i.radius;\n"
+    "    o.border = i.border;\n"
+    "    o.uv = float3(mix(i.uv.xy, i.uv.zw, corner), u.params.z);\n"
+    "    return o;\n"
+    "}\n"
+    "float sd_rounded_box(float2 p, float2 h, float4 r) {\n"
+    "    float rr = p.x < 0.0 ? (p.y < 0.0 ? r.x : r.z) : (p.y < 0.0 ? r.y : r.w);\n"
+    "    rr = min(rr, min(h.x, h.y));\n"
+    "    float2 q = abs(p) - h + rr;\n"
+    "    return min(max(q.x, q.y), 0.0) + length(max(q, float2(0.0))) - rr;\n"
+    "}\n"
+    "fragment float4 fs_main(vs_out i [[stage_in]], texture2d<float> tex [[texture(0)]], sampler smp [[sampler(0)]]) {\n"
+    "    float4 t = tex.sample(smp, i.uv.xy);\n"
+    "    float alpha = saturate(0.5 - sd_rounded_box(i.rect.xy, i.rect.zw, i.radius) * i.uv.z);\n"
+    "    float2 lo = i.border.xz - i.rect.zw;\n"
+    "    float2 hi = i.rect.zw - i.border.yw;\n"
+    "    if (dot(i.border, float4(1.0)) > 0.0 && hi.x > lo.x && hi.y > lo.y) {\n"
+    "        float4 ir = max(i.radius - max(i.border.xyxy, i.border.zzww), float4(0.0));\n"
+    "        alpha *= 1.0 - saturate(0.5 - sd_rounded_box(i.rect.xy - 0.5 * (lo + hi), 0.5 * (hi - lo), ir) * i.uv.z);\n"
+    "    }\n"
+    "    return float4(i.color.rgb * t.rgb, i.color.a * t.a * alpha);\n"
+    "}\n";
+
+static const char *_sclay_shader_wgsl =
+    "struct params_t {\n"
+    "    params: vec4f,\n"
+    "}\n"
+    "@group(0) @binding(0) var<uniform> u: params_t;\n"
+    "@group(1) @binding(0) var tex: texture_2d<f32>;\n"
+    "@group(1) @binding(1) var smp: sampler;\n"
+    "struct vs_out {\n"
+    "    @builtin(position) pos: vec4f,\n"
+    "    @location(0) rect: vec4f,\n"
+    "    @location(1) color: vec4f,\n"
+    "    @location(2) radius: vec4f,\n"
+    "    @location(3) border: vec4f,\n"
+    "    @location(4) uv: vec3f,\n"
+    "}\n"
+    "@vertex fn vs_main(@builtin(vertex_index) vid: u32, @location(0) bbox: vec4f, @location(1) color: vec4f,\n"
+    "                   @location(2) radius: vec4f, @location(3) border: vec4f, @location(4) uv: vec4f) -> vs_out {\n"
+    "    var o: vs_out;\n"
+    "    let corner = vec2f(f32(vid & 1u), f32(vid >> 1u));\n"
+    "    let pos = bbox.xy + corner * bbox.zw;\n"
+    "    o.pos = vec4f(pos.x * 2.0 / u.params.x - 1.0, 1.0 - pos.y * 2.0 / u.params.y, 0.0, 1.0);\n"
+    "    o.rect = vec4f((corner - 0.5) * bbox.zw, 0.5 * bbox.zw);\n"
+    "    o.color = color / 255.0;\n"
+    "    o.radius = radius;\n"
+    "    o.border = border;\n"
+    "    o.uv = vec3f(mix(uv.xy, uv.zw, corner), u.params.z);\n"
+    "    return o;\n"
+    "}\n"
+    "fn sd_rounded_box(p: vec2f, h: vec2f, r: vec4f) -> f32 {\n"
+    "    var rr = select(select(r.w, r.y, p.y < 0.0), select(r.z, r.x, p.y < 0.0), p.x < 0.0);\n"
+    "    rr = min(rr, min(h.x, h.y));\n"
+    "    let q = abs(p) - h + rr;\n"
+    "    return min(max(q.x, q.y), 0.0) + length(max(q, vec2f(0.0))) - rr;\n"
+    "}\n"
+    "@fragment fn fs_main(i: vs_out) -> @location(0) vec4f {\n"
+    "    let t = textureSample(tex, smp, i.uv.xy);\n"
+    "    var alpha = clamp(0.5 - sd_rounded_box(i.rect.xy, i.rect.zw, i.radius) * i.uv.z, 0.0, 1.0);\n"
+    "    let lo = i.border.xz - i.rect.zw;\n"
+    "    let hi = i.rect.zw - i.border.yw;\n"
+    "    if (dot(i.border, vec4f(1.0)) > 0.0 && hi.x > lo.x && hi.y > lo.y) {\n"
+    "        let ir = max(i.radius - max(i.border.xyxy, i.border.zzww), vec4f(0.0));\n"
+    "        alpha *= 1.0 - clamp(0.5 - sd_rounded_box(i.rect.xy - 0.5 * (lo + hi), 0.5 * (hi - lo), ir) * i.uv.z, 0.0, 1.0);\n"
+    "    }\n"
+    "    return vec4f(i.color.rgb * t.rgb, i.color.a * t.a * alpha);\n"
+    "}\n";
+
+static void _sclay_setup_instanced() {
+    _sclay.inst.initialized = true;
+    sg_shader_desc shd_desc = {
+        .attrs = {
+            [0] = { .glsl_name = "bbox", .hlsl_sem_name = "TEXCOORD", .hlsl_sem_index = 0 },
+            [1] = { .glsl_name = "color", .hlsl_sem_name = "TEXCOORD", .hlsl_sem_index = 1 },
+            [2] = { .glsl_name = "radius", .hlsl_sem_name = "TEXCOORD", .hlsl_sem_index = 2 },
+            [3] = { .glsl_name = "border", .hlsl_sem_name = "TEXCOORD", .hlsl_sem_index = 3 },
+            [4] = { .glsl_name = "uv", .hlsl_sem_name = "TEXCOORD", .hlsl_sem_index = 4 },
+        },
+        .uniform_blocks[0] = {
+            .stage = SG_SHADERSTAGE_VERTEX,
+            .size = 4 * sizeof(float),
+            .glsl_uniforms[0] = { .type = SG_UNIFORMTYPE_FLOAT4, .glsl_name = "params" },
+        },
+        .views[0].texture = {
+            .stage = SG_SHADERSTAGE_FRAGMENT,
+            .image_type = SG_IMAGETYPE_2D,
+            .sample_type = SG_IMAGESAMPLETYPE_FLOAT,
+        },
+        .samplers[0] = {
+            .stage = SG_SHADERSTAGE_FRAGMENT,
+            .sampler_type = SG_SAMPLERTYPE_FILTERING,
+            .wgsl_group1_binding_n = 1,
+        },
+        .texture_sampler_pairs[0] = {
+            .stage = SG_SHADERSTAGE_FRAGMENT,
+            .view_slot = 0,
+            .sampler_slot = 0,
+            .glsl_name = "tex_smp",
+        },
+        .label = "sclay-instanced-shader",
+    };
+    switch (sg_query_backend()) {
+        case SG_BACKEND_GLCORE:
+            shd_desc.vertex_func.source = _sclay_vs_glsl410;
+            shd_desc.fragment_func.source = _sclay_fs_glsl410;
+            break;
+        case SG_BACKEND_GLES3:
+            shd_desc.vertex_func.source = _sclay_vs_glsl300es;
+            shd_desc.fragment_func.source = _sclay_fs_glsl300es;
+            break;
+        case SG_BACKEND_D3D11:
+            shd_desc.vertex_func = (sg_shader_function){ .source = _sclay_vs_hlsl, .entry = "vs_main" };
+            shd_desc.fragment_func = (sg_shader_function){ .source = _sclay_fs_hlsl, .entry = "fs_main" };
+            break;
+        case SG_BACKEND_METAL_IOS:
+        case SG_BACKEND_METAL_MACOS:
+        case SG_BACKEND_METAL_SIMULATOR:
+            shd_desc.vertex_func = (sg_shader_function){ .source = _sclay_shader_msl, .entry = "vs_main" };
+            shd_desc.fragment_func = (sg_shader_function){ .source = _sclay_shader_msl, .entry = "fs_main" };
+            break;
+        case SG_BACKEND_WGPU:
+            shd_desc.vertex_func = (sg_shader_function){ .source = _sclay_shader_wgsl, .entry = "vs_main" };
+            shd_desc.fragment_func = (sg_shader_function){ .source = _sclay_shader_wgsl, .entry = "fs_main" };
+            break;
+        default:
+            _sclay.inst.unsupported = true;
+            return;
+    }
+    _sclay.inst.shd = sg_make_shader(&shd_desc);
+    if (sg_query_shader_state(_sclay.inst.shd) != SG_RESOURCESTATE_VALID) {
+        _sclay.inst.unsupported = true;
+        return;
+    }
+    _sclay.inst.pip = sg_make_pipeline(&(sg_pipeline_desc){
+        .shader = _sclay.inst.shd,
+        .layout = {
+            .buffers[0] = { .stride = sizeof(_sclay_instance_t), .step_func = SG_VERTEXSTEP_PER_INSTANCE },
+            .attrs = {
+                [0] = { .offset = offsetof(_sclay_instance_t, bbox), .format = SG_VERTEXFORMAT_FLOAT4 },
+                [1] = { .offset = offsetof(_sclay_instance_t, color), .format = SG_VERTEXFORMAT_FLOAT4 },
+                [2] = { .offset = offsetof(_sclay_instance_t, radius), .format = SG_VERTEXFORMAT_FLOAT4 },
+                [3] = { .offset = offsetof(_sclay_instance_t, border), .format = SG_VERTEXFORMAT_FLOAT4 },
+                [4] = { .offset = offsetof(_sclay_instance_t, uv), .format = SG_VERTEXFORMAT_FLOAT4 },
+            },
+        },
+        .primitive_type = SG_PRIMITIVETYPE_TRIANGLE_STRIP,
+        .colors[0] = {
+            .blend = {
+                .enabled = true,
+                .src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA,
+                .dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+            },
+        },
+        .label = "sclay-instanced-pipeline",
+    });
+    /* rectangles and borders sample a white texture, so that all three can share a draw call */
+    static const uint32_t white = 0xFFFFFFFF;
+    _sclay.inst.white_img = sg_make_image(&(sg_image_desc){
+        .width = 1,
+        .height = 1,
+        .pixel_format = SG_PIXELFORMAT_RGBA8,
+        .data.mip_levels[0] = SG_RANGE(white),
+        .label = "sclay-white-image",
+    });
+    _sclay.inst.white_view = sg_make_view(&(sg_view_desc){ .texture.image = _sclay.inst.white_img });
+    _sclay.inst.smp = sg_make_sampler(&(sg_sampler_desc){
+        .min_filter = SG_FILTER_LINEAR,
+        .mag_filter = SG_FILTER_LINEAR,
+        .wrap_u = SG_WRAP_CLAMP_TO_EDGE,
+        .wrap_v = SG_WRAP_CLAMP_TO_EDGE,
+        .label = "sclay-sampler",
+    });
+}
+
+/* Appends an instance, extending the previous draw if it has the same texture and scissor rect */
+static _sclay_instance_t *_sclay_push_instance(sg_view view, sg_sampler smp, Clay_BoundingBox scissor) {
+    _sclay_draw_t *draw = _sclay.inst.draw_count > 0 ? &_sclay.inst.draws[_sclay.inst.draw_count - 1] : NULL;
+    if (!draw || draw->text_layer != 0 || draw->view.id != view.id || draw->smp.id != smp.id
+        || draw->scissor.x != scissor.x || draw->scissor.y != scissor.y
+        || draw->scissor.width != scissor.width || draw->scissor.height != scissor.height) {
+        if (_sclay.inst.draw_count == _sclay.inst.draw_capacity) {
+            _sclay.inst.draw_capacity = _sclay.inst.draw_capacity * 2 + 16;
+            _sclay.inst.draws = (_sclay_draw_t *)realloc(_sclay.inst.draws, _sclay.inst.draw_capacity * sizeof(_sclay_draw_t));
+        }
+        draw = &_sclay.inst.draws[_sclay.inst.draw_count++];
+        *draw = (_sclay_draw_t){ .first_instance = _sclay.inst.instance_count, .view = view, .smp = smp, .scissor = scissor };
+    }
+    if (_sclay.inst.instance_count == _sclay.inst.instance_capacity) {
+        _sclay.inst.instance_capacity = _sclay.inst.instance_capacity * 2 + 256;
+        _sclay.inst.instances = (_sclay_instance_t *)realloc(_sclay.inst.instances, _sclay.inst.instance_capacity * sizeof(_sclay_instance_t));
+    }
+    draw->instance_count++;
+    return &_sclay.inst.instances[_sclay.inst.instance_count++];
+}
+
+void sclay_render_instanced(Clay_RenderCommandArray renderCommands, sclay_font_t *fonts) {
+    if (!_sclay.inst.initialized) {
+        _sclay_setup_instanced();
+    }
+    if (_sclay.inst.unsupported) {
+        /* same result through sokol_gl, drawn straight away like the instanced path */
+        sgl_layer(SOKOL_CLAY_FIRST_TEXT_LAYER);
+        sgl_matrix_mode_modelview();
+        sgl_push_matrix();
+        sgl_load_identity();
+        sclay_render_batched(renderCommands, fonts);
+        sgl_matrix_mode_modelview();
+        sgl_pop_matrix();
+        sgl_layer(0);
+        sgl_draw_layer(SOKOL_CLAY_FIRST_TEXT_LAYER);
+        return;
+    }
+    _sclay.inst.instance_count = 0;
+    _sclay.inst.draw_count = 0;
+    int next_text_layer = SOKOL_CLAY_FIRST_TEXT_LAYER;
+    sgl_matrix_mode_modelview();
+    sgl_push_matrix();
+    sgl_load_identity();
+    sgl_translate(-1.0f, 1.0f, 0.0f);
+    sgl_scale(2.0f/_sclay.size.width, -2.0f/_sclay.size.height, 1.0f);
+    sgl_disable_texture();
+
+    /* Build the instances and record the text first, the glyph atlas can only be updated once */
+    Clay_RenderBatcher_Batch(&_sclay.batcher, renderCommands);
+    for (int32_t i = 0; i < _sclay.batcher.batchCount; i++) {
+        Clay_RenderBatch *batch = &_sclay.batcher.batches[i];
+        Clay_BoundingBox scissor = batch->scissorEnabled ? batch->scissorBox : (Clay_BoundingBox){ 0, 0, _sclay.size.width, _sclay.size.height };
+        if (batch->type == CLAY_RENDER_BATCH_TYPE_QUADS) {
+            for (int32_t j = 0; j < batch->quadCount; j++) {
+                Clay_RenderBatchQuad *quad = &_sclay.batcher.quads[batch->quadsStart + j];
+                *_sclay_push_instance(_sclay.inst.white_view, _sclay.inst.smp, scissor) = (_sclay_instance_t){
+                    .bbox = quad->boundingBox,
+                    .color = quad->color,
+                    .radius = quad->cornerRadius,
+                    .border = { quad->borderWidth[0], quad->borderWidth[1], quad->borderWidth[2], quad->borderWidth[3] },
+                };
             }
-            case CLAY_RENDER_COMMAND_TYPE_BORDER: {
-                Clay_BorderRenderData *config = &renderCommand->renderData.border;
-                sgl_c4f(config->color.r / 255.0f,
-                        config->color.g / 255.0f,
-                        config->color.b / 255.0f,
-                        config->color.a / 255.0f);
-                Clay_BorderWidth w = config->width;
-                Clay_CornerRadius r = config->cornerRadius;
-                sgl_begin_triangle_strip();
-                if(w.left > 0){
-                    _draw_rect(bbox.x, bbox.y + r.topLeft,
-                               w.left, bbox.height - r.topLeft - r.bottomLeft);
-                }
-                if(w.right > 0){
-                    _draw_rect(bbox.x + bbox.width - w.right, bbox.y + r.topRight,
-                               w.right, bbox.height - r.topRight - r.bottomRight);
-                }
-                if(w.top > 0){
-                    _draw_rect(bbox.x + r.topLeft, bbox.y,
-                               bbox.width - r.topLeft - r.topRight, w.top);
-                }
-                if(w.bottom > 0){
-                    _draw_rect(bbox.x + r.bottomLeft, bbox.y + bbox.height - w.bottom,
-                               bbox.width - r.bottomLeft - r.bottomRight, w.bottom);
-                }
-                if(r.topLeft > 0 && (w.top > 0 || w.left > 0)){
-                    _draw_corner_border(bbox.x, bbox.y,
-                                        -r.topLeft, -r.topLeft,
-                                        -r.topLeft+w.left, -r.topLeft+w.top);
-                }
-                if(r.topRight > 0 && (w.top > 0 || w.right > 0)){
-                    _draw_corner_border(bbox.x+bbox.width, bbox.y,
-                                        r.topRight, -r.topRight,
-                                        r.topRight-w.right, -r.topRight+w.top);
-                }
-                if(r.bottomLeft > 0 && (w.bottom > 0 || w.left > 0)){
-                    _draw_corner_border(bbox.x, bbox.y+bbox.height,
-                                        -r.bottomLeft, r.bottomLeft,
-                                        -r.bottomLeft+w.left, r.bottomLeft-w.bottom);
+        } else if (batch->type == CLAY_RENDER_BATCH_TYPE_IMAGES) {
+            for (int32_t j = 0; j < batch->commandCount; j++) {
+                Clay_RenderCommand *renderCommand = &renderCommands.internalArray[_sclay.batcher.commandIndices[batch->commandsStart + j]];
+                Clay_ImageRenderData *config = &renderCommand->renderData.image;
+                sclay_image *img = (sclay_image *)config->imageData;
+                Clay_Color tint = config->backgroundColor;
+                if (tint.r == 0 && tint.g == 0 && tint.b == 0 && tint.a == 0) {
+                    tint = (Clay_Color){ 255, 255, 255, 255 };
                 }
-                if(r.bottomRight > 0 && (w.bottom > 0 || w.right > 0)){
-                    _draw_corner_border(bbox.x+bbox.width, bbox.y+bbox.height,
-                                        r.bottomRight, r.bottomRight,
-                                        r.bottomRight-w.right, r.bottomRight-w.bottom);
+                sg_sampler smp = img->sampler.id != SG_INVALID_ID ? img->sampler : _sclay.inst.smp;
+                *_sclay_push_instance(img->view, smp, scissor) = (_sclay_instance_t){
+                    .bbox = renderCommand->boundingBox,
+                    .color = tint,
+                    .radius = config->cornerRadius,
+                    .uv = { img->uv.u0, img->uv.v0, img->uv.u1 == 0.f ? 1.f : img->uv.u1, img->uv.v1 == 0.f ? 1.f : img->uv.v1 },
+                };
+            }
+        } else if (batch->type == CLAY_RENDER_BATCH_TYPE_TEXT) {
+            /* consecutive text batches share a layer, the scissor rect is recorded along with them */
+            if (_sclay.inst.draw_count == 0 || _sclay.inst.draws[_sclay.inst.draw_count - 1].text_layer == 0) {
+                if (_sclay.inst.draw_count == _sclay.inst.draw_capacity) {
+                    _sclay.inst.draw_capacity = _sclay.inst.draw_capacity * 2 + 16;
+                    _sclay.inst.draws = (_sclay_draw_t *)realloc(_sclay.inst.draws, _sclay.inst.draw_capacity * sizeof(_sclay_draw_t));
                 }
-                sgl_end();
-                break;
+                _sclay.inst.draws[_sclay.inst.draw_count++] = (_sclay_draw_t){ .text_layer = next_text_layer };
+                sgl_layer(next_text_layer++);
+            }
+            sgl_scissor_rectf(scissor.x*_sclay.dpi_scale, scissor.y*_sclay.dpi_scale,
+                              scissor.width*_sclay.dpi_scale, scissor.height*_sclay.dpi_scale,
+                              true);
+            for (int32_t j = 0; j < batch->commandCount; j++) {
+                _sclay_render_command(&renderCommands.internalArray[_sclay.batcher.commandIndices[batch->commandsStart + j]], fonts);
             }
-            default:
-                break;
         }
     }
-    sgl_pop_pipeline();
+    sgl_layer(0);
+    sgl_matrix_mode_modelview();
+    sgl_pop_matrix();
     sfons_flush(_sclay.fonts);
+
+    int offset = 0;
+    if (_sclay.inst.instance_count > 0) {
+        size_t size = (size_t)_sclay.inst.instance_count * sizeof(_sclay_instance_t);
+        if (_sclay.inst.buf.id == SG_INVALID_ID || sg_query_buffer_will_overflow(_sclay.inst.buf, size)) {
+            sg_destroy_buffer(_sclay.inst.buf);
+            _sclay.inst.buf = sg_make_buffer(&(sg_buffer_desc){
+                .size = 2 * size,
+                .usage = { .vertex_buffer = true, .stream_update = true },
+                .label = "sclay-instances",
+            });
+        }
+        offset = sg_append_buffer(_sclay.inst.buf, &(sg_range){ _sclay.inst.instances, size });
+    }
+
+    float params[4] = { _sclay.size.width, _sclay.size.height, _sclay.dpi_scale, 0 };
+    bool pipeline_applied = false;
+    for (int i = 0; i < _sclay.inst.draw_count; i++) {
+        _sclay_draw_t *draw = &_sclay.inst.draws[i];
+        if (draw->text_layer != 0) {
+            sgl_draw_layer(draw->text_layer);
+            pipeline_applied = false;
+            continue;
+        }
+        if (!pipeline_applied) {
+            sg_apply_pipeline(_sclay.inst.pip);
+            sg_apply_uniforms(0, &SG_RANGE(params));
+            pipeline_applied = true;
+        }
+        sg_apply_scissor_rectf(draw->scissor.x*_sclay.dpi_scale, draw->scissor.y*_sclay.dpi_scale,
+                               draw->scissor.width*_sclay.dpi_scale, draw->scissor.height*_sclay.dpi_scale,
+                               true);
+        sg_apply_bindings(&(sg_bindings){
+            .vertex_buffers[0] = _sclay.inst.buf,
+            .vertex_buffer_offsets[0] = offset + draw->first_instance * (int)sizeof(_sclay_instance_t),
+            .views[0] = draw->view,
+            .samplers[0] = draw->smp,
+        });
+        sg_draw(0, 4, draw->instance_count);
+    }
+    sg_apply_scissor_rectf(0, 0,
+                           _sclay.size.width*_sclay.dpi_scale, _sclay.size.height*_sclay.dpi_scale,
+                           true);
 }
+#endif /* CLAY_RENDER_BATCH_INCLUDED */
 #endif /* SOKOL_CLAY_IMPL */
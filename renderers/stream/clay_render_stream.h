@@ -0,0 +1,1018 @@
+#ifndef CLAY_RENDER_STREAM_INCLUDED
+#define CLAY_RENDER_STREAM_INCLUDED (1)
+/*
+    clay_render_stream.h -- compact binary encoding of Clay render commands
+
+    Do this:
+        #define CLAY_RENDER_STREAM_IMPLEMENTATION
+
+    before you include this file in *one* C file to create the
+    implementation. clay.h must be included first.
+
+    Optionally define CLAY_RENDER_STREAM_REALLOC and CLAY_RENDER_STREAM_FREE
+    before the implementation to replace realloc() and free().
+
+    FEATURE OVERVIEW:
+    =================
+    A Clay_RenderCommand is large, as every command carries a float bounding
+    box and the whole Clay_RenderData union. This header writes a frame's
+    render commands as a compact byte stream for sending to a thin client over
+    a socket or across the wasm boundary, and reads it back into an ordinary
+    Clay_RenderCommandArray that any renderer can draw:
+
+        - ids, indices and pointers are written as variable length integers.
+        - bounding boxes are written as four 16 bit fixed point edges with
+          CLAY_RENDER_STREAM_SUBPIXEL_BITS of sub pixel precision (a quarter
+          pixel by default). Edges are clamped to the representable range,
+          which is -8192 to 8191 pixels by default, so boxes that extend past
+          it are cut off rather than moved.
+        - colors (rounded to 8 bits per channel), corner radii, border widths
+          and text styles are each written once per frame in a table, and
+          commands refer to them by index.
+        - each distinct string is written once per frame, and text commands
+          refer to it by index.
+        - unless a keyframe is requested, commands and strings that are
+          identical to the previous frame are written as a reference to it,
+          so a frame where little changed costs a few bytes per command.
+
+    The reader doesn't copy the strings of a frame, the text commands it
+    produces point directly into the stream that was read.
+
+    Pointers (userData, imageData and customData) are written as integers,
+    so when the stream is read in another process they should be handles,
+    e.g. an index into a texture table, rather than addresses.
+
+    HOWTO:
+    ======
+        // Sending side
+        static Clay_RenderStreamWriter writer; // Zero initialised
+        Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+        if (Clay_RenderStreamWriter_Write(&writer, renderCommands, clientJustConnected)) {
+            send(socket, writer.data, writer.length, 0);
+        }
+
+        // Receiving side
+        static Clay_RenderStreamReader reader; // Zero initialised
+        if (Clay_RenderStreamReader_Read(&reader, packet, packetLength)) {
+            RenderFrame(reader.renderCommands);
+        } else {
+            // Ask the sender for a keyframe
+        }
+
+        Clay_RenderStreamWriter_Free(&writer); // on shutdown
+        Clay_RenderStreamReader_Free(&reader);
+
+    A frame that isn't a keyframe can only be read directly after the frame
+    that was written before it, so frames have to be delivered in order, and
+    a client that misses one needs a keyframe. The bytes passed to
+    Clay_RenderStreamReader_Read must stay valid until the frame has been
+    drawn and the next frame has been read.
+ */
+
+// The number of fractional bits in the fixed point coordinates and corner radii of the stream
+#ifndef CLAY_RENDER_STREAM_SUBPIXEL_BITS
+#define CLAY_RENDER_STREAM_SUBPIXEL_BITS 2
+#endif
+
+// The most bytes of strings carried over from the previous frame that the reader accepts in one frame.
+// A delta frame can refer to the same earlier string any number of times, so without a limit a small stream could make the reader allocate without bound.
+#ifndef CLAY_RENDER_STREAM_MAX_CARRIED_BYTES
+#define CLAY_RENDER_STREAM_MAX_CARRIED_BYTES (16 * 1024 * 1024)
+#endif
+
+// An encoded color, corner radius, border width or text style
+typedef struct {
+    uint64_t low;
+    uint64_t high;
+} Clay_RenderStreamKey;
+
+// One of the per frame tables that commands refer to by index
+typedef struct {
+    Clay_RenderStreamKey *keys;
+    int32_t count;
+    int32_t capacity;
+    int32_t *slots;
+    int32_t slotCapacity;
+} Clay_RenderStreamTable;
+
+// A render command after quantization, which is compared against the previous frame to find unchanged commands
+typedef struct {
+    uint32_t id;
+    int16_t edges[4]; // Left, top, right, bottom in fixed point
+    int16_t zIndex;
+    uint8_t commandType;
+    uint8_t clipFlags; // Bit 0 horizontal, bit 1 vertical
+    uint64_t userData;
+    uint64_t pointer; // imageData or customData
+    // The color or text style, the corner radius and the border width
+    Clay_RenderStreamKey keys[3];
+    int32_t keyIndices[3];
+    int32_t stringIndex;
+} Clay_RenderStreamRecord;
+
+typedef struct {
+    int32_t offset;
+    int32_t length;
+    uint32_t hash;
+    int32_t previousIndex; // The identical string of the previous frame, or -1
+} Clay_RenderStreamString;
+
+typedef struct {
+    // The stream written by the most recent call to Clay_RenderStreamWriter_Write
+    uint8_t *data;
+    size_t length;
+    // Internal storage, grown as required
+    size_t capacity;
+    uint32_t frameIndex;
+    Clay_RenderStreamRecord *records;
+    Clay_RenderStreamRecord *previousRecords;
+    int32_t recordCapacity;
+    int32_t previousRecordCapacity;
+    int32_t previousRecordCount;
+    int32_t *repeatIndices; // The identical record of the previous frame for each record, or -1
+    bool *previousMatched;
+    int32_t repeatCapacity;
+    int32_t previousMatchedCapacity;
+    Clay_RenderStreamTable tables[4];
+    Clay_RenderStreamString *strings;
+    Clay_RenderStreamString *previousStrings;
+    int32_t stringCount;
+    int32_t previousStringCount;
+    int32_t stringCapacity;
+    int32_t previousStringCapacity;
+    char *stringBytes;
+    char *previousStringBytes;
+    int32_t stringBytesLength;
+    int32_t stringBytesCapacity;
+    int32_t previousStringBytesCapacity;
+    Clay_RenderStreamTable stringSlots; // Only the slots are used
+    Clay_RenderStreamTable previousStringSlots;
+    Clay_RenderStreamTable previousRecordSlots;
+    bool outOfMemory; // Set when an allocation fails part way through a frame
+} Clay_RenderStreamWriter;
+
+typedef struct {
+    // The render commands of the most recently read frame
+    Clay_RenderCommandArray renderCommands;
+    // Internal storage, grown as required
+    bool hasFrame;
+    uint32_t frameIndex;
+    Clay_RenderCommand *nextCommands;
+    int32_t nextCommandCapacity;
+    Clay_StringSlice *strings;
+    Clay_StringSlice *nextStrings;
+    int32_t stringCount;
+    int32_t stringCapacity;
+    int32_t nextStringCapacity;
+    // Copies of the strings carried over from earlier frames, whose streams may no longer be valid
+    char *carriedBytes;
+    char *nextCarriedBytes;
+    int32_t carriedBytesCapacity;
+    int32_t nextCarriedBytesCapacity;
+    Clay_Color *colors;
+    Clay_CornerRadius *radii;
+    Clay_BorderWidth *borderWidths;
+    Clay_TextRenderData *textStyles;
+    int32_t tableCapacities[4];
+} Clay_RenderStreamReader;
+
+// Encodes a frame's render commands into writer->data, replacing the stream of the previous call.
+// With keyframe set, or on the first call, the stream doesn't depend on any earlier frame.
+// Returns false if memory couldn't be allocated, in which case writer->length is 0 and the next frame is still written relative to the last one that succeeded.
+bool Clay_RenderStreamWriter_Write(Clay_RenderStreamWriter *writer, Clay_RenderCommandArray renderCommands, bool keyframe);
+// Frees the memory used by the writer, which can then be reused
+void Clay_RenderStreamWriter_Free(Clay_RenderStreamWriter *writer);
+// Decodes a stream written by Clay_RenderStreamWriter_Write into reader->renderCommands.
+// Returns false if the stream is malformed, depends on a frame other than the last one read, or memory couldn't be allocated,
+// in which case reader->renderCommands is left unchanged.
+bool Clay_RenderStreamReader_Read(Clay_RenderStreamReader *reader, const uint8_t *data, size_t length);
+// Frees the memory used by the reader, which can then be reused
+void Clay_RenderStreamReader_Free(Clay_RenderStreamReader *reader);
+
+#endif /* CLAY_RENDER_STREAM_INCLUDED */
+
+#ifdef CLAY_RENDER_STREAM_IMPLEMENTATION
+#undef CLAY_RENDER_STREAM_IMPLEMENTATION
+#ifndef CLAY_HEADER
+#error "Please include clay.h before clay_render_stream.h"
+#endif
+
+#include <string.h>
+
+#if !defined(CLAY_RENDER_STREAM_REALLOC) || !defined(CLAY_RENDER_STREAM_FREE)
+#include <stdlib.h>
+#define CLAY_RENDER_STREAM_REALLOC(pointer, size) realloc(pointer, size)
+#define CLAY_RENDER_STREAM_FREE(pointer) free(pointer)
+#endif
+
+#define CLAY__RENDER_STREAM_VERSION 1
+#define CLAY__RENDER_STREAM_FLAG_DELTA 0x01
+// Command header bits, the low 3 bits hold the command type
+#define CLAY__RENDER_STREAM_COMMAND_TYPE_MASK 0x07
+#define CLAY__RENDER_STREAM_COMMAND_REPEAT 0x08
+#define CLAY__RENDER_STREAM_COMMAND_Z_INDEX 0x10
+#define CLAY__RENDER_STREAM_COMMAND_USER_DATA 0x20
+
+enum {
+    CLAY__RENDER_STREAM_TABLE_COLOR,
+    CLAY__RENDER_STREAM_TABLE_RADIUS,
+    CLAY__RENDER_STREAM_TABLE_BORDER_WIDTH,
+    CLAY__RENDER_STREAM_TABLE_TEXT_STYLE,
+};
+
+static const uint8_t CLAY__RENDER_STREAM_MAGIC[3] = { 'C', 'L', 'S' };
+
+// Grows an allocation to hold at least count items. Doubling means it stops growing after a few frames.
+// Returns false, leaving the allocation as it was, if count doesn't fit in an int32_t or realloc fails.
+static bool Clay__RenderStreamReserve(void **pointer, int32_t *capacity, int64_t count, size_t itemSize) {
+    if (count <= *capacity) {
+        return true;
+    }
+    if (count > INT32_MAX) {
+        return false;
+    }
+    int32_t newCapacity = (int32_t)CLAY__MAX(count, CLAY__MIN((int64_t)*capacity * 2, (int64_t)INT32_MAX));
+    void *grown = CLAY_RENDER_STREAM_REALLOC(*pointer, (size_t)newCapacity * itemSize);
+    if (!grown) {
+        return false;
+    }
+    *pointer = grown;
+    *capacity = newCapacity;
+    return true;
+}
+
+#define CLAY__RENDER_STREAM_RESERVE(pointer, capacity, count) Clay__RenderStreamReserve((void **)&(pointer), &(capacity), (int64_t)(count), sizeof(*(pointer)))
+
+static inline uint32_t Clay__RenderStreamHash(const void *data, int32_t length, uint32_t hash) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (int32_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static inline int16_t Clay__RenderStreamFixed(float value) {
+    float scaled = value * (float)(1 << CLAY_RENDER_STREAM_SUBPIXEL_BITS);
+    scaled = CLAY__MIN(CLAY__MAX(scaled, -32768.f), 32767.f);
+    return (int16_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+}
+
+static inline float Clay__RenderStreamFloat(int32_t fixed) {
+    return (float)fixed / (float)(1 << CLAY_RENDER_STREAM_SUBPIXEL_BITS);
+}
+
+static inline uint64_t Clay__RenderStreamPackColor(Clay_Color color) {
+    float channels[4] = { color.r, color.g, color.b, color.a };
+    uint64_t packed = 0;
+    for (int32_t i = 0; i < 4; i++) {
+        float channel = CLAY__MIN(CLAY__MAX(channels[i], 0.f), 255.f);
+        packed |= (uint64_t)(uint8_t)(channel + 0.5f) << (i * 8);
+    }
+    return packed;
+}
+
+static inline Clay_Color Clay__RenderStreamUnpackColor(uint32_t packed) {
+    return (Clay_Color) { (float)(packed & 0xff), (float)((packed >> 8) & 0xff), (float)((packed >> 16) & 0xff), (float)(packed >> 24) };
+}
+
+static inline uint64_t Clay__RenderStreamPackRadius(Clay_CornerRadius radius) {
+    float corners[4] = { radius.topLeft, radius.topRight, radius.bottomLeft, radius.bottomRight };
+    uint64_t packed = 0;
+    for (int32_t i = 0; i < 4; i++) {
+        packed |= (uint64_t)(uint16_t)Clay__RenderStreamFixed(CLAY__MAX(corners[i], 0.f)) << (i * 16);
+    }
+    return packed;
+}
+
+// Resets an open addressed table of indices to hold up to itemCount items at a load factor of at most one half.
+// Returns false if the slots couldn't be allocated.
+static bool Clay__RenderStreamClearSlots(Clay_RenderStreamTable *table, int32_t itemCount) {
+    int32_t slotCount = 64;
+    while (slotCount < itemCount * 2) {
+        slotCount *= 2;
+    }
+    if (slotCount > table->slotCapacity) {
+        int32_t *slots = (int32_t *)CLAY_RENDER_STREAM_REALLOC(table->slots, (size_t)slotCount * sizeof(int32_t));
+        if (!slots) {
+            return false;
+        }
+        table->slots = slots;
+        table->slotCapacity = slotCount;
+    }
+    for (int32_t i = 0; i < table->slotCapacity; i++) {
+        table->slots[i] = -1;
+    }
+    return true;
+}
+
+// Writing ---------------------------------------
+
+static void Clay__RenderStreamPutByte(Clay_RenderStreamWriter *writer, uint8_t byte) {
+    if (writer->length == writer->capacity) {
+        size_t capacity = CLAY__MAX(writer->capacity * 2, 1024);
+        uint8_t *data = (uint8_t *)CLAY_RENDER_STREAM_REALLOC(writer->data, capacity);
+        if (!data) {
+            writer->outOfMemory = true;
+            return;
+        }
+        writer->data = data;
+        writer->capacity = capacity;
+    }
+    writer->data[writer->length++] = byte;
+}
+
+static void Clay__RenderStreamPutVarint(Clay_RenderStreamWriter *writer, uint64_t value) {
+    while (value >= 0x80) {
+        Clay__RenderStreamPutByte(writer, (uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    Clay__RenderStreamPutByte(writer, (uint8_t)value);
+}
+
+static void Clay__RenderStreamPut16(Clay_RenderStreamWriter *writer, uint16_t value) {
+    Clay__RenderStreamPutByte(writer, (uint8_t)value);
+    Clay__RenderStreamPutByte(writer, (uint8_t)(value >> 8));
+}
+
+// Returns the index of the key in the table, adding it if it isn't there yet
+static int32_t Clay__RenderStreamInternKey(Clay_RenderStreamWriter *writer, Clay_RenderStreamTable *table, Clay_RenderStreamKey key) {
+    uint32_t mask = (uint32_t)table->slotCapacity - 1;
+    uint32_t slot = Clay__RenderStreamHash(&key, (int32_t)sizeof(key), 2166136261u) & mask;
+    while (table->slots[slot] != -1) {
+        Clay_RenderStreamKey *candidate = &table->keys[table->slots[slot]];
+        if (candidate->low == key.low && candidate->high == key.high) {
+            return table->slots[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    if (!CLAY__RENDER_STREAM_RESERVE(table->keys, table->capacity, table->count + 1)) {
+        writer->outOfMemory = true;
+        return 0;
+    }
+    table->keys[table->count] = key;
+    table->slots[slot] = table->count;
+    return table->count++;
+}
+
+// Returns the index of the string in this frame's string table, adding it if it isn't there yet
+static int32_t Clay__RenderStreamInternString(Clay_RenderStreamWriter *writer, Clay_StringSlice string) {
+    uint32_t hash = Clay__RenderStreamHash(string.chars, string.length, 2166136261u);
+    uint32_t mask = (uint32_t)writer->stringSlots.slotCapacity - 1;
+    uint32_t slot = hash & mask;
+    while (writer->stringSlots.slots[slot] != -1) {
+        Clay_RenderStreamString *candidate = &writer->strings[writer->stringSlots.slots[slot]];
+        if (candidate->hash == hash && candidate->length == string.length && memcmp(writer->stringBytes + candidate->offset, string.chars, (size_t)string.length) == 0) {
+            return writer->stringSlots.slots[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    // The strings are copied, so that they can be compared against next frame after the originals are gone
+    if (!CLAY__RENDER_STREAM_RESERVE(writer->stringBytes, writer->stringBytesCapacity, (int64_t)writer->stringBytesLength + string.length)
+        || !CLAY__RENDER_STREAM_RESERVE(writer->strings, writer->stringCapacity, writer->stringCount + 1)) {
+        writer->outOfMemory = true;
+        return 0;
+    }
+    memcpy(writer->stringBytes + writer->stringBytesLength, string.chars, (size_t)string.length);
+    writer->strings[writer->stringCount] = (Clay_RenderStreamString) { .offset = writer->stringBytesLength, .length = string.length, .hash = hash, .previousIndex = -1 };
+    writer->stringBytesLength += string.length;
+    writer->stringSlots.slots[slot] = writer->stringCount;
+    return writer->stringCount++;
+}
+
+static bool Clay__RenderStreamStringsEqual(Clay_RenderStreamWriter *writer, int32_t stringIndex, int32_t previousStringIndex) {
+    Clay_RenderStreamString *string = &writer->strings[stringIndex];
+    Clay_RenderStreamString *previous = &writer->previousStrings[previousStringIndex];
+    return string->hash == previous->hash && string->length == previous->length
+        && memcmp(writer->stringBytes + string->offset, writer->previousStringBytes + previous->offset, (size_t)string->length) == 0;
+}
+
+static bool Clay__RenderStreamRecordsEqual(Clay_RenderStreamWriter *writer, Clay_RenderStreamRecord *record, Clay_RenderStreamRecord *previous) {
+    if (record->id != previous->id || record->commandType != previous->commandType || record->zIndex != previous->zIndex
+        || record->clipFlags != previous->clipFlags || record->userData != previous->userData || record->pointer != previous->pointer
+        || memcmp(record->edges, previous->edges, sizeof(record->edges)) != 0) {
+        return false;
+    }
+    for (int32_t i = 0; i < 3; i++) {
+        if (record->keys[i].low != previous->keys[i].low || record->keys[i].high != previous->keys[i].high) {
+            return false;
+        }
+    }
+    return record->commandType != CLAY_RENDER_COMMAND_TYPE_TEXT || Clay__RenderStreamStringsEqual(writer, record->stringIndex, previous->stringIndex);
+}
+
+static Clay_RenderStreamRecord Clay__RenderStreamMakeRecord(Clay_RenderStreamWriter *writer, Clay_RenderCommand *command) {
+    Clay_RenderStreamRecord record;
+    memset(&record, 0, sizeof(record));
+    Clay_BoundingBox box = command->boundingBox;
+    record.id = command->id;
+    record.edges[0] = Clay__RenderStreamFixed(box.x);
+    record.edges[1] = Clay__RenderStreamFixed(box.y);
+    record.edges[2] = Clay__RenderStreamFixed(box.x + box.width);
+    record.edges[3] = Clay__RenderStreamFixed(box.y + box.height);
+    record.zIndex = command->zIndex;
+    record.commandType = (uint8_t)command->commandType;
+    record.userData = (uint64_t)(uintptr_t)command->userData;
+    record.stringIndex = -1;
+    int32_t keyCount = 0;
+    int32_t keyTables[3] = { CLAY__RENDER_STREAM_TABLE_COLOR, CLAY__RENDER_STREAM_TABLE_RADIUS, CLAY__RENDER_STREAM_TABLE_BORDER_WIDTH };
+    Clay_RenderData *data = &command->renderData;
+    switch (command->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            record.keys[0].low = Clay__RenderStreamPackColor(data->rectangle.backgroundColor);
+            record.keys[1].low = Clay__RenderStreamPackRadius(data->rectangle.cornerRadius);
+            keyCount = 2;
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            Clay_BorderWidth width = data->border.width;
+            record.keys[0].low = Clay__RenderStreamPackColor(data->border.color);
+            record.keys[1].low = Clay__RenderStreamPackRadius(data->border.cornerRadius);
+            record.keys[2].low = (uint64_t)width.left | (uint64_t)width.right << 16 | (uint64_t)width.top << 32 | (uint64_t)width.bottom << 48;
+            record.keys[2].high = width.betweenChildren;
+            keyCount = 3;
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            Clay_TextRenderData *text = &data->text;
+            record.keys[0].low = Clay__RenderStreamPackColor(text->textColor) | (uint64_t)text->fontId << 32 | (uint64_t)text->fontSize << 48;
+            record.keys[0].high = (uint64_t)text->letterSpacing | (uint64_t)text->lineHeight << 16;
+            keyTables[0] = CLAY__RENDER_STREAM_TABLE_TEXT_STYLE;
+            keyCount = 1;
+            record.stringIndex = Clay__RenderStreamInternString(writer, text->stringContents);
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
+            record.keys[0].low = Clay__RenderStreamPackColor(data->image.backgroundColor);
+            record.keys[1].low = Clay__RenderStreamPackRadius(data->image.cornerRadius);
+            record.pointer = (uint64_t)(uintptr_t)data->image.imageData;
+            keyCount = 2;
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
+            record.keys[0].low = Clay__RenderStreamPackColor(data->custom.backgroundColor);
+            record.keys[1].low = Clay__RenderStreamPackRadius(data->custom.cornerRadius);
+            record.pointer = (uint64_t)(uintptr_t)data->custom.customData;
+            keyCount = 2;
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START:
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
+            record.clipFlags = (uint8_t)((data->clip.horizontal ? 1 : 0) | (data->clip.vertical ? 2 : 0));
+            break;
+        }
+        default: break;
+    }
+    for (int32_t i = 0; i < keyCount; i++) {
+        record.keyIndices[i] = Clay__RenderStreamInternKey(writer, &writer->tables[keyTables[i]], record.keys[i]);
+    }
+    return record;
+}
+
+// Finds an unmatched command of the previous frame that is identical to the record, or returns -1
+static int32_t Clay__RenderStreamFindRepeat(Clay_RenderStreamWriter *writer, Clay_RenderStreamRecord *record) {
+    uint32_t mask = (uint32_t)writer->previousRecordSlots.slotCapacity - 1;
+    for (uint32_t slot = record->id & mask; writer->previousRecordSlots.slots[slot] != -1; slot = (slot + 1) & mask) {
+        int32_t previousIndex = writer->previousRecordSlots.slots[slot];
+        if (!writer->previousMatched[previousIndex] && Clay__RenderStreamRecordsEqual(writer, record, &writer->previousRecords[previousIndex])) {
+            writer->previousMatched[previousIndex] = true;
+            return previousIndex;
+        }
+    }
+    return -1;
+}
+
+bool Clay_RenderStreamWriter_Write(Clay_RenderStreamWriter *writer, Clay_RenderCommandArray renderCommands, bool keyframe) {
+    int32_t commandCount = renderCommands.length;
+    bool delta = !keyframe && writer->frameIndex > 0;
+    // Nothing that the next frame is compared against changes until the end, so a failed frame can simply be dropped
+    writer->length = 0;
+    writer->outOfMemory = !CLAY__RENDER_STREAM_RESERVE(writer->records, writer->recordCapacity, commandCount)
+        || !CLAY__RENDER_STREAM_RESERVE(writer->repeatIndices, writer->repeatCapacity, commandCount)
+        || !Clay__RenderStreamClearSlots(&writer->stringSlots, commandCount);
+    for (int32_t i = 0; i < 4 && !writer->outOfMemory; i++) {
+        writer->tables[i].count = 0;
+        writer->outOfMemory = !Clay__RenderStreamClearSlots(&writer->tables[i], commandCount);
+    }
+    if (delta && !writer->outOfMemory) {
+        writer->outOfMemory = !CLAY__RENDER_STREAM_RESERVE(writer->previousMatched, writer->previousMatchedCapacity, writer->previousRecordCount)
+            || !Clay__RenderStreamClearSlots(&writer->previousRecordSlots, writer->previousRecordCount)
+            || !Clay__RenderStreamClearSlots(&writer->previousStringSlots, writer->previousStringCount);
+    }
+    if (writer->outOfMemory) {
+        return false;
+    }
+    writer->stringCount = 0;
+    writer->stringBytesLength = 0;
+
+    // Index the previous frame's commands by id, and its strings by contents
+    if (delta) {
+        uint32_t mask = (uint32_t)writer->previousRecordSlots.slotCapacity - 1;
+        for (int32_t i = 0; i < writer->previousRecordCount; i++) {
+            uint32_t slot = writer->previousRecords[i].id & mask;
+            while (writer->previousRecordSlots.slots[slot] != -1) {
+                slot = (slot + 1) & mask;
+            }
+            writer->previousRecordSlots.slots[slot] = i;
+            writer->previousMatched[i] = false;
+        }
+        mask = (uint32_t)writer->previousStringSlots.slotCapacity - 1;
+        for (int32_t i = 0; i < writer->previousStringCount; i++) {
+            uint32_t slot = writer->previousStrings[i].hash & mask;
+            while (writer->previousStringSlots.slots[slot] != -1) {
+                slot = (slot + 1) & mask;
+            }
+            writer->previousStringSlots.slots[slot] = i;
+        }
+    }
+
+    for (int32_t i = 0; i < commandCount; i++) {
+        writer->records[i] = Clay__RenderStreamMakeRecord(writer, &renderCommands.internalArray[i]);
+        if (writer->outOfMemory) {
+            return false;
+        }
+        writer->repeatIndices[i] = delta ? Clay__RenderStreamFindRepeat(writer, &writer->records[i]) : -1;
+    }
+    if (delta) {
+        uint32_t mask = (uint32_t)writer->previousStringSlots.slotCapacity - 1;
+        for (int32_t i = 0; i < writer->stringCount; i++) {
+            for (uint32_t slot = writer->strings[i].hash & mask; writer->previousStringSlots.slots[slot] != -1; slot = (slot + 1) & mask) {
+                if (Clay__RenderStreamStringsEqual(writer, i, writer->previousStringSlots.slots[slot])) {
+                    writer->strings[i].previousIndex = writer->previousStringSlots.slots[slot];
+                    break;
+                }
+            }
+        }
+    }
+
+    // Header
+    for (int32_t i = 0; i < 3; i++) {
+        Clay__RenderStreamPutByte(writer, CLAY__RENDER_STREAM_MAGIC[i]);
+    }
+    Clay__RenderStreamPutByte(writer, CLAY__RENDER_STREAM_VERSION);
+    Clay__RenderStreamPutByte(writer, delta ? CLAY__RENDER_STREAM_FLAG_DELTA : 0);
+    Clay__RenderStreamPutVarint(writer, writer->frameIndex + 1);
+
+    // Tables
+    for (int32_t table = 0; table < 4; table++) {
+        Clay__RenderStreamPutVarint(writer, (uint64_t)writer->tables[table].count);
+        for (int32_t i = 0; i < writer->tables[table].count; i++) {
+            Clay_RenderStreamKey key = writer->tables[table].keys[i];
+            switch (table) {
+                case CLAY__RENDER_STREAM_TABLE_COLOR: {
+                    for (int32_t j = 0; j < 4; j++) Clay__RenderStreamPutByte(writer, (uint8_t)(key.low >> (j * 8)));
+                    break;
+                }
+                case CLAY__RENDER_STREAM_TABLE_RADIUS: {
+                    for (int32_t j = 0; j < 4; j++) Clay__RenderStreamPut16(writer, (uint16_t)(key.low >> (j * 16)));
+                    break;
+                }
+                case CLAY__RENDER_STREAM_TABLE_BORDER_WIDTH: {
+                    for (int32_t j = 0; j < 4; j++) Clay__RenderStreamPutVarint(writer, (uint16_t)(key.low >> (j * 16)));
+                    Clay__RenderStreamPutVarint(writer, key.high);
+                    break;
+                }
+                case CLAY__RENDER_STREAM_TABLE_TEXT_STYLE: {
+                    for (int32_t j = 0; j < 4; j++) Clay__RenderStreamPutByte(writer, (uint8_t)(key.low >> (j * 8)));
+                    Clay__RenderStreamPutVarint(writer, (uint16_t)(key.low >> 32)); // fontId
+                    Clay__RenderStreamPutVarint(writer, (uint16_t)(key.low >> 48)); // fontSize
+                    Clay__RenderStreamPutVarint(writer, (uint16_t)key.high); // letterSpacing
+                    Clay__RenderStreamPutVarint(writer, (uint16_t)(key.high >> 16)); // lineHeight
+                    break;
+                }
+            }
+        }
+    }
+
+    // Strings, either as their contents or as the index of the identical string in the previous frame
+    Clay__RenderStreamPutVarint(writer, (uint64_t)writer->stringCount);
+    for (int32_t i = 0; i < writer->stringCount; i++) {
+        Clay_RenderStreamString *string = &writer->strings[i];
+        if (string->previousIndex != -1) {
+            Clay__RenderStreamPutVarint(writer, (uint64_t)string->previousIndex << 1 | 1);
+            continue;
+        }
+        Clay__RenderStreamPutVarint(writer, (uint64_t)string->length << 1);
+        for (int32_t j = 0; j < string->length; j++) {
+            Clay__RenderStreamPutByte(writer, (uint8_t)writer->stringBytes[string->offset + j]);
+        }
+    }
+
+    // Commands. The zIndex is only written when it differs from the command before.
+    Clay__RenderStreamPutVarint(writer, (uint64_t)commandCount);
+    int16_t zIndex = 0;
+    for (int32_t i = 0; i < commandCount; i++) {
+        Clay_RenderStreamRecord *record = &writer->records[i];
+        if (writer->repeatIndices[i] != -1) {
+            Clay__RenderStreamPutByte(writer, record->commandType | CLAY__RENDER_STREAM_COMMAND_REPEAT);
+            // Relative to this command's own index, which unchanged commands usually share with the previous frame
+            int32_t offset = writer->repeatIndices[i] - i;
+            Clay__RenderStreamPutVarint(writer, ((uint32_t)offset << 1) ^ (uint32_t)(offset >> 31));
+            // The text itself is still referenced through this frame's string table
+            if (record->commandType == CLAY_RENDER_COMMAND_TYPE_TEXT) {
+                Clay__RenderStreamPutVarint(writer, (uint64_t)record->stringIndex);
+            }
+            zIndex = record->zIndex;
+            continue;
+        }
+        uint8_t header = record->commandType;
+        header |= record->zIndex != zIndex ? CLAY__RENDER_STREAM_COMMAND_Z_INDEX : 0;
+        header |= record->userData ? CLAY__RENDER_STREAM_COMMAND_USER_DATA : 0;
+        Clay__RenderStreamPutByte(writer, header);
+        if (record->zIndex != zIndex) {
+            Clay__RenderStreamPutVarint(writer, ((uint32_t)record->zIndex << 1) ^ (uint32_t)(record->zIndex >> 15));
+            zIndex = record->zIndex;
+        }
+        Clay__RenderStreamPutVarint(writer, record->id);
+        for (int32_t j = 0; j < 4; j++) {
+            Clay__RenderStreamPut16(writer, (uint16_t)record->edges[j]);
+        }
+        if (record->userData) {
+            Clay__RenderStreamPutVarint(writer, record->userData);
+        }
+        switch (record->commandType) {
+            case CLAY_RENDER_COMMAND_TYPE_RECTANGLE:
+            case CLAY_RENDER_COMMAND_TYPE_IMAGE:
+            case CLAY_RENDER_COMMAND_TYPE_CUSTOM:
+            case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+                Clay__RenderStreamPutVarint(writer, (uint64_t)record->keyIndices[0]);
+                Clay__RenderStreamPutVarint(writer, (uint64_t)record->keyIndices[1]);
+                if (record->commandType == CLAY_RENDER_COMMAND_TYPE_BORDER) {
+                    Clay__RenderStreamPutVarint(writer, (uint64_t)record->keyIndices[2]);
+                } else if (record->commandType != CLAY_RENDER_COMMAND_TYPE_RECTANGLE) {
+                    Clay__RenderStreamPutVarint(writer, record->pointer);
+                }
+                break;
+            }
+            case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+                Clay__RenderStreamPutVarint(writer, (uint64_t)record->keyIndices[0]);
+                Clay__RenderStreamPutVarint(writer, (uint64_t)record->stringIndex);
+                break;
+            }
+            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START:
+            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
+                Clay__RenderStreamPutByte(writer, record->clipFlags);
+                break;
+            }
+            default: break;
+        }
+    }
+
+    if (writer->outOfMemory) {
+        writer->length = 0;
+        return false;
+    }
+
+    // This frame becomes the one that the next frame is compared against
+    writer->frameIndex++;
+    Clay_RenderStreamRecord *records = writer->records;
+    writer->records = writer->previousRecords;
+    writer->previousRecords = records;
+    int32_t recordCapacity = writer->recordCapacity;
+    writer->recordCapacity = writer->previousRecordCapacity;
+    writer->previousRecordCapacity = recordCapacity;
+    writer->previousRecordCount = commandCount;
+    Clay_RenderStreamString *strings = writer->strings;
+    writer->strings = writer->previousStrings;
+    writer->previousStrings = strings;
+    int32_t stringCapacity = writer->stringCapacity;
+    writer->stringCapacity = writer->previousStringCapacity;
+    writer->previousStringCapacity = stringCapacity;
+    writer->previousStringCount = writer->stringCount;
+    char *stringBytes = writer->stringBytes;
+    writer->stringBytes = writer->previousStringBytes;
+    writer->previousStringBytes = stringBytes;
+    int32_t stringBytesCapacity = writer->stringBytesCapacity;
+    writer->stringBytesCapacity = writer->previousStringBytesCapacity;
+    writer->previousStringBytesCapacity = stringBytesCapacity;
+    return true;
+}
+
+void Clay_RenderStreamWriter_Free(Clay_RenderStreamWriter *writer) {
+    CLAY_RENDER_STREAM_FREE(writer->data);
+    CLAY_RENDER_STREAM_FREE(writer->records);
+    CLAY_RENDER_STREAM_FREE(writer->previousRecords);
+    CLAY_RENDER_STREAM_FREE(writer->repeatIndices);
+    CLAY_RENDER_STREAM_FREE(writer->previousMatched);
+    for (int32_t i = 0; i < 4; i++) {
+        CLAY_RENDER_STREAM_FREE(writer->tables[i].keys);
+        CLAY_RENDER_STREAM_FREE(writer->tables[i].slots);
+    }
+    CLAY_RENDER_STREAM_FREE(writer->strings);
+    CLAY_RENDER_STREAM_FREE(writer->previousStrings);
+    CLAY_RENDER_STREAM_FREE(writer->stringBytes);
+    CLAY_RENDER_STREAM_FREE(writer->previousStringBytes);
+    CLAY_RENDER_STREAM_FREE(writer->stringSlots.slots);
+    CLAY_RENDER_STREAM_FREE(writer->previousStringSlots.slots);
+    CLAY_RENDER_STREAM_FREE(writer->previousRecordSlots.slots);
+    *writer = (Clay_RenderStreamWriter) { 0 };
+}
+
+// Reading ---------------------------------------
+
+// Every read is bounds checked, as the stream may have arrived over the network. Reading past the end only sets failed.
+typedef struct {
+    const uint8_t *next;
+    const uint8_t *end;
+    bool failed;
+} Clay__RenderStreamCursor;
+
+static inline uint8_t Clay__RenderStreamGetByte(Clay__RenderStreamCursor *cursor) {
+    if (cursor->next == cursor->end) {
+        cursor->failed = true;
+        return 0;
+    }
+    return *cursor->next++;
+}
+
+static uint64_t Clay__RenderStreamGetVarint(Clay__RenderStreamCursor *cursor) {
+    uint64_t value = 0;
+    for (int32_t shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = Clay__RenderStreamGetByte(cursor);
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    cursor->failed = true;
+    return 0;
+}
+
+static inline int16_t Clay__RenderStreamGet16(Clay__RenderStreamCursor *cursor) {
+    uint16_t low = Clay__RenderStreamGetByte(cursor);
+    return (int16_t)(low | (uint16_t)Clay__RenderStreamGetByte(cursor) << 8);
+}
+
+// Reads an index that must be less than count
+static inline int32_t Clay__RenderStreamGetIndex(Clay__RenderStreamCursor *cursor, int32_t count) {
+    uint64_t index = Clay__RenderStreamGetVarint(cursor);
+    if (index >= (uint64_t)count) {
+        cursor->failed = true;
+        return 0;
+    }
+    return (int32_t)index;
+}
+
+// Reads a count, which can't be larger than the number of bytes left as each item takes at least one byte
+static inline int32_t Clay__RenderStreamGetCount(Clay__RenderStreamCursor *cursor) {
+    uint64_t count = Clay__RenderStreamGetVarint(cursor);
+    if (count > (uint64_t)(cursor->end - cursor->next)) {
+        cursor->failed = true;
+        return 0;
+    }
+    return (int32_t)count;
+}
+
+static bool Clay__RenderStreamReadTables(Clay_RenderStreamReader *reader, Clay__RenderStreamCursor *cursor, int32_t *tableCounts) {
+    for (int32_t table = 0; table < 4 && !cursor->failed; table++) {
+        int32_t count = tableCounts[table] = Clay__RenderStreamGetCount(cursor);
+        // Tables and strings always have room for one item, so that an index that failed to read can still be looked up before the frame is discarded
+        int32_t reserveCount = CLAY__MAX(count, 1);
+        bool reserved = false;
+        switch (table) {
+            case CLAY__RENDER_STREAM_TABLE_COLOR: reserved = CLAY__RENDER_STREAM_RESERVE(reader->colors, reader->tableCapacities[table], reserveCount); break;
+            case CLAY__RENDER_STREAM_TABLE_RADIUS: reserved = CLAY__RENDER_STREAM_RESERVE(reader->radii, reader->tableCapacities[table], reserveCount); break;
+            case CLAY__RENDER_STREAM_TABLE_BORDER_WIDTH: reserved = CLAY__RENDER_STREAM_RESERVE(reader->borderWidths, reader->tableCapacities[table], reserveCount); break;
+            case CLAY__RENDER_STREAM_TABLE_TEXT_STYLE: reserved = CLAY__RENDER_STREAM_RESERVE(reader->textStyles, reader->tableCapacities[table], reserveCount); break;
+        }
+        if (!reserved) {
+            return false;
+        }
+        for (int32_t i = 0; i < count && !cursor->failed; i++) {
+            switch (table) {
+                case CLAY__RENDER_STREAM_TABLE_COLOR: {
+                    uint32_t packed = 0;
+                    for (int32_t j = 0; j < 4; j++) packed |= (uint32_t)Clay__RenderStreamGetByte(cursor) << (j * 8);
+                    reader->colors[i] = Clay__RenderStreamUnpackColor(packed);
+                    break;
+                }
+                case CLAY__RENDER_STREAM_TABLE_RADIUS: {
+                    float corners[4];
+                    for (int32_t j = 0; j < 4; j++) corners[j] = Clay__RenderStreamFloat((uint16_t)Clay__RenderStreamGet16(cursor));
+                    reader->radii[i] = (Clay_CornerRadius) { corners[0], corners[1], corners[2], corners[3] };
+                    break;
+                }
+                case CLAY__RENDER_STREAM_TABLE_BORDER_WIDTH: {
+                    uint16_t widths[5];
+                    for (int32_t j = 0; j < 5; j++) widths[j] = (uint16_t)Clay__RenderStreamGetVarint(cursor);
+                    reader->borderWidths[i] = (Clay_BorderWidth) { widths[0], widths[1], widths[2], widths[3], widths[4] };
+                    break;
+                }
+                case CLAY__RENDER_STREAM_TABLE_TEXT_STYLE: {
+                    uint32_t packed = 0;
+                    for (int32_t j = 0; j < 4; j++) packed |= (uint32_t)Clay__RenderStreamGetByte(cursor) << (j * 8);
+                    Clay_TextRenderData *style = &reader->textStyles[i];
+                    style->textColor = Clay__RenderStreamUnpackColor(packed);
+                    style->fontId = (uint16_t)Clay__RenderStreamGetVarint(cursor);
+                    style->fontSize = (uint16_t)Clay__RenderStreamGetVarint(cursor);
+                    style->letterSpacing = (uint16_t)Clay__RenderStreamGetVarint(cursor);
+                    style->lineHeight = (uint16_t)Clay__RenderStreamGetVarint(cursor);
+                    break;
+                }
+            }
+        }
+    }
+    return !cursor->failed;
+}
+
+// Strings carried over from the previous frame are copied, as the stream they were read from may not outlive this frame.
+// The table is read twice, first to find how much space the copies need so that they don't move while being filled in.
+static bool Clay__RenderStreamReadStrings(Clay_RenderStreamReader *reader, Clay__RenderStreamCursor *cursor, bool delta, int32_t *stringCount) {
+    *stringCount = Clay__RenderStreamGetCount(cursor);
+    Clay__RenderStreamCursor start = *cursor;
+    uint64_t carriedLength = 0;
+    for (int32_t i = 0; i < *stringCount && !cursor->failed; i++) {
+        uint64_t value = Clay__RenderStreamGetVarint(cursor);
+        if (value & 1) {
+            uint64_t previousIndex = value >> 1;
+            if (!delta || previousIndex >= (uint64_t)reader->stringCount) {
+                return false;
+            }
+            carriedLength += (uint64_t)reader->strings[previousIndex].length;
+            if (carriedLength > CLAY_RENDER_STREAM_MAX_CARRIED_BYTES) {
+                return false;
+            }
+        } else {
+            uint64_t length = value >> 1;
+            if (length > (uint64_t)(cursor->end - cursor->next) || length > INT32_MAX) {
+                return false;
+            }
+            cursor->next += length;
+        }
+    }
+    if (cursor->failed) {
+        return false;
+    }
+    if (!CLAY__RENDER_STREAM_RESERVE(reader->nextStrings, reader->nextStringCapacity, CLAY__MAX(*stringCount, 1))
+        || !CLAY__RENDER_STREAM_RESERVE(reader->nextCarriedBytes, reader->nextCarriedBytesCapacity, carriedLength)) {
+        return false;
+    }
+    *cursor = start;
+    int32_t carriedOffset = 0;
+    for (int32_t i = 0; i < *stringCount; i++) {
+        uint64_t value = Clay__RenderStreamGetVarint(cursor);
+        if (value & 1) {
+            Clay_StringSlice previous = reader->strings[value >> 1];
+            char *copy = reader->nextCarriedBytes + carriedOffset;
+            if (previous.length > 0) {
+                memcpy(copy, previous.chars, (size_t)previous.length);
+            }
+            carriedOffset += previous.length;
+            reader->nextStrings[i] = (Clay_StringSlice) { .length = previous.length, .chars = copy, .baseChars = copy };
+        } else {
+            int32_t length = (int32_t)(value >> 1);
+            const char *chars = (const char *)cursor->next;
+            cursor->next += length;
+            reader->nextStrings[i] = (Clay_StringSlice) { .length = length, .chars = chars, .baseChars = chars };
+        }
+    }
+    return true;
+}
+
+static void Clay__RenderStreamReadCommand(Clay_RenderStreamReader *reader, Clay__RenderStreamCursor *cursor, Clay_RenderCommand *command, uint8_t header, const int32_t *tableCounts, int32_t stringCount) {
+    command->commandType = (Clay_RenderCommandType)(header & CLAY__RENDER_STREAM_COMMAND_TYPE_MASK);
+    command->id = (uint32_t)Clay__RenderStreamGetVarint(cursor);
+    int32_t edges[4];
+    for (int32_t i = 0; i < 4; i++) {
+        edges[i] = Clay__RenderStreamGet16(cursor);
+    }
+    command->boundingBox = (Clay_BoundingBox) {
+        Clay__RenderStreamFloat(edges[0]),
+        Clay__RenderStreamFloat(edges[1]),
+        Clay__RenderStreamFloat(edges[2] - edges[0]),
+        Clay__RenderStreamFloat(edges[3] - edges[1])
+    };
+    command->userData = (header & CLAY__RENDER_STREAM_COMMAND_USER_DATA) ? (void *)(uintptr_t)Clay__RenderStreamGetVarint(cursor) : NULL;
+    Clay_RenderData *data = &command->renderData;
+    memset(data, 0, sizeof(*data));
+    switch (command->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE:
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE:
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM:
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            Clay_Color color = reader->colors[Clay__RenderStreamGetIndex(cursor, tableCounts[CLAY__RENDER_STREAM_TABLE_COLOR])];
+            Clay_CornerRadius cornerRadius = reader->radii[Clay__RenderStreamGetIndex(cursor, tableCounts[CLAY__RENDER_STREAM_TABLE_RADIUS])];
+            if (command->commandType == CLAY_RENDER_COMMAND_TYPE_RECTANGLE) {
+                data->rectangle = (Clay_RectangleRenderData) { .backgroundColor = color, .cornerRadius = cornerRadius };
+            } else if (command->commandType == CLAY_RENDER_COMMAND_TYPE_BORDER) {
+                Clay_BorderWidth width = reader->borderWidths[Clay__RenderStreamGetIndex(cursor, tableCounts[CLAY__RENDER_STREAM_TABLE_BORDER_WIDTH])];
+                data->border = (Clay_BorderRenderData) { .color = color, .cornerRadius = cornerRadius, .width = width };
+            } else {
+                void *pointer = (void *)(uintptr_t)Clay__RenderStreamGetVarint(cursor);
+                if (command->commandType == CLAY_RENDER_COMMAND_TYPE_IMAGE) {
+                    data->image = (Clay_ImageRenderData) { .backgroundColor = color, .cornerRadius = cornerRadius, .imageData = pointer };
+                } else {
+                    data->custom = (Clay_CustomRenderData) { .backgroundColor = color, .cornerRadius = cornerRadius, .customData = pointer };
+                }
+            }
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            data->text = reader->textStyles[Clay__RenderStreamGetIndex(cursor, tableCounts[CLAY__RENDER_STREAM_TABLE_TEXT_STYLE])];
+            data->text.stringContents = reader->nextStrings[Clay__RenderStreamGetIndex(cursor, stringCount)];
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START:
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
+            uint8_t clipFlags = Clay__RenderStreamGetByte(cursor);
+            data->clip = (Clay_ClipRenderData) { .horizontal = (clipFlags & 1) != 0, .vertical = (clipFlags & 2) != 0 };
+            break;
+        }
+        default: break;
+    }
+}
+
+bool Clay_RenderStreamReader_Read(Clay_RenderStreamReader *reader, const uint8_t *data, size_t length) {
+    Clay__RenderStreamCursor cursor = { data, data + length, false };
+    for (int32_t i = 0; i < 3; i++) {
+        if (Clay__RenderStreamGetByte(&cursor) != CLAY__RENDER_STREAM_MAGIC[i]) {
+            return false;
+        }
+    }
+    if (Clay__RenderStreamGetByte(&cursor) != CLAY__RENDER_STREAM_VERSION) {
+        return false;
+    }
+    bool delta = Clay__RenderStreamGetByte(&cursor) & CLAY__RENDER_STREAM_FLAG_DELTA;
+    uint32_t frameIndex = (uint32_t)Clay__RenderStreamGetVarint(&cursor);
+    if (cursor.failed || (delta && (!reader->hasFrame || frameIndex != reader->frameIndex + 1))) {
+        return false;
+    }
+    int32_t tableCounts[4];
+    int32_t stringCount;
+    if (!Clay__RenderStreamReadTables(reader, &cursor, tableCounts) || !Clay__RenderStreamReadStrings(reader, &cursor, delta, &stringCount)) {
+        return false;
+    }
+
+    // Commands are decoded into the spare buffer, so that the last frame is still intact if this one turns out to be malformed
+    int32_t commandCount = Clay__RenderStreamGetCount(&cursor);
+    if (!CLAY__RENDER_STREAM_RESERVE(reader->nextCommands, reader->nextCommandCapacity, commandCount)) {
+        return false;
+    }
+    int16_t zIndex = 0;
+    for (int32_t i = 0; i < commandCount && !cursor.failed; i++) {
+        uint8_t header = Clay__RenderStreamGetByte(&cursor);
+        Clay_RenderCommand *command = &reader->nextCommands[i];
+        if (header & CLAY__RENDER_STREAM_COMMAND_REPEAT) {
+            uint64_t zigzag = Clay__RenderStreamGetVarint(&cursor);
+            int64_t previousIndex = (int64_t)i + (int64_t)(zigzag >> 1) * ((zigzag & 1) ? -1 : 1) - (int64_t)(zigzag & 1);
+            if (cursor.failed || !delta || previousIndex < 0 || previousIndex >= reader->renderCommands.length) {
+                return false;
+            }
+            *command = reader->renderCommands.internalArray[previousIndex];
+            if (command->commandType != (header & CLAY__RENDER_STREAM_COMMAND_TYPE_MASK)) {
+                return false;
+            }
+            if (command->commandType == CLAY_RENDER_COMMAND_TYPE_TEXT) {
+                command->renderData.text.stringContents = reader->nextStrings[Clay__RenderStreamGetIndex(&cursor, stringCount)];
+            }
+        } else {
+            if (header & CLAY__RENDER_STREAM_COMMAND_Z_INDEX) {
+                uint32_t zigzag = (uint32_t)Clay__RenderStreamGetVarint(&cursor);
+                command->zIndex = (int16_t)((zigzag >> 1) ^ (0u - (zigzag & 1)));
+            } else {
+                command->zIndex = zIndex;
+            }
+            Clay__RenderStreamReadCommand(reader, &cursor, command, header, tableCounts, stringCount);
+        }
+        zIndex = command->zIndex;
+    }
+    if (cursor.failed) {
+        return false;
+    }
+
+    Clay_RenderCommand *commands = reader->renderCommands.internalArray;
+    int32_t commandCapacity = reader->renderCommands.capacity;
+    reader->renderCommands = (Clay_RenderCommandArray) { .capacity = reader->nextCommandCapacity, .length = commandCount, .internalArray = reader->nextCommands };
+    reader->nextCommands = commands;
+    reader->nextCommandCapacity = commandCapacity;
+    Clay_StringSlice *strings = reader->strings;
+    reader->strings = reader->nextStrings;
+    reader->nextStrings = strings;
+    int32_t stringCapacity = reader->stringCapacity;
+    reader->stringCapacity = reader->nextStringCapacity;
+    reader->nextStringCapacity = stringCapacity;
+    reader->stringCount = stringCount;
+    char *carriedBytes = reader->carriedBytes;
+    reader->carriedBytes = reader->nextCarriedBytes;
+    reader->nextCarriedBytes = carriedBytes;
+    int32_t carriedBytesCapacity = reader->carriedBytesCapacity;
+    reader->carriedBytesCapacity = reader->nextCarriedBytesCapacity;
+    reader->nextCarriedBytesCapacity = carriedBytesCapacity;
+    reader->frameIndex = frameIndex;
+    reader->hasFrame = true;
+    return true;
+}
+
+void Clay_RenderStreamReader_Free(Clay_RenderStreamReader *reader) {
+    CLAY_RENDER_STREAM_FREE(reader->renderCommands.internalArray);
+    CLAY_RENDER_STREAM_FREE(reader->nextCommands);
+    CLAY_RENDER_STREAM_FREE(reader->strings);
+    CLAY_RENDER_STREAM_FREE(reader->nextStrings);
+    CLAY_RENDER_STREAM_FREE(reader->carriedBytes);
+    CLAY_RENDER_STREAM_FREE(reader->nextCarriedBytes);
+    CLAY_RENDER_STREAM_FREE(reader->colors);
+    CLAY_RENDER_STREAM_FREE(reader->radii);
+    CLAY_RENDER_STREAM_FREE(reader->borderWidths);
+    CLAY_RENDER_STREAM_FREE(reader->textStyles);
+    *reader = (Clay_RenderStreamReader) { 0 };
+}
+#endif /* CLAY_RENDER_STREAM_IMPLEMENTATION */
@@ -82,6 +82,34 @@ enum image_mode {
     CLAY_TB_IMAGE_MODE_UNICODE_FAST,
 };
 
+// Number of differently sized conversions of each image that are kept between renders
+#ifndef CLAY_TB_IMAGE_CACHE_SIZES
+#define CLAY_TB_IMAGE_CACHE_SIZES 4
+#endif
+
+typedef struct {
+    // Image converted to cells at a given width and height
+    enum image_mode last_image_mode;
+    int width, height;
+    size_t size_max;
+    uint32_t *characters;
+    Clay_Color *foreground;
+    Clay_Color *background;
+    // Render count when this conversion was last used, for choosing which one to replace
+    unsigned long last_used;
+
+    // Data storing progress of partially complete image conversions that take multiple renders
+    struct clay_tb_partial_render {
+        bool in_progress;
+        unsigned char *resized_pixel_data;
+        int cursor_x, cursor_y;
+        int cursor_mask;
+        int min_difference_squared_sum;
+        int best_mask;
+        Clay_Color best_foreground, best_background;
+    } partial_render;
+} clay_tb_image_conversion;
+
 typedef struct {
     // Stores information about image loaded from stb
     int pixel_width, pixel_height;
@@ -89,26 +117,15 @@ typedef struct {
 
     // Internal cached data from previous renders
     struct {
-        enum image_mode last_image_mode;
-        int width, height;
-        size_t size_max;
-        uint32_t *characters;
-        Clay_Color *foreground;
-        Clay_Color *background;
-
-        // Data storing progress of partially complete image conversions that take multiple renders
-        struct clay_tb_partial_render {
-            bool in_progress;
-            unsigned char *resized_pixel_data;
-            int cursor_x, cursor_y;
-            int cursor_mask;
-            int min_difference_squared_sum;
-            int best_mask;
-            Clay_Color best_foreground, best_background;
-        } partial_render;
+        clay_tb_image_conversion conversions[CLAY_TB_IMAGE_CACHE_SIZES];
     } internal;
 } clay_tb_image;
 
+typedef struct {
+    uint32_t ch;
+    uintattr_t fg, bg;
+} clay_tb_cell;
+
 // Truecolor is only enabled if TB_OPT_ATTR_W is set to 32 or 64. The default is 16, so it must be
 // defined to reference the constant
 #ifndef TB_OUTPUT_TRUECOLOR
@@ -271,9 +288,9 @@ static inline Clay_Dimensions Clay_Termbox_MeasureText(
 
   Supports image formats from stb_image (JPG, PNG, TGA, BMP, PSD, GIF, HDR, PIC)
 
-  Note that rendered characters are cached in the returned `clay_tb_image`. If the same image is
-  used in multiple places, load it a separate time for each use to reduce unecessary reprocessing
-  every render.
+  Note that rendered characters are cached in the returned `clay_tb_image`, for up to
+  CLAY_TB_IMAGE_CACHE_SIZES different sizes in cells. If the same image is drawn at more sizes
+  than that at once, load it a separate time for each use to avoid reprocessing every render.
 
   \param filename File to load image from
  */
@@ -284,9 +301,9 @@ clay_tb_image Clay_Termbox_Image_Load_File(const char *filename);
 
   Supports image formats from stb_image (JPG, PNG, TGA, BMP, PSD, GIF, HDR, PIC)
 
-  Note that rendered characters are cached in the returned `clay_tb_image`. If the same image is
-  used in multiple places, load it a separate time for each use to reduce unecessary reprocessing
-  every render.
+  Note that rendered characters are cached in the returned `clay_tb_image`, for up to
+  CLAY_TB_IMAGE_CACHE_SIZES different sizes in cells. If the same image is drawn at more sizes
+  than that at once, load it a separate time for each use to avoid reprocessing every render.
 
   \param image Image to load. Should be the whole file copied into memory
   \param size  Size of the image in bytes
@@ -352,10 +369,19 @@ void Clay_Termbox_Close(void);
 /**
   Render a set of commands to the terminal
 
+  Only cells that changed since the previous render are written to termbox, so tb_clear() should
+  not be called between renders. Cells that are no longer covered by any command are cleared.
+
   \param commands Array of render commands from Clay's CreateLayout() function
  */
 void Clay_Termbox_Render(Clay_RenderCommandArray commands);
 
+/**
+  Write every cell on the next render, rather than only the cells that changed. Needed after
+  clearing or drawing to termbox's buffer outside of this renderer, e.g. with tb_clear()
+ */
+void Clay_Termbox_Invalidate(void);
+
 /**
   Convenience function to block until an event is received from termbox. If an image is only
   partially rendered, this returns immediately.
@@ -406,6 +432,16 @@ static Clay_Color *clay_tb_color_buffer_clay = NULL;
 static clay_tb_dimensions clay_tb_color_buffer_dimensions = { 0, 0 };
 static clay_tb_dimensions clay_tb_color_buffer_max_dimensions = { 0, 0 };
 
+// Cells drawn during the current render, and the cells written to termbox by the previous render.
+// Only differences between the two are written to termbox. Same dimensions as the color buffer
+static clay_tb_cell *clay_tb_cell_buffer = NULL;
+static clay_tb_cell *clay_tb_cell_buffer_previous = NULL;
+// When set, every cell is written on the next render
+static bool clay_tb_cell_buffer_invalid = true;
+
+// Number of renders, used to find the least recently used image conversion
+static unsigned long clay_tb_render_count = 0;
+
 
 // -------------------------------------------------------------------------------------------------
 // -- Internal utility functions
@@ -685,6 +721,14 @@ static void clay_tb_resize_buffer(void)
             clay_tb_assert(false, "Reallocation failure for internal clay color buffer");
         }
         clay_tb_color_buffer_clay = tmp_clay;
+        clay_tb_cell *tmp_cells = tb_realloc(clay_tb_cell_buffer, sizeof(clay_tb_cell) * new_size);
+        clay_tb_cell *tmp_cells_previous
+            = tb_realloc(clay_tb_cell_buffer_previous, sizeof(clay_tb_cell) * new_size);
+        if (NULL == tmp_cells || NULL == tmp_cells_previous) {
+            clay_tb_assert(false, "Reallocation failure for internal cell buffer");
+        }
+        clay_tb_cell_buffer = tmp_cells;
+        clay_tb_cell_buffer_previous = tmp_cells_previous;
         for (size_t i = max_size; i < new_size; ++i) {
             clay_tb_color_buffer_clay[i] = (Clay_Color) { 0 };
         }
@@ -692,6 +736,10 @@ static void clay_tb_resize_buffer(void)
         clay_tb_color_buffer_max_dimensions.width = current_width;
         clay_tb_color_buffer_max_dimensions.height = current_height;
     }
+    if (clay_tb_color_buffer_dimensions.width != current_width
+        || clay_tb_color_buffer_dimensions.height != current_height) {
+        clay_tb_cell_buffer_invalid = true;
+    }
     clay_tb_color_buffer_dimensions.width = current_width;
     clay_tb_color_buffer_dimensions.height = current_height;
 }
@@ -730,7 +778,7 @@ static inline clay_tb_color_pair clay_tb_get_transparency_color(
   Draw a character cell at a position on screen.
 
   Accounts for scissor mode and stores the cell to the internal color buffer for transparency and
-  text backgrounds.
+  text backgrounds. Cells are written to termbox at the end of the render if they changed.
 
   \param x     X position of cell
   \param y     Y position of cell
@@ -761,44 +809,92 @@ static int clay_tb_set_cell(
             codepoint_width = tb_wcwidth(ch);
         }
 
-        int err;
         int max_x = CLAY__MIN(x + codepoint_width, tb_width());
         for (int i = x; i < max_x; ++i) {
             clay_tb_color_buffer_clay_set(i, y, bg);
-            err = tb_set_cell(i, y, ch, tb_fg, tb_bg);
-            if (TB_OK != err) {
-                break;
-            }
+            clay_tb_cell_buffer[i + (y * clay_tb_color_buffer_dimensions.width)]
+                = (clay_tb_cell) { .ch = ch, .fg = tb_fg, .bg = tb_bg };
         }
 
-        return err;
+        return TB_OK;
     }
     return -1;
 }
 
+/**
+  Write cells from the current render that differ from the previous render to termbox, then keep
+  them for comparison with the next render
+ */
+static void clay_tb_flush_cell_buffer(void)
+{
+    int size = clay_tb_color_buffer_dimensions.width * clay_tb_color_buffer_dimensions.height;
+    for (int i = 0; i < size; ++i) {
+        clay_tb_cell cell = clay_tb_cell_buffer[i];
+        clay_tb_cell previous = clay_tb_cell_buffer_previous[i];
+        if (clay_tb_cell_buffer_invalid || cell.ch != previous.ch || cell.fg != previous.fg
+            || cell.bg != previous.bg) {
+            tb_set_cell(i % clay_tb_color_buffer_dimensions.width,
+                i / clay_tb_color_buffer_dimensions.width, cell.ch, cell.fg, cell.bg);
+        }
+    }
+    clay_tb_cell *tmp = clay_tb_cell_buffer_previous;
+    clay_tb_cell_buffer_previous = clay_tb_cell_buffer;
+    clay_tb_cell_buffer = tmp;
+    clay_tb_cell_buffer_invalid = false;
+}
+
+/**
+  Find the cached conversion of an image at the specified width and height, or choose the least
+  recently used conversion to replace
+
+  \param image  Image to search
+  \param width  Width in cells of the conversion
+  \param height Height in cells of the conversion
+ */
+static clay_tb_image_conversion *clay_tb_image_find_conversion(
+    clay_tb_image *image, int width, int height)
+{
+    clay_tb_image_conversion *least_recently_used = &image->internal.conversions[0];
+    for (int i = 0; i < CLAY_TB_IMAGE_CACHE_SIZES; ++i) {
+        clay_tb_image_conversion *conversion = &image->internal.conversions[i];
+        if (width == conversion->width && height == conversion->height
+            && clay_tb_image_mode == conversion->last_image_mode) {
+            return conversion;
+        }
+        if (conversion->last_used < least_recently_used->last_used) {
+            least_recently_used = conversion;
+        }
+    }
+    return least_recently_used;
+}
+
 /**
   Convert a pixel-based image to a cell-based image of the specified width and height. Stores the
   converted/resized result in the cache of the input image.
 
-  If the image has not changed size or image mode since the last convert it is returned unchanged
+  If the image has already been converted at this size and image mode, the cached conversion is
+  returned unchanged
 
   \param image  Image to convert/resize
   \param width  Target width in cells for the converted image
   \param height Target height in cells for the converted image
  */
-bool clay_tb_image_convert(clay_tb_image *image, int width, int height)
+clay_tb_image_conversion *clay_tb_image_convert(clay_tb_image *image, int width, int height)
 {
     clay_tb_assert(NULL != image->pixel_data, "Image must be loaded");
 
-    bool image_unchanged = (width == image->internal.width && height == image->internal.height
-        && (clay_tb_image_mode == image->internal.last_image_mode));
+    clay_tb_image_conversion *conversion = clay_tb_image_find_conversion(image, width, height);
+    conversion->last_used = clay_tb_render_count;
+
+    bool image_unchanged = (width == conversion->width && height == conversion->height
+        && (clay_tb_image_mode == conversion->last_image_mode));
 
-    if (image_unchanged && !image->internal.partial_render.in_progress) {
-        return true;
+    if (image_unchanged && !conversion->partial_render.in_progress) {
+        return conversion;
     }
     if (!image_unchanged) {
-        free(image->internal.partial_render.resized_pixel_data);
-        image->internal.partial_render = (struct clay_tb_partial_render) {
+        free(conversion->partial_render.resized_pixel_data);
+        conversion->partial_render = (struct clay_tb_partial_render) {
             .in_progress = false,
             .resized_pixel_data = NULL,
             .cursor_x = 0,
@@ -814,29 +910,29 @@ bool clay_tb_image_convert(clay_tb_image *image, int width, int height)
     const size_t size = (size_t)width * height;
 
     // Allocate/resize internal cache data
-    if (size > image->internal.size_max) {
-        uint32_t *tmp_characters = realloc(image->internal.characters, size * sizeof(uint32_t));
-        Clay_Color *tmp_foreground = realloc(image->internal.foreground, size * sizeof(Clay_Color));
-        Clay_Color *tmp_background = realloc(image->internal.background, size * sizeof(Clay_Color));
+    if (size > conversion->size_max) {
+        uint32_t *tmp_characters = realloc(conversion->characters, size * sizeof(uint32_t));
+        Clay_Color *tmp_foreground = realloc(conversion->foreground, size * sizeof(Clay_Color));
+        Clay_Color *tmp_background = realloc(conversion->background, size * sizeof(Clay_Color));
 
         if (NULL == tmp_characters || NULL == tmp_foreground || NULL == tmp_background) {
-            image->internal.size_max = 0;
+            conversion->size_max = 0;
             free(tmp_characters);
             free(tmp_foreground);
             free(tmp_background);
-            image->internal.characters = NULL;
-            image->internal.foreground = NULL;
-            image->internal.background = NULL;
-            return false;
+            conversion->characters = NULL;
+            conversion->foreground = NULL;
+            conversion->background = NULL;
+            return NULL;
         }
-        image->internal.characters = tmp_characters;
-        image->internal.foreground = tmp_foreground;
-        image->internal.background = tmp_background;
-        image->internal.size_max = size;
+        conversion->characters = tmp_characters;
+        conversion->foreground = tmp_foreground;
+        conversion->background = tmp_background;
+        conversion->size_max = size;
     }
 
-    image->internal.width = width;
-    image->internal.height = height;
+    conversion->width = width;
+    conversion->height = height;
 
     // Resize image using the same width/height in cells, but with the pixel sizes of the character
     // masks instead of the cell size. The pixel data for each character mask will be compared to
@@ -848,12 +944,12 @@ bool clay_tb_image_convert(clay_tb_image *image, int width, int height)
     const int pixel_height = height * character_mask_pixel_height;
 
     unsigned char *resized_pixel_data;
-    if (image->internal.partial_render.in_progress) {
-        resized_pixel_data = image->internal.partial_render.resized_pixel_data;
+    if (conversion->partial_render.in_progress) {
+        resized_pixel_data = conversion->partial_render.resized_pixel_data;
     } else {
         resized_pixel_data = stbir_resize_uint8_linear(image->pixel_data, image->pixel_width,
             image->pixel_height, 0, NULL, pixel_width, pixel_height, 0, STBIR_RGB);
-        image->internal.partial_render.resized_pixel_data = resized_pixel_data;
+        conversion->partial_render.resized_pixel_data = resized_pixel_data;
     }
 
     int num_character_masks = 1;
@@ -896,10 +992,10 @@ bool clay_tb_image_convert(clay_tb_image *image, int width, int height)
     bool partial_character_render = false;
 
     // Do a quick initial render to set the background
-    if (!image->internal.partial_render.in_progress) {
-        image->internal.last_image_mode = clay_tb_image_mode;
-        for (int y = image->internal.partial_render.cursor_y; y < height; ++y) {
-            for (int x = image->internal.partial_render.cursor_x; x < width; ++x) {
+    if (!conversion->partial_render.in_progress) {
+        conversion->last_image_mode = clay_tb_image_mode;
+        for (int y = conversion->partial_render.cursor_y; y < height; ++y) {
+            for (int x = conversion->partial_render.cursor_x; x < width; ++x) {
                 const int cell_top_left_pixel_x = x * character_mask_pixel_width;
                 const int cell_top_left_pixel_y = y * character_mask_pixel_height;
                 const int image_index = 3
@@ -912,9 +1008,9 @@ bool clay_tb_image_convert(clay_tb_image *image, int width, int height)
                 };
 
                 const int cell_index = y * width + x;
-                image->internal.characters[cell_index] = '.';
-                image->internal.foreground[cell_index] = pixel_color;
-                image->internal.background[cell_index] = pixel_color;
+                conversion->characters[cell_index] = '.';
+                conversion->foreground[cell_index] = pixel_color;
+                conversion->background[cell_index] = pixel_color;
 
                 fuel_remaining = CLAY__MAX(0, fuel_remaining - 1);
             }
@@ -922,25 +1018,25 @@ bool clay_tb_image_convert(clay_tb_image *image, int width, int height)
     }
 
     if (0 == fuel_remaining) {
-        image->internal.partial_render.in_progress = true;
+        conversion->partial_render.in_progress = true;
         clay_tb_partial_image_drawn = true;
         goto done;
     }
 
-    for (int y = image->internal.partial_render.cursor_y; y < height; ++y) {
-        for (int x = image->internal.partial_render.cursor_x; x < width; ++x) {
+    for (int y = conversion->partial_render.cursor_y; y < height; ++y) {
+        for (int x = conversion->partial_render.cursor_x; x < width; ++x) {
             const int cell_top_left_pixel_x = x * character_mask_pixel_width;
             const int cell_top_left_pixel_y = y * character_mask_pixel_height;
 
             // For each possible cell character, use the mask to find the average color for the
             // foreground ('1's) and background ('0's).
             int min_difference_squared_sum
-                = image->internal.partial_render.min_difference_squared_sum;
-            int best_mask = image->internal.partial_render.best_mask;
-            Clay_Color best_foreground = image->internal.partial_render.best_foreground;
-            Clay_Color best_background = image->internal.partial_render.best_background;
+                = conversion->partial_render.min_difference_squared_sum;
+            int best_mask = conversion->partial_render.best_mask;
+            Clay_Color best_foreground = conversion->partial_render.best_foreground;
+            Clay_Color best_background = conversion->partial_render.best_background;
 
-            for (int i = image->internal.partial_render.cursor_mask; i < num_character_masks; ++i) {
+            for (int i = conversion->partial_render.cursor_mask; i < num_character_masks; ++i) {
                 int color_avg_background_r = 0;
                 int color_avg_background_g = 0;
                 int color_avg_background_b = 0;
@@ -1043,7 +1139,7 @@ bool clay_tb_image_convert(clay_tb_image *image, int width, int height)
                 fuel_remaining -= 1;
                 if (0 == fuel_remaining) {
                     // Set progress for partial render
-                    image->internal.partial_render = (struct clay_tb_partial_render) {
+                    conversion->partial_render = (struct clay_tb_partial_render) {
                         .in_progress = true,
                         .resized_pixel_data = resized_pixel_data,
                         .cursor_x = x,
@@ -1059,15 +1155,15 @@ bool clay_tb_image_convert(clay_tb_image *image, int width, int height)
                     goto done;
                 }
             }
-            image->internal.partial_render.cursor_mask = 0;
+            conversion->partial_render.cursor_mask = 0;
 
             // Set data in cache for this character
             const int index = y * width + x;
-            image->internal.characters[index] = character_masks[best_mask].character;
-            image->internal.foreground[index] = best_foreground;
-            image->internal.background[index] = best_background;
+            conversion->characters[index] = character_masks[best_mask].character;
+            conversion->foreground[index] = best_foreground;
+            conversion->background[index] = best_background;
 
-            image->internal.partial_render = (struct clay_tb_partial_render) {
+            conversion->partial_render = (struct clay_tb_partial_render) {
                 .in_progress = true,
                 .resized_pixel_data = resized_pixel_data,
                 .cursor_x = x + 1,
@@ -1083,16 +1179,16 @@ bool clay_tb_image_convert(clay_tb_image *image, int width, int height)
                 goto done;
             }
         }
-        image->internal.partial_render.cursor_x = 0;
+        conversion->partial_render.cursor_x = 0;
     }
-    image->internal.partial_render.cursor_y = 0;
-    image->internal.partial_render.in_progress = false;
+    conversion->partial_render.cursor_y = 0;
+    conversion->partial_render.in_progress = false;
     free(resized_pixel_data);
-    image->internal.partial_render.resized_pixel_data = NULL;
+    conversion->partial_render.resized_pixel_data = NULL;
 
 done:
     clay_tb_image_fuel_used += fuel_amount_initial - fuel_remaining;
-    return true;
+    return conversion;
 }
 
 
@@ -1120,6 +1216,7 @@ void Clay_Termbox_Set_Color_Mode(int color_mode)
 
     // Force complete re-render to ensure all colors are redrawn
     tb_invalidate();
+    clay_tb_cell_buffer_invalid = true;
 
     clay_tb_color_mode = color_mode;
 
@@ -1276,10 +1373,13 @@ clay_tb_image Clay_Termbox_Image_Load_Memory(const void *image, int size)
 void Clay_Termbox_Image_Free(clay_tb_image *image)
 {
     free(image->pixel_data);
-    free(image->internal.partial_render.resized_pixel_data);
-    free(image->internal.characters);
-    free(image->internal.foreground);
-    free(image->internal.background);
+    for (int i = 0; i < CLAY_TB_IMAGE_CACHE_SIZES; ++i) {
+        clay_tb_image_conversion *conversion = &image->internal.conversions[i];
+        free(conversion->partial_render.resized_pixel_data);
+        free(conversion->characters);
+        free(conversion->foreground);
+        free(conversion->background);
+    }
     *image = (clay_tb_image) { 0 };
 }
 
@@ -1420,6 +1520,13 @@ void Clay_Termbox_Close(void)
         tb_sendf("\x1b[?%d;%dl", 1003, 1006);
 
         tb_free(clay_tb_color_buffer_clay);
+        tb_free(clay_tb_cell_buffer);
+        tb_free(clay_tb_cell_buffer_previous);
+        clay_tb_color_buffer_clay = NULL;
+        clay_tb_cell_buffer = NULL;
+        clay_tb_cell_buffer_previous = NULL;
+        clay_tb_color_buffer_dimensions = (clay_tb_dimensions) { 0, 0 };
+        clay_tb_color_buffer_max_dimensions = (clay_tb_dimensions) { 0, 0 };
         tb_shutdown();
         clay_tb_initialized = false;
     }
@@ -1432,6 +1539,13 @@ void Clay_Termbox_Render(Clay_RenderCommandArray commands)
     clay_tb_resize_buffer();
     clay_tb_partial_image_drawn = false;
     clay_tb_image_fuel_used = 0;
+    clay_tb_render_count++;
+
+    // Start from a cleared screen, equivalent to tb_clear()
+    int size = clay_tb_color_buffer_dimensions.width * clay_tb_color_buffer_dimensions.height;
+    for (int i = 0; i < size; ++i) {
+        clay_tb_cell_buffer[i] = (clay_tb_cell) { .ch = ' ', .fg = TB_DEFAULT, .bg = TB_DEFAULT };
+    }
 
     for (int32_t i = 0; i < commands.length; ++i) {
         const Clay_RenderCommand *command = Clay_RenderCommandArray_Get(&commands, i);
@@ -1681,13 +1795,14 @@ void Clay_Termbox_Render(Clay_RenderCommandArray commands)
                 bool use_placeholder = true;
 
                 clay_tb_image *image = (clay_tb_image *)render_data.imageData;
+                clay_tb_image_conversion *conversion = NULL;
 
                 if (!(CLAY_TB_IMAGE_MODE_PLACEHOLDER == clay_tb_image_mode
                         || CLAY_TB_OUTPUT_NOCOLOR == clay_tb_color_mode)) {
-                    bool convert_success = (NULL != image)
+                    conversion = (NULL != image)
                         ? clay_tb_image_convert(image, cell_box.width, cell_box.height)
-                        : false;
-                    if (convert_success) {
+                        : NULL;
+                    if (NULL != conversion) {
                         use_placeholder = false;
                     }
                 }
@@ -1706,15 +1821,15 @@ void Clay_Termbox_Render(Clay_RenderCommandArray commands)
                                     color_tb_bg = TB_DEFAULT;
                                 } else {
                                     color_bg
-                                        = image->internal
-                                              .background[y_offset * cell_box.width + x_offset];
+                                        = conversion
+                                              ->background[y_offset * cell_box.width + x_offset];
                                     color_tb_bg = clay_tb_color_convert(color_bg);
                                 }
                             }
                             color_tb_fg = clay_tb_color_convert(
-                                image->internal.foreground[y_offset * cell_box.width + x_offset]);
+                                conversion->foreground[y_offset * cell_box.width + x_offset]);
                             uint32_t ch
-                                = image->internal.characters[y_offset * cell_box.width + x_offset];
+                                = conversion->characters[y_offset * cell_box.width + x_offset];
                             if (CLAY_TB_IMAGE_MODE_BG == clay_tb_image_mode) {
                                 ch = ' ';
                             }
@@ -1774,6 +1889,13 @@ void Clay_Termbox_Render(Clay_RenderCommandArray commands)
             }
         }
     }
+
+    clay_tb_flush_cell_buffer();
+}
+
+void Clay_Termbox_Invalidate(void)
+{
+    clay_tb_cell_buffer_invalid = true;
 }
 
 void Clay_Termbox_Waitfor_Event(void)
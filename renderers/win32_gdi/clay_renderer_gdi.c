@@ -6,9 +6,11 @@
 
 #include "../../clay.h"
 
+// The off-screen DC used for double-buffering, kept between frames and only recreated when the window size changes
 HDC renderer_hdcMem = {0};
 HBITMAP renderer_hbmMem = {0};
 HANDLE renderer_hOld = {0};
+SIZE renderer_size = {0};
 DWORD g_dwGdiRenderFlags;
 
 #ifndef RECTWIDTH
@@ -179,50 +181,16 @@ typedef struct {
     HBITMAP hbmMem;
     HBITMAP hbmMemPrev;
     void* pBits;
-    SIZE size;
+    SIZE size;      // The part of the DIB section in use, starting from the top left
+    SIZE capacity;  // The size of the DIB section, which is also its row stride in pixels
 } HDCSubstitute;
 
-static void CreateHDCSubstitute(HDCSubstitute* phdcs, HDC hdcSrc, PRECT prc)
-{
-    if (prc == NULL)
-        return;
-
-    phdcs->size = (SIZE){ RECTWIDTH(*prc), RECTHEIGHT(*prc) };
-    if (phdcs->size.cx <= 0 || phdcs->size.cy <= 0)
-        return;
-
-    phdcs->hdcMem = CreateCompatibleDC(hdcSrc);
-    if (phdcs->hdcMem == NULL)
-        return;
-
-    // Create a 32-bit DIB section for the memory DC
-    BITMAPINFO bmi = { 0 };
-    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bmi.bmiHeader.biWidth = phdcs->size.cx;
-    bmi.bmiHeader.biHeight = -phdcs->size.cy;   // I think it's faster? Probably
-    bmi.bmiHeader.biPlanes = 1;
-    bmi.bmiHeader.biBitCount = 32;
-    bmi.bmiHeader.biCompression = BI_RGB;
-
-    phdcs->pBits = NULL;
-
-    phdcs->hbmMem = CreateDIBSection(phdcs->hdcMem, &bmi, DIB_RGB_COLORS, &phdcs->pBits, NULL, 0);
-    if (phdcs->hbmMem == NULL)
-    {
-        DeleteDC(phdcs->hdcMem);
-        return;
-    }
-
-    // Select the DIB section into the memory DC
-    phdcs->hbmMemPrev = SelectObject(phdcs->hdcMem, phdcs->hbmMem);
-
-    // Copy the content of the target DC to the memory DC
-    BitBlt(phdcs->hdcMem, 0, 0, phdcs->size.cx, phdcs->size.cy, hdcSrc, prc->left, prc->top, SRCCOPY);
-}
+// Shared by every command that needs per pixel blending, so that it's only recreated when a larger one is needed
+static HDCSubstitute renderer_substitute = { 0 };
 
 static void DestroyHDCSubstitute(HDCSubstitute* phdcs)
 {
-    if (phdcs == NULL)
+    if (phdcs == NULL || phdcs->hdcMem == NULL)
         return;
 
     // Clean up
@@ -233,17 +201,69 @@ static void DestroyHDCSubstitute(HDCSubstitute* phdcs)
     ZeroMemory(phdcs, sizeof(HDCSubstitute));
 }
 
+// Copies the content of prc in hdcSrc to the top left of the substitute, growing it first if it is too small
+static bool AcquireHDCSubstitute(HDCSubstitute* phdcs, HDC hdcSrc, PRECT prc)
+{
+    if (prc == NULL)
+        return false;
+
+    SIZE size = { RECTWIDTH(*prc), RECTHEIGHT(*prc) };
+    if (size.cx <= 0 || size.cy <= 0)
+        return false;
+
+    if (phdcs->hdcMem == NULL || size.cx > phdcs->capacity.cx || size.cy > phdcs->capacity.cy)
+    {
+        SIZE capacity = { max(size.cx, phdcs->capacity.cx), max(size.cy, phdcs->capacity.cy) };
+        DestroyHDCSubstitute(phdcs);
+
+        phdcs->hdcMem = CreateCompatibleDC(hdcSrc);
+        if (phdcs->hdcMem == NULL)
+            return false;
+
+        // Create a 32-bit DIB section for the memory DC
+        BITMAPINFO bmi = { 0 };
+        bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        bmi.bmiHeader.biWidth = capacity.cx;
+        bmi.bmiHeader.biHeight = -capacity.cy;   // I think it's faster? Probably
+        bmi.bmiHeader.biPlanes = 1;
+        bmi.bmiHeader.biBitCount = 32;
+        bmi.bmiHeader.biCompression = BI_RGB;
+
+        phdcs->pBits = NULL;
+
+        phdcs->hbmMem = CreateDIBSection(phdcs->hdcMem, &bmi, DIB_RGB_COLORS, &phdcs->pBits, NULL, 0);
+        if (phdcs->hbmMem == NULL)
+        {
+            DeleteDC(phdcs->hdcMem);
+            ZeroMemory(phdcs, sizeof(HDCSubstitute));
+            return false;
+        }
+
+        // Select the DIB section into the memory DC
+        phdcs->hbmMemPrev = SelectObject(phdcs->hdcMem, phdcs->hbmMem);
+        phdcs->capacity = capacity;
+    }
+
+    phdcs->size = size;
+
+    // Copy the content of the target DC to the memory DC, and wait for it before the pixels are touched
+    BitBlt(phdcs->hdcMem, 0, 0, size.cx, size.cy, hdcSrc, prc->left, prc->top, SRCCOPY);
+    GdiFlush();
+    return true;
+}
+
 static void __Clay_Win32_FillRoundRect(HDC hdc, PRECT prc, Clay_Color color, Clay_CornerRadius radius)
 {
-    HDCSubstitute substitute = { 0 };
-    CreateHDCSubstitute(&substitute, hdc, prc);
+    HDCSubstitute* substitute = &renderer_substitute;
+    if (!AcquireHDCSubstitute(substitute, hdc, prc))
+        return;
 
     bool has_corner_radius = radius.topLeft || radius.topRight || radius.bottomLeft || radius.bottomRight;
 
     if (has_corner_radius)
     {
         // Limit the corner radius to the minimum of half the width and half the height
-        float max_radius = (float)fmin(substitute.size.cx / 2.0f, substitute.size.cy / 2.0f);
+        float max_radius = (float)fmin(substitute->size.cx / 2.0f, substitute->size.cy / 2.0f);
         if (radius.topLeft > max_radius)        radius.topLeft = max_radius;
         if (radius.topRight > max_radius)       radius.topRight = max_radius;
         if (radius.bottomLeft > max_radius)     radius.bottomLeft = max_radius;
@@ -251,18 +271,18 @@ static void __Clay_Win32_FillRoundRect(HDC hdc, PRECT prc, Clay_Color color, Cla
     }
 
     // Iterate over each pixel in the DIB section
-    uint32_t* pixels = (uint32_t*)substitute.pBits;
-    for (int y = 0; y < substitute.size.cy; ++y)
+    uint32_t* pixels = (uint32_t*)substitute->pBits;
+    for (int y = 0; y < substitute->size.cy; ++y)
     {
-        for (int x = 0; x < substitute.size.cx; ++x)
+        for (int x = 0; x < substitute->size.cx; ++x)
         {
             float coverage = 1.0f;
             if (has_corner_radius)
-                coverage = RoundedRectPixelCoverage(x, y, radius, substitute.size.cx, substitute.size.cy);
+                coverage = RoundedRectPixelCoverage(x, y, radius, substitute->size.cx, substitute->size.cy);
 
             if (coverage > 0.0f)
             {
-                uint32_t pixel = pixels[y * substitute.size.cx + x];
+                uint32_t pixel = pixels[y * substitute->capacity.cx + x];
                 Clay_Color dst_color = {
                     .r = (float)((pixel >> 16) & 0xFF), // Red
                     .g = (float)((pixel >> 8) & 0xFF),  // Green
@@ -271,7 +291,7 @@ static void __Clay_Win32_FillRoundRect(HDC hdc, PRECT prc, Clay_Color color, Cla
                 };
                 Clay_Color blended = ColorBlend(dst_color, color, coverage);
 
-                pixels[y * substitute.size.cx + x] =
+                pixels[y * substitute->capacity.cx + x] =
                     ((uint32_t)(blended.b) << 0) |
                     ((uint32_t)(blended.g) << 8) |
                     ((uint32_t)(blended.r) << 16);
@@ -280,8 +300,74 @@ static void __Clay_Win32_FillRoundRect(HDC hdc, PRECT prc, Clay_Color color, Cla
     }
 
     // Copy the blended content back to the target DC
-    BitBlt(hdc, prc->left, prc->top, substitute.size.cx, substitute.size.cy, substitute.hdcMem, 0, 0, SRCCOPY);
-    DestroyHDCSubstitute(&substitute);
+    BitBlt(hdc, prc->left, prc->top, substitute->size.cx, substitute->size.cy, substitute->hdcMem, 0, 0, SRCCOPY);
+}
+
+static void Clay_Win32_ReleaseBackBuffer(void)
+{
+    if (renderer_hdcMem == NULL)
+        return;
+
+    SelectObject(renderer_hdcMem, renderer_hOld);
+    DeleteObject(renderer_hbmMem);
+    DeleteDC(renderer_hdcMem);
+
+    renderer_hdcMem = NULL;
+    renderer_hbmMem = NULL;
+    renderer_hOld = NULL;
+    renderer_size = (SIZE){ 0 };
+}
+
+// Frees the off-screen buffers that the renderer keeps between frames
+void Clay_Win32_Shutdown(void)
+{
+    Clay_Win32_ReleaseBackBuffer();
+    DestroyHDCSubstitute(&renderer_substitute);
+}
+
+// Invalidates only the dirty rectangles of a Clay_EndLayoutDiff() result, instead of the whole window.
+// The next Clay_Win32_Render then redraws and copies to the window just those parts.
+void Clay_Win32_InvalidateDiff(HWND hwnd, Clay_RenderCommandDiff diff)
+{
+    for (int i = 0; i < diff.dirtyRects.length; i++)
+    {
+        Clay_BoundingBox b = diff.dirtyRects.internalArray[i];
+
+        // Rounded outwards, with an extra pixel for the right and bottom lines of borders
+        RECT r = {
+            .left = (LONG)floorf(b.x) - 1,
+            .top = (LONG)floorf(b.y) - 1,
+            .right = (LONG)ceilf(b.x + b.width) + 1,
+            .bottom = (LONG)ceilf(b.y + b.height) + 1,
+        };
+        InvalidateRect(hwnd, &r, FALSE);
+    }
+}
+
+// Copies the rectangles of a region from the off-screen DC to the window
+static void __Clay_Win32_BlitRegion(HDC hdc, HRGN region)
+{
+    union {
+        RGNDATA data;
+        char bytes[sizeof(RGNDATAHEADER) + 64 * sizeof(RECT)];
+    } buffer;
+
+    DWORD size = GetRegionData(region, 0, NULL);
+    if (size > 0 && size <= sizeof(buffer) && GetRegionData(region, size, &buffer.data))
+    {
+        RECT* rects = (RECT*)buffer.data.Buffer;
+        for (DWORD i = 0; i < buffer.data.rdh.nCount; i++)
+        {
+            BitBlt(hdc, rects[i].left, rects[i].top, RECTWIDTH(rects[i]), RECTHEIGHT(rects[i]),
+                   renderer_hdcMem, rects[i].left, rects[i].top, SRCCOPY);
+        }
+        return;
+    }
+
+    // Too many rectangles, copy their bounds instead
+    RECT box;
+    GetRgnBox(region, &box);
+    BitBlt(hdc, box.left, box.top, RECTWIDTH(box), RECTHEIGHT(box), renderer_hdcMem, box.left, box.top, SRCCOPY);
 }
 
 void Clay_Win32_Render(HWND hwnd, Clay_RenderCommandArray renderCommands, HFONT* fonts)
@@ -291,20 +377,40 @@ void Clay_Win32_Render(HWND hwnd, Clay_RenderCommandArray renderCommands, HFONT*
 
     PAINTSTRUCT ps;
     HDC hdc;
-    RECT rc; // Top left of our window
+    RECT rc; // Client area of our window
 
-    GetWindowRect(hwnd, &rc);
+    GetClientRect(hwnd, &rc);
+
+    // Only the invalidated part of the window needs to be drawn again, as the rest is still in the off-screen DC.
+    // This has to be read before BeginPaint validates it.
+    HRGN damage = CreateRectRgn(0, 0, 0, 0);
+    bool partial = GetUpdateRgn(hwnd, damage, FALSE) > NULLREGION;
 
     hdc = BeginPaint(hwnd, &ps);
 
     int win_width = rc.right - rc.left,
         win_height = rc.bottom - rc.top;
 
-    // Create an off-screen DC for double-buffering
-    renderer_hdcMem = CreateCompatibleDC(hdc);
-    renderer_hbmMem = CreateCompatibleBitmap(hdc, win_width, win_height);
+    // Create an off-screen DC for double-buffering, or replace it if the window has been resized
+    if (renderer_hdcMem == NULL || renderer_size.cx != win_width || renderer_size.cy != win_height)
+    {
+        Clay_Win32_ReleaseBackBuffer();
 
-    renderer_hOld = SelectObject(renderer_hdcMem, renderer_hbmMem);
+        renderer_hdcMem = CreateCompatibleDC(hdc);
+        renderer_hbmMem = CreateCompatibleBitmap(hdc, win_width, win_height);
+        renderer_hOld = SelectObject(renderer_hdcMem, renderer_hbmMem);
+        renderer_size = (SIZE){ win_width, win_height };
+
+        // A new buffer is drawn in full
+        partial = false;
+    }
+
+    if (!partial)
+        SetRectRgn(damage, 0, 0, win_width, win_height);
+
+    // Anything that isn't covered by a command is black, as it was in a newly created bitmap
+    SelectClipRgn(renderer_hdcMem, damage);
+    FillRgn(renderer_hdcMem, damage, GetStockObject(BLACK_BRUSH));
 
     // draw
 
@@ -313,6 +419,29 @@ void Clay_Win32_Render(HWND hwnd, Clay_RenderCommandArray renderCommands, HFONT*
         Clay_RenderCommand *renderCommand = Clay_RenderCommandArray_Get(&renderCommands, j);
         Clay_BoundingBox boundingBox = renderCommand->boundingBox;
 
+        // Skip commands outside of the damaged region, scissor commands still apply to the ones after them
+        if (partial
+            && renderCommand->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_START
+            && renderCommand->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_END)
+        {
+            // Border lines are centered on the edges of the bounding box, and the right and bottom ones are one pixel outside of it
+            int overhang = 1;
+            if (renderCommand->commandType == CLAY_RENDER_COMMAND_TYPE_BORDER)
+            {
+                Clay_BorderWidth width = renderCommand->renderData.border.width;
+                overhang += max(max(width.left, width.right), max(width.top, width.bottom)) / 2;
+            }
+
+            RECT bounds = {
+                .left = (LONG)boundingBox.x - overhang,
+                .top = (LONG)boundingBox.y - overhang,
+                .right = (LONG)(boundingBox.x + boundingBox.width) + 1 + overhang,
+                .bottom = (LONG)(boundingBox.y + boundingBox.height) + 1 + overhang,
+            };
+            if (!RectInRegion(damage, &bounds))
+                continue;
+        }
+
         switch (renderCommand->commandType)
         {
         case CLAY_RENDER_COMMAND_TYPE_TEXT:
@@ -397,11 +526,18 @@ void Clay_Win32_Render(HWND hwnd, Clay_RenderCommandArray renderCommands, HFONT*
         {
             is_clipping = true;
 
+            if (clipping_region)
+            {
+                DeleteObject(clipping_region);
+            }
+
             clipping_region = CreateRectRgn(boundingBox.x,
                                             boundingBox.y,
                                             boundingBox.x + boundingBox.width,
                                             boundingBox.y + boundingBox.height);
 
+            // Nothing outside of the damaged region is drawn, even inside the scissor rectangle
+            CombineRgn(clipping_region, clipping_region, damage, RGN_AND);
             SelectClipRgn(renderer_hdcMem, clipping_region);
             break;
         }
@@ -409,7 +545,7 @@ void Clay_Win32_Render(HWND hwnd, Clay_RenderCommandArray renderCommands, HFONT*
         // The renderer should finish any previously active clipping, and begin rendering elements in full again.
         case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END:
         {
-            SelectClipRgn(renderer_hdcMem, NULL);
+            SelectClipRgn(renderer_hdcMem, damage);
 
             if (clipping_region)
             {
@@ -498,13 +634,19 @@ void Clay_Win32_Render(HWND hwnd, Clay_RenderCommandArray renderCommands, HFONT*
         }
     }
 
-    BitBlt(hdc, 0, 0, win_width, win_height, renderer_hdcMem, 0, 0, SRCCOPY);
+    SelectClipRgn(renderer_hdcMem, NULL);
+    if (clipping_region)
+    {
+        DeleteObject(clipping_region);
+    }
 
-    // Free-up the off-screen DC
-    SelectObject(renderer_hdcMem, renderer_hOld);
-    DeleteObject(renderer_hbmMem);
-    DeleteDC(renderer_hdcMem);
+    // The off-screen DC is kept for the next frame, only the damaged region is copied to the window
+    if (partial)
+        __Clay_Win32_BlitRegion(hdc, damage);
+    else
+        BitBlt(hdc, 0, 0, win_width, win_height, renderer_hdcMem, 0, 0, SRCCOPY);
 
+    DeleteObject(damage);
     EndPaint(hwnd, &ps);
 }
 